@@ -225,6 +225,10 @@ struct BgfxCallback : public bgfx::CallbackI
 		}
 	}
 
+	virtual void fenceSignaled(bgfx::FenceHandle /*_handle*/) override
+	{
+	}
+
 	AviWriter* m_writer;
 };
 
@@ -17,6 +17,7 @@
 #include "entry_p.h"
 #include "cmd.h"
 #include "input.h"
+#include "perf.h"
 
 extern "C" int32_t _main_(int32_t _argc, char** _argv);
 
@@ -513,20 +514,26 @@ BX_PRAGMA_DIAGNOSTIC_POP();
 		WindowHandle defaultWindow = { 0 };
 		setWindowSize(defaultWindow, s_width, s_height);
 
+		perfInit(_argc, _argv, _app->getName() );
+
 #if BX_PLATFORM_EMSCRIPTEN
 		s_app = _app;
 		emscripten_set_main_loop(&updateApp, -1, 1);
 #else
 		while (_app->update() )
 		{
-			if (0 != bx::strLen(s_restartArgs) )
+			if (0 != bx::strLen(s_restartArgs)
+			||  !perfFrame() )
 			{
 				break;
 			}
 		}
 #endif // BX_PLATFORM_EMSCRIPTEN
 
-		return _app->shutdown();
+		const int32_t result = _app->shutdown();
+		const int32_t perfResult = perfShutdown();
+
+		return bx::kExitSuccess != result ? result : perfResult;
 	}
 
 	static int32_t sortApp(const void* _lhs, const void* _rhs)
@@ -0,0 +1,454 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/allocator.h>
+#include <bx/commandline.h>
+#include <bx/file.h>
+#include <bx/sort.h>
+#include <bx/string.h>
+#include <bgfx/bgfx.h>
+
+#include "entry.h"
+#include "perf.h"
+
+struct PerfMetric
+{
+	enum Enum
+	{
+		Cpu,
+		Submit,
+		Gpu,
+
+		Count
+	};
+};
+
+static const char* s_perfMetricName[] =
+{
+	"cpu",
+	"submit",
+	"gpu",
+};
+BX_STATIC_ASSERT(BX_COUNTOF(s_perfMetricName) == PerfMetric::Count);
+
+struct PerfStat
+{
+	enum Enum
+	{
+		Mean,
+		Min,
+		P50,
+		P95,
+		P99,
+		Max,
+
+		Count
+	};
+};
+
+struct PerfStatInfo
+{
+	const char* name;
+	bool compare;
+};
+
+// Min and max are recorded for reference only, they are too noisy to
+// compare against baseline.
+static const PerfStatInfo s_perfStatInfo[] =
+{
+	{ "mean", true  },
+	{ "min",  false },
+	{ "p50",  true  },
+	{ "p95",  true  },
+	{ "p99",  true  },
+	{ "max",  false },
+};
+BX_STATIC_ASSERT(BX_COUNTOF(s_perfStatInfo) == PerfStat::Count);
+
+struct PerfContext
+{
+	uint32_t    m_numFrames;
+	uint32_t    m_numWarmup;
+	uint32_t    m_frame;
+	float       m_tolerance;
+	bool        m_overrideTolerance;
+	const char* m_recordFilePath;
+	const char* m_baselineFilePath;
+	char        m_name[64];
+	char        m_renderer[64];
+
+	uint32_t    m_num[PerfMetric::Count];
+	float*      m_values[PerfMetric::Count];
+	float       m_stat[PerfMetric::Count][PerfStat::Count];
+};
+
+static PerfContext s_perf;
+
+static int32_t perfCompare(const void* _lhs, const void* _rhs)
+{
+	const float lhs = *(const float*)_lhs;
+	const float rhs = *(const float*)_rhs;
+	return lhs < rhs ? -1 : lhs > rhs ? 1 : 0;
+}
+
+static void perfAdd(PerfMetric::Enum _metric, int64_t _time, int64_t _freq)
+{
+	float* values = s_perf.m_values[_metric];
+	values[s_perf.m_num[_metric]++] = float(double(_time)*1000.0/double(bx::max<int64_t>(_freq, 1) ) );
+}
+
+void perfInit(int _argc, const char* const* _argv, const char* _name)
+{
+	bx::memSet(&s_perf, 0, sizeof(s_perf) );
+
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	const char* frames = cmdLine.findOption("frames");
+	if (NULL == frames)
+	{
+		return;
+	}
+
+	bx::fromString(&s_perf.m_numFrames, frames);
+
+	s_perf.m_numWarmup = 30;
+	const char* warmup = cmdLine.findOption("perf-warmup");
+	if (NULL != warmup)
+	{
+		bx::fromString(&s_perf.m_numWarmup, warmup);
+	}
+
+	s_perf.m_tolerance = 10.0f;
+	const char* tolerance = cmdLine.findOption("perf-tolerance");
+	if (NULL != tolerance)
+	{
+		bx::fromString(&s_perf.m_tolerance, tolerance);
+		s_perf.m_overrideTolerance = true;
+	}
+
+	s_perf.m_recordFilePath   = cmdLine.findOption("perf-record");
+	s_perf.m_baselineFilePath = cmdLine.findOption("perf-baseline");
+
+	bx::strCopy(s_perf.m_name, BX_COUNTOF(s_perf.m_name), _name);
+
+	const uint32_t num = s_perf.m_numFrames > s_perf.m_numWarmup
+		? s_perf.m_numFrames - s_perf.m_numWarmup
+		: 0
+		;
+
+	if (0 < num)
+	{
+		for (uint32_t ii = 0; ii < PerfMetric::Count; ++ii)
+		{
+			s_perf.m_values[ii] = (float*)BX_ALLOC(entry::getAllocator(), num*sizeof(float) );
+		}
+	}
+}
+
+bool perfFrame()
+{
+	if (0 == s_perf.m_numFrames)
+	{
+		return true;
+	}
+
+	if (NULL != s_perf.m_values[0]
+	&&  s_perf.m_frame >= s_perf.m_numWarmup)
+	{
+		const bgfx::Stats* stats = bgfx::getStats();
+
+		perfAdd(PerfMetric::Cpu,    stats->cpuTimeFrame,                    stats->cpuTimerFreq);
+		perfAdd(PerfMetric::Submit, stats->cpuTimeEnd - stats->cpuTimeBegin, stats->cpuTimerFreq);
+
+		if (0 != stats->gpuTimerFreq
+		&&  stats->gpuTimeEnd > stats->gpuTimeBegin)
+		{
+			perfAdd(PerfMetric::Gpu, stats->gpuTimeEnd - stats->gpuTimeBegin, stats->gpuTimerFreq);
+		}
+	}
+
+	if (0 == s_perf.m_frame)
+	{
+		bx::strCopy(s_perf.m_renderer, BX_COUNTOF(s_perf.m_renderer), bgfx::getRendererName(bgfx::getRendererType() ) );
+	}
+
+	++s_perf.m_frame;
+
+	return s_perf.m_frame < s_perf.m_numFrames;
+}
+
+static void perfSummarize()
+{
+	for (uint32_t ii = 0; ii < PerfMetric::Count; ++ii)
+	{
+		const uint32_t num = s_perf.m_num[ii];
+
+		if (0 == num)
+		{
+			continue;
+		}
+
+		float* values = s_perf.m_values[ii];
+		bx::quickSort(values, num, sizeof(float), perfCompare);
+
+		double total = 0.0;
+		for (uint32_t jj = 0; jj < num; ++jj)
+		{
+			total += values[jj];
+		}
+
+		float* stat = s_perf.m_stat[ii];
+		stat[PerfStat::Mean] = float(total/double(num) );
+		stat[PerfStat::Min ] = values[0];
+		stat[PerfStat::P50 ] = values[bx::min<uint32_t>(num-1, num*50/100)];
+		stat[PerfStat::P95 ] = values[bx::min<uint32_t>(num-1, num*95/100)];
+		stat[PerfStat::P99 ] = values[bx::min<uint32_t>(num-1, num*99/100)];
+		stat[PerfStat::Max ] = values[num-1];
+	}
+}
+
+static bool perfWrite(const char* _filePath)
+{
+	bx::FileWriter writer;
+	bx::Error err;
+
+	if (!bx::open(&writer, _filePath, false, &err) )
+	{
+		bx::printf("perf: Failed to open '%s' for writing.\n", _filePath);
+		return false;
+	}
+
+	bx::write(&writer, &err, "# bgfx frame time summary, values are in milliseconds.\n");
+	bx::write(&writer, &err, "name %s\n", s_perf.m_name);
+	bx::write(&writer, &err, "renderer %s\n", s_perf.m_renderer);
+	bx::write(&writer, &err, "frames %u\n", s_perf.m_num[PerfMetric::Cpu]);
+	bx::write(&writer, &err, "tolerance %.1f\n", s_perf.m_tolerance);
+
+	for (uint32_t ii = 0; ii < PerfMetric::Count; ++ii)
+	{
+		if (0 == s_perf.m_num[ii])
+		{
+			continue;
+		}
+
+		for (uint32_t jj = 0; jj < PerfStat::Count; ++jj)
+		{
+			bx::write(&writer, &err
+				, "%s.%s %.4f\n"
+				, s_perfMetricName[ii]
+				, s_perfStatInfo[jj].name
+				, s_perf.m_stat[ii][jj]
+				);
+		}
+	}
+
+	bx::close(&writer);
+
+	bx::printf("perf: Frame time summary written to '%s'.\n", _filePath);
+
+	return err.isOk();
+}
+
+static bool perfFindValue(const bx::StringView& _key, float& _outValue)
+{
+	const bx::StringView dot = bx::strFind(_key, '.');
+
+	if (dot.isEmpty() )
+	{
+		return false;
+	}
+
+	const bx::StringView metric(_key.getPtr(), dot.getPtr() );
+	const bx::StringView stat(dot.getPtr()+1, _key.getTerm() );
+
+	for (uint32_t ii = 0; ii < PerfMetric::Count; ++ii)
+	{
+		if (0 != bx::strCmp(metric, s_perfMetricName[ii])
+		||  0 == s_perf.m_num[ii])
+		{
+			continue;
+		}
+
+		for (uint32_t jj = 0; jj < PerfStat::Count; ++jj)
+		{
+			if (s_perfStatInfo[jj].compare
+			&&  0 == bx::strCmp(stat, s_perfStatInfo[jj].name) )
+			{
+				_outValue = s_perf.m_stat[ii][jj];
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static int32_t perfCompareBaseline(const char* _filePath)
+{
+	bx::FileReader reader;
+
+	if (!bx::open(&reader, _filePath) )
+	{
+		bx::printf("perf: Baseline '%s' doesn't exist, creating it from this run.\n", _filePath);
+		return perfWrite(_filePath) ? bx::kExitSuccess : bx::kExitFailure;
+	}
+
+	const uint32_t size = uint32_t(bx::getSize(&reader) );
+	char* data = (char*)BX_ALLOC(entry::getAllocator(), size+1);
+	bx::read(&reader, data, size);
+	bx::close(&reader);
+	data[size] = '\0';
+
+	float tolerance = s_perf.m_tolerance;
+
+	if (!s_perf.m_overrideTolerance)
+	{
+		for (bx::LineReader lr(data); !lr.isDone();)
+		{
+			const bx::StringView line = bx::strTrim(lr.next(), " \t\r");
+			const bx::StringView sep  = bx::strFind(line, ' ');
+
+			if (!sep.isEmpty()
+			&&  0 == bx::strCmp(bx::StringView(line.getPtr(), sep.getPtr() ), "tolerance") )
+			{
+				bx::fromString(&tolerance, bx::strTrim(bx::StringView(sep.getPtr(), line.getTerm() ), " \t") );
+			}
+		}
+	}
+
+	int32_t result = bx::kExitSuccess;
+
+	bx::printf("perf: Comparing '%s' with baseline '%s', tolerance %.1f%%.\n"
+		, s_perf.m_name
+		, _filePath
+		, tolerance
+		);
+
+	for (bx::LineReader lr(data); !lr.isDone();)
+	{
+		const bx::StringView line = bx::strTrim(lr.next(), " \t\r");
+		const bx::StringView sep  = bx::strFind(line, ' ');
+
+		if (line.isEmpty()
+		||  '#' == line.getPtr()[0]
+		||  sep.isEmpty() )
+		{
+			continue;
+		}
+
+		const bx::StringView key(line.getPtr(), sep.getPtr() );
+		const bx::StringView value = bx::strTrim(bx::StringView(sep.getPtr(), line.getTerm() ), " \t");
+
+		if (0 == bx::strCmp(key, "renderer") )
+		{
+			if (0 != bx::strCmp(value, s_perf.m_renderer) )
+			{
+				bx::printf("perf: Baseline was recorded with '%.*s' renderer, current renderer is '%s'.\n"
+					, value.getLength()
+					, value.getPtr()
+					, s_perf.m_renderer
+					);
+				result = bx::kExitFailure;
+			}
+
+			continue;
+		}
+
+		if (bx::strFind(key, '.').isEmpty() )
+		{
+			continue;
+		}
+
+		float expected = 0.0f;
+		bx::fromString(&expected, value);
+
+		float current = 0.0f;
+		if (!perfFindValue(key, current) )
+		{
+			// Stats not used for comparison are skipped silently, metric
+			// missing from this run (e.g. no GPU timer) is an error.
+			const bx::StringView dot = bx::strFind(key, '.');
+			const bx::StringView metric(key.getPtr(), dot.getPtr() );
+
+			for (uint32_t ii = 0; ii < PerfMetric::Count; ++ii)
+			{
+				if (0 == bx::strCmp(metric, s_perfMetricName[ii])
+				&&  0 == s_perf.m_num[ii])
+				{
+					bx::printf("perf: %-12.*s missing\n", key.getLength(), key.getPtr() );
+					result = bx::kExitFailure;
+				}
+			}
+
+			continue;
+		}
+
+		const float limit     = expected * (1.0f + tolerance/100.0f);
+		const bool  regressed = current > limit;
+		const float delta     = 0.0f < expected
+			? (current - expected) * 100.0f / expected
+			: 0.0f
+			;
+
+		bx::printf("perf: %-12.*s %10.4f ms, baseline %10.4f ms, %+7.2f%% %s\n"
+			, key.getLength()
+			, key.getPtr()
+			, current
+			, expected
+			, delta
+			, regressed ? "REGRESSION" : "ok"
+			);
+
+		if (regressed)
+		{
+			result = bx::kExitFailure;
+		}
+	}
+
+	BX_FREE(entry::getAllocator(), data);
+
+	return result;
+}
+
+int32_t perfShutdown()
+{
+	if (0 == s_perf.m_numFrames)
+	{
+		return bx::kExitSuccess;
+	}
+
+	perfSummarize();
+
+	int32_t result = bx::kExitSuccess;
+
+	if (0 == s_perf.m_num[PerfMetric::Cpu])
+	{
+		bx::printf("perf: No frames measured, --frames must be larger than --perf-warmup.\n");
+		result = bx::kExitFailure;
+	}
+	else
+	{
+		if (NULL != s_perf.m_recordFilePath
+		&&  !perfWrite(s_perf.m_recordFilePath) )
+		{
+			result = bx::kExitFailure;
+		}
+
+		if (NULL != s_perf.m_baselineFilePath
+		&&  bx::kExitSuccess != perfCompareBaseline(s_perf.m_baselineFilePath) )
+		{
+			result = bx::kExitFailure;
+		}
+	}
+
+	for (uint32_t ii = 0; ii < PerfMetric::Count; ++ii)
+	{
+		BX_FREE(entry::getAllocator(), s_perf.m_values[ii]);
+	}
+
+	bx::memSet(&s_perf, 0, sizeof(s_perf) );
+
+	return result;
+}
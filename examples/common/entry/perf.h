@@ -0,0 +1,31 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef PERF_H_HEADER_GUARD
+#define PERF_H_HEADER_GUARD
+
+#include <stdint.h>
+
+/// Fixed frame count run used for frame time regression checks. Options:
+///
+///   --frames <num>              Exit after number of frames.
+///   --perf-warmup <num>         Frames skipped before measuring (default: 30).
+///   --perf-record <file>        Write frame time summary to file.
+///   --perf-baseline <file>      Compare frame time summary with baseline file.
+///   --perf-tolerance <percent>  Allowed slowdown against baseline (default: 10,
+///                               or `tolerance` stored in baseline file).
+///
+void perfInit(int _argc, const char* const* _argv, const char* _name);
+
+/// Collect stats of last frame. Returns false once requested number of
+/// frames is reached.
+bool perfFrame();
+
+/// Write record and compare with baseline. Returns `bx::kExitFailure` if
+/// any measured value is slower than baseline by more than tolerance. When
+/// baseline file doesn't exist, it's created from this run.
+int32_t perfShutdown();
+
+#endif // PERF_H_HEADER_GUARD
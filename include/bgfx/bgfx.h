@@ -390,10 +390,55 @@ namespace bgfx
 		};
 	};
 
+	/// Memory accounting tag. Bytes held by bgfx are tracked per subsystem.
+	///
+	/// @attention C99 equivalent is `bgfx_memory_tag_t`.
+	///
+	struct MemoryTag
+	{
+		/// Memory tags:
+		enum Enum
+		{
+			Context,         //!< Context, resource handles, and references.
+			Frame,           //!< Frame render items, sort keys, arena, and debug text.
+			CommandBuffer,   //!< Frame pre and post command buffers.
+			FrameCache,      //!< Frame matrix and scissor rect caches.
+			UniformBuffer,   //!< Per encoder uniform buffers.
+			TransientBuffer, //!< Transient vertex and index buffer descriptors.
+			Memory,          //!< Memory obtained by `bgfx::alloc`, `bgfx::copy`, and `bgfx::makeRef`.
+			Shader,          //!< Shader uniform lists.
+			Encoder,         //!< Encoders.
+			Renderer,        //!< Renderer backend context, and state caches.
+			Container,       //!< Internal containers.
+
+			Count
+		};
+	};
+
+	/// Frame timing tracked by rolling statistics. See `bgfx::getFrameTimingStats`.
+	///
+	/// @attention C99 equivalent is `bgfx_frame_timing_t`.
+	///
+	struct FrameTiming
+	{
+		/// Frame timings:
+		enum Enum
+		{
+			Frame,      //!< CPU time between two `bgfx::frame` calls.
+			Submit,     //!< Render thread CPU submit time.
+			WaitRender, //!< Time API thread waited for render thread.
+			WaitSubmit, //!< Time render thread waited for API thread.
+			Gpu,        //!< GPU frame time.
+
+			Count
+		};
+	};
+
 	static const uint16_t kInvalidHandle = UINT16_MAX;
 
 	BGFX_HANDLE(DynamicIndexBufferHandle)
 	BGFX_HANDLE(DynamicVertexBufferHandle)
+	BGFX_HANDLE(FenceHandle)
 	BGFX_HANDLE(FrameBufferHandle)
 	BGFX_HANDLE(IndexBufferHandle)
 	BGFX_HANDLE(IndirectBufferHandle)
@@ -595,12 +640,29 @@ namespace bgfx
 		/// @attention C99 equivalent is `bgfx_callback_vtbl.capture_frame`.
 		///
 		virtual void captureFrame(const void* _data, uint32_t _size) = 0;
+
+		/// Called when fence is signaled.
+		///
+		/// @param[in] _handle Fence handle.
+		///
+		/// @remarks
+		///   Not thread safe and it can be called from any thread. Default
+		///   implementation does nothing.
+		///
+		/// @attention C99 equivalent is `bgfx_callback_vtbl.fence_signaled`,
+		///   which can be NULL.
+		///
+		virtual void fenceSignaled(FenceHandle _handle);
 	};
 
 	inline CallbackI::~CallbackI()
 	{
 	}
 
+	inline void CallbackI::fenceSignaled(FenceHandle /*_handle*/)
+	{
+	}
+
 	/// Platform data.
 	///
 	/// @attention C99 equivalent is `bgfx_platform_data_t`.
@@ -684,6 +746,11 @@ namespace bgfx
 		/// specified, bgfx uses the CRT allocator. Bgfx assumes
 		/// custom allocator is thread safe.
 		bx::AllocatorI* allocator;
+
+		/// When set, every frame starting from initialization is
+		/// recorded into this file. It can be replayed offline with
+		/// `bgfx::replayFrame`, see `tools/replay`.
+		const char* captureFilePath;
 	};
 
 	/// Memory release callback.
@@ -915,6 +982,31 @@ namespace bgfx
 		int64_t gpuTimeElapsed; //!< GPU time elapsed.
 	};
 
+	/// Program stats.
+	///
+	/// @attention C99 equivalent is `bgfx_program_stats_t`.
+	///
+	struct ProgramStats
+	{
+		ProgramHandle handle;     //!< Program handle.
+		uint32_t numDraw;         //!< Number of draw and compute calls submitted with program.
+		uint32_t numStateChanges; //!< Number of render state changes.
+		uint32_t numTextureBinds; //!< Number of texture and buffer bind changes.
+		uint32_t uniformBytes;    //!< Amount of per-draw uniform data updated.
+		int64_t  cpuTimeElapsed;  //!< CPU (submit) time elapsed.
+	};
+
+	/// GPU scope stats.
+	///
+	/// @attention C99 equivalent is `bgfx_gpu_scope_stats_t`.
+	///
+	struct GpuScopeStats
+	{
+		char     name[64];       //!< Scope name.
+		uint16_t depth;          //!< Scope nesting depth.
+		int64_t  gpuTimeElapsed; //!< GPU time elapsed in nanoseconds.
+	};
+
 	/// Encoder stats.
 	///
 	/// @attention C99 equivalent is `bgfx_encoder_stats_t`.
@@ -925,6 +1017,34 @@ namespace bgfx
 		int64_t cpuTimeEnd;   //!< Encoder thread CPU submit end time.
 	};
 
+	/// CPU memory held by bgfx, by subsystem. See `MemoryTag::Enum`.
+	///
+	/// @attention C99 equivalent is `bgfx_memory_stats_t`.
+	///
+	struct MemoryStats
+	{
+		int64_t  used[MemoryTag::Count]; //!< Bytes currently held by subsystem.
+		int64_t  peak[MemoryTag::Count]; //!< Peak bytes held by subsystem.
+		uint32_t num[MemoryTag::Count];  //!< Number of live allocations by subsystem.
+		int64_t  totalUsed;              //!< Bytes currently held by all subsystems.
+	};
+
+	/// Frame timing statistics over last `BGFX_CONFIG_FRAME_TIMING_FRAMES` frames.
+	/// All times are in nanoseconds.
+	///
+	/// @attention C99 equivalent is `bgfx_frame_timing_stats_t`.
+	///
+	struct FrameTimingStats
+	{
+		uint32_t numFrames;     //!< Number of sampled frames.
+		int64_t  mean;          //!< Mean.
+		int64_t  p50;           //!< Median.
+		int64_t  p95;           //!< 95th percentile.
+		int64_t  p99;           //!< 99th percentile.
+		int64_t  max;           //!< Maximum.
+		uint32_t histogram[16]; //!< Log2 histogram, bucket `ii` counts samples in [32us << ii, 64us << ii), first and last bucket are open ended.
+	};
+
 	/// Renderer statistics data.
 	///
 	/// @attention C99 equivalent is `bgfx_stats_t`.
@@ -945,6 +1065,9 @@ namespace bgfx
 		int64_t waitRender;                 //!< Time spent waiting for render backend thread to finish issuing
 		                                    //!  draw commands to underlying graphics API.
 		int64_t waitSubmit;                 //!< Time spent waiting for submit thread to advance to next frame.
+		int64_t framePacing;                //!< Time API thread was delayed by frame pacing before starting frame.
+		int64_t cpuTimeSort;                //!< Render thread CPU time spent sorting draw and blit items.
+		int64_t cpuTimeExecCommands;        //!< Render thread CPU time spent executing pre and post commands.
 
 		uint32_t numDraw;                   //!< Number of draw calls submitted.
 		uint32_t numCompute;                //!< Number of compute calls submitted.
@@ -967,9 +1090,22 @@ namespace bgfx
 		int64_t rtMemoryUsed;               //!< Estimate of render target memory used.
 		int32_t transientVbUsed;            //!< Amount of transient vertex buffer used.
 		int32_t transientIbUsed;            //!< Amount of transient index buffer used.
+		int32_t frameArenaUsed;             //!< Amount of per-frame arena memory used.
+		uint32_t numFrameArenaAllocs;       //!< Number of allocations served from per-frame arena.
 
 		uint32_t numPrims[Topology::Count]; //!< Number of primitives rendered.
 
+		uint32_t numProgramChanges;         //!< Number of program changes.
+		uint32_t numBlendStateChanges;      //!< Number of blend state changes.
+		uint32_t numDepthStateChanges;      //!< Number of depth and stencil state changes.
+		uint32_t numRasterStateChanges;     //!< Number of rasterizer state changes.
+		uint32_t numVertexBufferBinds;      //!< Number of vertex buffer binds.
+		uint32_t numIndexBufferBinds;       //!< Number of index buffer binds.
+		uint32_t numTextureBinds;           //!< Number of texture and buffer binds.
+		uint32_t numUniformUploads;         //!< Number of uniform uploads.
+		uint32_t numBindCacheHits;          //!< Number of resource binding sets reused from cache.
+		uint32_t numBindCacheMisses;        //!< Number of resource binding sets created.
+
 		int64_t gpuMemoryMax;               //!< Maximum available GPU memory for application.
 		int64_t gpuMemoryUsed;              //!< Amount of GPU memory used by the application.
 
@@ -981,6 +1117,12 @@ namespace bgfx
 		uint16_t   numViews;                //!< Number of view stats.
 		ViewStats* viewStats;               //!< Array of View stats.
 
+		uint16_t      numProgramStats;      //!< Number of program stats.
+		ProgramStats* programStats;         //!< Array of program stats. Requires `BGFX_DEBUG_PROGRAM_STATS`.
+
+		uint16_t       numGpuScopes;        //!< Number of GPU scope stats.
+		GpuScopeStats* gpuScopeStats;       //!< Array of GPU scope stats. Requires `BGFX_DEBUG_PROFILER`.
+
 		uint8_t       numEncoders;          //!< Number of encoders used during frame.
 		EncoderStats* encoderStats;         //!< Array of encoder stats.
 	};
@@ -1000,6 +1142,30 @@ namespace bgfx
 		///
 		void setMarker(const char* _marker);
 
+		/// Begin GPU timer scope. Scope is timed on GPU from the point
+		/// where draw call submitted after this call is executed, until
+		/// the point where draw call submitted after matching `endGpuScope`
+		/// is executed. Scopes can be nested.
+		///
+		/// @param[in] _name Scope name.
+		///
+		/// @remarks
+		///   Only GL and Vulkan renderers time scopes, and only when
+		///   `BGFX_DEBUG_PROFILER` is set. Results are available a few frames
+		///   later in `Stats::gpuScopeStats`. Since draw calls are sorted
+		///   within view, scopes are best used with `ViewMode::Sequential`
+		///   views.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_begin_gpu_scope`.
+		///
+		void beginGpuScope(const char* _name);
+
+		/// End GPU timer scope.
+		///
+		/// @attention C99 equivalent is `bgfx_encoder_end_gpu_scope`.
+		///
+		void endGpuScope();
+
 		/// Set render states for draw primitive.
 		///
 		/// @param[in] _state State flags. Default state for primitive type is
@@ -1932,6 +2098,11 @@ namespace bgfx
 	///     occurs. Default behavior is that flip occurs before rendering new
 	///     frame. This flag only has effect when `BGFX_CONFIG_MULTITHREADED=0`.
 	///   - `BGFX_RESET_SRGB_BACKBUFFER` - Enable sRGB backbuffer.
+	///   - `BGFX_RESET_FRAME_PACING` - Delay start of API thread frame, so that
+	///     it finishes just as render thread becomes available. This reduces
+	///     input latency without reducing throughput. Delay is reported in
+	///     `Stats::framePacing`. This flag only has effect when renderer is on
+	///     separate thread.
 	/// @param[in] _format Texture format. See: `TextureFormat::Enum`.
 	///
 	/// @attention This call doesn't actually change window size, it just
@@ -1997,24 +2168,62 @@ namespace bgfx
 	///
 	const Stats* getStats();
 
+	/// Returns CPU memory held by bgfx, by subsystem.
+	///
+	/// @remarks
+	///   Only available when bgfx is built with `BGFX_CONFIG_MEMORY_STATS=1`,
+	///   otherwise all counters are zero.
+	///
+	/// @attention C99 equivalent is `bgfx_get_memory_stats`.
+	///
+	const MemoryStats* getMemoryStats();
+
+	/// Returns rolling frame timing statistics.
+	///
+	/// @param[in] _timing Frame timing. See: `FrameTiming::Enum`.
+	///
+	/// @attention Pointer returned is valid until `bgfx::frame` is called.
+	/// @attention C99 equivalent is `bgfx_get_frame_timing_stats`.
+	///
+	const FrameTimingStats* getFrameTimingStats(FrameTiming::Enum _timing);
+
 	/// Allocate buffer to pass to bgfx calls. Data will be freed inside bgfx.
 	///
 	/// @param[in] _size Size to allocate.
+	/// @param[in] _flags Memory flags:
+	///   - `BGFX_MEMORY_FRAME` - Allocate from per-frame arena. Memory is
+	///     reclaimed once the frame is rendered, and it must be passed to bgfx
+	///     before next `bgfx::frame` call. When arena is exhausted allocation
+	///     falls back to regular allocator.
+	///   - `BGFX_MEMORY_STAGING` - Allocate from per-frame staging area. When
+	///     renderer supports it, memory is mapped upload buffer and data is
+	///     consumed by GPU without intermediate copy. Memory can only be passed
+	///     to `bgfx::updateTexture*`, `bgfx::update` of dynamic index/vertex
+	///     buffer, and it must be passed before next `bgfx::frame` call.
+	///     Only OpenGL and Vulkan renderers map staging area (Vulkan only for
+	///     dynamic index/vertex buffers). On Direct3D 9/11/12 and Metal, or
+	///     when staging area is exhausted, allocation silently falls back to
+	///     `BGFX_MEMORY_FRAME` behavior.
 	///
 	/// @attention C99 equivalent is `bgfx_alloc`.
 	///
-	const Memory* alloc(uint32_t _size);
+	const Memory* alloc(
+		  uint32_t _size
+		, uint8_t _flags = BGFX_MEMORY_NONE
+		);
 
 	/// Allocate buffer and copy data into it. Data will be freed inside bgfx.
 	///
 	/// @param[in] _data Pointer to data to be copied.
 	/// @param[in] _size Size of data to be copied.
+	/// @param[in] _flags Memory flags, same as for `bgfx::alloc`.
 	///
 	/// @attention C99 equivalent is `bgfx_copy`.
 	///
 	const Memory* copy(
 		  const void* _data
 		, uint32_t _size
+		, uint8_t _flags = BGFX_MEMORY_NONE
 		);
 
 	/// Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
@@ -2573,6 +2782,29 @@ namespace bgfx
 	///
 	void destroy(ProgramHandle _handle);
 
+	/// Create pipeline state for program, vertex layout and render state
+	/// combination ahead of first draw call that uses it. Use it while
+	/// loading to avoid stalls caused by compiling pipeline on first use.
+	///
+	/// @param[in] _id View id. Pipeline is created for frame buffer currently
+	///   set on view.
+	/// @param[in] _program Program handle.
+	/// @param[in] _declHandle Vertex declaration handle.
+	/// @param[in] _state State flags. See: `bgfx::setState`.
+	///
+	/// @remarks
+	///   Only renderers that compile pipeline state objects do any work,
+	///   for others this is no-op.
+	///
+	/// @attention C99 equivalent is `bgfx_prewarm_pipeline`.
+	///
+	void prewarmPipeline(
+		  ViewId _id
+		, ProgramHandle _program
+		, VertexDeclHandle _declHandle
+		, uint64_t _state = BGFX_STATE_DEFAULT
+		);
+
 	/// Validate texture parameters.
 	///
 	/// @param[in] _depth Depth dimension of volume texture.
@@ -3150,6 +3382,35 @@ namespace bgfx
 	///
 	void destroy(OcclusionQueryHandle _handle);
 
+	/// Create fence. Fence is signaled once GPU completes all work submitted
+	/// before next `bgfx::frame` call.
+	///
+	/// @returns Handle to fence object.
+	///
+	/// @remarks
+	///   `bgfx::CallbackI::fenceSignaled` is called when fence is signaled.
+	///
+	/// @attention C99 equivalent is `bgfx_create_fence`.
+	///
+	FenceHandle createFence();
+
+	/// Returns true if fence is signaled.
+	///
+	/// @param[in] _handle Handle to fence object.
+	/// @returns True if fence is signaled.
+	///
+	/// @attention C99 equivalent is `bgfx_is_signaled`.
+	///
+	bool isSignaled(FenceHandle _handle);
+
+	/// Destroy fence.
+	///
+	/// @param[in] _handle Handle to fence object.
+	///
+	/// @attention C99 equivalent is `bgfx_destroy_fence`.
+	///
+	void destroy(FenceHandle _handle);
+
 	/// Set palette color value.
 	///
 	/// @param[in] _index Index into palette.
@@ -3396,6 +3657,20 @@ namespace bgfx
 	///
 	void setMarker(const char* _marker);
 
+	/// Begin GPU timer scope. See `Encoder::beginGpuScope`.
+	///
+	/// @param[in] _name Scope name.
+	///
+	/// @attention C99 equivalent is `bgfx_begin_gpu_scope`.
+	///
+	void beginGpuScope(const char* _name);
+
+	/// End GPU timer scope.
+	///
+	/// @attention C99 equivalent is `bgfx_end_gpu_scope`.
+	///
+	void endGpuScope();
+
 	/// Set render states for draw primitive.
 	///
 	/// @param[in] _state State flags. Default state for primitive type is
@@ -377,6 +377,44 @@ typedef enum bgfx_view_mode
 
 } bgfx_view_mode_t;
 
+/**
+ * Memory accounting tag. Bytes held by bgfx are tracked per subsystem.
+ *
+ */
+typedef enum bgfx_memory_tag
+{
+    BGFX_MEMORY_TAG_CONTEXT,                  /** ( 0) Context, resource handles, and references. */
+    BGFX_MEMORY_TAG_FRAME,                    /** ( 1) Frame render items, sort keys, arena, and debug text. */
+    BGFX_MEMORY_TAG_COMMAND_BUFFER,           /** ( 2) Frame pre and post command buffers. */
+    BGFX_MEMORY_TAG_FRAME_CACHE,              /** ( 3) Frame matrix and scissor rect caches. */
+    BGFX_MEMORY_TAG_UNIFORM_BUFFER,           /** ( 4) Per encoder uniform buffers.   */
+    BGFX_MEMORY_TAG_TRANSIENT_BUFFER,         /** ( 5) Transient vertex and index buffer descriptors. */
+    BGFX_MEMORY_TAG_MEMORY,                   /** ( 6) Memory obtained by `bgfx::alloc`, `bgfx::copy`, and `bgfx::makeRef`. */
+    BGFX_MEMORY_TAG_SHADER,                   /** ( 7) Shader uniform lists.          */
+    BGFX_MEMORY_TAG_ENCODER,                  /** ( 8) Encoders.                      */
+    BGFX_MEMORY_TAG_RENDERER,                 /** ( 9) Renderer backend context, and state caches. */
+    BGFX_MEMORY_TAG_CONTAINER,                /** (10) Internal containers.           */
+
+    BGFX_MEMORY_TAG_COUNT
+
+} bgfx_memory_tag_t;
+
+/**
+ * Frame timing tracked by rolling statistics. See `bgfx::getFrameTimingStats`.
+ *
+ */
+typedef enum bgfx_frame_timing
+{
+    BGFX_FRAME_TIMING_FRAME,                  /** ( 0) CPU time between two `bgfx::frame` calls. */
+    BGFX_FRAME_TIMING_SUBMIT,                 /** ( 1) Render thread CPU submit time. */
+    BGFX_FRAME_TIMING_WAIT_RENDER,            /** ( 2) Time API thread waited for render thread. */
+    BGFX_FRAME_TIMING_WAIT_SUBMIT,            /** ( 3) Time render thread waited for API thread. */
+    BGFX_FRAME_TIMING_GPU,                    /** ( 4) GPU frame time.                */
+
+    BGFX_FRAME_TIMING_COUNT
+
+} bgfx_frame_timing_t;
+
 /**
  * Render frame enum.
  *
@@ -413,35 +451,12 @@ typedef struct bgfx_allocator_vtbl_s
 /**/
 typedef struct bgfx_interface_vtbl bgfx_interface_vtbl_t;
 
-/**/
-typedef struct bgfx_callback_interface_s
-{
-    const struct bgfx_callback_vtbl_s* vtbl;
-
-} bgfx_callback_interface_t;
-
-/**/
-typedef struct bgfx_callback_vtbl_s
-{
-    void (*fatal)(bgfx_callback_interface_t* _this, const char* _filePath, uint16_t _line, bgfx_fatal_t _code, const char* _str);
-    void (*trace_vargs)(bgfx_callback_interface_t* _this, const char* _filePath, uint16_t _line, const char* _format, va_list _argList);
-    void (*profiler_begin)(bgfx_callback_interface_t* _this, const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line);
-    void (*profiler_begin_literal)(bgfx_callback_interface_t* _this, const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line);
-    void (*profiler_end)(bgfx_callback_interface_t* _this);
-    uint32_t (*cache_read_size)(bgfx_callback_interface_t* _this, uint64_t _id);
-    bool (*cache_read)(bgfx_callback_interface_t* _this, uint64_t _id, void* _data, uint32_t _size);
-    void (*cache_write)(bgfx_callback_interface_t* _this, uint64_t _id, const void* _data, uint32_t _size);
-    void (*screen_shot)(bgfx_callback_interface_t* _this, const char* _filePath, uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _data, uint32_t _size, bool _yflip);
-    void (*capture_begin)(bgfx_callback_interface_t* _this, uint32_t _width, uint32_t _height, uint32_t _pitch, bgfx_texture_format_t _format, bool _yflip);
-    void (*capture_end)(bgfx_callback_interface_t* _this);
-    void (*capture_frame)(bgfx_callback_interface_t* _this, const void* _data, uint32_t _size);
-
-} bgfx_callback_vtbl_t;
-
 typedef struct bgfx_dynamic_index_buffer_handle_s { uint16_t idx; } bgfx_dynamic_index_buffer_handle_t;
 
 typedef struct bgfx_dynamic_vertex_buffer_handle_s { uint16_t idx; } bgfx_dynamic_vertex_buffer_handle_t;
 
+typedef struct bgfx_fence_handle_s { uint16_t idx; } bgfx_fence_handle_t;
+
 typedef struct bgfx_frame_buffer_handle_s { uint16_t idx; } bgfx_frame_buffer_handle_t;
 
 typedef struct bgfx_index_buffer_handle_s { uint16_t idx; } bgfx_index_buffer_handle_t;
@@ -465,6 +480,32 @@ typedef struct bgfx_vertex_decl_handle_s { uint16_t idx; } bgfx_vertex_decl_hand
 
 #define BGFX_HANDLE_IS_VALID(h) ((h).idx != UINT16_MAX)
 
+/**/
+typedef struct bgfx_callback_interface_s
+{
+    const struct bgfx_callback_vtbl_s* vtbl;
+
+} bgfx_callback_interface_t;
+
+/**/
+typedef struct bgfx_callback_vtbl_s
+{
+    void (*fatal)(bgfx_callback_interface_t* _this, const char* _filePath, uint16_t _line, bgfx_fatal_t _code, const char* _str);
+    void (*trace_vargs)(bgfx_callback_interface_t* _this, const char* _filePath, uint16_t _line, const char* _format, va_list _argList);
+    void (*profiler_begin)(bgfx_callback_interface_t* _this, const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line);
+    void (*profiler_begin_literal)(bgfx_callback_interface_t* _this, const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line);
+    void (*profiler_end)(bgfx_callback_interface_t* _this);
+    uint32_t (*cache_read_size)(bgfx_callback_interface_t* _this, uint64_t _id);
+    bool (*cache_read)(bgfx_callback_interface_t* _this, uint64_t _id, void* _data, uint32_t _size);
+    void (*cache_write)(bgfx_callback_interface_t* _this, uint64_t _id, const void* _data, uint32_t _size);
+    void (*screen_shot)(bgfx_callback_interface_t* _this, const char* _filePath, uint32_t _width, uint32_t _height, uint32_t _pitch, const void* _data, uint32_t _size, bool _yflip);
+    void (*capture_begin)(bgfx_callback_interface_t* _this, uint32_t _width, uint32_t _height, uint32_t _pitch, bgfx_texture_format_t _format, bool _yflip);
+    void (*capture_end)(bgfx_callback_interface_t* _this);
+    void (*capture_frame)(bgfx_callback_interface_t* _this, const void* _data, uint32_t _size);
+    void (*fence_signaled)(bgfx_callback_interface_t* _this, bgfx_fence_handle_t _handle);
+
+} bgfx_callback_vtbl_t;
+
 /**
  * Memory release callback.
  *
@@ -661,6 +702,13 @@ typedef struct bgfx_init_s
      * custom allocator is thread safe.
      */
     bgfx_allocator_interface_t* allocator;
+    
+    /**
+     * When set, every frame starting from initialization is
+     * recorded into this file. It can be replayed offline with
+     * `bgfx::replayFrame`, see `tools/replay`.
+     */
+    const char*          captureFilePath;
 
 } bgfx_init_t;
 
@@ -787,6 +835,33 @@ typedef struct bgfx_view_stats_s
 
 } bgfx_view_stats_t;
 
+/**
+ * Program stats.
+ *
+ */
+typedef struct bgfx_program_stats_s
+{
+    bgfx_program_handle_t handle;            /** Program handle.                          */
+    uint32_t             numDraw;            /** Number of draw and compute calls submitted with program. */
+    uint32_t             numStateChanges;    /** Number of render state changes.          */
+    uint32_t             numTextureBinds;    /** Number of texture and buffer bind changes. */
+    uint32_t             uniformBytes;       /** Amount of per-draw uniform data updated. */
+    int64_t              cpuTimeElapsed;     /** CPU (submit) time elapsed.               */
+
+} bgfx_program_stats_t;
+
+/**
+ * GPU scope stats.
+ *
+ */
+typedef struct bgfx_gpu_scope_stats_s
+{
+    char                 name[64];           /** Scope name.                              */
+    uint16_t             depth;              /** Scope nesting depth.                     */
+    int64_t              gpuTimeElapsed;     /** GPU time elapsed in nanoseconds.         */
+
+} bgfx_gpu_scope_stats_t;
+
 /**
  * Encoder stats.
  *
@@ -798,6 +873,35 @@ typedef struct bgfx_encoder_stats_s
 
 } bgfx_encoder_stats_t;
 
+/**
+ * CPU memory held by bgfx, by subsystem. See `MemoryTag::Enum`.
+ *
+ */
+typedef struct bgfx_memory_stats_s
+{
+    int64_t              used[BGFX_MEMORY_TAG_COUNT]; /** Bytes currently held by subsystem.       */
+    int64_t              peak[BGFX_MEMORY_TAG_COUNT]; /** Peak bytes held by subsystem.            */
+    uint32_t             num[BGFX_MEMORY_TAG_COUNT]; /** Number of live allocations by subsystem. */
+    int64_t              totalUsed;          /** Bytes currently held by all subsystems.  */
+
+} bgfx_memory_stats_t;
+
+/**
+ * Frame timing statistics over last `BGFX_CONFIG_FRAME_TIMING_FRAMES` frames. All times are in nanoseconds.
+ *
+ */
+typedef struct bgfx_frame_timing_stats_s
+{
+    uint32_t             numFrames;          /** Number of sampled frames.                */
+    int64_t              mean;               /** Mean.                                    */
+    int64_t              p50;                /** Median.                                  */
+    int64_t              p95;                /** 95th percentile.                         */
+    int64_t              p99;                /** 99th percentile.                         */
+    int64_t              max;                /** Maximum.                                 */
+    uint32_t             histogram[16];      /** Log2 histogram, bucket `ii` counts samples in [32us << ii, 64us << ii), first and last bucket are open ended. */
+
+} bgfx_frame_timing_stats_t;
+
 /**
  * Renderer statistics data.
  * @remarks All time values are high-resolution timestamps, while
@@ -815,6 +919,9 @@ typedef struct bgfx_stats_s
     int64_t              gpuTimerFreq;       /** GPU timer frequency.                     */
     int64_t              waitRender;         /** Time spent waiting for render backend thread to finish issuing draw commands to underlying graphics API. */
     int64_t              waitSubmit;         /** Time spent waiting for submit thread to advance to next frame. */
+    int64_t              framePacing;        /** Time API thread was delayed by frame pacing before starting frame. */
+    int64_t              cpuTimeSort;        /** Render thread CPU time spent sorting draw and blit items. */
+    int64_t              cpuTimeExecCommands; /** Render thread CPU time spent executing pre and post commands. */
     uint32_t             numDraw;            /** Number of draw calls submitted.          */
     uint32_t             numCompute;         /** Number of compute calls submitted.       */
     uint32_t             numBlit;            /** Number of blit calls submitted.          */
@@ -834,7 +941,19 @@ typedef struct bgfx_stats_s
     int64_t              rtMemoryUsed;       /** Estimate of render target memory used.   */
     int32_t              transientVbUsed;    /** Amount of transient vertex buffer used.  */
     int32_t              transientIbUsed;    /** Amount of transient index buffer used.   */
+    int32_t              frameArenaUsed;     /** Amount of per-frame arena memory used.   */
+    uint32_t             numFrameArenaAllocs; /** Number of allocations served from per-frame arena. */
     uint32_t             numPrims[BGFX_TOPOLOGY_COUNT]; /** Number of primitives rendered.           */
+    uint32_t             numProgramChanges;  /** Number of program changes.               */
+    uint32_t             numBlendStateChanges; /** Number of blend state changes.           */
+    uint32_t             numDepthStateChanges; /** Number of depth and stencil state changes. */
+    uint32_t             numRasterStateChanges; /** Number of rasterizer state changes.      */
+    uint32_t             numVertexBufferBinds; /** Number of vertex buffer binds.           */
+    uint32_t             numIndexBufferBinds; /** Number of index buffer binds.            */
+    uint32_t             numTextureBinds;    /** Number of texture and buffer binds.      */
+    uint32_t             numUniformUploads;  /** Number of uniform uploads.               */
+    uint32_t             numBindCacheHits;   /** Number of resource binding sets reused from cache. */
+    uint32_t             numBindCacheMisses; /** Number of resource binding sets created. */
     int64_t              gpuMemoryMax;       /** Maximum available GPU memory for application. */
     int64_t              gpuMemoryUsed;      /** Amount of GPU memory used by the application. */
     uint16_t             width;              /** Backbuffer width in pixels.              */
@@ -843,6 +962,10 @@ typedef struct bgfx_stats_s
     uint16_t             textHeight;         /** Debug text height in characters.         */
     uint16_t             numViews;           /** Number of view stats.                    */
     bgfx_view_stats_t*   viewStats;          /** Array of View stats.                     */
+    uint16_t             numProgramStats;    /** Number of program stats.                 */
+    bgfx_program_stats_t* programStats;      /** Array of program stats. Requires `BGFX_DEBUG_PROGRAM_STATS`. */
+    uint16_t             numGpuScopes;       /** Number of GPU scope stats.               */
+    bgfx_gpu_scope_stats_t* gpuScopeStats;   /** Array of GPU scope stats. Requires `BGFX_DEBUG_PROFILER`. */
     uint8_t              numEncoders;        /** Number of encoders used during frame.    */
     bgfx_encoder_stats_t* encoderStats;      /** Array of encoder stats.                  */
 
@@ -1133,26 +1256,48 @@ BGFX_C_API const bgfx_caps_t* bgfx_get_caps(void);
  */
 BGFX_C_API const bgfx_stats_t* bgfx_get_stats(void);
 
+/**
+ * Returns CPU memory held by bgfx, by subsystem.
+ * @remarks
+ *   Only available when bgfx is built with `BGFX_CONFIG_MEMORY_STATS=1`,
+ *   otherwise all counters are zero.
+ *
+ */
+BGFX_C_API const bgfx_memory_stats_t* bgfx_get_memory_stats(void);
+
+/**
+ * Returns rolling frame timing statistics.
+ * @attention Pointer returned is valid until `bgfx::frame` is called.
+ *
+ * @param[in] _timing Frame timing. See: `FrameTiming::Enum`.
+ *
+ * @returns Frame timing stats.
+ *
+ */
+BGFX_C_API const bgfx_frame_timing_stats_t* bgfx_get_frame_timing_stats(bgfx_frame_timing_t _timing);
+
 /**
  * Allocate buffer to pass to bgfx calls. Data will be freed inside bgfx.
  *
  * @param[in] _size Size to allocate.
+ * @param[in] _flags Memory flags. See: `BGFX_MEMORY_*`.
  *
  * @returns Allocated memory.
  *
  */
-BGFX_C_API const bgfx_memory_t* bgfx_alloc(uint32_t _size);
+BGFX_C_API const bgfx_memory_t* bgfx_alloc(uint32_t _size, uint8_t _flags);
 
 /**
  * Allocate buffer and copy data into it. Data will be freed inside bgfx.
  *
  * @param[in] _data Pointer to data to be copied.
  * @param[in] _size Size of data to be copied.
+ * @param[in] _flags Memory flags. See: `BGFX_MEMORY_*`.
  *
  * @returns Allocated memory.
  *
  */
-BGFX_C_API const bgfx_memory_t* bgfx_copy(const void* _data, uint32_t _size);
+BGFX_C_API const bgfx_memory_t* bgfx_copy(const void* _data, uint32_t _size, uint8_t _flags);
 
 /**
  * Make reference to data to pass to bgfx. Unlike `bgfx::alloc`, this call
@@ -1659,6 +1804,23 @@ BGFX_C_API bgfx_program_handle_t bgfx_create_compute_program(bgfx_shader_handle_
  */
 BGFX_C_API void bgfx_destroy_program(bgfx_program_handle_t _handle);
 
+/**
+ * Create pipeline state for program, vertex layout and render state
+ * combination ahead of first draw call that uses it. Use it while
+ * loading to avoid stalls caused by compiling pipeline on first use.
+ * @remarks
+ *   Only renderers that compile pipeline state objects do any work,
+ *   for others this is no-op.
+ *
+ * @param[in] _id View id. Pipeline is created for frame buffer currently
+ *  set on view.
+ * @param[in] _program Program handle.
+ * @param[in] _declHandle Vertex declaration handle.
+ * @param[in] _state State flags. See: `bgfx::setState`.
+ *
+ */
+BGFX_C_API void bgfx_prewarm_pipeline(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_vertex_decl_handle_t _declHandle, uint64_t _state);
+
 /**
  * Validate texture parameters.
  *
@@ -2102,6 +2264,33 @@ BGFX_C_API bgfx_occlusion_query_result_t bgfx_get_result(bgfx_occlusion_query_ha
  */
 BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _handle);
 
+/**
+ * Create fence. Fence is signaled once GPU completes all work submitted
+ * before next `bgfx::frame` call.
+ * @remarks
+ *   `bgfx::CallbackI::fenceSignaled` is called when fence is signaled.
+ *
+ */
+BGFX_C_API bgfx_fence_handle_t bgfx_create_fence(void);
+
+/**
+ * Returns true if fence is signaled.
+ *
+ * @param[in] _handle Handle to fence object.
+ *
+ * @returns True if fence is signaled.
+ *
+ */
+BGFX_C_API bool bgfx_is_signaled(bgfx_fence_handle_t _handle);
+
+/**
+ * Destroy fence.
+ *
+ * @param[in] _handle Handle to fence object.
+ *
+ */
+BGFX_C_API void bgfx_destroy_fence(bgfx_fence_handle_t _handle);
+
 /**
  * Set palette color value.
  *
@@ -2281,6 +2470,27 @@ BGFX_C_API void bgfx_encoder_end(bgfx_encoder_t* _encoder);
  */
 BGFX_C_API void bgfx_encoder_set_marker(bgfx_encoder_t* _this, const char* _marker);
 
+/**
+ * Begin GPU timer scope. Scope is timed on GPU from the point where draw call
+ * submitted after this call is executed, until the point where draw call
+ * submitted after matching `endGpuScope` is executed. Scopes can be nested.
+ * @remarks
+ *   Only GL and Vulkan renderers time scopes, and only when `BGFX_DEBUG_PROFILER`
+ *   is set. Results are available a few frames later in `Stats::gpuScopeStats`.
+ *   Since draw calls are sorted within view, scopes are best used with
+ *   `ViewMode::Sequential` views.
+ *
+ * @param[in] _name Scope name.
+ *
+ */
+BGFX_C_API void bgfx_encoder_begin_gpu_scope(bgfx_encoder_t* _this, const char* _name);
+
+/**
+ * End GPU timer scope.
+ *
+ */
+BGFX_C_API void bgfx_encoder_end_gpu_scope(bgfx_encoder_t* _this);
+
 /**
  * Set render states for draw primitive.
  * @remarks
@@ -2802,6 +3012,45 @@ BGFX_C_API uintptr_t bgfx_override_internal_texture_ptr(bgfx_texture_handle_t _h
  */
 BGFX_C_API uintptr_t bgfx_override_internal_texture(bgfx_texture_handle_t _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, bgfx_texture_format_t _format, uint64_t _flags);
 
+/**
+ * Replay frame recorded with `Init::captureFilePath`. Frame data is submitted
+ * to renderer instead of state set through API since last `bgfx::frame` call.
+ * @attention It's expected you understand some bgfx internals before you
+ *   use this call.
+ * @warning Must be called only on API thread, and capture must be replayed
+ *   with the same `Init::limits` it was recorded with.
+ *
+ * @param[in] _data Frame chunk data.
+ * @param[in] _size Frame chunk size.
+ *
+ * @returns True if frame was replayed, false if data is not valid frame chunk.
+ *
+ */
+BGFX_C_API bool bgfx_replay_frame(const void* _data, uint32_t _size);
+
+/**
+ * Destroy all resources created by replaying frames, and forget handle
+ * mapping. Call it before replaying capture from the first frame again.
+ * @warning Must be called only on API thread.
+ *
+ */
+BGFX_C_API void bgfx_replay_reset(void);
+
+/**
+ * Write profiler scopes recorded by built-in trace recorder as Chrome trace
+ * event format JSON, viewable in `chrome://tracing` or Perfetto.
+ * @remarks
+ *   Only available when bgfx is built with `BGFX_CONFIG_PROFILER=1`.
+ *
+ * @param[in] _filePath Will be passed to `bx::open`.
+ * @param[in] _firstFrame First frame to write.
+ * @param[in] _numFrames Number of frames to write.
+ *
+ * @returns True if trace was written.
+ *
+ */
+BGFX_C_API bool bgfx_dump_trace(const char* _filePath, uint32_t _firstFrame, uint32_t _numFrames);
+
 /**
  * Sets a debug marker. This allows you to group graphics calls together for easy browsing in
  * graphics debugging tools.
@@ -2811,6 +3060,20 @@ BGFX_C_API uintptr_t bgfx_override_internal_texture(bgfx_texture_handle_t _handl
  */
 BGFX_C_API void bgfx_set_marker(const char* _marker);
 
+/**
+ * Begin GPU timer scope. See `Encoder::beginGpuScope`.
+ *
+ * @param[in] _name Scope name.
+ *
+ */
+BGFX_C_API void bgfx_begin_gpu_scope(const char* _name);
+
+/**
+ * End GPU timer scope.
+ *
+ */
+BGFX_C_API void bgfx_end_gpu_scope(void);
+
 /**
  * Set render states for draw primitive.
  * @remarks
@@ -3253,6 +3516,8 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_GET_RENDERER_TYPE,
     BGFX_FUNCTION_ID_GET_CAPS,
     BGFX_FUNCTION_ID_GET_STATS,
+    BGFX_FUNCTION_ID_GET_MEMORY_STATS,
+    BGFX_FUNCTION_ID_GET_FRAME_TIMING_STATS,
     BGFX_FUNCTION_ID_ALLOC,
     BGFX_FUNCTION_ID_COPY,
     BGFX_FUNCTION_ID_MAKE_REF,
@@ -3294,6 +3559,7 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_CREATE_PROGRAM,
     BGFX_FUNCTION_ID_CREATE_COMPUTE_PROGRAM,
     BGFX_FUNCTION_ID_DESTROY_PROGRAM,
+    BGFX_FUNCTION_ID_PREWARM_PIPELINE,
     BGFX_FUNCTION_ID_IS_TEXTURE_VALID,
     BGFX_FUNCTION_ID_CALC_TEXTURE_SIZE,
     BGFX_FUNCTION_ID_CREATE_TEXTURE,
@@ -3322,6 +3588,9 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_CREATE_OCCLUSION_QUERY,
     BGFX_FUNCTION_ID_GET_RESULT,
     BGFX_FUNCTION_ID_DESTROY_OCCLUSION_QUERY,
+    BGFX_FUNCTION_ID_CREATE_FENCE,
+    BGFX_FUNCTION_ID_IS_SIGNALED,
+    BGFX_FUNCTION_ID_DESTROY_FENCE,
     BGFX_FUNCTION_ID_SET_PALETTE_COLOR,
     BGFX_FUNCTION_ID_SET_PALETTE_COLOR_RGBA8,
     BGFX_FUNCTION_ID_SET_VIEW_NAME,
@@ -3337,6 +3606,8 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_ENCODER_BEGIN,
     BGFX_FUNCTION_ID_ENCODER_END,
     BGFX_FUNCTION_ID_ENCODER_SET_MARKER,
+    BGFX_FUNCTION_ID_ENCODER_BEGIN_GPU_SCOPE,
+    BGFX_FUNCTION_ID_ENCODER_END_GPU_SCOPE,
     BGFX_FUNCTION_ID_ENCODER_SET_STATE,
     BGFX_FUNCTION_ID_ENCODER_SET_CONDITION,
     BGFX_FUNCTION_ID_ENCODER_SET_STENCIL,
@@ -3378,7 +3649,12 @@ typedef enum bgfx_function_id
     BGFX_FUNCTION_ID_GET_INTERNAL_DATA,
     BGFX_FUNCTION_ID_OVERRIDE_INTERNAL_TEXTURE_PTR,
     BGFX_FUNCTION_ID_OVERRIDE_INTERNAL_TEXTURE,
+    BGFX_FUNCTION_ID_REPLAY_FRAME,
+    BGFX_FUNCTION_ID_REPLAY_RESET,
+    BGFX_FUNCTION_ID_DUMP_TRACE,
     BGFX_FUNCTION_ID_SET_MARKER,
+    BGFX_FUNCTION_ID_BEGIN_GPU_SCOPE,
+    BGFX_FUNCTION_ID_END_GPU_SCOPE,
     BGFX_FUNCTION_ID_SET_STATE,
     BGFX_FUNCTION_ID_SET_CONDITION,
     BGFX_FUNCTION_ID_SET_STENCIL,
@@ -3445,8 +3721,10 @@ struct bgfx_interface_vtbl
     bgfx_renderer_type_t (*get_renderer_type)(void);
     const bgfx_caps_t* (*get_caps)(void);
     const bgfx_stats_t* (*get_stats)(void);
-    const bgfx_memory_t* (*alloc)(uint32_t _size);
-    const bgfx_memory_t* (*copy)(const void* _data, uint32_t _size);
+    const bgfx_memory_stats_t* (*get_memory_stats)(void);
+    const bgfx_frame_timing_stats_t* (*get_frame_timing_stats)(bgfx_frame_timing_t _timing);
+    const bgfx_memory_t* (*alloc)(uint32_t _size, uint8_t _flags);
+    const bgfx_memory_t* (*copy)(const void* _data, uint32_t _size, uint8_t _flags);
     const bgfx_memory_t* (*make_ref)(const void* _data, uint32_t _size);
     const bgfx_memory_t* (*make_ref_release)(const void* _data, uint32_t _size, bgfx_release_fn_t _releaseFn, void* _userData);
     void (*set_debug)(uint32_t _debug);
@@ -3486,6 +3764,7 @@ struct bgfx_interface_vtbl
     bgfx_program_handle_t (*create_program)(bgfx_shader_handle_t _vsh, bgfx_shader_handle_t _fsh, bool _destroyShaders);
     bgfx_program_handle_t (*create_compute_program)(bgfx_shader_handle_t _csh, bool _destroyShaders);
     void (*destroy_program)(bgfx_program_handle_t _handle);
+    void (*prewarm_pipeline)(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_vertex_decl_handle_t _declHandle, uint64_t _state);
     bool (*is_texture_valid)(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, bgfx_texture_format_t _format, uint64_t _flags);
     void (*calc_texture_size)(bgfx_texture_info_t * _info, uint16_t _width, uint16_t _height, uint16_t _depth, bool _cubeMap, bool _hasMips, uint16_t _numLayers, bgfx_texture_format_t _format);
     bgfx_texture_handle_t (*create_texture)(const bgfx_memory_t* _mem, uint64_t _flags, uint8_t _skip, bgfx_texture_info_t* _info);
@@ -3514,6 +3793,9 @@ struct bgfx_interface_vtbl
     bgfx_occlusion_query_handle_t (*create_occlusion_query)(void);
     bgfx_occlusion_query_result_t (*get_result)(bgfx_occlusion_query_handle_t _handle, int32_t* _result);
     void (*destroy_occlusion_query)(bgfx_occlusion_query_handle_t _handle);
+    bgfx_fence_handle_t (*create_fence)(void);
+    bool (*is_signaled)(bgfx_fence_handle_t _handle);
+    void (*destroy_fence)(bgfx_fence_handle_t _handle);
     void (*set_palette_color)(uint8_t _index, const float _rgba[4]);
     void (*set_palette_color_rgba8)(uint8_t _index, uint32_t _rgba);
     void (*set_view_name)(bgfx_view_id_t _id, const char* _name);
@@ -3529,6 +3811,8 @@ struct bgfx_interface_vtbl
     bgfx_encoder_t* (*encoder_begin)(bool _forThread);
     void (*encoder_end)(bgfx_encoder_t* _encoder);
     void (*encoder_set_marker)(bgfx_encoder_t* _this, const char* _marker);
+    void (*encoder_begin_gpu_scope)(bgfx_encoder_t* _this, const char* _name);
+    void (*encoder_end_gpu_scope)(bgfx_encoder_t* _this);
     void (*encoder_set_state)(bgfx_encoder_t* _this, uint64_t _state, uint32_t _rgba);
     void (*encoder_set_condition)(bgfx_encoder_t* _this, bgfx_occlusion_query_handle_t _handle, bool _visible);
     void (*encoder_set_stencil)(bgfx_encoder_t* _this, uint32_t _fstencil, uint32_t _bstencil);
@@ -3570,7 +3854,12 @@ struct bgfx_interface_vtbl
     const bgfx_internal_data_t* (*get_internal_data)(void);
     uintptr_t (*override_internal_texture_ptr)(bgfx_texture_handle_t _handle, uintptr_t _ptr);
     uintptr_t (*override_internal_texture)(bgfx_texture_handle_t _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, bgfx_texture_format_t _format, uint64_t _flags);
+    bool (*replay_frame)(const void* _data, uint32_t _size);
+    void (*replay_reset)(void);
+    bool (*dump_trace)(const char* _filePath, uint32_t _firstFrame, uint32_t _numFrames);
     void (*set_marker)(const char* _marker);
+    void (*begin_gpu_scope)(const char* _name);
+    void (*end_gpu_scope)(void);
     void (*set_state)(uint64_t _state, uint32_t _rgba);
     void (*set_condition)(bgfx_occlusion_query_handle_t _handle, bool _visible);
     void (*set_stencil)(uint32_t _fstencil, uint32_t _bstencil);
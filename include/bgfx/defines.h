@@ -6,7 +6,7 @@
 #ifndef BGFX_DEFINES_H_HEADER_GUARD
 #define BGFX_DEFINES_H_HEADER_GUARD
 
-#define BGFX_API_VERSION UINT32_C(99)
+#define BGFX_API_VERSION UINT32_C(114)
 
 /**
  * Color RGB/alpha/depth write. When it's not specified write will be disabled.
@@ -249,6 +249,7 @@
 #define BGFX_DEBUG_STATS                    UINT32_C(0x00000004) //!< Enable statistics display.
 #define BGFX_DEBUG_TEXT                     UINT32_C(0x00000008) //!< Enable debug text display.
 #define BGFX_DEBUG_PROFILER                 UINT32_C(0x00000010) //!< Enable profiler.
+#define BGFX_DEBUG_PROGRAM_STATS            UINT32_C(0x00000020) //!< Enable per-program render thread statistics.
 
 #define BGFX_BUFFER_COMPUTE_FORMAT_8X1      UINT16_C(0x0001) //!< 1 8-bit value
 #define BGFX_BUFFER_COMPUTE_FORMAT_8X2      UINT16_C(0x0002) //!< 2 8-bit values
@@ -423,6 +424,7 @@
 #define BGFX_RESET_HIDPI                    UINT32_C(0x00020000) //!< Enable HiDPI rendering.
 #define BGFX_RESET_DEPTH_CLAMP              UINT32_C(0x00040000) //!< Enable depth clamp.
 #define BGFX_RESET_SUSPEND                  UINT32_C(0x00080000) //!< Suspend rendering.
+#define BGFX_RESET_FRAME_PACING             UINT32_C(0x00100000) //!< Delay start of API thread frame to reduce input latency. This flag only has effect when renderer is on separate thread.
 
 #define BGFX_RESET_FULLSCREEN_SHIFT         0
 
@@ -486,6 +488,10 @@
 #define BGFX_RESOLVE_NONE                   UINT8_C(0x00) //!< No resolve flags.
 #define BGFX_RESOLVE_AUTO_GEN_MIPS          UINT8_C(0x01) //!< Auto-generate mip maps on resolve.
 
+#define BGFX_MEMORY_NONE                    UINT8_C(0x00) //!< No memory flags.
+#define BGFX_MEMORY_FRAME                   UINT8_C(0x01) //!< Allocate from per-frame arena. Memory must be passed to bgfx before next `bgfx::frame` call.
+#define BGFX_MEMORY_STAGING                 UINT8_C(0x02) //!< Allocate from per-frame staging area. Memory can only be used to update texture or dynamic buffer.
+
 #define BGFX_PCI_ID_NONE                    UINT16_C(0x0000) //!< Autoselect adapter.
 #define BGFX_PCI_ID_SOFTWARE_RASTERIZER     UINT16_C(0x0001) //!< Software rasterizer.
 #define BGFX_PCI_ID_AMD                     UINT16_C(0x1002) //!< AMD adapter.
@@ -132,6 +132,54 @@ namespace bgfx
 		, uint64_t _flags = BGFX_TEXTURE_NONE|BGFX_SAMPLER_NONE
 		);
 
+	/// Replay frame recorded with `Init::captureFilePath`. Frame data is
+	/// submitted to renderer instead of state set through API since last
+	/// `bgfx::frame` call.
+	///
+	/// @attention It's expected you understand some bgfx internals before you
+	///   use this call.
+	///
+	/// @param[in] _data Frame chunk data.
+	/// @param[in] _size Frame chunk size.
+	///
+	/// @returns True if frame was replayed, false if data is not valid frame
+	///   chunk.
+	///
+	/// @warning Must be called only on API thread, and capture must be
+	///   replayed with the same `Init::limits` it was recorded with.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_frame`.
+	///
+	bool replayFrame(const void* _data, uint32_t _size);
+
+	/// Destroy all resources created by replaying frames, and forget handle
+	/// mapping. Call it before replaying capture from the first frame again.
+	///
+	/// @warning Must be called only on API thread.
+	///
+	/// @attention C99 equivalent is `bgfx_replay_reset`.
+	///
+	void replayReset();
+
+	/// Write profiler scopes recorded by built-in trace recorder as Chrome
+	/// trace event format JSON, viewable in `chrome://tracing` or Perfetto.
+	///
+	/// @param[in] _filePath Will be passed to `bx::open`.
+	/// @param[in] _firstFrame First frame to write.
+	/// @param[in] _numFrames Number of frames to write.
+	///
+	/// @returns True if trace was written.
+	///
+	/// @remarks
+	///   Only available when bgfx is built with `BGFX_CONFIG_PROFILER=1`.
+	///   Recorder keeps last `BGFX_CONFIG_PROFILER_TRACE_EVENTS` events
+	///   from API, encoder, and render threads, and GPU view timings when
+	///   `BGFX_DEBUG_PROFILER` is set.
+	///
+	/// @attention C99 equivalent is `bgfx_dump_trace`.
+	///
+	bool dumpTrace(const char* _filePath, uint32_t _firstFrame, uint32_t _numFrames = UINT32_MAX);
+
 } // namespace bgfx
 
 #endif // BGFX_PLATFORM_H_HEADER_GUARD
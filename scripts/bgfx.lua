@@ -166,6 +166,7 @@ function bgfxProjectBase(_kind, _defines)
 	if _OPTIONS["with-amalgamated"] then
 		excludes {
 			path.join(BGFX_DIR, "src/bgfx.cpp"),
+			path.join(BGFX_DIR, "src/capture.cpp"),
 			path.join(BGFX_DIR, "src/debug_**.cpp"),
 			path.join(BGFX_DIR, "src/dxgi.cpp"),
 			path.join(BGFX_DIR, "src/glcontext_**.cpp"),
@@ -175,6 +176,7 @@ function bgfxProjectBase(_kind, _defines)
 			path.join(BGFX_DIR, "src/renderer_**.cpp"),
 			path.join(BGFX_DIR, "src/shader**.cpp"),
 			path.join(BGFX_DIR, "src/topology.cpp"),
+			path.join(BGFX_DIR, "src/trace.cpp"),
 			path.join(BGFX_DIR, "src/vertexdecl.cpp"),
 		}
 
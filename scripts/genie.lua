@@ -23,6 +23,11 @@ newoption {
 	description = "Use Wayland backend.",
 }
 
+newoption {
+	trigger = "with-headless",
+	description = "Enable headless build (noop entry, OpenGL ES with surfaceless EGL).",
+}
+
 newoption {
 	trigger = "with-profiler",
 	description = "Enable build with intrusive profiler.",
@@ -97,7 +102,7 @@ BGFX_DIR   = path.getabsolute("..")
 BX_DIR     = os.getenv("BX_DIR")
 BIMG_DIR   = os.getenv("BIMG_DIR")
 
-local BGFX_BUILD_DIR = path.join(BGFX_DIR, ".build")
+local BGFX_BUILD_DIR = path.join(BGFX_DIR, _OPTIONS["with-headless"] and ".build-headless" or ".build")
 local BGFX_THIRD_PARTY_DIR = path.join(BGFX_DIR, "3rdparty")
 if not BX_DIR then
 	BX_DIR = path.getabsolute(path.join(BGFX_DIR, "../bx"))
@@ -141,6 +146,13 @@ if _OPTIONS["with-sdl"] then
 	end
 end
 
+if _OPTIONS["with-headless"] then
+	defines {
+		"ENTRY_CONFIG_USE_NOOP=1",
+		"BGFX_CONFIG_RENDERER_OPENGLES=31",
+	}
+end
+
 if _OPTIONS["with-profiler"] then
 	defines {
 		"ENTRY_CONFIG_PROFILER=1",
@@ -508,4 +520,6 @@ if _OPTIONS["with-tools"] then
 	dofile "texturec.lua"
 	dofile "texturev.lua"
 	dofile "geometryc.lua"
+	dofile "bench.lua"
+	dofile "replay.lua"
 end
@@ -79,6 +79,10 @@ typedef struct bgfx_allocator_vtbl_s
 /**/
 typedef struct bgfx_interface_vtbl bgfx_interface_vtbl_t;
 
+$chandles
+
+#define BGFX_HANDLE_IS_VALID(h) ((h).idx != UINT16_MAX)
+
 /**/
 typedef struct bgfx_callback_interface_s
 {
@@ -101,13 +105,10 @@ typedef struct bgfx_callback_vtbl_s
 	void (*capture_begin)(bgfx_callback_interface_t* _this, uint32_t _width, uint32_t _height, uint32_t _pitch, bgfx_texture_format_t _format, bool _yflip);
 	void (*capture_end)(bgfx_callback_interface_t* _this);
 	void (*capture_frame)(bgfx_callback_interface_t* _this, const void* _data, uint32_t _size);
+	void (*fence_signaled)(bgfx_callback_interface_t* _this, bgfx_fence_handle_t _handle);
 
 } bgfx_callback_vtbl_t;
 
-$chandles
-
-#define BGFX_HANDLE_IS_VALID(h) ((h).idx != UINT16_MAX)
-
 $cfuncptrs
 
 $cstructs
@@ -4,6 +4,7 @@
  */
 
 #include "bgfx.cpp"
+#include "capture.cpp"
 #include "debug_renderdoc.cpp"
 #include "dxgi.cpp"
 #include "glcontext_egl.cpp"
@@ -22,4 +23,5 @@
 #include "shader_dxbc.cpp"
 #include "shader_spirv.cpp"
 #include "topology.cpp"
+#include "trace.cpp"
 #include "vertexdecl.cpp"
@@ -10,6 +10,7 @@
 #include <bx/file.h>
 #include <bx/mutex.h>
 
+#include "capture.h"
 #include "topology.h"
 
 #if BX_PLATFORM_OSX
@@ -40,14 +41,14 @@ namespace bgfx
 #if BGFX_CONFIG_USE_TINYSTL
 	void* TinyStlAllocator::static_allocate(size_t _bytes)
 	{
-		return BX_ALLOC(g_allocator, _bytes);
+		return BX_ALLOC(getAllocator(MemoryTag::Container), _bytes);
 	}
 
 	void TinyStlAllocator::static_deallocate(void* _ptr, size_t /*_bytes*/)
 	{
 		if (NULL != _ptr)
 		{
-			BX_FREE(g_allocator, _ptr);
+			BX_FREE(getAllocator(MemoryTag::Container), _ptr);
 		}
 	}
 #endif // BGFX_CONFIG_USE_TINYSTL
@@ -146,6 +147,10 @@ namespace bgfx
 		virtual void captureFrame(const void* /*_data*/, uint32_t /*_size*/) override
 		{
 		}
+
+		virtual void fenceSignaled(FenceHandle /*_handle*/) override
+		{
+		}
 	};
 
 #ifndef BGFX_CONFIG_MEMORY_TRACKING
@@ -245,6 +250,131 @@ namespace bgfx
 
 	Caps g_caps;
 
+	static MemoryStats s_memoryStats;
+
+#if BGFX_CONFIG_MEMORY_STATS
+	struct MemoryCounter
+	{
+		int64_t  m_used[MemoryTag::Count];
+		int64_t  m_peak[MemoryTag::Count];
+		uint32_t m_num[MemoryTag::Count];
+	};
+
+	static MemoryCounter s_memoryCounter;
+
+	void memoryTag(MemoryTag::Enum _tag, int64_t _size)
+	{
+		const int64_t used = bx::atomicAddAndFetch<int64_t>(&s_memoryCounter.m_used[_tag], _size);
+
+		for (int64_t peak = s_memoryCounter.m_peak[_tag]; used > peak;)
+		{
+			const int64_t old = bx::atomicCompareAndSwap<int64_t>(&s_memoryCounter.m_peak[_tag], peak, used);
+			if (old == peak)
+			{
+				break;
+			}
+
+			peak = old;
+		}
+	}
+
+	class TaggedAllocator : public bx::AllocatorI
+	{
+	public:
+		struct Header
+		{
+			uint64_t m_size;
+			uint32_t m_offset;
+			uint32_t m_align;
+		};
+
+		virtual ~TaggedAllocator()
+		{
+		}
+
+		virtual void* realloc(void* _ptr, size_t _size, size_t _align, const char* _file, uint32_t _line) override
+		{
+			if (0 == _size)
+			{
+				free(_ptr, _file, _line);
+				return NULL;
+			}
+
+			void* ptr = alloc(_size, _align, _file, _line);
+
+			if (NULL != _ptr)
+			{
+				const Header* header = (const Header*)_ptr - 1;
+				bx::memCopy(ptr, _ptr, bx::min<size_t>(_size, size_t(header->m_size) ) );
+				free(_ptr, _file, _line);
+			}
+
+			return ptr;
+		}
+
+	private:
+		MemoryTag::Enum tag() const;
+
+		void* alloc(size_t _size, size_t _align, const char* _file, uint32_t _line)
+		{
+			// Header is stored right before user pointer, offset is kept multiple of alignment.
+			const uint32_t offset = bx::max<uint32_t>(uint32_t(_align), sizeof(Header) );
+
+			uint8_t* data = (uint8_t*)g_allocator->realloc(NULL, _size + offset, _align, _file, _line);
+			uint8_t* ptr  = data + offset;
+
+			Header* header   = (Header*)ptr - 1;
+			header->m_size   = _size;
+			header->m_offset = offset;
+			header->m_align  = uint32_t(_align);
+
+			const MemoryTag::Enum memTag = tag();
+			memoryTag(memTag, int64_t(_size) );
+			bx::atomicFetchAndAdd<uint32_t>(&s_memoryCounter.m_num[memTag], 1);
+
+			return ptr;
+		}
+
+		void free(void* _ptr, const char* _file, uint32_t _line)
+		{
+			if (NULL == _ptr)
+			{
+				return;
+			}
+
+			const Header* header = (const Header*)_ptr - 1;
+			uint8_t* data = (uint8_t*)_ptr - header->m_offset;
+
+			const MemoryTag::Enum memTag = tag();
+			memoryTag(memTag, -int64_t(header->m_size) );
+			bx::atomicFetchAndSub<uint32_t>(&s_memoryCounter.m_num[memTag], 1);
+
+			g_allocator->realloc(data, 0, header->m_align, _file, _line);
+		}
+	};
+
+	static TaggedAllocator s_taggedAllocator[MemoryTag::Count];
+
+	inline MemoryTag::Enum TaggedAllocator::tag() const
+	{
+		return MemoryTag::Enum(this - s_taggedAllocator);
+	}
+
+	bx::AllocatorI* getAllocator(MemoryTag::Enum _tag)
+	{
+		return &s_taggedAllocator[_tag];
+	}
+#else
+	void memoryTag(MemoryTag::Enum /*_tag*/, int64_t /*_size*/)
+	{
+	}
+
+	bx::AllocatorI* getAllocator(MemoryTag::Enum /*_tag*/)
+	{
+		return g_allocator;
+	}
+#endif // BGFX_CONFIG_MEMORY_STATS
+
 #if BGFX_CONFIG_MULTITHREADED && !defined(BX_THREAD_LOCAL)
 	class ThreadData
 	{
@@ -395,6 +525,35 @@ namespace bgfx
 		return rci->getInternal(_handle);
 	}
 
+	bool replayFrame(const void* _data, uint32_t _size)
+	{
+		BGFX_CHECK_API_THREAD();
+		return s_ctx->replayFrame(_data, _size);
+	}
+
+	void replayReset()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->replayReset();
+	}
+
+	bool dumpTrace(const char* _filePath, uint32_t _firstFrame, uint32_t _numFrames)
+	{
+		BGFX_CHECK_API_THREAD();
+
+		bx::FileWriter writer;
+		if (!bx::open(&writer, _filePath) )
+		{
+			BX_TRACE("Failed to open trace file '%s'.", _filePath);
+			return false;
+		}
+
+		const bool result = traceWrite(&writer, _firstFrame, _numFrames);
+		bx::close(&writer);
+
+		return result;
+	}
+
 	void setGraphicsDebuggerPresent(bool _present)
 	{
 		BX_TRACE("Graphics debugger is %spresent.", _present ? "" : "not ");
@@ -659,7 +818,7 @@ namespace bgfx
 
 		const Memory* mem;
 
-		mem = alloc(pitch*height);
+		mem = alloc(pitch*height, BGFX_MEMORY_FRAME);
 		uint8_t* rgba = mem->data;
 		charsetFillTexture(vga8x8, rgba, 8, pitch, bpp);
 		charsetFillTexture(vga8x16, &rgba[8*pitch], 16, pitch, bpp);
@@ -1355,6 +1514,8 @@ namespace bgfx
 	{
 		BGFX_PROFILER_SCOPE("bgfx/Sort", 0xff2040ff);
 
+		const int64_t timeBegin = bx::getHPCounter();
+
 		ViewId viewRemap[BGFX_CONFIG_MAX_VIEWS];
 		for (uint32_t ii = 0; ii < BGFX_CONFIG_MAX_VIEWS; ++ii)
 		{
@@ -1372,6 +1533,8 @@ namespace bgfx
 			m_blitKeys[ii] = BlitKey::remapView(m_blitKeys[ii], viewRemap);
 		}
 		bx::radixSort(m_blitKeys, (uint32_t*)&s_ctx->m_tempKeys, m_numBlitItems);
+
+		m_perfStats.cpuTimeSort = bx::getHPCounter() - timeBegin;
 	}
 
 	RenderFrame::Enum renderFrame(int32_t _msecs)
@@ -1434,10 +1597,10 @@ namespace bgfx
 		write(&_handle, sizeof(UniformHandle) );
 	}
 
-	void UniformBuffer::writeMarker(const char* _marker)
+	void UniformBuffer::writeMarker(const char* _marker, MarkerType::Enum _type)
 	{
 		uint16_t num = (uint16_t)bx::strLen(_marker)+1;
-		uint32_t opcode = encodeOpcode(bgfx::UniformType::Count, 0, num, true);
+		uint32_t opcode = encodeOpcode(bgfx::UniformType::Count, uint16_t(_type), num, true);
 		write(opcode);
 		write(_marker, num);
 	}
@@ -1764,6 +1927,10 @@ namespace bgfx
 		m_frames  = 0;
 		m_debug   = BGFX_DEBUG_NONE;
 		m_frameTimeLast = bx::getHPCounter();
+		m_frameTimingHistory.reset();
+
+		traceInit();
+		traceFrame(m_frames);
 
 		m_submit->create();
 
@@ -1814,14 +1981,19 @@ namespace bgfx
 
 		m_declRef.init();
 
+		if (NULL != _init.captureFilePath)
+		{
+			captureBegin(_init.captureFilePath);
+		}
+
 		CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RendererInit);
 		cmdbuf.write(_init);
 
 		frameNoRenderWait();
 
-		m_encoderHandle = bx::createHandleAlloc(g_allocator, _init.limits.maxEncoders);
-		m_encoder       = (EncoderImpl*)BX_ALLOC(g_allocator, sizeof(EncoderImpl)*_init.limits.maxEncoders);
-		m_encoderStats  = (EncoderStats*)BX_ALLOC(g_allocator, sizeof(EncoderStats)*_init.limits.maxEncoders);
+		m_encoderHandle = bx::createHandleAlloc(getAllocator(MemoryTag::Encoder), _init.limits.maxEncoders);
+		m_encoder       = (EncoderImpl*)BX_ALLOC(getAllocator(MemoryTag::Encoder), sizeof(EncoderImpl)*_init.limits.maxEncoders);
+		m_encoderStats  = (EncoderStats*)BX_ALLOC(getAllocator(MemoryTag::Encoder), sizeof(EncoderStats)*_init.limits.maxEncoders);
 		for (uint32_t ii = 0, num = _init.limits.maxEncoders; ii < num; ++ii)
 		{
 			BX_PLACEMENT_NEW(&m_encoder[ii], EncoderImpl);
@@ -1896,6 +2068,8 @@ namespace bgfx
 
 	void Context::shutdown()
 	{
+		captureEnd();
+
 		getCommandBuffer(CommandBuffer::RendererShutdownBegin);
 		frame();
 
@@ -1919,15 +2093,15 @@ namespace bgfx
 
 		m_encoder[0].end(true);
 		m_encoderHandle->free(0);
-		bx::destroyHandleAlloc(g_allocator, m_encoderHandle);
+		bx::destroyHandleAlloc(getAllocator(MemoryTag::Encoder), m_encoderHandle);
 		m_encoderHandle = NULL;
 
 		for (uint32_t ii = 0, num = g_caps.limits.maxEncoders; ii < num; ++ii)
 		{
 			m_encoder[ii].~EncoderImpl();
 		}
-		BX_FREE(g_allocator, m_encoder);
-		BX_FREE(g_allocator, m_encoderStats);
+		BX_FREE(getAllocator(MemoryTag::Encoder), m_encoder);
+		BX_FREE(getAllocator(MemoryTag::Encoder), m_encoderStats);
 
 		m_dynVertexBufferAllocator.compact();
 		m_dynIndexBufferAllocator.compact();
@@ -1960,6 +2134,10 @@ namespace bgfx
 
 		m_submit->destroy();
 
+		m_textureUpdateBatch.destroy();
+
+		traceShutdown();
+
 		if (BX_ENABLED(BGFX_CONFIG_DEBUG) )
 		{
 #define CHECK_HANDLE_LEAK(_name, _handleAlloc)                                        \
@@ -2034,6 +2212,7 @@ namespace bgfx
 			CHECK_HANDLE_LEAK_NAME   ("FrameBufferHandle",         m_frameBufferHandle,        FrameBufferRef, m_frameBufferRef);
 			CHECK_HANDLE_LEAK_RC_NAME("UniformHandle",             m_uniformHandle,            UniformRef,     m_uniformRef    );
 			CHECK_HANDLE_LEAK        ("OcclusionQueryHandle",      m_occlusionQueryHandle                                      );
+			CHECK_HANDLE_LEAK        ("FenceHandle",               m_fenceHandle                                               );
 #undef CHECK_HANDLE_LEAK
 #undef CHECK_HANDLE_LEAK_NAME
 		}
@@ -2101,6 +2280,11 @@ namespace bgfx
 		{
 			m_uniformHandle.free(_frame->m_freeUniform.get(ii).idx);
 		}
+
+		for (uint16_t ii = 0, num = _frame->m_freeFence.getNumQueued(); ii < num; ++ii)
+		{
+			m_fenceHandle.free(_frame->m_freeFence.get(ii).idx);
+		}
 	}
 
 	Encoder* Context::begin(bool _forThread)
@@ -2146,25 +2330,249 @@ namespace bgfx
 	{
 		m_encoder[0].end(true);
 
+		uint32_t frames;
+
+		{
 #if BGFX_CONFIG_MULTITHREADED
-		bx::MutexScope resourceApiScope(m_resourceApiLock);
+			bx::MutexScope resourceApiScope(m_resourceApiLock);
 
-		encoderApiWait();
-		bx::MutexScope encoderApiScope(m_encoderApiLock);
+			encoderApiWait();
+			bx::MutexScope encoderApiScope(m_encoderApiLock);
 #else
-		encoderApiWait();
+			encoderApiWait();
 #endif // BGFX_CONFIG_MULTITHREADED
 
-		m_submit->m_capture = _capture;
+			m_submit->m_capture = _capture;
 
-		BGFX_PROFILER_SCOPE("bgfx/API thread frame", 0xff2040ff);
-		// wait for render thread to finish
-		renderSemWait();
-		frameNoRenderWait();
+			BGFX_PROFILER_SCOPE("bgfx/API thread frame", 0xff2040ff);
+			// wait for render thread to finish
+			renderSemWait();
+			updateFramePacing();
+			frameNoRenderWait();
+
+			frames = m_frames;
+		}
+
+		// Wait outside of API locks, other threads can keep creating
+		// resources while API thread is held back.
+		framePacingWait();
+
+		m_encoder[0].begin(m_submit, 0);
+
+		return frames;
+	}
+
+	bool Context::replayFrame(const void* _data, uint32_t _size)
+	{
+		m_encoder[0].end(true);
+
+		bool result;
+
+		{
+#if BGFX_CONFIG_MULTITHREADED
+			bx::MutexScope resourceApiScope(m_resourceApiLock);
+
+			encoderApiWait();
+			bx::MutexScope encoderApiScope(m_encoderApiLock);
+#else
+			encoderApiWait();
+#endif // BGFX_CONFIG_MULTITHREADED
+
+			BGFX_PROFILER_SCOPE("bgfx/API thread replay frame", 0xff2040ff);
+			renderSemWait();
+
+			bx::MemoryReader reader(_data, _size);
+			bx::Error err;
+
+			result = captureReadFrame(&reader, &err);
+
+			if (!result)
+			{
+				BX_TRACE("Failed to replay frame: %s", err.getMessage().getPtr() );
+
+				// Resource commands decoded before failure stay in frame,
+				// resources they created are destroyed after them.
+				captureDestroyCreated();
+
+				m_submit->m_numRenderItems = 0;
+				m_submit->m_numBlitItems   = 0;
+				m_submit->m_frameCache.reset();
+				m_submit->m_iboffset = 0;
+				m_submit->m_vboffset = 0;
+			}
+
+			frameNoRenderWait();
+		}
 
 		m_encoder[0].begin(m_submit, 0);
 
-		return m_frames;
+		return result;
+	}
+
+	void Context::replayReset()
+	{
+		BGFX_MUTEX_SCOPE(m_resourceApiLock);
+		captureReset();
+	}
+
+	void Context::updateFramePacing()
+	{
+		if (!BX_ENABLED(BGFX_CONFIG_MULTITHREADED)
+		||  m_singleThreaded
+		||  0 == (m_init.resolution.reset & BGFX_RESET_FRAME_PACING) )
+		{
+			m_framePacing = 0;
+			m_submit->m_framePacing = 0;
+			m_submit->m_perfStats.framePacing = 0;
+			return;
+		}
+
+		// Render thread just finished m_render, its timings are the most
+		// recent estimate of how long the next frame will take to render.
+		const Stats& stats = m_render->m_perfStats;
+		const int64_t cpuFreq    = bx::getHPFrequency();
+		const int64_t renderTime = stats.cpuTimeEnd - stats.cpuTimeBegin;
+		const int64_t gpuTime    = 0 < stats.gpuTimerFreq && stats.gpuTimeEnd > stats.gpuTimeBegin
+			? (stats.gpuTimeEnd - stats.gpuTimeBegin)*cpuFreq/stats.gpuTimerFreq
+			: 0
+			;
+		const int64_t frameTime = bx::max(renderTime, gpuTime);
+
+		// Keep some headroom so that jitter in API thread frame doesn't make
+		// render thread starve.
+		const int64_t margin = bx::max(frameTime/8, cpuFreq/2000);
+
+		const int64_t waitRender = m_submit->m_waitRender;
+		const int64_t waitSubmit = m_render->m_waitSubmit;
+
+		int64_t slack = m_framePacing;
+
+		if (waitSubmit > margin)
+		{
+			// Render thread was waiting for API thread, back off immediately.
+			slack -= waitSubmit - margin;
+		}
+		else
+		{
+			// API thread was waiting for render thread, move that wait to
+			// start of frame gradually.
+			slack += (waitRender - margin)/2;
+		}
+
+		m_framePacing = bx::clamp<int64_t>(slack, 0, frameTime);
+		m_submit->m_framePacing = m_framePacing;
+		m_submit->m_perfStats.framePacing = m_framePacing;
+	}
+
+	static int64_t toNs(int64_t _time, int64_t _freq)
+	{
+		return 0 < _freq
+			? int64_t(double(_time)*1000000000.0/double(_freq) )
+			: 0
+			;
+	}
+
+	static int32_t compareFrameTiming(const void* _lhs, const void* _rhs)
+	{
+		const int64_t lhs = *(const int64_t*)_lhs;
+		const int64_t rhs = *(const int64_t*)_rhs;
+		return lhs < rhs ? -1 : lhs > rhs ? 1 : 0;
+	}
+
+	void FrameTimingHistory::reset()
+	{
+		bx::memSet(m_num, 0, sizeof(m_num) );
+		bx::memSet(m_pos, 0, sizeof(m_pos) );
+	}
+
+	void FrameTimingHistory::add(const Stats& _stats)
+	{
+		int64_t sample[FrameTiming::Count];
+		sample[FrameTiming::Frame]      = toNs(_stats.cpuTimeFrame,                    _stats.cpuTimerFreq);
+		sample[FrameTiming::Submit]     = toNs(_stats.cpuTimeEnd - _stats.cpuTimeBegin, _stats.cpuTimerFreq);
+		sample[FrameTiming::WaitRender] = toNs(_stats.waitRender,                      _stats.cpuTimerFreq);
+		sample[FrameTiming::WaitSubmit] = toNs(_stats.waitSubmit,                      _stats.cpuTimerFreq);
+		sample[FrameTiming::Gpu]        = _stats.gpuTimeEnd > _stats.gpuTimeBegin
+			? toNs(_stats.gpuTimeEnd - _stats.gpuTimeBegin, _stats.gpuTimerFreq)
+			: 0
+			;
+
+		for (uint32_t ii = 0; ii < FrameTiming::Count; ++ii)
+		{
+			// Renderers without GPU timer don't contribute GPU samples.
+			if (FrameTiming::Gpu == ii
+			&&  0 == sample[ii])
+			{
+				continue;
+			}
+
+			m_sample[ii][m_pos[ii]] = sample[ii];
+			m_pos[ii] = (m_pos[ii] + 1) % BGFX_CONFIG_FRAME_TIMING_FRAMES;
+			m_num[ii] = bx::min<uint32_t>(m_num[ii] + 1, BGFX_CONFIG_FRAME_TIMING_FRAMES);
+		}
+	}
+
+	void FrameTimingHistory::summarize(FrameTiming::Enum _timing, FrameTimingStats& _outStats) const
+	{
+		bx::memSet(&_outStats, 0, sizeof(FrameTimingStats) );
+
+		const uint32_t num = m_num[_timing];
+		_outStats.numFrames = num;
+
+		if (0 == num)
+		{
+			return;
+		}
+
+		int64_t sorted[BGFX_CONFIG_FRAME_TIMING_FRAMES];
+		bx::memCopy(sorted, m_sample[_timing], num*sizeof(int64_t) );
+		bx::quickSort(sorted, num, sizeof(int64_t), compareFrameTiming);
+
+		int64_t total = 0;
+
+		for (uint32_t ii = 0; ii < num; ++ii)
+		{
+			const int64_t time = sorted[ii];
+			total += time;
+
+			// Bucket ii holds [32us << ii, 64us << ii).
+			const uint32_t units  = uint32_t(bx::min<int64_t>(time/32000, UINT32_MAX) );
+			const uint32_t bucket = 2 > units ? 0 : 31 - bx::uint32_cntlz(units);
+			++_outStats.histogram[bx::min<uint32_t>(bucket, BX_COUNTOF(_outStats.histogram)-1)];
+		}
+
+		_outStats.mean = total/num;
+		_outStats.p50  = sorted[bx::min<uint32_t>(num-1, num*50/100)];
+		_outStats.p95  = sorted[bx::min<uint32_t>(num-1, num*95/100)];
+		_outStats.p99  = sorted[bx::min<uint32_t>(num-1, num*99/100)];
+		_outStats.max  = sorted[num-1];
+	}
+
+	void Context::framePacingWait()
+	{
+		if (0 == m_framePacing)
+		{
+			return;
+		}
+
+		BGFX_PROFILER_SCOPE("bgfx/Frame pacing", 0xff2040ff);
+
+		const int64_t freq = bx::getHPFrequency();
+		const int64_t end  = bx::getHPCounter() + m_framePacing;
+
+		for (int64_t now = bx::getHPCounter(); now < end; now = bx::getHPCounter() )
+		{
+			// Sleep is coarse, spin for the last millisecond.
+			const int64_t ms = (end - now)*1000/freq;
+			if (1 < ms)
+			{
+				bx::sleep(uint32_t(ms - 1) );
+			}
+			else
+			{
+				bx::yield();
+			}
+		}
 	}
 
 	void Context::frameNoRenderWait()
@@ -2182,6 +2590,15 @@ namespace bgfx
 		m_init.resolution.reset &= ~BGFX_RESET_INTERNAL_FORCE;
 		m_submit->m_debug = m_debug;
 		m_submit->m_perfStats.numViews = 0;
+		m_submit->m_perfStats.numProgramStats = 0;
+
+		if (0 != (m_debug & BGFX_DEBUG_STATS) )
+		{
+			for (uint32_t ii = 0; ii < FrameTiming::Count; ++ii)
+			{
+				m_frameTimingHistory.summarize(FrameTiming::Enum(ii), m_submit->m_frameTiming[ii]);
+			}
+		}
 
 		bx::memCopy(m_submit->m_viewRemap, m_viewRemap, sizeof(m_viewRemap) );
 		bx::memCopy(m_submit->m_view, m_view, sizeof(m_view) );
@@ -2197,6 +2614,11 @@ namespace bgfx
 
 		m_submit->finish();
 
+		if (NULL != m_captureWriter)
+		{
+			captureWriteFrame(m_captureWriter, m_captureBlock, m_submit);
+		}
+
 		bx::swap(m_render, m_submit);
 
 		bx::memCopy(m_render->m_occlusion, m_submit->m_occlusion, sizeof(m_submit->m_occlusion) );
@@ -2208,6 +2630,7 @@ namespace bgfx
 		}
 
 		m_frames++;
+		traceFrame(m_frames);
 		m_submit->start();
 
 		bx::memSet(m_seq, 0, sizeof(m_seq) );
@@ -2221,6 +2644,10 @@ namespace bgfx
 		int64_t now = bx::getHPCounter();
 		m_submit->m_perfStats.cpuTimeFrame = now - m_frameTimeLast;
 		m_frameTimeLast = now;
+
+		// Render thread is done with m_submit, it holds complete timings of
+		// the most recently rendered frame.
+		m_frameTimingHistory.add(m_submit->m_perfStats);
 	}
 
 	///
@@ -2284,23 +2711,50 @@ namespace bgfx
 
 		if (apiSemWait(_msecs) )
 		{
+			const uint8_t stagingIdx = uint8_t(m_render - m_frame);
+
+			if (NULL != m_render->m_staging.m_data)
+			{
+				// Staging memory must be unmapped before update commands consume it.
+				m_renderCtx->unmapStagingBuffer(stagingIdx, m_render->m_staging.m_offset);
+			}
+
+			int64_t timeExecCommands = bx::getHPCounter();
+
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Exec commands pre", 0xff2040ff);
 				rendererExecCommands(m_render->m_cmdPre);
 			}
 
+			timeExecCommands = bx::getHPCounter() - timeExecCommands;
+
 			if (m_rendererInitialized)
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Render submit", 0xff2040ff);
 				m_renderCtx->submit(m_render, m_clearQuad, m_textVideoMemBlitter);
 				m_flipped = false;
+
+				traceGpuViews(m_render->m_perfStats);
 			}
 
+			const int64_t timeExecCommandsPost = bx::getHPCounter();
+
 			{
 				BGFX_PROFILER_SCOPE("bgfx/Exec commands post", 0xff2040ff);
 				rendererExecCommands(m_render->m_cmdPost);
 			}
 
+			timeExecCommands += bx::getHPCounter() - timeExecCommandsPost;
+			m_render->m_perfStats.cpuTimeExecCommands = timeExecCommands;
+
+			checkFences();
+
+			m_render->m_staging.attach(m_rendererInitialized
+				? m_renderCtx->mapStagingBuffer(stagingIdx, BGFX_CONFIG_FRAME_STAGING_SIZE)
+				: NULL
+				, BGFX_CONFIG_FRAME_STAGING_SIZE
+				);
+
 			renderSemPost();
 
 			if (m_flipAfterRender)
@@ -2353,7 +2807,50 @@ namespace bgfx
 			}
 			else
 			{
-				_renderCtx->setMarker(data, uint16_t(size)-1);
+				switch (loc)
+				{
+				case MarkerType::GpuScopeBegin:
+					_renderCtx->beginGpuScope(data, uint16_t(size)-1);
+					break;
+
+				case MarkerType::GpuScopeEnd:
+					_renderCtx->endGpuScope();
+					break;
+
+				default:
+					_renderCtx->setMarker(data, uint16_t(size)-1);
+					break;
+				}
+			}
+		}
+	}
+
+	void Context::checkFences()
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Check fences", 0xff2040ff);
+
+		for (uint16_t ii = 0; ii < m_numPendingFences;)
+		{
+			const PendingFence& fence = m_pendingFence[ii];
+
+			// Backends without GPU sync primitive signal fence after the same
+			// number of frames readTexture promises data to be available.
+			const bool signaled = fence.m_native
+				? m_renderCtx->isFenceSignaled(fence.m_handle)
+				: m_frames >= fence.m_frameNum + 2
+				;
+
+			if (signaled)
+			{
+				const FenceHandle handle = fence.m_handle;
+				m_pendingFence[ii] = m_pendingFence[--m_numPendingFences];
+
+				bx::atomicFetchAndAdd<uint32_t>(&m_fenceSignaled[handle.idx], 1);
+				g_callback->fenceSignaled(handle);
+			}
+			else
+			{
+				++ii;
 			}
 		}
 	}
@@ -2971,11 +3468,6 @@ namespace bgfx
 				{
 					BGFX_PROFILER_SCOPE("UpdateTexture", 0xff2040ff);
 
-					if (m_textureUpdateBatch.isFull() )
-					{
-						flushTextureUpdateBatch(_cmdbuf);
-					}
-
 					uint32_t value = _cmdbuf.m_pos;
 
 					TextureHandle handle;
@@ -3155,6 +3647,40 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::CreateFence:
+				{
+					BGFX_PROFILER_SCOPE("CreateFence", 0xff2040ff);
+
+					FenceHandle handle;
+					_cmdbuf.read(handle);
+
+					PendingFence& fence = m_pendingFence[m_numPendingFences++];
+					fence.m_handle   = handle;
+					fence.m_frameNum = m_frames;
+					fence.m_native   = m_renderCtx->createFence(handle);
+				}
+				break;
+
+			case CommandBuffer::DestroyFence:
+				{
+					BGFX_PROFILER_SCOPE("DestroyFence", 0xff2040ff);
+
+					FenceHandle handle;
+					_cmdbuf.read(handle);
+
+					for (uint16_t ii = 0, num = m_numPendingFences; ii < num; ++ii)
+					{
+						if (m_pendingFence[ii].m_handle.idx == handle.idx)
+						{
+							m_pendingFence[ii] = m_pendingFence[--m_numPendingFences];
+							break;
+						}
+					}
+
+					m_renderCtx->destroyFence(handle);
+				}
+				break;
+
 			case CommandBuffer::UpdateViewName:
 				{
 					BGFX_PROFILER_SCOPE("UpdateViewName", 0xff2040ff);
@@ -3198,6 +3724,26 @@ namespace bgfx
 				}
 				break;
 
+			case CommandBuffer::PrewarmPipeline:
+				{
+					BGFX_PROFILER_SCOPE("PrewarmPipeline", 0xff2040ff);
+
+					ProgramHandle program;
+					_cmdbuf.read(program);
+
+					VertexDeclHandle declHandle;
+					_cmdbuf.read(declHandle);
+
+					FrameBufferHandle fbh;
+					_cmdbuf.read(fbh);
+
+					uint64_t state;
+					_cmdbuf.read(state);
+
+					m_renderCtx->prewarmPipeline(program, declHandle, fbh, state);
+				}
+				break;
+
 			default:
 				BX_CHECK(false, "Invalid command: %d", command);
 				break;
@@ -3280,6 +3826,7 @@ namespace bgfx
 		, profile(BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
 		, callback(NULL)
 		, allocator(NULL)
+		, captureFilePath(NULL)
 	{
 		limits.maxEncoders     = BGFX_CONFIG_DEFAULT_MAX_ENCODERS;
 		limits.transientVbSize = BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE;
@@ -3387,7 +3934,7 @@ namespace bgfx
 
 		errorState = ErrorState::ContextAllocated;
 
-		s_ctx = BX_ALIGNED_NEW(g_allocator, Context, 64);
+		s_ctx = BX_ALIGNED_NEW(getAllocator(MemoryTag::Context), Context, 64);
 		if (s_ctx->init(_init) )
 		{
 			BX_TRACE("Init complete.");
@@ -3400,7 +3947,7 @@ namespace bgfx
 		switch (errorState)
 		{
 		case ErrorState::ContextAllocated:
-			BX_ALIGNED_DELETE(g_allocator, s_ctx, 64);
+			BX_ALIGNED_DELETE(getAllocator(MemoryTag::Context), s_ctx, 64);
 			s_ctx = NULL;
 			BX_FALLTHROUGH;
 
@@ -3436,7 +3983,7 @@ namespace bgfx
 		ctx->shutdown();
 		BX_CHECK(NULL == s_ctx, "bgfx is should be uninitialized here.");
 
-		BX_ALIGNED_DELETE(g_allocator, ctx, 16);
+		BX_ALIGNED_DELETE(getAllocator(MemoryTag::Context), ctx, 16);
 
 		BX_TRACE("Shutdown complete.");
 
@@ -3482,6 +4029,16 @@ namespace bgfx
 		BGFX_ENCODER(setMarker(_marker) );
 	}
 
+	void Encoder::beginGpuScope(const char* _name)
+	{
+		BGFX_ENCODER(beginGpuScope(_name) );
+	}
+
+	void Encoder::endGpuScope()
+	{
+		BGFX_ENCODER(endGpuScope() );
+	}
+
 	void Encoder::setState(uint64_t _state, uint32_t _rgba)
 	{
 		BX_CHECK(0 == (_state&BGFX_STATE_RESERVED_MASK), "Do not set state reserved flags!");
@@ -3822,24 +4379,86 @@ namespace bgfx
 		return s_ctx->getPerfStats();
 	}
 
+	const FrameTimingStats* getFrameTimingStats(FrameTiming::Enum _timing)
+	{
+		BX_CHECK(_timing < FrameTiming::Count, "Invalid frame timing %d.", _timing);
+		return s_ctx->getFrameTimingStats(_timing);
+	}
+
+	const MemoryStats* getMemoryStats()
+	{
+		MemoryStats& stats = s_memoryStats;
+		bx::memSet(&stats, 0, sizeof(stats) );
+
+#if BGFX_CONFIG_MEMORY_STATS
+		for (uint32_t ii = 0; ii < MemoryTag::Count; ++ii)
+		{
+			stats.used[ii] = s_memoryCounter.m_used[ii];
+			stats.peak[ii] = s_memoryCounter.m_peak[ii];
+			stats.num[ii]  = s_memoryCounter.m_num[ii];
+			stats.totalUsed += stats.used[ii];
+		}
+#endif // BGFX_CONFIG_MEMORY_STATS
+
+		return &stats;
+	}
+
 	RendererType::Enum getRendererType()
 	{
 		return g_caps.rendererType;
 	}
 
-	const Memory* alloc(uint32_t _size)
+	const Memory* alloc(uint32_t _size, uint8_t _flags)
 	{
 		BX_CHECK(0 < _size, "Invalid memory operation. _size is 0.");
-		Memory* mem = (Memory*)BX_ALLOC(g_allocator, sizeof(Memory) + _size);
+
+		Memory* mem = NULL;
+
+		// Frame arena is reset on API thread inside bgfx::frame, allocations from
+		// other threads could outlive it and they always go to regular allocator.
+		if (0 != (_flags & BGFX_MEMORY_FRAME)
+		&&  NULL != s_ctx
+		&&  BGFX_API_THREAD_MAGIC == s_threadIndex)
+		{
+			mem = (Memory*)s_ctx->m_submit->m_arena.alloc(sizeof(Memory) + _size);
+		}
+		else if (0 != (_flags & BGFX_MEMORY_STAGING)
+		&&  NULL != s_ctx
+		&&  BGFX_API_THREAD_MAGIC == s_threadIndex)
+		{
+			Frame* frame = s_ctx->m_submit;
+
+			// Staging area is mapped by renderer, when it's not available data
+			// lives in frame arena as plain memory.
+			uint8_t* data = (uint8_t*)frame->m_staging.alloc(_size);
+			if (NULL != data)
+			{
+				mem = (Memory*)frame->m_arena.alloc(sizeof(Memory) );
+				if (NULL != mem)
+				{
+					mem->size = _size;
+					mem->data = data;
+					return mem;
+				}
+			}
+
+			mem = (Memory*)frame->m_arena.alloc(sizeof(Memory) + _size);
+		}
+
+		if (NULL == mem)
+		{
+			mem = (Memory*)BX_ALLOC(getAllocator(MemoryTag::Memory), sizeof(Memory) + _size);
+		}
+
 		mem->size = _size;
 		mem->data = (uint8_t*)mem + sizeof(Memory);
 		return mem;
 	}
 
-	const Memory* copy(const void* _data, uint32_t _size)
+	const Memory* copy(const void* _data, uint32_t _size, uint8_t _flags)
 	{
 		BX_CHECK(0 < _size, "Invalid memory operation. _size is 0.");
-		const Memory* mem = alloc(_size);
+		const Memory* mem = alloc(_size, _flags);
 		bx::memCopy(mem->data, _data, _size);
 		return mem;
 	}
@@ -3853,7 +4472,7 @@ namespace bgfx
 
 	const Memory* makeRef(const void* _data, uint32_t _size, ReleaseFn _releaseFn, void* _userData)
 	{
-		MemoryRef* memRef = (MemoryRef*)BX_ALLOC(g_allocator, sizeof(MemoryRef) );
+		MemoryRef* memRef = (MemoryRef*)BX_ALLOC(getAllocator(MemoryTag::Memory), sizeof(MemoryRef) );
 		memRef->mem.size  = _size;
 		memRef->mem.data  = (uint8_t*)_data;
 		memRef->releaseFn = _releaseFn;
@@ -3870,6 +4489,14 @@ namespace bgfx
 	{
 		BX_CHECK(NULL != _mem, "_mem can't be NULL");
 		Memory* mem = const_cast<Memory*>(_mem);
+
+		if (NULL != s_ctx
+		&&  s_ctx->isFrameMemory(mem) )
+		{
+			// Reclaimed when frame arena is reset.
+			return;
+		}
+
 		if (isMemoryRef(mem) )
 		{
 			MemoryRef* memRef = reinterpret_cast<MemoryRef*>(mem);
@@ -3878,7 +4505,7 @@ namespace bgfx
 				memRef->releaseFn(mem->data, memRef->userData);
 			}
 		}
-		BX_FREE(g_allocator, mem);
+		BX_FREE(getAllocator(MemoryTag::Memory), mem);
 	}
 
 	void setDebug(uint32_t _debug)
@@ -4140,6 +4767,11 @@ namespace bgfx
 		s_ctx->destroyProgram(_handle);
 	}
 
+	void prewarmPipeline(ViewId _id, ProgramHandle _program, VertexDeclHandle _declHandle, uint64_t _state)
+	{
+		s_ctx->prewarmPipeline(_id, _program, _declHandle, _state);
+	}
+
 	static void isTextureValid(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, TextureFormat::Enum _format, uint64_t _flags, bx::Error* _err)
 	{
 		BX_ERROR_SCOPE(_err);
@@ -4327,7 +4959,7 @@ namespace bgfx
 		}
 
 		uint32_t size = sizeof(uint32_t)+sizeof(TextureCreate);
-		const Memory* mem = alloc(size);
+		const Memory* mem = alloc(size, BGFX_MEMORY_FRAME);
 
 		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
 		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
@@ -4380,7 +5012,7 @@ namespace bgfx
 		}
 
 		uint32_t size = sizeof(uint32_t)+sizeof(TextureCreate);
-		const Memory* mem = alloc(size);
+		const Memory* mem = alloc(size, BGFX_MEMORY_FRAME);
 
 		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
 		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
@@ -4422,7 +5054,7 @@ namespace bgfx
 		}
 
 		uint32_t size = sizeof(uint32_t)+sizeof(TextureCreate);
-		const Memory* mem = alloc(size);
+		const Memory* mem = alloc(size, BGFX_MEMORY_FRAME);
 
 		bx::StaticMemoryBlockWriter writer(mem->data, mem->size);
 		uint32_t magic = BGFX_CHUNK_MAGIC_TEX;
@@ -4621,6 +5253,21 @@ namespace bgfx
 		s_ctx->destroyOcclusionQuery(_handle);
 	}
 
+	FenceHandle createFence()
+	{
+		return s_ctx->createFence();
+	}
+
+	bool isSignaled(FenceHandle _handle)
+	{
+		return s_ctx->isSignaled(_handle);
+	}
+
+	void destroy(FenceHandle _handle)
+	{
+		s_ctx->destroyFence(_handle);
+	}
+
 	void setPaletteColor(uint8_t _index, uint32_t _rgba)
 	{
 		const uint8_t rr = uint8_t(_rgba>>24);
@@ -4733,6 +5380,18 @@ namespace bgfx
 		s_ctx->m_encoder0->setMarker(_marker);
 	}
 
+	void beginGpuScope(const char* _name)
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->beginGpuScope(_name);
+	}
+
+	void endGpuScope()
+	{
+		BGFX_CHECK_API_THREAD();
+		s_ctx->m_encoder0->endGpuScope();
+	}
+
 	void setState(uint64_t _state, uint32_t _rgba)
 	{
 		BGFX_CHECK_API_THREAD();
@@ -5301,6 +5960,16 @@ namespace bgfx
 			m_interface->vtbl->capture_frame(m_interface, _data, _size);
 		}
 
+		virtual void fenceSignaled(FenceHandle _handle) override
+		{
+			// Slot was added later, callers with older vtbl leave it NULL.
+			if (NULL != m_interface->vtbl->fence_signaled)
+			{
+				union { FenceHandle cpp; bgfx_fence_handle_t c; } handle = { _handle };
+				m_interface->vtbl->fence_signaled(m_interface, handle.c);
+			}
+		}
+
 		bgfx_callback_interface_t* m_interface;
 	};
 
@@ -170,14 +170,24 @@ BGFX_C_API const bgfx_stats_t* bgfx_get_stats(void)
 	return (const bgfx_stats_t*)bgfx::getStats();
 }
 
-BGFX_C_API const bgfx_memory_t* bgfx_alloc(uint32_t _size)
+BGFX_C_API const bgfx_memory_stats_t* bgfx_get_memory_stats(void)
 {
-	return (const bgfx_memory_t*)bgfx::alloc(_size);
+	return (const bgfx_memory_stats_t*)bgfx::getMemoryStats();
 }
 
-BGFX_C_API const bgfx_memory_t* bgfx_copy(const void* _data, uint32_t _size)
+BGFX_C_API const bgfx_frame_timing_stats_t* bgfx_get_frame_timing_stats(bgfx_frame_timing_t _timing)
 {
-	return (const bgfx_memory_t*)bgfx::copy(_data, _size);
+	return (const bgfx_frame_timing_stats_t*)bgfx::getFrameTimingStats((bgfx::FrameTiming::Enum)_timing);
+}
+
+BGFX_C_API const bgfx_memory_t* bgfx_alloc(uint32_t _size, uint8_t _flags)
+{
+	return (const bgfx_memory_t*)bgfx::alloc(_size, _flags);
+}
+
+BGFX_C_API const bgfx_memory_t* bgfx_copy(const void* _data, uint32_t _size, uint8_t _flags)
+{
+	return (const bgfx_memory_t*)bgfx::copy(_data, _size, _flags);
 }
 
 BGFX_C_API const bgfx_memory_t* bgfx_make_ref(const void* _data, uint32_t _size)
@@ -424,6 +434,13 @@ BGFX_C_API void bgfx_destroy_program(bgfx_program_handle_t _handle)
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API void bgfx_prewarm_pipeline(bgfx_view_id_t _id, bgfx_program_handle_t _program, bgfx_vertex_decl_handle_t _declHandle, uint64_t _state)
+{
+	union { bgfx_program_handle_t c; bgfx::ProgramHandle cpp; } program = { _program };
+	union { bgfx_vertex_decl_handle_t c; bgfx::VertexDeclHandle cpp; } declHandle = { _declHandle };
+	bgfx::prewarmPipeline((bgfx::ViewId)_id, program.cpp, declHandle.cpp, _state);
+}
+
 BGFX_C_API bool bgfx_is_texture_valid(uint16_t _depth, bool _cubeMap, uint16_t _numLayers, bgfx_texture_format_t _format, uint64_t _flags)
 {
 	return bgfx::isTextureValid(_depth, _cubeMap, _numLayers, (bgfx::TextureFormat::Enum)_format, _flags);
@@ -606,6 +623,25 @@ BGFX_C_API void bgfx_destroy_occlusion_query(bgfx_occlusion_query_handle_t _hand
 	bgfx::destroy(handle.cpp);
 }
 
+BGFX_C_API bgfx_fence_handle_t bgfx_create_fence(void)
+{
+	union { bgfx_fence_handle_t c; bgfx::FenceHandle cpp; } handle_ret;
+	handle_ret.cpp = bgfx::createFence();
+	return handle_ret.c;
+}
+
+BGFX_C_API bool bgfx_is_signaled(bgfx_fence_handle_t _handle)
+{
+	union { bgfx_fence_handle_t c; bgfx::FenceHandle cpp; } handle = { _handle };
+	return bgfx::isSignaled(handle.cpp);
+}
+
+BGFX_C_API void bgfx_destroy_fence(bgfx_fence_handle_t _handle)
+{
+	union { bgfx_fence_handle_t c; bgfx::FenceHandle cpp; } handle = { _handle };
+	bgfx::destroy(handle.cpp);
+}
+
 BGFX_C_API void bgfx_set_palette_color(uint8_t _index, const float _rgba[4])
 {
 	bgfx::setPaletteColor(_index, _rgba);
@@ -683,6 +719,18 @@ BGFX_C_API void bgfx_encoder_set_marker(bgfx_encoder_t* _this, const char* _mark
 	This->setMarker(_marker);
 }
 
+BGFX_C_API void bgfx_encoder_begin_gpu_scope(bgfx_encoder_t* _this, const char* _name)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->beginGpuScope(_name);
+}
+
+BGFX_C_API void bgfx_encoder_end_gpu_scope(bgfx_encoder_t* _this)
+{
+	bgfx::Encoder* This = (bgfx::Encoder*)_this;
+	This->endGpuScope();
+}
+
 BGFX_C_API void bgfx_encoder_set_state(bgfx_encoder_t* _this, uint64_t _state, uint32_t _rgba)
 {
 	bgfx::Encoder* This = (bgfx::Encoder*)_this;
@@ -956,11 +1004,36 @@ BGFX_C_API uintptr_t bgfx_override_internal_texture(bgfx_texture_handle_t _handl
 	return bgfx::overrideInternal(handle.cpp, _width, _height, _numMips, (bgfx::TextureFormat::Enum)_format, _flags);
 }
 
+BGFX_C_API bool bgfx_replay_frame(const void* _data, uint32_t _size)
+{
+	return bgfx::replayFrame(_data, _size);
+}
+
+BGFX_C_API void bgfx_replay_reset(void)
+{
+	bgfx::replayReset();
+}
+
+BGFX_C_API bool bgfx_dump_trace(const char* _filePath, uint32_t _firstFrame, uint32_t _numFrames)
+{
+	return bgfx::dumpTrace(_filePath, _firstFrame, _numFrames);
+}
+
 BGFX_C_API void bgfx_set_marker(const char* _marker)
 {
 	bgfx::setMarker(_marker);
 }
 
+BGFX_C_API void bgfx_begin_gpu_scope(const char* _name)
+{
+	bgfx::beginGpuScope(_name);
+}
+
+BGFX_C_API void bgfx_end_gpu_scope(void)
+{
+	bgfx::endGpuScope();
+}
+
 BGFX_C_API void bgfx_set_state(uint64_t _state, uint32_t _rgba)
 {
 	bgfx::setState(_state, _rgba);
@@ -1225,6 +1298,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_get_renderer_type,
 			bgfx_get_caps,
 			bgfx_get_stats,
+			bgfx_get_memory_stats,
+			bgfx_get_frame_timing_stats,
 			bgfx_alloc,
 			bgfx_copy,
 			bgfx_make_ref,
@@ -1266,6 +1341,7 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_program,
 			bgfx_create_compute_program,
 			bgfx_destroy_program,
+			bgfx_prewarm_pipeline,
 			bgfx_is_texture_valid,
 			bgfx_calc_texture_size,
 			bgfx_create_texture,
@@ -1294,6 +1370,9 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_create_occlusion_query,
 			bgfx_get_result,
 			bgfx_destroy_occlusion_query,
+			bgfx_create_fence,
+			bgfx_is_signaled,
+			bgfx_destroy_fence,
 			bgfx_set_palette_color,
 			bgfx_set_palette_color_rgba8,
 			bgfx_set_view_name,
@@ -1309,6 +1388,8 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_encoder_begin,
 			bgfx_encoder_end,
 			bgfx_encoder_set_marker,
+			bgfx_encoder_begin_gpu_scope,
+			bgfx_encoder_end_gpu_scope,
 			bgfx_encoder_set_state,
 			bgfx_encoder_set_condition,
 			bgfx_encoder_set_stencil,
@@ -1350,7 +1431,12 @@ BGFX_C_API bgfx_interface_vtbl_t* bgfx_get_interface(uint32_t _version)
 			bgfx_get_internal_data,
 			bgfx_override_internal_texture_ptr,
 			bgfx_override_internal_texture,
+			bgfx_replay_frame,
+			bgfx_replay_reset,
+			bgfx_dump_trace,
 			bgfx_set_marker,
+			bgfx_begin_gpu_scope,
+			bgfx_end_gpu_scope,
 			bgfx_set_state,
 			bgfx_set_condition,
 			bgfx_set_stencil,
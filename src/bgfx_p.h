@@ -52,10 +52,10 @@
 
 #if BGFX_CONFIG_PROFILER
 #	define BGFX_PROFILER_SCOPE(_name, _abgr)            ProfilerScope BX_CONCATENATE(profilerScope, __LINE__)(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_BEGIN(_name, _abgr)            g_callback->profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    g_callback->profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) )
-#	define BGFX_PROFILER_END()                          g_callback->profilerEnd()
-#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) BX_NOOP()
+#	define BGFX_PROFILER_BEGIN(_name, _abgr)            bgfx::profilerBegin(_name, _abgr, __FILE__, uint16_t(__LINE__) )
+#	define BGFX_PROFILER_BEGIN_LITERAL(_name, _abgr)    bgfx::profilerBeginLiteral(_name, _abgr, __FILE__, uint16_t(__LINE__) )
+#	define BGFX_PROFILER_END()                          bgfx::profilerEnd()
+#	define BGFX_PROFILER_SET_CURRENT_THREAD_NAME(_name) bgfx::traceSetThreadName(_name)
 #else
 #	define BGFX_PROFILER_SCOPE(_name, _abgr)            BX_NOOP()
 #	define BGFX_PROFILER_BEGIN(_name, _abgr)            BX_NOOP()
@@ -130,6 +130,7 @@ namespace bgfx
 #include <bgfx/platform.h>
 #include <bimg/bimg.h>
 #include "shader.h"
+#include "trace.h"
 #include "vertexdecl.h"
 
 #define BGFX_CHUNK_MAGIC_TEX BX_MAKEFOURCC('T', 'E', 'X', 0x0)
@@ -465,20 +466,46 @@ namespace bgfx
 	extern const uint32_t g_uniformTypeSize[UniformType::Count+1];
 	extern CallbackI* g_callback;
 	extern bx::AllocatorI* g_allocator;
+
+	/// Returns allocator that accounts allocations to subsystem `_tag`, and
+	/// forwards them to `g_allocator`.
+	bx::AllocatorI* getAllocator(MemoryTag::Enum _tag);
+
+	/// Account memory not allocated through `getAllocator`, for example
+	/// storage embedded in other structures, to subsystem `_tag`.
+	void memoryTag(MemoryTag::Enum _tag, int64_t _size);
 	extern Caps g_caps;
 
 	typedef bx::StringT<&g_allocator> String;
 
+	inline void profilerBegin(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
+	{
+		traceBegin(_name, _abgr);
+		g_callback->profilerBegin(_name, _abgr, _filePath, _line);
+	}
+
+	inline void profilerBeginLiteral(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
+	{
+		traceBegin(_name, _abgr);
+		g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+	}
+
+	inline void profilerEnd()
+	{
+		g_callback->profilerEnd();
+		traceEnd();
+	}
+
 	struct ProfilerScope
 	{
 		ProfilerScope(const char* _name, uint32_t _abgr, const char* _filePath, uint16_t _line)
 		{
-			g_callback->profilerBeginLiteral(_name, _abgr, _filePath, _line);
+			profilerBeginLiteral(_name, _abgr, _filePath, _line);
 		}
 
 		~ProfilerScope()
 		{
-			g_callback->profilerEnd();
+			profilerEnd();
 		}
 	};
 
@@ -560,7 +587,7 @@ namespace bgfx
 
 		~TextVideoMem()
 		{
-			BX_FREE(g_allocator, m_mem);
+			BX_FREE(getAllocator(MemoryTag::Frame), m_mem);
 		}
 
 		void resize(bool _small, uint32_t _width, uint32_t _height)
@@ -580,7 +607,7 @@ namespace bgfx
 				uint32_t size = m_size;
 				m_size = m_width * m_height;
 
-				m_mem = (MemSlot*)BX_REALLOC(g_allocator, m_mem, m_size * sizeof(MemSlot));
+				m_mem = (MemSlot*)BX_REALLOC(getAllocator(MemoryTag::Frame), m_mem, m_size * sizeof(MemSlot));
 
 				if (size < m_size)
 				{
@@ -670,16 +697,36 @@ namespace bgfx
 		blit(_renderCtx, _blitter, *_mem);
 	}
 
-	template <uint32_t maxKeys>
-	struct UpdateBatchT
+	struct UpdateBatch
 	{
-		UpdateBatchT()
-			: m_num(0)
+		UpdateBatch()
+			: m_keys(NULL)
+			, m_values(NULL)
+			, m_num(0)
+			, m_max(0)
+		{
+		}
+
+		void destroy()
 		{
+			if (NULL != m_keys)
+			{
+				BX_FREE(getAllocator(MemoryTag::Frame), m_keys);
+				m_keys   = NULL;
+				m_values = NULL;
+			}
+
+			m_num = 0;
+			m_max = 0;
 		}
 
 		void add(uint32_t _key, uint32_t _value)
 		{
+			if (m_num == m_max)
+			{
+				grow();
+			}
+
 			uint32_t num = m_num++;
 			m_keys[num] = _key;
 			m_values[num] = _value;
@@ -689,8 +736,9 @@ namespace bgfx
 		{
 			if (0 < m_num)
 			{
-				uint32_t* tempKeys = (uint32_t*)alloca(sizeof(m_keys) );
-				uint32_t* tempValues = (uint32_t*)alloca(sizeof(m_values) );
+				// Temp storage for radix sort is allocated past keys and values.
+				uint32_t* tempKeys   = &m_values[m_max];
+				uint32_t* tempValues = &tempKeys[m_max];
 				bx::radixSort(m_keys, tempKeys, m_values, tempValues, m_num);
 				return true;
 			}
@@ -698,19 +746,39 @@ namespace bgfx
 			return false;
 		}
 
-		bool isFull() const
-		{
-			return m_num >= maxKeys;
-		}
-
 		void reset()
 		{
 			m_num = 0;
 		}
 
-		uint32_t m_num;
-		uint32_t m_keys[maxKeys];
-		uint32_t m_values[maxKeys];
+		uint32_t* m_keys;
+		uint32_t* m_values;
+		uint32_t  m_num;
+		uint32_t  m_max;
+
+	private:
+		void grow()
+		{
+			const uint32_t maxKeys = bx::max<uint32_t>(256, m_max*2);
+
+			uint32_t* keys   = (uint32_t*)BX_ALLOC(getAllocator(MemoryTag::Frame), maxKeys*4*sizeof(uint32_t) );
+			uint32_t* values = &keys[maxKeys];
+
+			if (0 < m_num)
+			{
+				bx::memCopy(keys,   m_keys,   m_num*sizeof(uint32_t) );
+				bx::memCopy(values, m_values, m_num*sizeof(uint32_t) );
+			}
+
+			if (NULL != m_keys)
+			{
+				BX_FREE(getAllocator(MemoryTag::Frame), m_keys);
+			}
+
+			m_keys   = keys;
+			m_values = values;
+			m_max    = maxKeys;
+		}
 	};
 
 	struct ClearQuad
@@ -796,6 +864,7 @@ namespace bgfx
 			UpdateViewName,
 			InvalidateOcclusionQuery,
 			SetName,
+			PrewarmPipeline,
 			End,
 			RendererShutdownEnd,
 			DestroyVertexDecl,
@@ -810,6 +879,8 @@ namespace bgfx
 			DestroyUniform,
 			ReadTexture,
 			RequestScreenShot,
+			CreateFence,
+			DestroyFence,
 		};
 
 		void write(const void* _data, uint32_t _size)
@@ -1315,6 +1386,90 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		uint32_t m_num;
 	};
 
+	struct FrameArena
+	{
+		FrameArena()
+			: m_data(NULL)
+			, m_size(0)
+			, m_offset(0)
+			, m_num(0)
+		{
+		}
+
+		void create(uint32_t _size)
+		{
+			m_size = _size;
+			m_data = 0 < _size
+				? (uint8_t*)BX_ALLOC(getAllocator(MemoryTag::Frame), _size)
+				: NULL
+				;
+			reset();
+		}
+
+		void destroy()
+		{
+			if (NULL != m_data)
+			{
+				BX_FREE(getAllocator(MemoryTag::Frame), m_data);
+				m_data = NULL;
+			}
+
+			m_size = 0;
+		}
+
+		void attach(void* _data, uint32_t _size)
+		{
+			m_data = (uint8_t*)_data;
+			m_size = NULL != _data ? _size : 0;
+			reset();
+		}
+
+		void reset()
+		{
+			m_offset = 0;
+			m_num    = 0;
+		}
+
+		void* alloc(uint32_t _size)
+		{
+			const uint32_t size = bx::strideAlign(_size, 16);
+
+			uint32_t offset = m_offset;
+			for (;;)
+			{
+				if (size > m_size - offset)
+				{
+					return NULL;
+				}
+
+				const uint32_t prev = bx::atomicCompareAndSwap<uint32_t>(&m_offset, offset, offset + size);
+				if (prev == offset)
+				{
+					break;
+				}
+
+				offset = prev;
+			}
+
+			bx::atomicFetchAndAdd<uint32_t>(&m_num, 1);
+
+			return &m_data[offset];
+		}
+
+		bool contains(const void* _ptr) const
+		{
+			const uint8_t* ptr = (const uint8_t*)_ptr;
+			return ptr >= m_data
+				&& ptr <  m_data + m_size
+				;
+		}
+
+		uint8_t* m_data;
+		uint32_t m_size;
+		uint32_t m_offset;
+		uint32_t m_num;
+	};
+
 #define CONSTANT_OPCODE_TYPE_SHIFT 27
 #define CONSTANT_OPCODE_TYPE_MASK  UINT32_C(0xf8000000)
 #define CONSTANT_OPCODE_LOC_SHIFT  11
@@ -1328,6 +1483,18 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 #define BGFX_UNIFORM_SAMPLERBIT  UINT8_C(0x20)
 #define BGFX_UNIFORM_MASK (BGFX_UNIFORM_FRAGMENTBIT|BGFX_UNIFORM_SAMPLERBIT)
 
+	/// Markers are stored in uniform buffer as `UniformType::Count` opcode,
+	/// with marker type in location field.
+	struct MarkerType
+	{
+		enum Enum
+		{
+			Debug,
+			GpuScopeBegin,
+			GpuScopeEnd,
+		};
+	};
+
 	class UniformBuffer
 	{
 	public:
@@ -1336,14 +1503,14 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			const uint32_t structSize = sizeof(UniformBuffer)-sizeof(UniformBuffer::m_buffer);
 
 			uint32_t size = BX_ALIGN_16(_size);
-			void*    data = BX_ALLOC(g_allocator, size+structSize);
+			void*    data = BX_ALLOC(getAllocator(MemoryTag::UniformBuffer), size+structSize);
 			return BX_PLACEMENT_NEW(data, UniformBuffer)(size);
 		}
 
 		static void destroy(UniformBuffer* _uniformBuffer)
 		{
 			_uniformBuffer->~UniformBuffer();
-			BX_FREE(g_allocator, _uniformBuffer);
+			BX_FREE(getAllocator(MemoryTag::UniformBuffer), _uniformBuffer);
 		}
 
 		static void update(UniformBuffer** _uniformBuffer, uint32_t _treshold = 64<<10, uint32_t _grow = 1<<20)
@@ -1353,7 +1520,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			{
 				const uint32_t structSize = sizeof(UniformBuffer)-sizeof(UniformBuffer::m_buffer);
 				uint32_t size = BX_ALIGN_16(uniformBuffer->m_size + _grow);
-				void*    data = BX_REALLOC(g_allocator, uniformBuffer, size+structSize);
+				void*    data = BX_REALLOC(getAllocator(MemoryTag::UniformBuffer), uniformBuffer, size+structSize);
 				uniformBuffer = reinterpret_cast<UniformBuffer*>(data);
 				uniformBuffer->m_size = size;
 
@@ -1437,7 +1604,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void writeUniform(UniformType::Enum _type, uint16_t _loc, const void* _value, uint16_t _num = 1);
 		void writeUniformHandle(UniformType::Enum _type, uint16_t _loc, UniformHandle _handle, uint16_t _num = 1);
-		void writeMarker(const char* _marker);
+		void writeMarker(const char* _marker, MarkerType::Enum _type = MarkerType::Debug);
 
 	private:
 		UniformBuffer(uint32_t _size)
@@ -1892,11 +2059,24 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		RectCache m_rectCache;
 	};
 
+	/// Rolling window of frame timings, samples are in nanoseconds.
+	struct FrameTimingHistory
+	{
+		void reset();
+		void add(const Stats& _stats);
+		void summarize(FrameTiming::Enum _timing, FrameTimingStats& _outStats) const;
+
+		int64_t  m_sample[FrameTiming::Count][BGFX_CONFIG_FRAME_TIMING_FRAMES];
+		uint32_t m_num[FrameTiming::Count];
+		uint32_t m_pos[FrameTiming::Count];
+	};
+
 	BX_ALIGN_DECL_CACHE_LINE(struct) Frame
 	{
 		Frame()
 			: m_waitSubmit(0)
 			, m_waitRender(0)
+			, m_framePacing(0)
 			, m_capture(false)
 		{
 			SortKey term;
@@ -1906,7 +2086,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_sortValues[BGFX_CONFIG_MAX_DRAW_CALLS] = BGFX_CONFIG_MAX_DRAW_CALLS;
 			bx::memSet(m_occlusion, 0xff, sizeof(m_occlusion) );
 
-			m_perfStats.viewStats = m_viewStats;
+			m_perfStats.viewStats     = m_viewStats;
+			m_perfStats.programStats  = m_programStats;
+			m_perfStats.gpuScopeStats = m_gpuScopeStats;
+			m_perfStats.numGpuScopes  = 0;
+
+			bx::memSet(m_frameTiming, 0, sizeof(m_frameTiming) );
 		}
 
 		~Frame()
@@ -1915,10 +2100,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void create()
 		{
+			tagEmbedded(1);
+
 			{
 				const uint32_t num = g_caps.limits.maxEncoders;
 
-				m_uniformBuffer = (UniformBuffer**)BX_ALLOC(g_allocator, sizeof(UniformBuffer*)*num);
+				m_uniformBuffer = (UniformBuffer**)BX_ALLOC(getAllocator(MemoryTag::UniformBuffer), sizeof(UniformBuffer*)*num);
 
 				for (uint32_t ii = 0; ii < num; ++ii)
 				{
@@ -1926,9 +2113,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				}
 			}
 
+			m_arena.create(BGFX_CONFIG_FRAME_ARENA_SIZE);
+
 			reset();
 			start();
-			m_textVideoMem = BX_NEW(g_allocator, TextVideoMem);
+			m_textVideoMem = BX_NEW(getAllocator(MemoryTag::Frame), TextVideoMem);
 		}
 
 		void destroy()
@@ -1938,8 +2127,26 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				UniformBuffer::destroy(m_uniformBuffer[ii]);
 			}
 
-			BX_FREE(g_allocator, m_uniformBuffer);
-			BX_DELETE(g_allocator, m_textVideoMem);
+			BX_FREE(getAllocator(MemoryTag::UniformBuffer), m_uniformBuffer);
+			BX_DELETE(getAllocator(MemoryTag::Frame), m_textVideoMem);
+
+			m_arena.destroy();
+
+			tagEmbedded(-1);
+		}
+
+		// Frame is embedded in Context, move its storage from Context to
+		// subsystems it belongs to.
+		void tagEmbedded(int64_t _sign)
+		{
+			const int64_t cmdSize   = int64_t(sizeof(m_cmdPre) + sizeof(m_cmdPost) );
+			const int64_t cacheSize = int64_t(sizeof(m_frameCache) );
+			const int64_t frameSize = int64_t(sizeof(Frame) ) - cmdSize - cacheSize;
+
+			memoryTag(MemoryTag::Context,       -_sign*int64_t(sizeof(Frame) ) );
+			memoryTag(MemoryTag::Frame,          _sign*frameSize);
+			memoryTag(MemoryTag::CommandBuffer,  _sign*cmdSize);
+			memoryTag(MemoryTag::FrameCache,     _sign*cacheSize);
 		}
 
 		void reset()
@@ -1951,10 +2158,14 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 		void start()
 		{
-			m_perfStats.transientVbUsed = m_vboffset;
-			m_perfStats.transientIbUsed = m_iboffset;
+			m_perfStats.transientVbUsed     = m_vboffset;
+			m_perfStats.transientIbUsed     = m_iboffset;
+			m_perfStats.frameArenaUsed      = m_arena.m_offset;
+			m_perfStats.numFrameArenaAllocs = m_arena.m_num;
 
 			m_frameCache.reset();
+			m_arena.reset();
+			m_staging.reset();
 			m_numRenderItems = 0;
 			m_numBlitItems   = 0;
 			m_iboffset = 0;
@@ -2059,6 +2270,11 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return m_freeUniform.queue(_handle);
 		}
 
+		bool free(FenceHandle _handle)
+		{
+			return m_freeFence.queue(_handle);
+		}
+
 		void resetFreeHandles()
 		{
 			m_freeIndexBuffer.reset();
@@ -2069,6 +2285,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_freeTexture.reset();
 			m_freeFrameBuffer.reset();
 			m_freeUniform.reset();
+			m_freeFence.reset();
 		}
 
 		ViewId m_viewRemap[BGFX_CONFIG_MAX_VIEWS];
@@ -2167,14 +2384,25 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		FreeHandle<TextureHandle,      BGFX_CONFIG_MAX_TEXTURES>       m_freeTexture;
 		FreeHandle<FrameBufferHandle,  BGFX_CONFIG_MAX_FRAME_BUFFERS>  m_freeFrameBuffer;
 		FreeHandle<UniformHandle,      BGFX_CONFIG_MAX_UNIFORMS>       m_freeUniform;
+		FreeHandle<FenceHandle,        BGFX_CONFIG_MAX_FENCES>         m_freeFence;
 
 		TextVideoMem* m_textVideoMem;
 
+		FrameArena m_arena;
+		FrameArena m_staging;
+
 		Stats     m_perfStats;
 		ViewStats m_viewStats[BGFX_CONFIG_MAX_VIEWS];
+		ProgramStats m_programStats[BGFX_CONFIG_MAX_PROGRAMS];
+		GpuScopeStats m_gpuScopeStats[BGFX_CONFIG_MAX_GPU_SCOPES];
+
+		// Summary of frame timing history, only updated when `BGFX_DEBUG_STATS`
+		// overlay is enabled.
+		FrameTimingStats m_frameTiming[FrameTiming::Count];
 
 		int64_t m_waitSubmit;
 		int64_t m_waitRender;
+		int64_t m_framePacing;
 
 		bool m_capture;
 	};
@@ -2230,6 +2458,18 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			uniformBuffer->writeMarker(_name);
 		}
 
+		void beginGpuScope(const char* _name)
+		{
+			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+			uniformBuffer->writeMarker(_name, MarkerType::GpuScopeBegin);
+		}
+
+		void endGpuScope()
+		{
+			UniformBuffer* uniformBuffer = m_frame->m_uniformBuffer[m_uniformIdx];
+			uniformBuffer->writeMarker("", MarkerType::GpuScopeEnd);
+		}
+
 		void setUniform(UniformType::Enum _type, UniformHandle _handle, const void* _value, uint16_t _num)
 		{
 			if (BX_ENABLED(BGFX_CONFIG_DEBUG_UNIFORM) )
@@ -2786,10 +3026,13 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		virtual void destroyShader(ShaderHandle _handle) = 0;
 		virtual void createProgram(ProgramHandle _handle, ShaderHandle _vsh, ShaderHandle _fsh) = 0;
 		virtual void destroyProgram(ProgramHandle _handle) = 0;
+		virtual void prewarmPipeline(ProgramHandle _program, VertexDeclHandle _declHandle, FrameBufferHandle _fbh, uint64_t _state) = 0;
 		virtual void* createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip) = 0;
 		virtual void updateTextureBegin(TextureHandle _handle, uint8_t _side, uint8_t _mip) = 0;
 		virtual void updateTexture(TextureHandle _handle, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem) = 0;
 		virtual void updateTextureEnd() = 0;
+		virtual void* mapStagingBuffer(uint8_t _idx, uint32_t _size) = 0;
+		virtual void unmapStagingBuffer(uint8_t _idx, uint32_t _size) = 0;
 		virtual void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) = 0;
 		virtual void resizeTexture(TextureHandle _handle, uint16_t _width, uint16_t _height, uint8_t _numMips, uint16_t _numLayers) = 0;
 		virtual void overrideInternal(TextureHandle _handle, uintptr_t _ptr) = 0;
@@ -2804,7 +3047,12 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		virtual void updateViewName(ViewId _id, const char* _name) = 0;
 		virtual void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) = 0;
 		virtual void invalidateOcclusionQuery(OcclusionQueryHandle _handle) = 0;
+		virtual bool createFence(FenceHandle _handle) = 0;
+		virtual bool isFenceSignaled(FenceHandle _handle) = 0;
+		virtual void destroyFence(FenceHandle _handle) = 0;
 		virtual void setMarker(const char* _marker, uint16_t _len) = 0;
+		virtual void beginGpuScope(const char* _name, uint16_t _len) = 0;
+		virtual void endGpuScope() = 0;
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) = 0;
 		virtual void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) = 0;
 		virtual void blitSetup(TextVideoMemBlitter& _blitter) = 0;
@@ -2817,6 +3065,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 
 	void rendererUpdateUniforms(RendererContextI* _renderCtx, UniformBuffer* _uniformBuffer, uint32_t _begin, uint32_t _end);
 
+	struct CaptureRemap;
+
 #if BGFX_CONFIG_DEBUG
 #	define BGFX_API_FUNC(_func) BX_NO_INLINE _func
 #else
@@ -2831,6 +3081,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			, m_numFreeDynamicIndexBufferHandles(0)
 			, m_numFreeDynamicVertexBufferHandles(0)
 			, m_numFreeOcclusionQueryHandles(0)
+			, m_numPendingFences(0)
 			, m_colorPaletteDirty(0)
 			, m_frames(0)
 			, m_debug(BGFX_DEBUG_NONE)
@@ -2843,6 +3094,10 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			, m_exit(false)
 			, m_flipAfterRender(false)
 			, m_singleThreaded(false)
+			, m_framePacing(0)
+			, m_captureWriter(NULL)
+			, m_captureBlock(NULL)
+			, m_captureRemap(NULL)
 		{
 		}
 
@@ -2941,6 +3196,32 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_submit->m_textVideoMem->image(_x, _y, _width, _height, _data, _pitch);
 		}
 
+		bool isFrameMemory(const void* _ptr) const
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frame); ++ii)
+			{
+				if (m_frame[ii].m_arena.contains(_ptr) )
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+		bool isStagingMemory(const Memory* _mem) const
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frame); ++ii)
+			{
+				if (m_frame[ii].m_staging.contains(_mem->data) )
+				{
+					return true;
+				}
+			}
+
+			return false;
+		}
+
 		BGFX_API_FUNC(const Stats* getPerfStats() )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -2972,10 +3253,21 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			return &stats;
 		}
 
+		BGFX_API_FUNC(const FrameTimingStats* getFrameTimingStats(FrameTiming::Enum _timing) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			m_frameTimingHistory.summarize(_timing, m_frameTimingStats);
+
+			return &m_frameTimingStats;
+		}
+
 		BGFX_API_FUNC(IndexBufferHandle createIndexBuffer(const Memory* _mem, uint16_t _flags) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
+			BX_CHECK(!isStagingMemory(_mem), "Staging memory can't be used to create index buffer.");
+
 			IndexBufferHandle handle = { m_indexBufferHandle.alloc() };
 
 			BX_WARN(isValid(handle), "Failed to allocate index buffer handle.");
@@ -3072,6 +3364,8 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
+			BX_CHECK(!isStagingMemory(_mem), "Staging memory can't be used to create vertex buffer.");
+
 			VertexBufferHandle handle = { m_vertexBufferHandle.alloc() };
 
 			if (isValid(handle) )
@@ -3553,7 +3847,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				cmdbuf.write(flags);
 
 				const uint32_t size = BX_ALIGN_16(sizeof(TransientIndexBuffer) ) + BX_ALIGN_16(_size);
-				tib = (TransientIndexBuffer*)BX_ALIGNED_ALLOC(g_allocator, size, 16);
+				tib = (TransientIndexBuffer*)BX_ALIGNED_ALLOC(getAllocator(MemoryTag::TransientBuffer), size, 16);
 				tib->data   = (uint8_t *)tib + BX_ALIGN_16(sizeof(TransientIndexBuffer) );
 				tib->size   = _size;
 				tib->handle = handle;
@@ -3570,7 +3864,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			cmdbuf.write(_tib->handle);
 
 			m_submit->free(_tib->handle);
-			BX_ALIGNED_FREE(g_allocator, _tib, 16);
+			BX_ALIGNED_FREE(getAllocator(MemoryTag::TransientBuffer), _tib, 16);
 		}
 
 		BGFX_API_FUNC(void allocTransientIndexBuffer(TransientIndexBuffer* _tib, uint32_t _num) )
@@ -3614,7 +3908,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 				cmdbuf.write(flags);
 
 				const uint32_t size = BX_ALIGN_16(sizeof(TransientVertexBuffer) ) + BX_ALIGN_16(_size);
-				tvb = (TransientVertexBuffer*)BX_ALIGNED_ALLOC(g_allocator, size, 16);
+				tvb = (TransientVertexBuffer*)BX_ALIGNED_ALLOC(getAllocator(MemoryTag::TransientBuffer), size, 16);
 				tvb->data = (uint8_t *)tvb + BX_ALIGN_16(sizeof(TransientVertexBuffer) );
 				tvb->size = _size;
 				tvb->startVertex = 0;
@@ -3634,7 +3928,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			cmdbuf.write(_tvb->handle);
 
 			m_submit->free(_tvb->handle);
-			BX_ALIGNED_FREE(g_allocator, _tvb, 16);
+			BX_ALIGNED_FREE(getAllocator(MemoryTag::TransientBuffer), _tvb, 16);
 		}
 
 		BGFX_API_FUNC(void allocTransientVertexBuffer(TransientVertexBuffer* _tvb, uint32_t _num, const VertexDecl& _decl) )
@@ -3846,7 +4140,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			if (0 != sr.m_num)
 			{
 				uint32_t size = sr.m_num*sizeof(UniformHandle);
-				sr.m_uniforms = (UniformHandle*)BX_ALLOC(g_allocator, size);
+				sr.m_uniforms = (UniformHandle*)BX_ALLOC(getAllocator(MemoryTag::Shader), size);
 				bx::memCopy(sr.m_uniforms, uniforms, size);
 			}
 
@@ -3954,7 +4248,7 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 						destroyUniform(sr.m_uniforms[ii]);
 					}
 
-					BX_FREE(g_allocator, sr.m_uniforms);
+					BX_FREE(getAllocator(MemoryTag::Shader), sr.m_uniforms);
 					sr.m_uniforms = NULL;
 					sr.m_num = 0;
 				}
@@ -4102,10 +4396,27 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			}
 		}
 
+		BGFX_API_FUNC(void prewarmPipeline(ViewId _id, ProgramHandle _program, VertexDeclHandle _declHandle, uint64_t _state) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("prewarmPipeline", m_programHandle, _program);
+			BGFX_CHECK_HANDLE("prewarmPipeline", m_vertexDeclHandle, _declHandle);
+			BX_CHECK(_id < BGFX_CONFIG_MAX_VIEWS, "Invalid view id: %d", _id);
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::PrewarmPipeline);
+			cmdbuf.write(_program);
+			cmdbuf.write(_declHandle);
+			cmdbuf.write(m_view[_id].m_fbh);
+			cmdbuf.write(_state);
+		}
+
 		BGFX_API_FUNC(TextureHandle createTexture(const Memory* _mem, uint64_t _flags, uint8_t _skip, TextureInfo* _info, BackbufferRatio::Enum _ratio, bool _immutable) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
 
+			BX_CHECK(!isStagingMemory(_mem), "Staging memory can't be used to create texture.");
+
 			TextureInfo ti;
 			if (NULL == _info)
 			{
@@ -4650,6 +4961,49 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 			m_freeOcclusionQueryHandle[m_numFreeOcclusionQueryHandles++] = _handle;
 		}
 
+		BGFX_API_FUNC(FenceHandle createFence() )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			FenceHandle handle = { m_fenceHandle.alloc() };
+			BX_WARN(isValid(handle), "Failed to allocate fence handle.");
+
+			if (isValid(handle) )
+			{
+				m_fenceSignaled[handle.idx] = 0;
+
+				CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateFence);
+				cmdbuf.write(handle);
+			}
+
+			return handle;
+		}
+
+		BGFX_API_FUNC(bool isSignaled(FenceHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("isSignaled", m_fenceHandle, _handle);
+
+			// Written by render thread as soon as backend reports fence completed.
+			return 0 != bx::atomicFetchAndAdd<uint32_t>(&m_fenceSignaled[_handle.idx], 0);
+		}
+
+		BGFX_API_FUNC(void destroyFence(FenceHandle _handle) )
+		{
+			BGFX_MUTEX_SCOPE(m_resourceApiLock);
+
+			BGFX_CHECK_HANDLE("destroyFence", m_fenceHandle, _handle);
+
+			bool ok = m_submit->free(_handle); BX_UNUSED(ok);
+			BX_CHECK(ok, "Fence handle %d is already destroyed!", _handle.idx);
+
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::DestroyFence);
+			cmdbuf.write(_handle);
+		}
+
+		void checkFences();
+
 		BGFX_API_FUNC(void requestScreenShot(FrameBufferHandle _handle, const char* _filePath) )
 		{
 			BGFX_MUTEX_SCOPE(m_resourceApiLock);
@@ -4779,6 +5133,19 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		void freeDynamicBuffers();
 		void freeAllHandles(Frame* _frame);
 		void frameNoRenderWait();
+		void updateFramePacing();
+		void framePacingWait();
+
+		BGFX_API_FUNC(bool replayFrame(const void* _data, uint32_t _size) );
+		BGFX_API_FUNC(void replayReset() );
+
+		void captureBegin(const char* _filePath);
+		void captureEnd();
+		void captureDestroy(CaptureRemap& _remap, uint8_t _cmd, uint16_t _idx);
+		void captureDestroyCreated();
+		void captureReset();
+		bool captureReadCommands(bx::ReaderSeekerI* _reader, bx::Error* _err);
+		bool captureReadFrame(bx::ReaderSeekerI* _reader, bx::Error* _err);
 		void swap();
 
 		// render thread
@@ -4934,6 +5301,18 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bx::HandleAllocT<BGFX_CONFIG_MAX_FRAME_BUFFERS> m_frameBufferHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_UNIFORMS> m_uniformHandle;
 		bx::HandleAllocT<BGFX_CONFIG_MAX_OCCLUSION_QUERIES> m_occlusionQueryHandle;
+		bx::HandleAllocT<BGFX_CONFIG_MAX_FENCES> m_fenceHandle;
+
+		struct PendingFence
+		{
+			FenceHandle m_handle;
+			uint32_t m_frameNum;
+			bool m_native;
+		};
+
+		uint32_t m_fenceSignaled[BGFX_CONFIG_MAX_FENCES];
+		PendingFence m_pendingFence[BGFX_CONFIG_MAX_FENCES];
+		uint16_t m_numPendingFences;
 
 		typedef bx::HandleHashMapT<BGFX_CONFIG_MAX_UNIFORMS*2> UniformHashMap;
 		UniformHashMap m_uniformHashMap;
@@ -4980,8 +5359,16 @@ constexpr uint64_t kSortKeyComputeProgramMask  = uint64_t(BGFX_CONFIG_MAX_PROGRA
 		bool m_singleThreaded;
 		bool m_flipped;
 
-		typedef UpdateBatchT<256> TextureUpdateBatch;
-		BX_ALIGN_DECL_CACHE_LINE(TextureUpdateBatch m_textureUpdateBatch);
+		int64_t m_framePacing;
+
+		FrameTimingHistory m_frameTimingHistory;
+		FrameTimingStats   m_frameTimingStats;
+
+		bx::FileWriterI*  m_captureWriter;
+		bx::MemoryBlockI* m_captureBlock;
+		CaptureRemap*     m_captureRemap;
+
+		UpdateBatch m_textureUpdateBatch;
 	};
 
 #undef BGFX_API_FUNC
@@ -0,0 +1,1573 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_p.h"
+#include "capture.h"
+
+#include <bx/file.h>
+
+BX_ERROR_RESULT(BGFX_ERROR_CAPTURE_INVALID, BX_MAKEFOURCC('b', 'g', 0, 2) );
+
+namespace bgfx
+{
+	// Maps resource handles from capture file to handles allocated by
+	// replaying context.
+	struct CaptureRemap
+	{
+		// Resource created by frame being replayed, destroyed if frame fails.
+		struct Created
+		{
+			uint8_t  m_cmd;
+			uint16_t m_idx;
+		};
+
+		CaptureRemap()
+		{
+			reset();
+		}
+
+		void reset()
+		{
+			bx::memSet(m_indexBuffer,         0xff, sizeof(m_indexBuffer) );
+			bx::memSet(m_indexBufferDestroy,  0xff, sizeof(m_indexBufferDestroy) );
+			bx::memSet(m_vertexDecl,          0xff, sizeof(m_vertexDecl) );
+			bx::memSet(m_vertexBuffer,        0xff, sizeof(m_vertexBuffer) );
+			bx::memSet(m_vertexBufferDestroy, 0xff, sizeof(m_vertexBufferDestroy) );
+			bx::memSet(m_shader,              0xff, sizeof(m_shader) );
+			bx::memSet(m_program,             0xff, sizeof(m_program) );
+			bx::memSet(m_texture,             0xff, sizeof(m_texture) );
+			bx::memSet(m_frameBuffer,         0xff, sizeof(m_frameBuffer) );
+			bx::memSet(m_uniform,             0xff, sizeof(m_uniform) );
+			m_created.clear();
+		}
+
+		uint16_t m_indexBuffer[BGFX_CONFIG_MAX_INDEX_BUFFERS];
+		uint16_t m_vertexDecl[BGFX_CONFIG_MAX_VERTEX_DECLS];
+		uint16_t m_vertexBuffer[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		uint16_t m_shader[BGFX_CONFIG_MAX_SHADERS];
+		uint16_t m_program[BGFX_CONFIG_MAX_PROGRAMS];
+		uint16_t m_texture[BGFX_CONFIG_MAX_TEXTURES];
+		uint16_t m_frameBuffer[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+		uint16_t m_uniform[BGFX_CONFIG_MAX_UNIFORMS];
+
+		// Destroy command for index and vertex buffers created by replay,
+		// UINT8_MAX when handle is owned by replaying context (transient
+		// buffers).
+		uint8_t m_indexBufferDestroy[BGFX_CONFIG_MAX_INDEX_BUFFERS];
+		uint8_t m_vertexBufferDestroy[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+
+		stl::vector<Created> m_created;
+	};
+
+	template<uint32_t MaxT>
+	static uint16_t captureRemap(const uint16_t (&_remap)[MaxT], uint16_t _idx)
+	{
+		return _idx < MaxT ? _remap[_idx] : kInvalidHandle;
+	}
+
+	template<typename Ty, uint32_t MaxT>
+	static void captureRemap(const uint16_t (&_remap)[MaxT], Ty& _handle)
+	{
+		_handle.idx = captureRemap(_remap, _handle.idx);
+	}
+
+	template<typename Ty, uint32_t MaxT>
+	static bool captureAlloc(CaptureRemap& _remap, uint16_t (&_slot)[MaxT], bx::HandleAlloc& _alloc, Ty& _handle, CommandBuffer::Enum _destroy)
+	{
+		if (_handle.idx >= MaxT)
+		{
+			return false;
+		}
+
+		const CaptureRemap::Created created = { uint8_t(_destroy), _handle.idx };
+
+		_slot[_handle.idx] = _alloc.alloc();
+		_handle.idx = _slot[_handle.idx];
+
+		if (isValid(_handle) )
+		{
+			_remap.m_created.push_back(created);
+			return true;
+		}
+
+		return false;
+	}
+
+	// Handles are returned to allocators at the end of frame, same as when
+	// resource is destroyed through API.
+	template<typename Ty, uint32_t MaxT>
+	static uint16_t captureFree(Frame* _frame, uint16_t (&_remap)[MaxT], uint16_t _idx)
+	{
+		Ty handle = { captureRemap(_remap, _idx) };
+
+		if (isValid(handle) )
+		{
+			_frame->free(handle);
+			_remap[_idx] = kInvalidHandle;
+		}
+
+		return handle.idx;
+	}
+
+	// Memory read from capture is released when it's not passed to renderer.
+	static void captureRelease(const Memory* _mem, bool _texture = false)
+	{
+		if (NULL == _mem)
+		{
+			return;
+		}
+
+		if (_texture
+		&&  sizeof(uint32_t) + sizeof(TextureCreate) <= _mem->size
+		&&  BGFX_CHUNK_MAGIC_TEX == *(const uint32_t*)_mem->data)
+		{
+			TextureCreate tc;
+			bx::memCopy(&tc, &_mem->data[sizeof(uint32_t)], sizeof(TextureCreate) );
+			if (NULL != tc.m_mem)
+			{
+				release(tc.m_mem);
+			}
+		}
+
+		release(_mem);
+	}
+
+	template<typename Ty>
+	static Ty captureCopy(bx::WriterI* _writer, CommandBuffer& _cmdbuf)
+	{
+		Ty value;
+		_cmdbuf.read(value);
+		bx::write(_writer, &value, sizeof(Ty) );
+		return value;
+	}
+
+	static void captureCopyBytes(bx::WriterI* _writer, CommandBuffer& _cmdbuf, uint32_t _size)
+	{
+		bx::write(_writer, _cmdbuf.skip(_size), _size);
+	}
+
+	static void captureCopyMemory(bx::WriterI* _writer, CommandBuffer& _cmdbuf, bool _texture = false)
+	{
+		const Memory* mem;
+		_cmdbuf.read(mem);
+
+		bx::write(_writer, mem->size);
+		bx::write(_writer, mem->data, mem->size);
+
+		if (!_texture)
+		{
+			return;
+		}
+
+		// Texture create chunk holds pointer to texture data, inline it.
+		bx::MemoryReader reader(mem->data, mem->size);
+
+		uint32_t magic = 0;
+		bx::read(&reader, magic);
+
+		if (BGFX_CHUNK_MAGIC_TEX == magic
+		&&  sizeof(uint32_t) + sizeof(TextureCreate) <= mem->size)
+		{
+			TextureCreate tc;
+			bx::read(&reader, tc);
+
+			const uint32_t size = NULL != tc.m_mem ? tc.m_mem->size : 0;
+			bx::write(_writer, size);
+
+			if (0 != size)
+			{
+				bx::write(_writer, tc.m_mem->data, size);
+			}
+		}
+	}
+
+	static void captureWriteCommands(bx::WriterI* _writer, CommandBuffer& _cmdbuf)
+	{
+		_cmdbuf.reset();
+
+		for (bool end = false; !end;)
+		{
+			uint8_t command;
+			_cmdbuf.read(command);
+
+			switch (command)
+			{
+			case CommandBuffer::RendererInit:
+				{
+					// Replaying context is already initialized.
+					Init init;
+					_cmdbuf.read(init);
+				}
+				break;
+
+			case CommandBuffer::RendererShutdownBegin:
+			case CommandBuffer::RendererShutdownEnd:
+				break;
+
+			case CommandBuffer::CreateVertexDecl:
+				bx::write(_writer, command);
+				captureCopy<VertexDeclHandle>(_writer, _cmdbuf);
+				captureCopy<VertexDecl>(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::CreateIndexBuffer:
+				bx::write(_writer, command);
+				captureCopy<IndexBufferHandle>(_writer, _cmdbuf);
+				captureCopyMemory(_writer, _cmdbuf);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::CreateVertexBuffer:
+				bx::write(_writer, command);
+				captureCopy<VertexBufferHandle>(_writer, _cmdbuf);
+				captureCopyMemory(_writer, _cmdbuf);
+				captureCopy<VertexDeclHandle>(_writer, _cmdbuf);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::CreateDynamicIndexBuffer:
+			case CommandBuffer::CreateDynamicVertexBuffer:
+				bx::write(_writer, command);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				captureCopy<uint32_t>(_writer, _cmdbuf);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::UpdateDynamicIndexBuffer:
+			case CommandBuffer::UpdateDynamicVertexBuffer:
+				bx::write(_writer, command);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				captureCopy<uint32_t>(_writer, _cmdbuf);
+				captureCopy<uint32_t>(_writer, _cmdbuf);
+				captureCopyMemory(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::CreateShader:
+				bx::write(_writer, command);
+				captureCopy<ShaderHandle>(_writer, _cmdbuf);
+				captureCopyMemory(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::CreateProgram:
+				bx::write(_writer, command);
+				captureCopy<ProgramHandle>(_writer, _cmdbuf);
+				captureCopy<ShaderHandle>(_writer, _cmdbuf);
+				captureCopy<ShaderHandle>(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::CreateTexture:
+				bx::write(_writer, command);
+				captureCopy<TextureHandle>(_writer, _cmdbuf);
+				captureCopyMemory(_writer, _cmdbuf, true);
+				captureCopy<uint64_t>(_writer, _cmdbuf);
+				captureCopy<uint8_t>(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::UpdateTexture:
+				bx::write(_writer, command);
+				captureCopy<TextureHandle>(_writer, _cmdbuf);
+				captureCopy<uint8_t>(_writer, _cmdbuf);
+				captureCopy<uint8_t>(_writer, _cmdbuf);
+				captureCopy<Rect>(_writer, _cmdbuf);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				captureCopyMemory(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::ResizeTexture:
+				bx::write(_writer, command);
+				captureCopy<TextureHandle>(_writer, _cmdbuf);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				captureCopy<uint8_t>(_writer, _cmdbuf);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::ReadTexture:
+				{
+					// Destination is application memory, nothing to replay.
+					_cmdbuf.skip<TextureHandle>();
+					_cmdbuf.skip<void*>();
+					_cmdbuf.skip<uint8_t>();
+				}
+				break;
+
+			case CommandBuffer::CreateFrameBuffer:
+				{
+					FrameBufferHandle handle;
+					_cmdbuf.read(handle);
+
+					bool window;
+					_cmdbuf.read(window);
+
+					if (window)
+					{
+						// Native window handle is not valid in replay, views
+						// rendering into it are redirected to back buffer.
+						_cmdbuf.skip<void*>();
+						_cmdbuf.skip<uint16_t>();
+						_cmdbuf.skip<uint16_t>();
+						_cmdbuf.skip<TextureFormat::Enum>();
+						_cmdbuf.skip<TextureFormat::Enum>();
+					}
+					else
+					{
+						bx::write(_writer, command);
+						bx::write(_writer, handle);
+
+						const uint8_t num = captureCopy<uint8_t>(_writer, _cmdbuf);
+						captureCopyBytes(_writer, _cmdbuf, sizeof(Attachment)*num);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateUniform:
+				{
+					bx::write(_writer, command);
+					captureCopy<UniformHandle>(_writer, _cmdbuf);
+					captureCopy<UniformType::Enum>(_writer, _cmdbuf);
+					captureCopy<uint16_t>(_writer, _cmdbuf);
+
+					const uint8_t len = captureCopy<uint8_t>(_writer, _cmdbuf);
+					captureCopyBytes(_writer, _cmdbuf, len);
+				}
+				break;
+
+			case CommandBuffer::UpdateViewName:
+				{
+					bx::write(_writer, command);
+					captureCopy<ViewId>(_writer, _cmdbuf);
+
+					const uint16_t len = captureCopy<uint16_t>(_writer, _cmdbuf);
+					captureCopyBytes(_writer, _cmdbuf, len);
+				}
+				break;
+
+			case CommandBuffer::SetName:
+				{
+					bx::write(_writer, command);
+					captureCopy<Handle>(_writer, _cmdbuf);
+
+					const uint16_t len = captureCopy<uint16_t>(_writer, _cmdbuf);
+					captureCopyBytes(_writer, _cmdbuf, len);
+				}
+				break;
+
+			case CommandBuffer::RequestScreenShot:
+				{
+					bx::write(_writer, command);
+					captureCopy<FrameBufferHandle>(_writer, _cmdbuf);
+
+					const uint16_t len = captureCopy<uint16_t>(_writer, _cmdbuf);
+					captureCopyBytes(_writer, _cmdbuf, len);
+				}
+				break;
+
+			case CommandBuffer::CreateFence:
+			case CommandBuffer::DestroyFence:
+				// Fences are owned by application, replay doesn't wait on them.
+				_cmdbuf.skip<FenceHandle>();
+				break;
+
+			case CommandBuffer::PrewarmPipeline:
+				// Doesn't affect rendered result, replay creates pipelines on
+				// first use.
+				_cmdbuf.skip<ProgramHandle>();
+				_cmdbuf.skip<VertexDeclHandle>();
+				_cmdbuf.skip<FrameBufferHandle>();
+				_cmdbuf.skip<uint64_t>();
+				break;
+
+			case CommandBuffer::InvalidateOcclusionQuery:
+			case CommandBuffer::DestroyVertexDecl:
+			case CommandBuffer::DestroyIndexBuffer:
+			case CommandBuffer::DestroyVertexBuffer:
+			case CommandBuffer::DestroyDynamicIndexBuffer:
+			case CommandBuffer::DestroyDynamicVertexBuffer:
+			case CommandBuffer::DestroyShader:
+			case CommandBuffer::DestroyProgram:
+			case CommandBuffer::DestroyTexture:
+			case CommandBuffer::DestroyFrameBuffer:
+			case CommandBuffer::DestroyUniform:
+				bx::write(_writer, command);
+				captureCopy<uint16_t>(_writer, _cmdbuf);
+				break;
+
+			case CommandBuffer::End:
+				bx::write(_writer, command);
+				end = true;
+				break;
+
+			default:
+				BX_CHECK(false, "Unknown command %d.", command);
+				end = true;
+				break;
+			}
+		}
+
+		_cmdbuf.reset();
+	}
+
+	void captureWriteHeader(bx::WriterI* _writer, const Init& _init)
+	{
+		CaptureHeader header;
+		bx::memSet(&header, 0, sizeof(header) );
+		header.m_version      = BGFX_CAPTURE_VERSION;
+		header.m_apiVersion   = BGFX_API_VERSION;
+		header.m_rendererType = _init.type;
+		header.m_resolution   = _init.resolution;
+		header.m_limits       = _init.limits;
+
+		bx::write(_writer, BGFX_CHUNK_MAGIC_CAP);
+		bx::write(_writer, uint32_t(sizeof(CaptureHeader) ) );
+		bx::write(_writer, &header, sizeof(CaptureHeader) );
+	}
+
+	void captureWriteFrame(bx::WriterI* _writer, bx::MemoryBlockI* _mb, Frame* _frame)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Capture frame", 0xff2040ff);
+
+		bx::MemoryWriter writer(_mb);
+
+		bx::write(&writer, &_frame->m_resolution, sizeof(Resolution) );
+		bx::write(&writer, _frame->m_debug);
+		bx::write(&writer, _frame->m_capture);
+
+		// Transient buffers are created after first frame during init.
+		const uint16_t transientIb = NULL != _frame->m_transientIb ? _frame->m_transientIb->handle.idx : kInvalidHandle;
+		const uint16_t transientVb = NULL != _frame->m_transientVb ? _frame->m_transientVb->handle.idx : kInvalidHandle;
+		bx::write(&writer, transientIb);
+		bx::write(&writer, transientVb);
+
+		captureWriteCommands(&writer, _frame->m_cmdPre);
+		captureWriteCommands(&writer, _frame->m_cmdPost);
+
+		bx::write(&writer, _frame->m_viewRemap,    sizeof(_frame->m_viewRemap) );
+		bx::write(&writer, _frame->m_view,         sizeof(_frame->m_view) );
+		bx::write(&writer, _frame->m_colorPalette, sizeof(_frame->m_colorPalette) );
+
+		const uint32_t numRenderItems = _frame->m_numRenderItems;
+		bx::write(&writer, numRenderItems);
+		bx::write(&writer, _frame->m_sortKeys,       sizeof(uint64_t)*numRenderItems);
+		bx::write(&writer, _frame->m_sortValues,     sizeof(RenderItemCount)*numRenderItems);
+		bx::write(&writer, _frame->m_renderItem,     sizeof(RenderItem)*numRenderItems);
+		bx::write(&writer, _frame->m_renderItemBind, sizeof(RenderBind)*numRenderItems);
+
+		const uint16_t numBlitItems = _frame->m_numBlitItems;
+		bx::write(&writer, numBlitItems);
+		bx::write(&writer, _frame->m_blitKeys, sizeof(uint32_t)*numBlitItems);
+		bx::write(&writer, _frame->m_blitItem, sizeof(BlitItem)*numBlitItems);
+
+		const MatrixCache& matrixCache = _frame->m_frameCache.m_matrixCache;
+		bx::write(&writer, matrixCache.m_num);
+		bx::write(&writer, matrixCache.m_cache, sizeof(Matrix4)*matrixCache.m_num);
+
+		const RectCache& rectCache = _frame->m_frameCache.m_rectCache;
+		bx::write(&writer, rectCache.m_num);
+		bx::write(&writer, rectCache.m_cache, sizeof(Rect)*rectCache.m_num);
+
+		// Uniform buffers are finished at this point, used size is found by
+		// render items referencing them.
+		const uint32_t numEncoders = g_caps.limits.maxEncoders;
+		uint32_t uniformSize[128]; // Init::Limits::maxEncoders is at most 128.
+		bx::memSet(uniformSize, 0, sizeof(uniformSize) );
+
+		for (uint32_t ii = 0; ii < numRenderItems; ++ii)
+		{
+			const RenderItem& renderItem = _frame->m_renderItem[_frame->m_sortValues[ii] ];
+			const bool isCompute = 0 == (_frame->m_sortKeys[ii] & kSortKeyDrawBit);
+
+			const uint8_t  uniformIdx = isCompute ? renderItem.compute.m_uniformIdx : renderItem.draw.m_uniformIdx;
+			const uint32_t uniformEnd = isCompute ? renderItem.compute.m_uniformEnd : renderItem.draw.m_uniformEnd;
+
+			if (uniformIdx < numEncoders)
+			{
+				uniformSize[uniformIdx] = bx::max(uniformSize[uniformIdx], uniformEnd);
+			}
+		}
+
+		bx::write(&writer, numEncoders);
+		for (uint32_t ii = 0; ii < numEncoders; ++ii)
+		{
+			bx::write(&writer, uniformSize[ii]);
+			bx::write(&writer, _frame->m_uniformBuffer[ii]->read(0), uniformSize[ii]);
+		}
+
+		bx::write(&writer, _frame->m_iboffset);
+		if (0 != _frame->m_iboffset)
+		{
+			bx::write(&writer, _frame->m_transientIb->data, _frame->m_iboffset);
+		}
+
+		bx::write(&writer, _frame->m_vboffset);
+		if (0 != _frame->m_vboffset)
+		{
+			bx::write(&writer, _frame->m_transientVb->data, _frame->m_vboffset);
+		}
+
+		const TextVideoMem& tvm = *_frame->m_textVideoMem;
+		bx::write(&writer, tvm.m_small);
+		bx::write(&writer, tvm.m_width);
+		bx::write(&writer, tvm.m_height);
+		bx::write(&writer, tvm.m_mem, tvm.m_size*sizeof(TextVideoMem::MemSlot) );
+
+		const uint32_t size = uint32_t(bx::seek(&writer) );
+		bx::write(_writer, BGFX_CHUNK_MAGIC_FRM);
+		bx::write(_writer, size);
+		bx::write(_writer, _mb->more(), size);
+	}
+
+	void Context::captureBegin(const char* _filePath)
+	{
+		bx::FileWriterI* writer = BX_NEW(g_allocator, bx::FileWriter);
+
+		if (!bx::open(writer, _filePath) )
+		{
+			BX_TRACE("Failed to open capture file '%s'.", _filePath);
+			BX_DELETE(g_allocator, writer);
+			return;
+		}
+
+		BX_TRACE("Capturing to '%s'.", _filePath);
+
+		m_captureWriter = writer;
+		m_captureBlock  = BX_NEW(g_allocator, bx::MemoryBlock)(g_allocator);
+
+		captureWriteHeader(m_captureWriter, m_init);
+	}
+
+	void Context::captureEnd()
+	{
+		if (NULL != m_captureWriter)
+		{
+			bx::close(m_captureWriter);
+			BX_DELETE(g_allocator, m_captureWriter);
+			BX_DELETE(g_allocator, m_captureBlock);
+			m_captureWriter = NULL;
+			m_captureBlock  = NULL;
+		}
+
+		if (NULL != m_captureRemap)
+		{
+			BX_DELETE(g_allocator, m_captureRemap);
+			m_captureRemap = NULL;
+		}
+	}
+
+	static const Memory* captureReadMemory(bx::ReaderSeekerI* _reader, bx::Error* _err, bool _texture = false)
+	{
+		uint32_t size = 0;
+		bx::read(_reader, size, _err);
+
+		if (!_err->isOk() )
+		{
+			return NULL;
+		}
+
+		if (0 == size
+		||  int64_t(size) > bx::getRemain(_reader) )
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid memory size.");
+			return NULL;
+		}
+
+		const Memory* mem = alloc(size, BGFX_MEMORY_FRAME);
+		bx::read(_reader, mem->data, size, _err);
+
+		if (!_texture)
+		{
+			return mem;
+		}
+
+		bx::MemoryReader reader(mem->data, mem->size);
+
+		uint32_t magic = 0;
+		bx::read(&reader, magic);
+
+		if (BGFX_CHUNK_MAGIC_TEX == magic
+		&&  sizeof(uint32_t) + sizeof(TextureCreate) <= size)
+		{
+			TextureCreate tc;
+			bx::read(&reader, tc);
+
+			uint32_t texSize = 0;
+			bx::read(_reader, texSize, _err);
+
+			tc.m_mem = NULL;
+			if (0 != texSize)
+			{
+				if (int64_t(texSize) > bx::getRemain(_reader) )
+				{
+					BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid texture size.");
+					release(mem);
+					return NULL;
+				}
+
+				const Memory* texMem = alloc(texSize, BGFX_MEMORY_FRAME);
+				bx::read(_reader, texMem->data, texSize, _err);
+				tc.m_mem = texMem;
+			}
+
+			bx::memCopy(&mem->data[sizeof(uint32_t)], &tc, sizeof(TextureCreate) );
+		}
+
+		return mem;
+	}
+
+	static void captureReadBytes(bx::ReaderSeekerI* _reader, CommandBuffer& _cmdbuf, uint32_t _size, bx::Error* _err)
+	{
+		if (int64_t(_size) > bx::getRemain(_reader)
+		||  _cmdbuf.m_pos + _size > _cmdbuf.m_size)
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid string size.");
+			return;
+		}
+
+		bx::read(_reader, &_cmdbuf.m_buffer[_cmdbuf.m_pos], _size, _err);
+		_cmdbuf.m_pos += _size;
+	}
+
+	void Context::captureDestroy(CaptureRemap& _remap, uint8_t _cmd, uint16_t _idx)
+	{
+		uint16_t idx = kInvalidHandle;
+
+		switch (_cmd)
+		{
+		case CommandBuffer::DestroyIndexBuffer:
+		case CommandBuffer::DestroyDynamicIndexBuffer:
+			// Transient buffers map to buffers owned by replaying context.
+			if (_idx < BX_COUNTOF(_remap.m_indexBuffer)
+			&&  UINT8_MAX != _remap.m_indexBufferDestroy[_idx])
+			{
+				_cmd = _remap.m_indexBufferDestroy[_idx];
+				_remap.m_indexBufferDestroy[_idx] = UINT8_MAX;
+				idx = captureFree<IndexBufferHandle>(m_submit, _remap.m_indexBuffer, _idx);
+			}
+			break;
+
+		case CommandBuffer::DestroyVertexBuffer:
+		case CommandBuffer::DestroyDynamicVertexBuffer:
+			if (_idx < BX_COUNTOF(_remap.m_vertexBuffer)
+			&&  UINT8_MAX != _remap.m_vertexBufferDestroy[_idx])
+			{
+				_cmd = _remap.m_vertexBufferDestroy[_idx];
+				_remap.m_vertexBufferDestroy[_idx] = UINT8_MAX;
+				idx = captureFree<VertexBufferHandle>(m_submit, _remap.m_vertexBuffer, _idx);
+			}
+			break;
+
+		case CommandBuffer::DestroyVertexDecl:  idx = captureFree<VertexDeclHandle>(m_submit, _remap.m_vertexDecl,   _idx); break;
+		case CommandBuffer::DestroyShader:      idx = captureFree<ShaderHandle>(m_submit, _remap.m_shader,           _idx); break;
+		case CommandBuffer::DestroyProgram:     idx = captureFree<ProgramHandle>(m_submit, _remap.m_program,         _idx); break;
+		case CommandBuffer::DestroyTexture:     idx = captureFree<TextureHandle>(m_submit, _remap.m_texture,         _idx); break;
+		case CommandBuffer::DestroyFrameBuffer: idx = captureFree<FrameBufferHandle>(m_submit, _remap.m_frameBuffer, _idx); break;
+		case CommandBuffer::DestroyUniform:     idx = captureFree<UniformHandle>(m_submit, _remap.m_uniform,         _idx); break;
+
+		default:
+			break;
+		}
+
+		if (kInvalidHandle != idx)
+		{
+			CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::Enum(_cmd) );
+			cmdbuf.write(idx);
+		}
+	}
+
+	void Context::captureDestroyCreated()
+	{
+		if (NULL == m_captureRemap)
+		{
+			return;
+		}
+
+		CaptureRemap& remap = *m_captureRemap;
+
+		// Create commands of failed frame are still executed by renderer,
+		// destroy commands are queued after them.
+		for (uint32_t ii = uint32_t(remap.m_created.size() ); 0 < ii; --ii)
+		{
+			const CaptureRemap::Created& created = remap.m_created[ii-1];
+			captureDestroy(remap, created.m_cmd, created.m_idx);
+		}
+
+		remap.m_created.clear();
+	}
+
+	void Context::captureReset()
+	{
+		if (NULL == m_captureRemap)
+		{
+			return;
+		}
+
+		CaptureRemap& remap = *m_captureRemap;
+
+		// Resources that reference others are destroyed first.
+		for (uint16_t ii = 0; ii < BX_COUNTOF(remap.m_frameBuffer);  ++ii) { captureDestroy(remap, CommandBuffer::DestroyFrameBuffer,  ii); }
+		for (uint16_t ii = 0; ii < BX_COUNTOF(remap.m_program);      ++ii) { captureDestroy(remap, CommandBuffer::DestroyProgram,      ii); }
+		for (uint16_t ii = 0; ii < BX_COUNTOF(remap.m_shader);       ++ii) { captureDestroy(remap, CommandBuffer::DestroyShader,       ii); }
+		for (uint16_t ii = 0; ii < BX_COUNTOF(remap.m_texture);      ++ii) { captureDestroy(remap, CommandBuffer::DestroyTexture,      ii); }
+		for (uint16_t ii = 0; ii < BX_COUNTOF(remap.m_indexBuffer);  ++ii) { captureDestroy(remap, CommandBuffer::DestroyIndexBuffer,  ii); }
+		for (uint16_t ii = 0; ii < BX_COUNTOF(remap.m_vertexBuffer); ++ii) { captureDestroy(remap, CommandBuffer::DestroyVertexBuffer, ii); }
+		for (uint16_t ii = 0; ii < BX_COUNTOF(remap.m_vertexDecl);   ++ii) { captureDestroy(remap, CommandBuffer::DestroyVertexDecl,   ii); }
+		for (uint16_t ii = 0; ii < BX_COUNTOF(remap.m_uniform);      ++ii) { captureDestroy(remap, CommandBuffer::DestroyUniform,      ii); }
+
+		remap.reset();
+	}
+
+	bool Context::captureReadCommands(bx::ReaderSeekerI* _reader, bx::Error* _err)
+	{
+		CaptureRemap& remap = *m_captureRemap;
+
+		while (_err->isOk() )
+		{
+			uint8_t command = CommandBuffer::End;
+			bx::read(_reader, command, _err);
+
+			if (!_err->isOk()
+			||  CommandBuffer::End == command)
+			{
+				break;
+			}
+
+			// Command that fails to decode is dropped, commands before it are
+			// kept, so resources they created are tracked by remap.
+			const uint32_t cmdPre  = m_submit->m_cmdPre.m_pos;
+			const uint32_t cmdPost = m_submit->m_cmdPost.m_pos;
+
+			switch (command)
+			{
+			case CommandBuffer::CreateVertexDecl:
+				{
+					VertexDeclHandle handle;
+					bx::read(_reader, handle, _err);
+
+					VertexDecl decl;
+					bx::read(_reader, &decl, sizeof(VertexDecl), _err);
+
+					if (_err->isOk()
+					&&  captureAlloc(remap, remap.m_vertexDecl, m_vertexDeclHandle, handle, CommandBuffer::DestroyVertexDecl) )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexDecl);
+						cmdbuf.write(handle);
+						cmdbuf.write(decl);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateIndexBuffer:
+				{
+					IndexBufferHandle handle;
+					bx::read(_reader, handle, _err);
+
+					const Memory* mem = captureReadMemory(_reader, _err);
+
+					uint16_t flags;
+					bx::read(_reader, flags, _err);
+
+					const uint16_t idx = handle.idx;
+
+					if (_err->isOk()
+					&&  captureAlloc(remap, remap.m_indexBuffer, m_indexBufferHandle, handle, CommandBuffer::DestroyIndexBuffer) )
+					{
+						remap.m_indexBufferDestroy[idx] = CommandBuffer::DestroyIndexBuffer;
+
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateIndexBuffer);
+						cmdbuf.write(handle);
+						cmdbuf.write(mem);
+						cmdbuf.write(flags);
+					}
+					else
+					{
+						captureRelease(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateVertexBuffer:
+				{
+					VertexBufferHandle handle;
+					bx::read(_reader, handle, _err);
+
+					const Memory* mem = captureReadMemory(_reader, _err);
+
+					VertexDeclHandle declHandle;
+					bx::read(_reader, declHandle, _err);
+					captureRemap(remap.m_vertexDecl, declHandle);
+
+					uint16_t flags;
+					bx::read(_reader, flags, _err);
+
+					const uint16_t idx = handle.idx;
+
+					if (_err->isOk()
+					&&  captureAlloc(remap, remap.m_vertexBuffer, m_vertexBufferHandle, handle, CommandBuffer::DestroyVertexBuffer) )
+					{
+						remap.m_vertexBufferDestroy[idx] = CommandBuffer::DestroyVertexBuffer;
+
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateVertexBuffer);
+						cmdbuf.write(handle);
+						cmdbuf.write(mem);
+						cmdbuf.write(declHandle);
+						cmdbuf.write(flags);
+					}
+					else
+					{
+						captureRelease(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateDynamicIndexBuffer:
+			case CommandBuffer::CreateDynamicVertexBuffer:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx, _err);
+
+					uint32_t size;
+					bx::read(_reader, size, _err);
+
+					uint16_t flags;
+					bx::read(_reader, flags, _err);
+
+					if (!_err->isOk() )
+					{
+						break;
+					}
+
+					bool valid = false;
+					if (CommandBuffer::CreateDynamicIndexBuffer == command)
+					{
+						IndexBufferHandle handle = { idx };
+						valid = captureAlloc(remap, remap.m_indexBuffer, m_indexBufferHandle, handle, CommandBuffer::DestroyDynamicIndexBuffer);
+						if (valid)
+						{
+							remap.m_indexBufferDestroy[idx] = CommandBuffer::DestroyDynamicIndexBuffer;
+						}
+						idx = handle.idx;
+					}
+					else
+					{
+						VertexBufferHandle handle = { idx };
+						valid = captureAlloc(remap, remap.m_vertexBuffer, m_vertexBufferHandle, handle, CommandBuffer::DestroyDynamicVertexBuffer);
+						if (valid)
+						{
+							remap.m_vertexBufferDestroy[idx] = CommandBuffer::DestroyDynamicVertexBuffer;
+						}
+						idx = handle.idx;
+					}
+
+					if (valid)
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::Enum(command) );
+						cmdbuf.write(idx);
+						cmdbuf.write(size);
+						cmdbuf.write(flags);
+					}
+				}
+				break;
+
+			case CommandBuffer::UpdateDynamicIndexBuffer:
+			case CommandBuffer::UpdateDynamicVertexBuffer:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx, _err);
+
+					idx = CommandBuffer::UpdateDynamicIndexBuffer == command
+						? captureRemap(remap.m_indexBuffer,  idx)
+						: captureRemap(remap.m_vertexBuffer, idx)
+						;
+
+					uint32_t offset;
+					bx::read(_reader, offset, _err);
+
+					uint32_t size;
+					bx::read(_reader, size, _err);
+
+					const Memory* mem = captureReadMemory(_reader, _err);
+
+					if (_err->isOk()
+					&&  kInvalidHandle != idx)
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::Enum(command) );
+						cmdbuf.write(idx);
+						cmdbuf.write(offset);
+						cmdbuf.write(size);
+						cmdbuf.write(mem);
+					}
+					else
+					{
+						captureRelease(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateShader:
+				{
+					ShaderHandle handle;
+					bx::read(_reader, handle, _err);
+
+					const Memory* mem = captureReadMemory(_reader, _err);
+
+					if (_err->isOk()
+					&&  captureAlloc(remap, remap.m_shader, m_shaderHandle, handle, CommandBuffer::DestroyShader) )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateShader);
+						cmdbuf.write(handle);
+						cmdbuf.write(mem);
+					}
+					else
+					{
+						captureRelease(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateProgram:
+				{
+					ProgramHandle handle;
+					bx::read(_reader, handle, _err);
+
+					ShaderHandle vsh;
+					bx::read(_reader, vsh, _err);
+					captureRemap(remap.m_shader, vsh);
+
+					ShaderHandle fsh;
+					bx::read(_reader, fsh, _err);
+					captureRemap(remap.m_shader, fsh);
+
+					if (_err->isOk()
+					&&  captureAlloc(remap, remap.m_program, m_programHandle, handle, CommandBuffer::DestroyProgram) )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateProgram);
+						cmdbuf.write(handle);
+						cmdbuf.write(vsh);
+						cmdbuf.write(fsh);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateTexture:
+				{
+					TextureHandle handle;
+					bx::read(_reader, handle, _err);
+
+					const Memory* mem = captureReadMemory(_reader, _err, true);
+
+					uint64_t flags;
+					bx::read(_reader, flags, _err);
+
+					uint8_t skip;
+					bx::read(_reader, skip, _err);
+
+					if (_err->isOk()
+					&&  captureAlloc(remap, remap.m_texture, m_textureHandle, handle, CommandBuffer::DestroyTexture) )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateTexture);
+						cmdbuf.write(handle);
+						cmdbuf.write(mem);
+						cmdbuf.write(flags);
+						cmdbuf.write(skip);
+					}
+					else
+					{
+						captureRelease(mem, true);
+					}
+				}
+				break;
+
+			case CommandBuffer::UpdateTexture:
+				{
+					TextureHandle handle;
+					bx::read(_reader, handle, _err);
+					captureRemap(remap.m_texture, handle);
+
+					uint8_t side;
+					bx::read(_reader, side, _err);
+
+					uint8_t mip;
+					bx::read(_reader, mip, _err);
+
+					Rect rect;
+					bx::read(_reader, &rect, sizeof(Rect), _err);
+
+					uint16_t zz;
+					bx::read(_reader, zz, _err);
+
+					uint16_t depth;
+					bx::read(_reader, depth, _err);
+
+					uint16_t pitch;
+					bx::read(_reader, pitch, _err);
+
+					const Memory* mem = captureReadMemory(_reader, _err);
+
+					if (_err->isOk()
+					&&  isValid(handle) )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateTexture);
+						cmdbuf.write(handle);
+						cmdbuf.write(side);
+						cmdbuf.write(mip);
+						cmdbuf.write(rect);
+						cmdbuf.write(zz);
+						cmdbuf.write(depth);
+						cmdbuf.write(pitch);
+						cmdbuf.write(mem);
+					}
+					else
+					{
+						captureRelease(mem);
+					}
+				}
+				break;
+
+			case CommandBuffer::ResizeTexture:
+				{
+					TextureHandle handle;
+					bx::read(_reader, handle, _err);
+					captureRemap(remap.m_texture, handle);
+
+					uint16_t width;
+					bx::read(_reader, width, _err);
+
+					uint16_t height;
+					bx::read(_reader, height, _err);
+
+					uint8_t numMips;
+					bx::read(_reader, numMips, _err);
+
+					uint16_t numLayers;
+					bx::read(_reader, numLayers, _err);
+
+					if (_err->isOk()
+					&&  isValid(handle) )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::ResizeTexture);
+						cmdbuf.write(handle);
+						cmdbuf.write(width);
+						cmdbuf.write(height);
+						cmdbuf.write(numMips);
+						cmdbuf.write(numLayers);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateFrameBuffer:
+				{
+					FrameBufferHandle handle;
+					bx::read(_reader, handle, _err);
+
+					uint8_t num = 0;
+					bx::read(_reader, num, _err);
+
+					Attachment attachment[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS];
+					if (num > BX_COUNTOF(attachment) )
+					{
+						BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid number of attachments.");
+						break;
+					}
+
+					bx::read(_reader, attachment, sizeof(Attachment)*num, _err);
+
+					for (uint32_t ii = 0; ii < num; ++ii)
+					{
+						captureRemap(remap.m_texture, attachment[ii].handle);
+					}
+
+					if (_err->isOk()
+					&&  captureAlloc(remap, remap.m_frameBuffer, m_frameBufferHandle, handle, CommandBuffer::DestroyFrameBuffer) )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateFrameBuffer);
+						const bool window = false;
+						cmdbuf.write(handle);
+						cmdbuf.write(window);
+						cmdbuf.write(num);
+						cmdbuf.write(attachment, sizeof(Attachment)*num);
+					}
+				}
+				break;
+
+			case CommandBuffer::CreateUniform:
+				{
+					UniformHandle handle;
+					bx::read(_reader, handle, _err);
+
+					UniformType::Enum type;
+					bx::read(_reader, type, _err);
+
+					uint16_t num;
+					bx::read(_reader, num, _err);
+
+					uint8_t len = 0;
+					bx::read(_reader, len, _err);
+
+					// Name is read before handle is allocated, so that command
+					// is either written whole or not at all.
+					char name[256];
+					bx::read(_reader, name, len, _err);
+
+					if (_err->isOk()
+					&&  captureAlloc(remap, remap.m_uniform, m_uniformHandle, handle, CommandBuffer::DestroyUniform) )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::CreateUniform);
+						cmdbuf.write(handle);
+						cmdbuf.write(type);
+						cmdbuf.write(num);
+						cmdbuf.write(len);
+						cmdbuf.write(name, len);
+					}
+				}
+				break;
+
+			case CommandBuffer::UpdateViewName:
+				{
+					ViewId id;
+					bx::read(_reader, id, _err);
+
+					uint16_t len = 0;
+					bx::read(_reader, len, _err);
+
+					if (_err->isOk() )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::UpdateViewName);
+						cmdbuf.write(id);
+						cmdbuf.write(len);
+						captureReadBytes(_reader, cmdbuf, len, _err);
+					}
+				}
+				break;
+
+			case CommandBuffer::SetName:
+				{
+					Handle handle;
+					bx::read(_reader, handle, _err);
+
+					switch (handle.type)
+					{
+					case Handle::IndexBuffer:  handle.idx = captureRemap(remap.m_indexBuffer,  handle.idx); break;
+					case Handle::Shader:       handle.idx = captureRemap(remap.m_shader,       handle.idx); break;
+					case Handle::Texture:      handle.idx = captureRemap(remap.m_texture,      handle.idx); break;
+					case Handle::VertexBuffer: handle.idx = captureRemap(remap.m_vertexBuffer, handle.idx); break;
+					default:                   handle.idx = kInvalidHandle;                                 break;
+					}
+
+					uint16_t len = 0;
+					bx::read(_reader, len, _err);
+
+					if (_err->isOk()
+					&&  kInvalidHandle != handle.idx)
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::SetName);
+						cmdbuf.write(handle);
+						cmdbuf.write(len);
+						captureReadBytes(_reader, cmdbuf, len, _err);
+					}
+					else
+					{
+						bx::seek(_reader, len);
+					}
+				}
+				break;
+
+			case CommandBuffer::RequestScreenShot:
+				{
+					FrameBufferHandle handle;
+					bx::read(_reader, handle, _err);
+					captureRemap(remap.m_frameBuffer, handle);
+
+					uint16_t len = 0;
+					bx::read(_reader, len, _err);
+
+					if (_err->isOk() )
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::RequestScreenShot);
+						cmdbuf.write(handle);
+						cmdbuf.write(len);
+						captureReadBytes(_reader, cmdbuf, len, _err);
+					}
+				}
+				break;
+
+			case CommandBuffer::InvalidateOcclusionQuery:
+				{
+					OcclusionQueryHandle handle;
+					bx::read(_reader, handle, _err);
+
+					if (_err->isOk()
+					&&  handle.idx < BGFX_CONFIG_MAX_OCCLUSION_QUERIES)
+					{
+						CommandBuffer& cmdbuf = getCommandBuffer(CommandBuffer::InvalidateOcclusionQuery);
+						cmdbuf.write(handle);
+					}
+				}
+				break;
+
+			case CommandBuffer::DestroyVertexDecl:
+			case CommandBuffer::DestroyIndexBuffer:
+			case CommandBuffer::DestroyVertexBuffer:
+			case CommandBuffer::DestroyDynamicIndexBuffer:
+			case CommandBuffer::DestroyDynamicVertexBuffer:
+			case CommandBuffer::DestroyShader:
+			case CommandBuffer::DestroyProgram:
+			case CommandBuffer::DestroyTexture:
+			case CommandBuffer::DestroyFrameBuffer:
+			case CommandBuffer::DestroyUniform:
+				{
+					uint16_t idx;
+					bx::read(_reader, idx, _err);
+
+					if (_err->isOk() )
+					{
+						captureDestroy(remap, command, idx);
+					}
+				}
+				break;
+
+			default:
+				BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Unknown command.");
+				break;
+			}
+
+			if (!_err->isOk() )
+			{
+				m_submit->m_cmdPre.m_pos  = cmdPre;
+				m_submit->m_cmdPost.m_pos = cmdPost;
+			}
+		}
+
+		return _err->isOk();
+	}
+
+	static uint64_t captureRemapProgram(uint64_t _key, const CaptureRemap& _remap)
+	{
+		uint64_t mask  = kSortKeyComputeProgramMask;
+		uint64_t shift = kSortKeyComputeProgramShift;
+
+		if (0 != (_key & kSortKeyDrawBit) )
+		{
+			const uint64_t type = _key & kSortKeyDrawTypeMask;
+
+			if (type == kSortKeyDrawTypeDepth)
+			{
+				mask  = kSortKeyDraw1ProgramMask;
+				shift = kSortKeyDraw1ProgramShift;
+			}
+			else if (type == kSortKeyDrawTypeSequence)
+			{
+				mask  = kSortKeyDraw2ProgramMask;
+				shift = kSortKeyDraw2ProgramShift;
+			}
+			else
+			{
+				mask  = kSortKeyDraw0ProgramMask;
+				shift = kSortKeyDraw0ProgramShift;
+			}
+		}
+
+		const uint16_t program = captureRemap(_remap.m_program, uint16_t( (_key & mask) >> shift) );
+		return (_key & ~mask) | ( (uint64_t(program) << shift) & mask);
+	}
+
+	static void captureRemapUniforms(UniformBuffer* _uniformBuffer, uint32_t _size, const CaptureRemap& _remap)
+	{
+		_uniformBuffer->reset();
+
+		while (_uniformBuffer->getPos() < _size)
+		{
+			const uint32_t pos    = _uniformBuffer->getPos();
+			const uint32_t opcode = _uniformBuffer->read();
+
+			UniformType::Enum type;
+			uint16_t loc;
+			uint16_t num;
+			uint16_t copy;
+			UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+			if (UniformType::End == type)
+			{
+				break;
+			}
+
+			if (UniformType::Count == type)
+			{
+				_uniformBuffer->read(num);
+				continue;
+			}
+
+			uint32_t data = _uniformBuffer->getPos();
+			_uniformBuffer->reset(pos);
+			_uniformBuffer->write(UniformBuffer::encodeOpcode(type, captureRemap(_remap.m_uniform, loc), num, copy) );
+			_uniformBuffer->reset(data);
+			_uniformBuffer->read(copy ? g_uniformTypeSize[type]*num : sizeof(UniformHandle) );
+		}
+
+		_uniformBuffer->reset(_size);
+		_uniformBuffer->finish();
+	}
+
+	bool Context::captureReadFrame(bx::ReaderSeekerI* _reader, bx::Error* _err)
+	{
+		if (NULL == m_captureRemap)
+		{
+			m_captureRemap = BX_NEW(g_allocator, CaptureRemap);
+		}
+
+		CaptureRemap& remap = *m_captureRemap;
+		remap.m_created.clear();
+
+		Frame* frame = m_submit;
+
+		bx::read(_reader, &m_init.resolution, sizeof(Resolution), _err);
+		bx::read(_reader, m_debug, _err);
+		bx::read(_reader, frame->m_capture, _err);
+
+		uint16_t transientIb;
+		bx::read(_reader, transientIb, _err);
+
+		uint16_t transientVb;
+		bx::read(_reader, transientVb, _err);
+
+		if (!captureReadCommands(_reader, _err)
+		||  !captureReadCommands(_reader, _err) )
+		{
+			return false;
+		}
+
+		// Transient buffers are allocated by each context, whatever was used
+		// in capture maps to buffers of frame being replayed. Buffer replay
+		// created for capture's transient buffer is never used.
+		if (transientIb < BX_COUNTOF(remap.m_indexBuffer) )
+		{
+			captureDestroy(remap, CommandBuffer::DestroyDynamicIndexBuffer, transientIb);
+			remap.m_indexBuffer[transientIb] = frame->m_transientIb->handle.idx;
+		}
+
+		if (transientVb < BX_COUNTOF(remap.m_vertexBuffer) )
+		{
+			captureDestroy(remap, CommandBuffer::DestroyDynamicVertexBuffer, transientVb);
+			remap.m_vertexBuffer[transientVb] = frame->m_transientVb->handle.idx;
+		}
+
+		bx::read(_reader, m_viewRemap,  sizeof(m_viewRemap), _err);
+		bx::read(_reader, m_view,       sizeof(m_view), _err);
+		bx::read(_reader, m_clearColor, sizeof(m_clearColor), _err);
+		m_colorPaletteDirty = 2;
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_view); ++ii)
+		{
+			captureRemap(remap.m_frameBuffer, m_view[ii].m_fbh);
+		}
+
+		uint32_t numRenderItems = 0;
+		bx::read(_reader, numRenderItems, _err);
+
+		if (!_err->isOk()
+		||  numRenderItems > BGFX_CONFIG_MAX_DRAW_CALLS)
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid number of render items.");
+			return false;
+		}
+
+		frame->m_numRenderItems = numRenderItems;
+		bx::read(_reader, frame->m_sortKeys,       sizeof(uint64_t)*numRenderItems, _err);
+		bx::read(_reader, frame->m_sortValues,     sizeof(RenderItemCount)*numRenderItems, _err);
+		bx::read(_reader, frame->m_renderItem,     sizeof(RenderItem)*numRenderItems, _err);
+		bx::read(_reader, frame->m_renderItemBind, sizeof(RenderBind)*numRenderItems, _err);
+
+		const uint32_t numEncoders = g_caps.limits.maxEncoders;
+
+		for (uint32_t ii = 0; ii < numRenderItems; ++ii)
+		{
+			if (frame->m_sortValues[ii] >= numRenderItems)
+			{
+				BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid render item.");
+				return false;
+			}
+
+			frame->m_sortKeys[ii] = captureRemapProgram(frame->m_sortKeys[ii], remap);
+
+			const RenderItemCount itemIdx = frame->m_sortValues[ii];
+			RenderItem& renderItem = frame->m_renderItem[itemIdx];
+
+			if (0 != (frame->m_sortKeys[ii] & kSortKeyDrawBit) )
+			{
+				RenderDraw& draw = renderItem.draw;
+
+				for (uint32_t stream = 0; stream < BGFX_CONFIG_MAX_VERTEX_STREAMS; ++stream)
+				{
+					captureRemap(remap.m_vertexBuffer, draw.m_stream[stream].m_handle);
+					captureRemap(remap.m_vertexDecl,   draw.m_stream[stream].m_decl);
+				}
+
+				captureRemap(remap.m_indexBuffer,  draw.m_indexBuffer);
+				captureRemap(remap.m_vertexBuffer, draw.m_instanceDataBuffer);
+				captureRemap(remap.m_vertexBuffer, draw.m_indirectBuffer);
+
+				if (UINT8_MAX != draw.m_uniformIdx
+				&&  draw.m_uniformIdx >= numEncoders)
+				{
+					draw.m_uniformIdx = UINT8_MAX;
+				}
+			}
+			else
+			{
+				RenderCompute& compute = renderItem.compute;
+
+				captureRemap(remap.m_vertexBuffer, compute.m_indirectBuffer);
+
+				if (UINT8_MAX != compute.m_uniformIdx
+				&&  compute.m_uniformIdx >= numEncoders)
+				{
+					compute.m_uniformIdx = UINT8_MAX;
+				}
+			}
+
+			RenderBind& renderBind = frame->m_renderItemBind[itemIdx];
+
+			for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
+			{
+				Binding& bind = renderBind.m_bind[stage];
+
+				switch (bind.m_type)
+				{
+				case Binding::Image:
+				case Binding::Texture:
+					bind.m_idx = captureRemap(remap.m_texture, bind.m_idx);
+					break;
+
+				case Binding::IndexBuffer:
+					bind.m_idx = captureRemap(remap.m_indexBuffer, bind.m_idx);
+					break;
+
+				case Binding::VertexBuffer:
+					bind.m_idx = captureRemap(remap.m_vertexBuffer, bind.m_idx);
+					break;
+
+				default:
+					break;
+				}
+			}
+		}
+
+		uint16_t numBlitItems = 0;
+		bx::read(_reader, numBlitItems, _err);
+
+		if (!_err->isOk()
+		||  numBlitItems > BGFX_CONFIG_MAX_BLIT_ITEMS)
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid number of blit items.");
+			return false;
+		}
+
+		frame->m_numBlitItems = numBlitItems;
+		bx::read(_reader, frame->m_blitKeys, sizeof(uint32_t)*numBlitItems, _err);
+		bx::read(_reader, frame->m_blitItem, sizeof(BlitItem)*numBlitItems, _err);
+
+		for (uint32_t ii = 0; ii < numBlitItems; ++ii)
+		{
+			captureRemap(remap.m_texture, frame->m_blitItem[ii].m_src);
+			captureRemap(remap.m_texture, frame->m_blitItem[ii].m_dst);
+		}
+
+		MatrixCache& matrixCache = frame->m_frameCache.m_matrixCache;
+		bx::read(_reader, matrixCache.m_num, _err);
+
+		if (!_err->isOk()
+		||  matrixCache.m_num > BGFX_CONFIG_MAX_MATRIX_CACHE)
+		{
+			matrixCache.reset();
+			BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid matrix cache.");
+			return false;
+		}
+
+		bx::read(_reader, matrixCache.m_cache, sizeof(Matrix4)*matrixCache.m_num, _err);
+
+		RectCache& rectCache = frame->m_frameCache.m_rectCache;
+		bx::read(_reader, rectCache.m_num, _err);
+
+		if (!_err->isOk()
+		||  rectCache.m_num > BGFX_CONFIG_MAX_RECT_CACHE)
+		{
+			rectCache.reset();
+			BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid rect cache.");
+			return false;
+		}
+
+		bx::read(_reader, rectCache.m_cache, sizeof(Rect)*rectCache.m_num, _err);
+
+		uint32_t numUniformBuffers = 0;
+		bx::read(_reader, numUniformBuffers, _err);
+
+		for (uint32_t ii = 0; ii < numUniformBuffers && _err->isOk(); ++ii)
+		{
+			uint32_t size = 0;
+			bx::read(_reader, size, _err);
+
+			if (0 == size)
+			{
+				continue;
+			}
+
+			if (ii >= numEncoders
+			||  int64_t(size) > bx::getRemain(_reader) )
+			{
+				BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Invalid uniform buffer.");
+				return false;
+			}
+
+			UniformBuffer*& uniformBuffer = frame->m_uniformBuffer[ii];
+			uniformBuffer->reset();
+			UniformBuffer::update(&uniformBuffer, size + sizeof(uint32_t), size);
+
+			char* data = const_cast<char*>(uniformBuffer->read(size) );
+			bx::read(_reader, data, size, _err);
+
+			captureRemapUniforms(uniformBuffer, size, remap);
+		}
+
+		uint32_t iboffset = 0;
+		bx::read(_reader, iboffset, _err);
+
+		if (iboffset > frame->m_transientIb->size)
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Transient index buffer overflow.");
+			return false;
+		}
+
+		frame->m_iboffset = iboffset;
+		bx::read(_reader, frame->m_transientIb->data, iboffset, _err);
+
+		uint32_t vboffset = 0;
+		bx::read(_reader, vboffset, _err);
+
+		if (vboffset > frame->m_transientVb->size)
+		{
+			BX_ERROR_SET(_err, BGFX_ERROR_CAPTURE_INVALID, "Capture: Transient vertex buffer overflow.");
+			return false;
+		}
+
+		frame->m_vboffset = vboffset;
+		bx::read(_reader, frame->m_transientVb->data, vboffset, _err);
+
+		bool small;
+		bx::read(_reader, small, _err);
+
+		uint16_t width;
+		bx::read(_reader, width, _err);
+
+		uint16_t height;
+		bx::read(_reader, height, _err);
+
+		TextVideoMem& tvm = *frame->m_textVideoMem;
+		tvm.resize(small, width*8, height*(small ? 8 : 16) );
+		bx::read(_reader, tvm.m_mem, tvm.m_size*sizeof(TextVideoMem::MemSlot), _err);
+
+		return _err->isOk();
+	}
+
+} // namespace bgfx
@@ -0,0 +1,43 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_CAPTURE_H_HEADER_GUARD
+#define BGFX_CAPTURE_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+#include <bx/readerwriter.h>
+
+#define BGFX_CHUNK_MAGIC_CAP BX_MAKEFOURCC('C', 'A', 'P', 0x0)
+#define BGFX_CHUNK_MAGIC_FRM BX_MAKEFOURCC('F', 'R', 'M', 0x0)
+
+#define BGFX_CAPTURE_VERSION 1
+
+namespace bgfx
+{
+	struct Frame;
+
+	/// Capture file starts with header chunk, followed by one frame chunk
+	/// per swapped frame. Each chunk is magic, payload size, and payload.
+	/// Frame chunk payload can be passed directly to `bgfx::replayFrame`.
+	struct CaptureHeader
+	{
+		uint32_t m_version;
+		uint32_t m_apiVersion;
+		RendererType::Enum m_rendererType; //!< Requested renderer type.
+		Resolution m_resolution;
+		Init::Limits m_limits;
+	};
+
+	///
+	void captureWriteHeader(bx::WriterI* _writer, const Init& _init);
+
+	/// Serialize frame after it's finished on API thread, and before it's
+	/// handed to render thread. Resource handles are written as they are,
+	/// replay remaps them.
+	void captureWriteFrame(bx::WriterI* _writer, bx::MemoryBlockI* _mb, Frame* _frame);
+
+} // namespace bgfx
+
+#endif // BGFX_CAPTURE_H_HEADER_GUARD
@@ -286,6 +286,22 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_MAX_OCCLUSION_QUERIES 256
 #endif // BGFX_CONFIG_MAX_OCCLUSION_QUERIES
 
+/// Maximum number of GPU scopes timed per frame. Renderer keeps timer
+/// queries for 4 frames of scopes in flight.
+#ifndef BGFX_CONFIG_MAX_GPU_SCOPES
+#	define BGFX_CONFIG_MAX_GPU_SCOPES 128
+#endif // BGFX_CONFIG_MAX_GPU_SCOPES
+
+/// Number of most recent frames used for frame timing percentiles and
+/// histograms. See `bgfx::getFrameTimingStats`.
+#ifndef BGFX_CONFIG_FRAME_TIMING_FRAMES
+#	define BGFX_CONFIG_FRAME_TIMING_FRAMES 256
+#endif // BGFX_CONFIG_FRAME_TIMING_FRAMES
+
+#ifndef BGFX_CONFIG_MAX_FENCES
+#	define BGFX_CONFIG_MAX_FENCES 256
+#endif // BGFX_CONFIG_MAX_FENCES
+
 #ifndef BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
 #	define BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE (64<<10)
 #endif // BGFX_CONFIG_MAX_COMMAND_BUFFER_SIZE
@@ -298,6 +314,16 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE (2<<20)
 #endif // BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
 
+/// Size of per-frame arena used for transient allocations.
+#ifndef BGFX_CONFIG_FRAME_ARENA_SIZE
+#	define BGFX_CONFIG_FRAME_ARENA_SIZE (1<<20)
+#endif // BGFX_CONFIG_FRAME_ARENA_SIZE
+
+/// Size of per-frame staging area used for texture and dynamic buffer updates.
+#ifndef BGFX_CONFIG_FRAME_STAGING_SIZE
+#	define BGFX_CONFIG_FRAME_STAGING_SIZE (4<<20)
+#endif // BGFX_CONFIG_FRAME_STAGING_SIZE
+
 #ifndef BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
 #	define BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT 5
 #endif // BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT
@@ -312,6 +338,18 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_PROFILER 0
 #endif // BGFX_CONFIG_PROFILER
 
+/// Number of events kept by built-in profiler trace recorder, when
+/// `BGFX_CONFIG_PROFILER` is enabled. Must be power of 2.
+#ifndef BGFX_CONFIG_PROFILER_TRACE_EVENTS
+#	define BGFX_CONFIG_PROFILER_TRACE_EVENTS (64<<10)
+#endif // BGFX_CONFIG_PROFILER_TRACE_EVENTS
+
+/// Enable per subsystem accounting of CPU memory allocated by bgfx, see
+/// `bgfx::getMemoryStats`. Adds small header to each tagged allocation.
+#ifndef BGFX_CONFIG_MEMORY_STATS
+#	define BGFX_CONFIG_MEMORY_STATS 1
+#endif // BGFX_CONFIG_MEMORY_STATS
+
 #ifndef BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
 #	define BGFX_CONFIG_RENDERDOC_LOG_FILEPATH "temp/bgfx"
 #endif // BGFX_CONFIG_RENDERDOC_LOG_FILEPATH
@@ -332,8 +370,61 @@ BX_STATIC_ASSERT(bx::isPowerOf2(BGFX_CONFIG_MAX_VIEWS), "BGFX_CONFIG_MAX_VIEWS m
 #	define BGFX_CONFIG_DEFAULT_MAX_ENCODERS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 8 : 1)
 #endif // BGFX_CONFIG_DEFAULT_MAX_ENCODERS
 
+/// Noop renderer walks submitted frame like real renderer does (sort key
+/// decode, predefined uniforms, uniform commit, state and bind diffing),
+/// without issuing any graphics API calls. When disabled, Noop renderer
+/// only sorts frame, and render thread cost is not representative.
+#ifndef BGFX_CONFIG_RENDERER_NOOP_NULL_DRIVER
+#	define BGFX_CONFIG_RENDERER_NOOP_NULL_DRIVER 1
+#endif // BGFX_CONFIG_RENDERER_NOOP_NULL_DRIVER
+
 #ifndef BGFX_CONFIG_MAX_BACK_BUFFERS
 #	define BGFX_CONFIG_MAX_BACK_BUFFERS 4
 #endif // BGFX_CONFIG_MAX_BACK_BUFFERS
 
+/// Size of device memory block Vulkan renderer sub-allocates buffers and
+/// images from. Resources larger than half of block size get their own
+/// device memory allocation.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_MEMORY_BLOCK_SIZE
+#	define BGFX_CONFIG_RENDERER_VULKAN_MEMORY_BLOCK_SIZE (64<<20)
+#endif // BGFX_CONFIG_RENDERER_VULKAN_MEMORY_BLOCK_SIZE
+
+/// Number of worker threads Vulkan renderer uses, together with render
+/// thread, to record views into secondary command buffers. When 0, all
+/// views are recorded on render thread.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS
+#	define BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS ( (0 != BGFX_CONFIG_MULTITHREADED) ? 3 : 0)
+#endif // BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS
+
+/// Maximum number of commands Vulkan renderer records into single secondary
+/// command buffer. Frames with fewer commands are recorded on render thread.
+#ifndef BGFX_CONFIG_RENDERER_VULKAN_RECORD_CHUNK_SIZE
+#	define BGFX_CONFIG_RENDERER_VULKAN_RECORD_CHUNK_SIZE 1024
+#endif // BGFX_CONFIG_RENDERER_VULKAN_RECORD_CHUNK_SIZE
+
+/// Maximum number of vertex array objects OpenGL renderer keeps per GL
+/// context. Least recently used VAO is released when cache is full.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_VAO_CACHE_SIZE
+#	define BGFX_CONFIG_RENDERER_OPENGL_VAO_CACHE_SIZE 256
+#endif // BGFX_CONFIG_RENDERER_OPENGL_VAO_CACHE_SIZE
+
+/// Number of frames OpenGL renderer keeps in persistently mapped upload ring
+/// used for transient and dynamic buffer updates when buffer storage is
+/// supported.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES
+#	define BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES 3
+#endif // BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES
+
+/// Size of per frame region of uniform block ring used by OpenGL renderer
+/// for shaders compiled with uniform blocks.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_UNIFORM_STREAM_SIZE
+#	define BGFX_CONFIG_RENDERER_OPENGL_UNIFORM_STREAM_SIZE (1<<20)
+#endif // BGFX_CONFIG_RENDERER_OPENGL_UNIFORM_STREAM_SIZE
+
+/// Number of pixel pack buffers OpenGL renderer uses to read back screen
+/// shots and captured frames asynchronously.
+#ifndef BGFX_CONFIG_RENDERER_OPENGL_PIXEL_PACK_BUFFERS
+#	define BGFX_CONFIG_RENDERER_OPENGL_PIXEL_PACK_BUFFERS 4
+#endif // BGFX_CONFIG_RENDERER_OPENGL_PIXEL_PACK_BUFFERS
+
 #endif // BGFX_CONFIG_H_HEADER_GUARD
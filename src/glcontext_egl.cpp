@@ -21,6 +21,12 @@ namespace bgfx { namespace gl
 #	define EGL_CONTEXT_FLAG_NO_ERROR_BIT_KHR 0x00000008
 #endif // EGL_CONTEXT_FLAG_NO_ERROR_BIT_KHR
 
+#ifndef EGL_PLATFORM_SURFACELESS_MESA
+#	define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif // EGL_PLATFORM_SURFACELESS_MESA
+
+	typedef EGLDisplay (EGLAPIENTRY* PFNEGLGETPLATFORMDISPLAYPROC)(EGLenum platform, void* native_display, const EGLint* attrib_list);
+
 #if BGFX_USE_GL_DYNAMIC_LIB
 
 	typedef void (*EGLPROC)(void);
@@ -173,7 +179,38 @@ EGL_IMPORT
 			}
 #	endif // BX_PLATFORM_WINDOWS
 
-			m_display = eglGetDisplay(ndt);
+			// Without window handle context is created without surface, and
+			// renders into FBO owned by context. On Mesa this works without
+			// display server when EGL_MESA_platform_surfaceless is available.
+			const bool headless = true
+				&& !BX_ENABLED(BX_PLATFORM_ANDROID || BX_PLATFORM_RPI)
+				&& NULL == nwh
+				;
+
+			m_display = EGL_NO_DISPLAY;
+
+			if (headless)
+			{
+				const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+				if (NULL != clientExtensions
+				&&  !bx::findIdentifierMatch(clientExtensions, "EGL_MESA_platform_surfaceless").isEmpty() )
+				{
+					PFNEGLGETPLATFORMDISPLAYPROC getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+
+					if (NULL != getPlatformDisplay)
+					{
+						m_display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+						BX_TRACE("Using EGL_MESA_platform_surfaceless display %p.", m_display);
+					}
+				}
+			}
+
+			if (EGL_NO_DISPLAY == m_display)
+			{
+				m_display = eglGetDisplay(ndt);
+			}
+
 			BGFX_FATAL(m_display != EGL_NO_DISPLAY, Fatal::UnableToInitialize, "Failed to create display %p", m_display);
 
 			EGLint major = 0;
@@ -201,6 +238,7 @@ EGL_IMPORT
 			EGLint attrs[] =
 			{
 				EGL_RENDERABLE_TYPE, EGL_OPENGL_ES2_BIT,
+				EGL_SURFACE_TYPE, headless ? EGL_PBUFFER_BIT : EGL_WINDOW_BIT,
 
 #	if BX_PLATFORM_ANDROID
 				EGL_DEPTH_SIZE, 16,
@@ -253,8 +291,18 @@ EGL_IMPORT
 			vc_dispmanx_update_submit_sync(dispmanUpdate);
 #	endif // BX_PLATFORM_ANDROID
 
-			m_surface = eglCreateWindowSurface(m_display, m_config, nwh, NULL);
-			BGFX_FATAL(m_surface != EGL_NO_SURFACE, Fatal::UnableToInitialize, "Failed to create surface.");
+			if (headless)
+			{
+				const bool hasEglKhrSurfacelessContext = !bx::findIdentifierMatch(extensions, "EGL_KHR_surfaceless_context").isEmpty();
+				BGFX_FATAL(hasEglKhrSurfacelessContext, Fatal::UnableToInitialize, "Headless context requires EGL_KHR_surfaceless_context.");
+
+				m_surface = EGL_NO_SURFACE;
+			}
+			else
+			{
+				m_surface = eglCreateWindowSurface(m_display, m_config, nwh, NULL);
+				BGFX_FATAL(m_surface != EGL_NO_SURFACE, Fatal::UnableToInitialize, "Failed to create surface.");
+			}
 
 			const bool hasEglKhrCreateContext = !bx::findIdentifierMatch(extensions, "EGL_KHR_create_context").isEmpty();
 			const bool hasEglKhrNoError       = !bx::findIdentifierMatch(extensions, "EGL_KHR_create_context_no_error").isEmpty();
@@ -319,21 +367,63 @@ EGL_IMPORT
 			BGFX_FATAL(success, Fatal::UnableToInitialize, "Failed to set context.");
 			m_current = NULL;
 
-			eglSwapInterval(m_display, 0);
+			if (EGL_NO_SURFACE != m_surface)
+			{
+				eglSwapInterval(m_display, 0);
+			}
 		}
 
 		import();
 
+		if (NULL != m_display
+		&&  EGL_NO_SURFACE == m_surface)
+		{
+			GL_CHECK(glGenFramebuffers(1, &m_fbo) );
+			GL_CHECK(glGenRenderbuffers(BX_COUNTOF(m_rbo), m_rbo) );
+			resizeFbo(_width, _height);
+		}
+
 		g_internalData.context = m_context;
 	}
 
+	void GlContext::resizeFbo(uint32_t _width, uint32_t _height)
+	{
+		GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_fbo) );
+
+		GL_CHECK(glBindRenderbuffer(GL_RENDERBUFFER, m_rbo[0]) );
+		GL_CHECK(glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, _width, _height) );
+		GL_CHECK(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, m_rbo[0]) );
+
+		GL_CHECK(glBindRenderbuffer(GL_RENDERBUFFER, m_rbo[1]) );
+		GL_CHECK(glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, _width, _height) );
+		GL_CHECK(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT,   GL_RENDERBUFFER, m_rbo[1]) );
+		GL_CHECK(glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_STENCIL_ATTACHMENT, GL_RENDERBUFFER, m_rbo[1]) );
+
+		BX_CHECK(GL_FRAMEBUFFER_COMPLETE == glCheckFramebufferStatus(GL_FRAMEBUFFER)
+			, "glCheckFramebufferStatus failed 0x%08x"
+			, glCheckFramebufferStatus(GL_FRAMEBUFFER)
+			);
+	}
+
 	void GlContext::destroy()
 	{
 		if (NULL != m_display)
 		{
+			if (0 != m_fbo)
+			{
+				GL_CHECK(glDeleteFramebuffers(1, &m_fbo) );
+				GL_CHECK(glDeleteRenderbuffers(BX_COUNTOF(m_rbo), m_rbo) );
+				m_fbo = 0;
+			}
+
 			eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
 			eglDestroyContext(m_display, m_context);
-			eglDestroySurface(m_display, m_surface);
+
+			if (EGL_NO_SURFACE != m_surface)
+			{
+				eglDestroySurface(m_display, m_surface);
+			}
+
 			eglTerminate(m_display);
 			m_context = NULL;
 		}
@@ -365,10 +455,14 @@ EGL_IMPORT
 #	elif BX_PLATFORM_EMSCRIPTEN
 		emscripten_set_canvas_size(_width, _height);
 #	else
-		BX_UNUSED(_width, _height);
+		if (0 != m_fbo)
+		{
+			resizeFbo(_width, _height);
+		}
 #	endif // BX_PLATFORM_*
 
-		if (NULL != m_display)
+		if (NULL != m_display
+		&&  EGL_NO_SURFACE != m_surface)
 		{
 			bool vsync = !!(_flags&BGFX_RESET_VSYNC);
 			eglSwapInterval(m_display, vsync ? 1 : 0);
@@ -403,7 +497,11 @@ EGL_IMPORT
 
 		if (NULL == _swapChain)
 		{
-			if (NULL != m_display)
+			if (0 != m_fbo)
+			{
+				GL_CHECK(glFlush() );
+			}
+			else if (NULL != m_display)
 			{
 				eglSwapBuffers(m_display, m_surface);
 			}
@@ -26,12 +26,16 @@ namespace bgfx { namespace gl
 			, m_context(NULL)
 			, m_display(NULL)
 			, m_surface(NULL)
+			, m_fbo(0)
 		{
+			m_rbo[0] = 0;
+			m_rbo[1] = 0;
 		}
 
 		void create(uint32_t _width, uint32_t _height);
 		void destroy();
 		void resize(uint32_t _width, uint32_t _height, uint32_t _flags);
+		void resizeFbo(uint32_t _width, uint32_t _height);
 
 		uint64_t getCaps() const;
 		SwapChainGL* createSwapChain(void* _nwh);
@@ -41,6 +45,11 @@ namespace bgfx { namespace gl
 
 		void import();
 
+		GLuint getFbo()
+		{
+			return m_fbo;
+		}
+
 		bool isValid() const
 		{
 			return NULL != m_context;
@@ -52,6 +61,11 @@ namespace bgfx { namespace gl
 		EGLContext m_context;
 		EGLDisplay m_display;
 		EGLSurface m_surface;
+
+		// Headless (surfaceless) context renders into this FBO instead of
+		// window surface.
+		GLuint m_fbo;
+		GLuint m_rbo[2];
 	};
 } /* namespace gl */ } // namespace bgfx
 
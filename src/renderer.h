@@ -27,6 +27,46 @@ namespace bgfx
 	constexpr uint32_t kColorMarker   = toAbgr8(0xff, 0x00, 0x00);
 	constexpr uint32_t kColorResource = toAbgr8(0xff, 0x40, 0x20);
 
+	/// Print frame timing percentiles for `BGFX_DEBUG_STATS` overlay. Returns
+	/// next free line.
+	inline uint16_t dbgTextFrameTiming(TextVideoMem& _tvm, uint16_t _x, uint16_t _y, const Frame* _render)
+	{
+		static const char* s_name[] =
+		{
+			"       Frame",
+			"      Submit",
+			" Wait render",
+			" Wait submit",
+			"         GPU",
+		};
+		BX_STATIC_ASSERT(BX_COUNTOF(s_name) == FrameTiming::Count);
+
+		const double toMs = 1.0/1000000.0;
+
+		_tvm.printf(_x, _y++, 0x8c, " Frame timing  [ms]     p50      p95      p99      max ");
+
+		for (uint32_t ii = 0; ii < FrameTiming::Count; ++ii)
+		{
+			const FrameTimingStats& stats = _render->m_frameTiming[ii];
+
+			if (0 == stats.numFrames)
+			{
+				continue;
+			}
+
+			_tvm.printf(_x, _y++, 0x8b, " %s: %8.3f %8.3f %8.3f %8.3f (%d frames) "
+				, s_name[ii]
+				, double(stats.p50)*toMs
+				, double(stats.p95)*toMs
+				, double(stats.p99)*toMs
+				, double(stats.max)*toMs
+				, stats.numFrames
+				);
+		}
+
+		return _y;
+	}
+
 	struct BlitState
 	{
 		BlitState(const Frame* _frame)
@@ -537,6 +577,367 @@ namespace bgfx
 		bool     m_enabled;
 	};
 
+	/// Aggregates render thread cost per program when `BGFX_DEBUG_PROGRAM_STATS`
+	/// is set. Renderer calls `begin` once view changes are handled for render
+	/// item, and `end` before anything that shouldn't be attributed to program
+	/// (view change, blits, end of frame).
+	struct ProgramProfiler
+	{
+		ProgramProfiler(Frame* _frame)
+			: m_frame(_frame)
+			, m_time(0)
+			, m_current(UINT16_MAX)
+			, m_num(0)
+			, m_enabled(0 != (_frame->m_debug & BGFX_DEBUG_PROGRAM_STATS) )
+		{
+			if (m_enabled)
+			{
+				bx::memSet(m_slot, 0xff, sizeof(m_slot) );
+			}
+		}
+
+		~ProgramProfiler()
+		{
+			end();
+			m_frame->m_perfStats.numProgramStats = m_num;
+		}
+
+		void begin(ProgramHandle _program, const RenderItem& _item, bool _isCompute)
+		{
+			if (m_enabled
+			&&  isValid(_program) )
+			{
+				end();
+
+				uint16_t& slot = m_slot[_program.idx];
+				if (UINT16_MAX == slot)
+				{
+					slot = m_num++;
+
+					ProgramStats& stats = m_frame->m_perfStats.programStats[slot];
+					bx::memSet(&stats, 0, sizeof(ProgramStats) );
+					stats.handle = _program;
+				}
+
+				ProgramStats& stats = m_frame->m_perfStats.programStats[slot];
+				++stats.numDraw;
+				stats.uniformBytes += _isCompute
+					? _item.compute.m_uniformEnd - _item.compute.m_uniformBegin
+					: _item.draw.m_uniformEnd    - _item.draw.m_uniformBegin
+					;
+
+				m_current = slot;
+				m_time    = bx::getHPCounter();
+			}
+		}
+
+		void end()
+		{
+			if (UINT16_MAX != m_current)
+			{
+				m_frame->m_perfStats.programStats[m_current].cpuTimeElapsed += bx::getHPCounter() - m_time;
+				m_current = UINT16_MAX;
+			}
+		}
+
+		void stateChange()
+		{
+			if (UINT16_MAX != m_current)
+			{
+				++m_frame->m_perfStats.programStats[m_current].numStateChanges;
+			}
+		}
+
+		void textureBind(uint32_t _num = 1)
+		{
+			if (UINT16_MAX != m_current)
+			{
+				m_frame->m_perfStats.programStats[m_current].numTextureBinds += _num;
+			}
+		}
+
+		Frame*   m_frame;
+		int64_t  m_time;
+		uint16_t m_slot[BGFX_CONFIG_MAX_PROGRAMS];
+		uint16_t m_current;
+		uint16_t m_num;
+		bool     m_enabled;
+	};
+
+	/// Counts state changes and binds renderer issued to underlying graphics
+	/// API during frame. Counters are written to `Stats` when submit is done.
+	struct StateCounter
+	{
+		StateCounter(Frame* _frame)
+			: m_frame(_frame)
+			, m_numProgramChanges(0)
+			, m_numBlendStateChanges(0)
+			, m_numDepthStateChanges(0)
+			, m_numRasterStateChanges(0)
+			, m_numVertexBufferBinds(0)
+			, m_numIndexBufferBinds(0)
+			, m_numTextureBinds(0)
+			, m_numUniformUploads(0)
+			, m_numBindCacheHits(0)
+			, m_numBindCacheMisses(0)
+		{
+		}
+
+		~StateCounter()
+		{
+			Stats& perfStats = m_frame->m_perfStats;
+			perfStats.numProgramChanges     = m_numProgramChanges;
+			perfStats.numBlendStateChanges  = m_numBlendStateChanges;
+			perfStats.numDepthStateChanges  = m_numDepthStateChanges;
+			perfStats.numRasterStateChanges = m_numRasterStateChanges;
+			perfStats.numVertexBufferBinds  = m_numVertexBufferBinds;
+			perfStats.numIndexBufferBinds   = m_numIndexBufferBinds;
+			perfStats.numTextureBinds       = m_numTextureBinds;
+			perfStats.numUniformUploads     = m_numUniformUploads;
+			perfStats.numBindCacheHits      = m_numBindCacheHits;
+			perfStats.numBindCacheMisses    = m_numBindCacheMisses;
+		}
+
+		void stateChange(uint64_t _changedFlags, uint64_t _changedStencil)
+		{
+			m_numBlendStateChanges += 0 != (_changedFlags & (0
+				| BGFX_STATE_BLEND_MASK
+				| BGFX_STATE_BLEND_EQUATION_MASK
+				| BGFX_STATE_BLEND_INDEPENDENT
+				| BGFX_STATE_BLEND_ALPHA_TO_COVERAGE
+				| BGFX_STATE_WRITE_RGB
+				| BGFX_STATE_WRITE_A
+				) );
+
+			m_numDepthStateChanges += 0 != (_changedFlags & (0
+				| BGFX_STATE_DEPTH_TEST_MASK
+				| BGFX_STATE_WRITE_Z
+				) )
+				|| 0 != _changedStencil
+				;
+
+			m_numRasterStateChanges += 0 != (_changedFlags & (0
+				| BGFX_STATE_CULL_MASK
+				| BGFX_STATE_MSAA
+				| BGFX_STATE_LINEAA
+				| BGFX_STATE_CONSERVATIVE_RASTER
+				) );
+		}
+
+		void programChange()
+		{
+			++m_numProgramChanges;
+		}
+
+		void vertexBufferBind(uint32_t _num = 1)
+		{
+			m_numVertexBufferBinds += _num;
+		}
+
+		void indexBufferBind(uint32_t _num = 1)
+		{
+			m_numIndexBufferBinds += _num;
+		}
+
+		void textureBind(uint32_t _num = 1)
+		{
+			m_numTextureBinds += _num;
+		}
+
+		void uniformUpload()
+		{
+			++m_numUniformUploads;
+		}
+
+		void bindCache(bool _hit)
+		{
+			m_numBindCacheHits   += _hit;
+			m_numBindCacheMisses += !_hit;
+		}
+
+		Frame*   m_frame;
+		uint32_t m_numProgramChanges;
+		uint32_t m_numBlendStateChanges;
+		uint32_t m_numDepthStateChanges;
+		uint32_t m_numRasterStateChanges;
+		uint32_t m_numVertexBufferBinds;
+		uint32_t m_numIndexBufferBinds;
+		uint32_t m_numTextureBinds;
+		uint32_t m_numUniformUploads;
+		uint32_t m_numBindCacheHits;
+		uint32_t m_numBindCacheMisses;
+	};
+
+	/// Number of GPU timestamp queries used by `GpuScopeProfiler`, two per
+	/// scope, for 4 frames of scopes in flight.
+	constexpr uint32_t kGpuScopeQueries = BGFX_CONFIG_MAX_GPU_SCOPES*4*2;
+
+	/// Times GPU scopes (`Encoder::beginGpuScope`/`endGpuScope`) with pairs
+	/// of GPU timestamps. Scopes are kept in ring, scopes that don't fit are
+	/// not timed. Once all scopes of frame are resolved, they are reported in
+	/// `Stats` until next frame is resolved.
+	///
+	/// `Ty` must implement:
+	///  - `void timestamp(uint32_t _idx)` - Write timestamp query `_idx`.
+	///  - `bool result(uint32_t _idx, uint64_t& _time)` - Read timestamp in
+	///    nanoseconds, returns false if result is not available yet.
+	///  - `void release(uint32_t _idx)` - Query `_idx` result won't be read
+	///    anymore, and it can be reused.
+	///
+	template<typename Ty>
+	struct GpuScopeProfiler
+	{
+		GpuScopeProfiler()
+			: m_control(BX_COUNTOF(m_scope) )
+			, m_num(0)
+			, m_depth(0)
+			, m_write(0)
+			, m_enabled(false)
+		{
+			m_numResults[0] = 0;
+			m_numResults[1] = 0;
+		}
+
+		void start(const Frame* _render, bool _enabled)
+		{
+			m_enabled = _enabled && 0 != (_render->m_debug & BGFX_DEBUG_PROFILER);
+			m_num     = 0;
+			m_depth   = 0;
+		}
+
+		void begin(const char* _name, uint16_t _len)
+		{
+			if (!m_enabled)
+			{
+				return;
+			}
+
+			uint32_t idx = UINT32_MAX;
+
+			if (m_depth < BX_COUNTOF(m_stack)
+			&&  m_num   < BGFX_CONFIG_MAX_GPU_SCOPES
+			&&  0 != m_control.reserve(1) )
+			{
+				idx = m_control.m_current;
+
+				Scope& scope = m_scope[idx];
+				bx::strCopy(scope.m_name, BX_COUNTOF(scope.m_name), _name, _len);
+				scope.m_depth = m_depth;
+				scope.m_ended = false;
+				scope.m_last  = false;
+
+				m_timer.timestamp(idx*2);
+				m_control.commit(1);
+				++m_num;
+			}
+
+			if (m_depth < BX_COUNTOF(m_stack) )
+			{
+				m_stack[m_depth] = idx;
+			}
+
+			++m_depth;
+		}
+
+		void end()
+		{
+			if (0 == m_depth)
+			{
+				return;
+			}
+
+			--m_depth;
+
+			if (m_depth < BX_COUNTOF(m_stack) )
+			{
+				const uint32_t idx = m_stack[m_depth];
+				if (UINT32_MAX != idx)
+				{
+					m_timer.timestamp(idx*2+1);
+					m_scope[idx].m_ended = true;
+				}
+			}
+		}
+
+		void finish(Frame* _render)
+		{
+			while (0 != m_depth)
+			{
+				end();
+			}
+
+			if (0 != m_num)
+			{
+				const uint32_t size = BX_COUNTOF(m_scope);
+				m_scope[(m_control.m_current + size - 1) % size].m_last = true;
+			}
+
+			while (0 != m_control.available() )
+			{
+				const uint32_t idx = m_control.m_read;
+				const Scope& scope = m_scope[idx];
+
+				uint64_t begin;
+				uint64_t end;
+
+				if (!scope.m_ended
+				||  !m_timer.result(idx*2,   begin)
+				||  !m_timer.result(idx*2+1, end) )
+				{
+					break;
+				}
+
+				uint16_t& num = m_numResults[m_write];
+				if (num < BGFX_CONFIG_MAX_GPU_SCOPES)
+				{
+					GpuScopeStats& stats = m_result[m_write][num++];
+					bx::strCopy(stats.name, BX_COUNTOF(stats.name), scope.m_name);
+					stats.depth          = scope.m_depth;
+					stats.gpuTimeElapsed = int64_t(end - begin);
+				}
+
+				m_timer.release(idx*2);
+				m_timer.release(idx*2+1);
+				m_control.consume(1);
+
+				if (scope.m_last)
+				{
+					m_write ^= 1;
+					m_numResults[m_write] = 0;
+				}
+			}
+
+			const uint8_t read = m_write^1;
+			const uint16_t numResults = m_enabled ? m_numResults[read] : 0;
+
+			Stats& perfStats = _render->m_perfStats;
+			perfStats.numGpuScopes = numResults;
+			bx::memCopy(_render->m_gpuScopeStats, m_result[read], numResults*sizeof(GpuScopeStats) );
+		}
+
+		struct Scope
+		{
+			char     m_name[64];
+			uint16_t m_depth;
+			bool     m_ended;
+			bool     m_last;
+		};
+
+		Ty m_timer;
+
+		Scope m_scope[kGpuScopeQueries/2];
+		bx::RingBufferControl m_control;
+
+		GpuScopeStats m_result[2][BGFX_CONFIG_MAX_GPU_SCOPES];
+		uint16_t m_numResults[2];
+
+		uint32_t m_stack[16];
+		uint16_t m_num;
+		uint16_t m_depth;
+		uint8_t  m_write;
+		bool     m_enabled;
+	};
+
 } // namespace bgfx
 
 #endif // BGFX_RENDERER_H_HEADER_GUARD
@@ -690,6 +690,7 @@ namespace bgfx { namespace d3d11
 			m_fbh.idx = kInvalidHandle;
 			bx::memSet(&m_scd, 0, sizeof(m_scd) );
 			bx::memSet(&m_windows, 0xff, sizeof(m_windows) );
+			bx::memSet(m_fence, 0, sizeof(m_fence) );
 		}
 
 		~RendererContextD3D11()
@@ -1616,6 +1617,11 @@ namespace bgfx { namespace d3d11
 
 			invalidateCache();
 
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_fence); ++ii)
+			{
+				DX_RELEASE(m_fence[ii], 0);
+			}
+
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
 			{
 				m_frameBuffers[ii].destroy();
@@ -1757,6 +1763,10 @@ namespace bgfx { namespace d3d11
 			m_program[_handle.idx].destroy();
 		}
 
+		void prewarmPipeline(ProgramHandle /*_program*/, VertexDeclHandle /*_declHandle*/, FrameBufferHandle /*_fbh*/, uint64_t /*_state*/) override
+		{
+		}
+
 		void* createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip) override
 		{
 			return m_textures[_handle.idx].create(_mem, _flags, _skip);
@@ -1775,6 +1785,15 @@ namespace bgfx { namespace d3d11
 		{
 		}
 
+		void* mapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
+		{
+			return NULL;
+		}
+
+		void unmapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
+		{
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
 			const TextureD3D11& texture = m_textures[_handle.idx];
@@ -1897,11 +1916,11 @@ namespace bgfx { namespace d3d11
 		{
 			if (NULL != m_uniforms[_handle.idx])
 			{
-				BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+				BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			}
 
 			uint32_t size = BX_ALIGN_16(g_uniformTypeSize[_type]*_num);
-			void* data = BX_ALLOC(g_allocator, size);
+			void* data = BX_ALLOC(getAllocator(MemoryTag::Renderer), size);
 			bx::memSet(data, 0, size);
 			m_uniforms[_handle.idx] = data;
 			m_uniformReg.add(_handle, _name);
@@ -1909,7 +1928,7 @@ namespace bgfx { namespace d3d11
 
 		void destroyUniform(UniformHandle _handle) override
 		{
-			BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+			BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			m_uniforms[_handle.idx] = NULL;
 			m_uniformReg.remove(_handle);
 		}
@@ -2015,6 +2034,36 @@ namespace bgfx { namespace d3d11
 			m_occlusionQuery.invalidate(_handle);
 		}
 
+		bool createFence(FenceHandle _handle) override
+		{
+			D3D11_QUERY_DESC desc;
+			desc.Query     = D3D11_QUERY_EVENT;
+			desc.MiscFlags = 0;
+
+			ID3D11Query*& fence = m_fence[_handle.idx];
+			if (FAILED(m_device->CreateQuery(&desc, &fence) ) )
+			{
+				fence = NULL;
+				return false;
+			}
+
+			m_deviceCtx->End(fence);
+			return true;
+		}
+
+		bool isFenceSignaled(FenceHandle _handle) override
+		{
+			BOOL signaled = FALSE;
+			return S_OK == m_deviceCtx->GetData(m_fence[_handle.idx], &signaled, sizeof(signaled), D3D11_ASYNC_GETDATA_DONOTFLUSH)
+				&& signaled
+				;
+		}
+
+		void destroyFence(FenceHandle _handle) override
+		{
+			DX_RELEASE(m_fence[_handle.idx], 0);
+		}
+
 		void setMarker(const char* _marker, uint16_t _len) override
 		{
 			if (BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
@@ -2027,6 +2076,14 @@ namespace bgfx { namespace d3d11
 			}
 		}
 
+		void beginGpuScope(const char* /*_name*/, uint16_t /*_len*/) override
+		{
+		}
+
+		void endGpuScope() override
+		{
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			switch (_handle.type)
@@ -3445,6 +3502,7 @@ namespace bgfx { namespace d3d11
 
 		TimerQueryD3D11     m_gpuTimer;
 		OcclusionQueryD3D11 m_occlusionQuery;
+		ID3D11Query*        m_fence[BGFX_CONFIG_MAX_FENCES];
 
 		uint32_t m_deviceInterfaceVersion;
 
@@ -3504,10 +3562,10 @@ namespace bgfx { namespace d3d11
 
 	RendererContextI* rendererCreate(const Init& _init)
 	{
-		s_renderD3D11 = BX_NEW(g_allocator, RendererContextD3D11);
+		s_renderD3D11 = BX_NEW(getAllocator(MemoryTag::Renderer), RendererContextD3D11);
 		if (!s_renderD3D11->init(_init) )
 		{
-			BX_DELETE(g_allocator, s_renderD3D11);
+			BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderD3D11);
 			s_renderD3D11 = NULL;
 		}
 		return s_renderD3D11;
@@ -3516,7 +3574,7 @@ namespace bgfx { namespace d3d11
 	void rendererDestroy()
 	{
 		s_renderD3D11->shutdown();
-		BX_DELETE(g_allocator, s_renderD3D11);
+		BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderD3D11);
 		s_renderD3D11 = NULL;
 	}
 
@@ -5322,6 +5380,8 @@ namespace bgfx { namespace d3d11
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
 
 		BlitState bs(_render);
+		ProgramProfiler programProfiler(_render);
+		StateCounter stateCounter(_render);
 
 		const uint64_t primType = _render->m_debug&BGFX_DEBUG_WIREFRAME ? BGFX_STATE_PT_LINES : 0;
 		uint8_t primIndex = uint8_t(primType >> BGFX_STATE_PT_SHIFT);
@@ -5379,6 +5439,8 @@ namespace bgfx { namespace d3d11
 
 				if (viewChanged)
 				{
+					programProfiler.end();
+
 					view = key.m_view;
 					currentProgram = BGFX_INVALID_HANDLE;
 
@@ -5424,6 +5486,8 @@ namespace bgfx { namespace d3d11
 					submitBlit(bs, view);
 				}
 
+				programProfiler.begin(key.m_program, renderItem, isCompute);
+
 				if (isCompute)
 				{
 					if (!wasCompute)
@@ -5459,6 +5523,7 @@ namespace bgfx { namespace d3d11
 
 						deviceCtx->CSSetShader(program.m_vsh->m_computeShader, NULL, 0);
 						deviceCtx->CSSetConstantBuffers(0, 1, &program.m_vsh->m_buffer);
+						stateCounter.programChange();
 
 						programChanged =
 							constantsChanged = true;
@@ -5483,6 +5548,7 @@ namespace bgfx { namespace d3d11
 						||  program.m_numPredefined > 0)
 						{
 							commitShaderConstants();
+							stateCounter.uniformUpload();
 						}
 					}
 					BX_UNUSED(programChanged);
@@ -5629,6 +5695,13 @@ namespace bgfx { namespace d3d11
 				changedFlags |= 0 != changedStencil ? BGFX_D3D11_DEPTH_STENCIL_MASK : 0;
 				currentState.m_stencil = newStencil;
 
+				if (0 != changedFlags
+				||  0 != changedStencil)
+				{
+					programProfiler.stateChange();
+					stateCounter.stateChange(changedFlags, changedStencil);
+				}
+
 				if (resetState)
 				{
 					wasCompute = false;
@@ -5773,6 +5846,7 @@ namespace bgfx { namespace d3d11
 						}
 					}
 
+					stateCounter.programChange();
 					programChanged =
 						constantsChanged = true;
 				}
@@ -5805,6 +5879,7 @@ namespace bgfx { namespace d3d11
 					||  program.m_numPredefined > 0)
 					{
 						commitShaderConstants();
+						stateCounter.uniformUpload();
 					}
 				}
 
@@ -5855,6 +5930,9 @@ namespace bgfx { namespace d3d11
 						current = bind;
 					}
 
+					programProfiler.textureBind(changes);
+					stateCounter.textureBind(changes);
+
 					if (0 < changes)
 					{
 						commitTextureStage();
@@ -5920,12 +5998,14 @@ namespace bgfx { namespace d3d11
 					if (0 < numStreams)
 					{
 						deviceCtx->IASetVertexBuffers(0, numStreams, buffers, strides, offsets);
+						stateCounter.vertexBufferBind(numStreams);
 
 						if (isValid(draw.m_instanceDataBuffer) )
 						{
 							const VertexBufferD3D11& inst = m_vertexBuffers[draw.m_instanceDataBuffer.idx];
 							const uint32_t instStride = draw.m_instanceDataStride;
 							deviceCtx->IASetVertexBuffers(numStreams, 1, &inst.m_ptr, &instStride, &draw.m_instanceDataOffset);
+							stateCounter.vertexBufferBind();
 							setInputLayout(numStreams, decls, m_program[currentProgram.idx], uint16_t(instStride/16) );
 						}
 						else
@@ -5943,6 +6023,7 @@ namespace bgfx { namespace d3d11
 							const VertexBufferD3D11& inst = m_vertexBuffers[draw.m_instanceDataBuffer.idx];
 							const uint32_t instStride = draw.m_instanceDataStride;
 							deviceCtx->IASetVertexBuffers(0, 1, &inst.m_ptr, &instStride, &draw.m_instanceDataOffset);
+							stateCounter.vertexBufferBind();
 							setInputLayout(0, NULL, m_program[currentProgram.idx], uint16_t(instStride/16) );
 						}
 						else
@@ -5969,6 +6050,8 @@ namespace bgfx { namespace d3d11
 					{
 						deviceCtx->IASetIndexBuffer(NULL, DXGI_FORMAT_R16_UINT, 0);
 					}
+
+					stateCounter.indexBufferBind();
 				}
 
 				if (0 != currentState.m_streamMask)
@@ -6119,6 +6202,8 @@ namespace bgfx { namespace d3d11
 				invalidateCompute();
 			}
 
+			programProfiler.end();
+
 			submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
 
 			if (0 < _render->m_numRenderItems)
@@ -6279,6 +6364,9 @@ namespace bgfx { namespace d3d11
 				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
 				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
 
+				pos++;
+				pos = dbgTextFrameTiming(tvm, 10, pos, _render);
+
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " Occlusion queries: %3d ", m_occlusionQuery.m_control.available() );
 
@@ -6302,6 +6390,7 @@ namespace bgfx { namespace d3d11
 
 				tvm.printf(10, pos++, attr[attrIndex&1], " Submit wait: %7.4f [ms] ", _render->m_waitSubmit*toMs);
 				tvm.printf(10, pos++, attr[(attrIndex+1)&1], " Render wait: %7.4f [ms] ", _render->m_waitRender*toMs);
+				tvm.printf(10, pos++, 0x8b, " Pacing wait: %7.4f [ms] ", _render->m_framePacing*toMs);
 
 				min = frameTime;
 				max = frameTime;
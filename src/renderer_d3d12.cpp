@@ -663,6 +663,11 @@ namespace bgfx { namespace d3d12
 			, m_backBufferColorIdx(0)
 			, m_rtMsaa(false)
 			, m_directAccessSupport(false)
+			, m_textureUpload(NULL)
+			, m_textureUploadData(NULL)
+			, m_textureUploadPos(0)
+			, m_textureUploadSize(0)
+			, m_updateTexture(NULL)
 		{
 		}
 
@@ -1394,6 +1399,8 @@ namespace bgfx { namespace d3d12
 
 		void shutdown()
 		{
+			releaseTextureUpload();
+
 			m_cmd.finish();
 			m_batch.destroy();
 
@@ -1599,13 +1606,35 @@ namespace bgfx { namespace d3d12
 			m_program[_handle.idx].destroy();
 		}
 
+		void prewarmPipeline(ProgramHandle _program, VertexDeclHandle _declHandle, FrameBufferHandle _fbh, uint64_t _state) override
+		{
+			// Pipeline state depends on render target formats of frame buffer.
+			const FrameBufferHandle fbh = m_fbh;
+			m_fbh = _fbh;
+
+			const VertexDecl* decls[1] = { &m_vertexDecls[_declHandle.idx] };
+			getPipelineState(_state
+				, packStencil(BGFX_STENCIL_DEFAULT, BGFX_STENCIL_DEFAULT)
+				, 1
+				, decls
+				, _program
+				, 0
+				);
+
+			m_fbh = fbh;
+		}
+
 		void* createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip) override
 		{
 			return m_textures[_handle.idx].create(_mem, _flags, _skip);
 		}
 
-		void updateTextureBegin(TextureHandle /*_handle*/, uint8_t /*_side*/, uint8_t /*_mip*/) override
+		void updateTextureBegin(TextureHandle _handle, uint8_t /*_side*/, uint8_t /*_mip*/) override
 		{
+			// Updates are batched per texture/side/mip, transition texture only
+			// once for the whole batch.
+			m_updateTexture      = &m_textures[_handle.idx];
+			m_updateTextureState = m_updateTexture->setState(m_commandList, D3D12_RESOURCE_STATE_COPY_DEST);
 		}
 
 		void updateTexture(TextureHandle _handle, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem) override
@@ -1614,6 +1643,58 @@ namespace bgfx { namespace d3d12
 		}
 
 		void updateTextureEnd() override
+		{
+			m_updateTexture->setState(m_commandList, m_updateTextureState);
+			m_updateTexture = NULL;
+		}
+
+		uint8_t* allocTextureUpload(ID3D12Resource*& _resource, uint64_t& _offset, uint32_t _size)
+		{
+			uint32_t pos = bx::strideAlign(m_textureUploadPos, D3D12_TEXTURE_DATA_PLACEMENT_ALIGNMENT);
+
+			if (NULL == m_textureUpload
+			||  pos + _size > m_textureUploadSize)
+			{
+				releaseTextureUpload();
+
+				m_textureUploadSize = bx::max<uint32_t>(_size, BGFX_CONFIG_FRAME_STAGING_SIZE);
+				m_textureUpload = createCommittedResource(m_device, HeapProperty::Upload, m_textureUploadSize);
+
+				// Upload heap stays mapped until it's released.
+				D3D12_RANGE readRange = { 0, 0 };
+				DX_CHECK(m_textureUpload->Map(0, &readRange, (void**)&m_textureUploadData) );
+
+				pos = 0;
+			}
+
+			m_textureUploadPos = pos + _size;
+
+			_resource = m_textureUpload;
+			_offset   = pos;
+			return &m_textureUploadData[pos];
+		}
+
+		void releaseTextureUpload()
+		{
+			if (NULL != m_textureUpload)
+			{
+				D3D12_RANGE writeRange = { 0, m_textureUploadPos };
+				m_textureUpload->Unmap(0, &writeRange);
+
+				m_cmd.release(m_textureUpload);
+				m_textureUpload     = NULL;
+				m_textureUploadData = NULL;
+				m_textureUploadPos  = 0;
+				m_textureUploadSize = 0;
+			}
+		}
+
+		void* mapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
+		{
+			return NULL;
+		}
+
+		void unmapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
 		{
 		}
 
@@ -1779,11 +1860,11 @@ namespace bgfx { namespace d3d12
 		{
 			if (NULL != m_uniforms[_handle.idx])
 			{
-				BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+				BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			}
 
 			uint32_t size = BX_ALIGN_16(g_uniformTypeSize[_type] * _num);
-			void* data = BX_ALLOC(g_allocator, size);
+			void* data = BX_ALLOC(getAllocator(MemoryTag::Renderer), size);
 			bx::memSet(data, 0, size);
 			m_uniforms[_handle.idx] = data;
 			m_uniformReg.add(_handle, _name);
@@ -1791,7 +1872,7 @@ namespace bgfx { namespace d3d12
 
 		void destroyUniform(UniformHandle _handle) override
 		{
-			BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+			BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			m_uniforms[_handle.idx] = NULL;
 			m_uniformReg.remove(_handle);
 		}
@@ -1882,6 +1963,24 @@ namespace bgfx { namespace d3d12
 			m_occlusionQuery.invalidate(_handle);
 		}
 
+		bool createFence(FenceHandle _handle) override
+		{
+			// Fence is created after frame is kicked, it's signaled once last
+			// command list completes.
+			m_fenceValue[_handle.idx] = m_cmd.m_currentFence - 1;
+			return true;
+		}
+
+		bool isFenceSignaled(FenceHandle _handle) override
+		{
+			return m_fenceValue[_handle.idx] <= m_cmd.m_fence->GetCompletedValue();
+		}
+
+		void destroyFence(FenceHandle _handle) override
+		{
+			BX_UNUSED(_handle);
+		}
+
 		void setMarker(const char* _marker, uint16_t _len) override
 		{
 			BX_UNUSED(_len);
@@ -1892,6 +1991,14 @@ namespace bgfx { namespace d3d12
 			}
 		}
 
+		void beginGpuScope(const char* /*_name*/, uint16_t /*_len*/) override
+		{
+		}
+
+		void endGpuScope() override
+		{
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			switch (_handle.type)
@@ -3317,6 +3424,7 @@ namespace bgfx { namespace d3d12
 		ID3D12Device*       m_device;
 		TimerQueryD3D12     m_gpuTimer;
 		OcclusionQueryD3D12 m_occlusionQuery;
+		uint64_t            m_fenceValue[BGFX_CONFIG_MAX_FENCES];
 
 		uint32_t m_deviceInterfaceVersion;
 
@@ -3340,6 +3448,14 @@ namespace bgfx { namespace d3d12
 		BatchD3D12 m_batch;
 		ID3D12GraphicsCommandList* m_commandList;
 
+		ID3D12Resource* m_textureUpload;
+		uint8_t* m_textureUploadData;
+		uint32_t m_textureUploadPos;
+		uint32_t m_textureUploadSize;
+
+		TextureD3D12* m_updateTexture;
+		D3D12_RESOURCE_STATES m_updateTextureState;
+
 		Resolution m_resolution;
 		bool m_wireframe;
 		bool m_lost;
@@ -3379,10 +3495,10 @@ namespace bgfx { namespace d3d12
 
 	RendererContextI* rendererCreate(const Init& _init)
 	{
-		s_renderD3D12 = BX_NEW(g_allocator, RendererContextD3D12);
+		s_renderD3D12 = BX_NEW(getAllocator(MemoryTag::Renderer), RendererContextD3D12);
 		if (!s_renderD3D12->init(_init) )
 		{
-			BX_DELETE(g_allocator, s_renderD3D12);
+			BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderD3D12);
 			s_renderD3D12 = NULL;
 		}
 		return s_renderD3D12;
@@ -3391,7 +3507,7 @@ namespace bgfx { namespace d3d12
 	void rendererDestroy()
 	{
 		s_renderD3D12->shutdown();
-		BX_DELETE(g_allocator, s_renderD3D12);
+		BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderD3D12);
 		s_renderD3D12 = NULL;
 	}
 
@@ -3580,7 +3696,7 @@ namespace bgfx { namespace d3d12
 
 	void DescriptorAllocatorD3D12::create(D3D12_DESCRIPTOR_HEAP_TYPE _type, uint16_t _maxDescriptors, uint16_t _numDescriptorsPerBlock)
 	{
-		m_handleAlloc = bx::createHandleAlloc(g_allocator, _maxDescriptors);
+		m_handleAlloc = bx::createHandleAlloc(getAllocator(MemoryTag::Renderer), _maxDescriptors);
 		m_numDescriptorsPerBlock = _numDescriptorsPerBlock;
 
 		ID3D12Device* device = s_renderD3D12->m_device;
@@ -3603,7 +3719,7 @@ namespace bgfx { namespace d3d12
 
 	void DescriptorAllocatorD3D12::destroy()
 	{
-		bx::destroyHandleAlloc(g_allocator, m_handleAlloc);
+		bx::destroyHandleAlloc(getAllocator(MemoryTag::Renderer), m_handleAlloc);
 
 		DX_RELEASE(m_heap, 0);
 	}
@@ -3689,8 +3805,8 @@ namespace bgfx { namespace d3d12
 	void DescriptorAllocatorD3D12::reset()
 	{
 		uint16_t max = m_handleAlloc->getMaxHandles();
-		bx::destroyHandleAlloc(g_allocator, m_handleAlloc);
-		m_handleAlloc = bx::createHandleAlloc(g_allocator, max);
+		bx::destroyHandleAlloc(getAllocator(MemoryTag::Renderer), m_handleAlloc);
+		m_handleAlloc = bx::createHandleAlloc(getAllocator(MemoryTag::Renderer), max);
 	}
 
 	D3D12_GPU_DESCRIPTOR_HANDLE DescriptorAllocatorD3D12::get(uint16_t _idx)
@@ -3906,8 +4022,8 @@ namespace bgfx { namespace d3d12
 			, (void**)&m_commandSignature[DrawIndexed]
 			) );
 
-		m_cmds[Draw       ] = BX_ALLOC(g_allocator, m_maxDrawPerBatch*sizeof(DrawIndirectCommand) );
-		m_cmds[DrawIndexed] = BX_ALLOC(g_allocator, m_maxDrawPerBatch*sizeof(DrawIndexedIndirectCommand) );
+		m_cmds[Draw       ] = BX_ALLOC(getAllocator(MemoryTag::Renderer), m_maxDrawPerBatch*sizeof(DrawIndirectCommand) );
+		m_cmds[DrawIndexed] = BX_ALLOC(getAllocator(MemoryTag::Renderer), m_maxDrawPerBatch*sizeof(DrawIndexedIndirectCommand) );
 
 		uint32_t cmdSize = bx::max<uint32_t>(sizeof(DrawIndirectCommand), sizeof(DrawIndexedIndirectCommand) );
 		for (uint32_t ii = 0; ii < BX_COUNTOF(m_indirect); ++ii)
@@ -3923,8 +4039,8 @@ namespace bgfx { namespace d3d12
 
 	void BatchD3D12::destroy()
 	{
-		BX_FREE(g_allocator, m_cmds[0]);
-		BX_FREE(g_allocator, m_cmds[1]);
+		BX_FREE(getAllocator(MemoryTag::Renderer), m_cmds[0]);
+		BX_FREE(getAllocator(MemoryTag::Renderer), m_cmds[1]);
 
 		DX_RELEASE(m_commandSignature[0], 0);
 		DX_RELEASE(m_commandSignature[1], 0);
@@ -4012,6 +4128,7 @@ namespace bgfx { namespace d3d12
 				, numStreams
 				, vbvs
 				);
+			m_stats.m_numVertexBufferBinds++;
 
 			const VertexBufferD3D12& indirect = s_renderD3D12->m_vertexBuffers[_draw.m_indirectBuffer.idx];
 			const uint32_t numDrawIndirect = UINT16_MAX == _draw.m_numIndirect
@@ -4042,6 +4159,7 @@ namespace bgfx { namespace d3d12
 					: DXGI_FORMAT_R32_UINT
 					;
 				_commandList->IASetIndexBuffer(&ibv);
+				m_stats.m_numIndexBufferBinds++;
 
 				_commandList->ExecuteIndirect(
 					  s_renderD3D12->m_commandSignature[2]
@@ -4211,6 +4329,7 @@ namespace bgfx { namespace d3d12
 								, BGFX_CONFIG_MAX_VERTEX_STREAMS+1
 								, cmd.vbv
 								);
+							m_stats.m_numVertexBufferBinds++;
 						}
 
 						_commandList->DrawInstanced(
@@ -4241,12 +4360,14 @@ namespace bgfx { namespace d3d12
 								, BGFX_CONFIG_MAX_VERTEX_STREAMS+1
 								, cmd.vbv
 								);
+							m_stats.m_numVertexBufferBinds++;
 						}
 
 						if (0 != bx::memCmp(&m_current.ibv, &cmd.ibv, sizeof(cmd.ibv) ) )
 						{
 							bx::memCopy(&m_current.ibv, &cmd.ibv, sizeof(cmd.ibv) );
 							_commandList->IASetIndexBuffer(&cmd.ibv);
+							m_stats.m_numIndexBufferBinds++;
 						}
 
 						_commandList->DrawIndexedInstanced(
@@ -5000,17 +5121,13 @@ namespace bgfx { namespace d3d12
 
 		const uint32_t rowPitch = layout.Footprint.RowPitch;
 
-		ID3D12Resource* staging = createCommittedResource(s_renderD3D12->m_device, HeapProperty::Upload, totalBytes);
-		uint8_t* data;
+		ID3D12Resource* staging;
+		uint8_t* data = s_renderD3D12->allocTextureUpload(staging, layout.Offset, uint32_t(totalBytes) );
 
-		D3D12_RANGE readRange = { 0, 0 };
-		DX_CHECK(staging->Map(0, &readRange, (void**)&data) );
 		for (uint32_t ii = 0, height = _rect.m_height; ii < height; ++ii)
 		{
 			bx::memCopy(&data[ii*rowPitch], &_mem->data[ii*srcpitch], srcpitch);
 		}
-		D3D12_RANGE writeRange = { 0, _rect.m_height*srcpitch };
-		staging->Unmap(0, &writeRange);
 
 		D3D12_BOX box;
 		box.left   = 0;
@@ -5026,8 +5143,6 @@ namespace bgfx { namespace d3d12
 		_commandList->CopyTextureRegion(&dst, _rect.m_x, _rect.m_y, 0, &src, &box);
 
 		setState(_commandList, state);
-
-		s_renderD3D12->m_cmd.release(staging);
 	}
 
 	void TextureD3D12::resolve(uint8_t _resolve) const
@@ -5715,6 +5830,10 @@ namespace bgfx { namespace d3d12
 
 	void RendererContextD3D12::submit(Frame* _render, ClearQuad& /*_clearQuad*/, TextVideoMemBlitter& _textVideoMemBlitter)
 	{
+		// All texture updates for this frame are recorded, upload heap is
+		// released once command list using it is completed.
+		releaseTextureUpload();
+
 		if (m_lost
 		||  updateResolution(_render->m_resolution) )
 		{
@@ -5774,6 +5893,8 @@ namespace bgfx { namespace d3d12
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
 
 		BlitState bs(_render);
+		ProgramProfiler programProfiler(_render);
+		StateCounter stateCounter(_render);
 
 		uint32_t blendFactor = 0;
 
@@ -5877,6 +5998,8 @@ namespace bgfx { namespace d3d12
 
 				if (viewChanged)
 				{
+					programProfiler.end();
+
 					m_batch.flush(m_commandList, true);
 					kick();
 
@@ -5938,6 +6061,8 @@ namespace bgfx { namespace d3d12
 					submitBlit(bs, view);
 				}
 
+				programProfiler.begin(key.m_program, renderItem, isCompute);
+
 				if (isCompute)
 				{
 					if (!wasCompute)
@@ -5977,6 +6102,8 @@ namespace bgfx { namespace d3d12
 					if (currentBindHash != bindHash)
 					{
 						currentBindHash  = bindHash;
+						programProfiler.textureBind();
+						stateCounter.textureBind();
 
 						Bind* bindCached = bindLru.find(bindHash);
 						if (NULL == bindCached)
@@ -6095,6 +6222,11 @@ namespace bgfx { namespace d3d12
 					{
 						rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
 
+						if (currentProgram.idx != key.m_program.idx)
+						{
+							stateCounter.programChange();
+						}
+
 						currentProgram = key.m_program;
 						ProgramD3D12& program = m_program[currentProgram.idx];
 
@@ -6114,6 +6246,7 @@ namespace bgfx { namespace d3d12
 						ProgramD3D12& program = m_program[currentProgram.idx];
 						viewState.setPredefined<4>(this, view, program, _render, compute);
 						commitShaderConstants(key.m_program, gpuAddress);
+						stateCounter.uniformUpload();
 						m_commandList->SetComputeRootConstantBufferView(Rdt::CBV, gpuAddress);
 					}
 
@@ -6189,6 +6322,13 @@ namespace bgfx { namespace d3d12
 				uint64_t changedStencil = (currentState.m_stencil ^ draw.m_stencil) & BGFX_STENCIL_FUNC_REF_MASK;
 				currentState.m_stencil = newStencil;
 
+				if (0 != changedFlags
+				||  0 != changedStencil)
+				{
+					programProfiler.stateChange();
+					stateCounter.stateChange(changedFlags, changedStencil);
+				}
+
 				if (resetState)
 				{
 					wasCompute = false;
@@ -6306,6 +6446,8 @@ namespace bgfx { namespace d3d12
 					if (currentBindHash != bindHash)
 					{
 						currentBindHash  = bindHash;
+						programProfiler.textureBind();
+						stateCounter.textureBind();
 
 						Bind* bindCached = bindLru.find(bindHash);
 						if (NULL == bindCached)
@@ -6478,6 +6620,11 @@ namespace bgfx { namespace d3d12
 					||  currentProgram.idx != key.m_program.idx
 					||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
 					{
+						if (currentProgram.idx != key.m_program.idx)
+						{
+							stateCounter.programChange();
+						}
+
 						currentProgram = key.m_program;
 						ProgramD3D12& program = m_program[currentProgram.idx];
 
@@ -6508,6 +6655,7 @@ namespace bgfx { namespace d3d12
 						viewState.m_alphaRef = ref/255.0f;
 						viewState.setPredefined<4>(this, view, program, _render, draw);
 						commitShaderConstants(key.m_program, gpuAddress);
+						stateCounter.uniformUpload();
 					}
 
 					uint32_t numIndices        = m_batch.draw(m_commandList, gpuAddress, draw);
@@ -6531,6 +6679,9 @@ namespace bgfx { namespace d3d12
 			m_batch.end(m_commandList);
 			kick();
 
+			stateCounter.vertexBufferBind(m_batch.m_stats.m_numVertexBufferBinds);
+			stateCounter.indexBufferBind(m_batch.m_stats.m_numIndexBufferBinds);
+
 			if (wasCompute)
 			{
 				setViewType(view, "C");
@@ -6538,6 +6689,8 @@ namespace bgfx { namespace d3d12
 				BGFX_D3D12_PROFILER_BEGIN(view, kColorCompute);
 			}
 
+			programProfiler.end();
+
 			submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
 
 			if (0 < _render->m_numRenderItems)
@@ -6753,6 +6906,9 @@ namespace bgfx { namespace d3d12
 				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
 				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
 
+				pos++;
+				pos = dbgTextFrameTiming(tvm, 10, pos, _render);
+
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " State cache:                        ");
 				tvm.printf(10, pos++, 0x8b, " PSO    | Sampler | Bind   | Queued  ");
@@ -6772,6 +6928,7 @@ namespace bgfx { namespace d3d12
 
 				tvm.printf(10, pos++, attr[attrIndex&1], " Submit wait: %7.4f [ms] ", _render->m_waitSubmit*toMs);
 				tvm.printf(10, pos++, attr[(attrIndex+1)&1], " Render wait: %7.4f [ms] ", _render->m_waitRender*toMs);
+				tvm.printf(10, pos++, 0x8b, " Pacing wait: %7.4f [ms] ", _render->m_framePacing*toMs);
 
 				min = frameTime;
 				max = frameTime;
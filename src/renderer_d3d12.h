@@ -498,6 +498,8 @@ namespace bgfx { namespace d3d12
 		{
 			uint32_t m_numImmediate[Count];
 			uint32_t m_numIndirect[Count];
+			uint32_t m_numVertexBufferBinds;
+			uint32_t m_numIndexBufferBinds;
 		};
 
 		BufferD3D12 m_indirect[32];
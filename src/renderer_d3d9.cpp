@@ -1070,6 +1070,10 @@ namespace bgfx { namespace d3d9
 			m_program[_handle.idx].destroy();
 		}
 
+		void prewarmPipeline(ProgramHandle /*_program*/, VertexDeclHandle /*_declHandle*/, FrameBufferHandle /*_fbh*/, uint64_t /*_state*/) override
+		{
+		}
+
 		void* createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip) override
 		{
 			m_textures[_handle.idx].create(_mem, _flags, _skip);
@@ -1093,6 +1097,15 @@ namespace bgfx { namespace d3d9
 			m_updateTexture = NULL;
 		}
 
+		void* mapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
+		{
+			return NULL;
+		}
+
+		void unmapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
+		{
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
 			TextureD3D9& texture = m_textures[_handle.idx];
@@ -1210,11 +1223,11 @@ namespace bgfx { namespace d3d9
 		{
 			if (NULL != m_uniforms[_handle.idx])
 			{
-				BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+				BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			}
 
 			uint32_t size = BX_ALIGN_16(g_uniformTypeSize[_type]*_num);
-			void* data = BX_ALLOC(g_allocator, size);
+			void* data = BX_ALLOC(getAllocator(MemoryTag::Renderer), size);
 			bx::memSet(data, 0, size);
 			m_uniforms[_handle.idx] = data;
 			m_uniformReg.add(_handle, _name);
@@ -1222,7 +1235,7 @@ namespace bgfx { namespace d3d9
 
 		void destroyUniform(UniformHandle _handle) override
 		{
-			BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+			BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			m_uniforms[_handle.idx] = NULL;
 			m_uniformReg.remove(_handle);
 		}
@@ -1320,6 +1333,23 @@ namespace bgfx { namespace d3d9
 			m_occlusionQuery.invalidate(_handle);
 		}
 
+		bool createFence(FenceHandle _handle) override
+		{
+			BX_UNUSED(_handle);
+			return false;
+		}
+
+		bool isFenceSignaled(FenceHandle _handle) override
+		{
+			BX_UNUSED(_handle);
+			return false;
+		}
+
+		void destroyFence(FenceHandle _handle) override
+		{
+			BX_UNUSED(_handle);
+		}
+
 		void setMarker(const char* _marker, uint16_t _len) override
 		{
 			if (BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
@@ -1332,6 +1362,14 @@ namespace bgfx { namespace d3d9
 			}
 		}
 
+		void beginGpuScope(const char* /*_name*/, uint16_t /*_len*/) override
+		{
+		}
+
+		void endGpuScope() override
+		{
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			BX_UNUSED(_handle, _name, _len)
@@ -2262,10 +2300,10 @@ namespace bgfx { namespace d3d9
 
 	RendererContextI* rendererCreate(const Init& _init)
 	{
-		s_renderD3D9 = BX_NEW(g_allocator, RendererContextD3D9);
+		s_renderD3D9 = BX_NEW(getAllocator(MemoryTag::Renderer), RendererContextD3D9);
 		if (!s_renderD3D9->init(_init) )
 		{
-			BX_DELETE(g_allocator, s_renderD3D9);
+			BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderD3D9);
 			s_renderD3D9 = NULL;
 		}
 		return s_renderD3D9;
@@ -2274,7 +2312,7 @@ namespace bgfx { namespace d3d9
 	void rendererDestroy()
 	{
 		s_renderD3D9->shutdown();
-		BX_DELETE(g_allocator, s_renderD3D9);
+		BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderD3D9);
 		s_renderD3D9 = NULL;
 	}
 
@@ -2290,7 +2328,7 @@ namespace bgfx { namespace d3d9
 		{
 			usage |= D3DUSAGE_DYNAMIC;
 			pool = D3DPOOL_DEFAULT;
-			m_dynamic = (uint8_t*)BX_ALLOC(g_allocator, _size);
+			m_dynamic = (uint8_t*)BX_ALLOC(getAllocator(MemoryTag::Renderer), _size);
 		}
 
 		const D3DFORMAT format = 0 == (_flags & BGFX_BUFFER_INDEX32)
@@ -2353,7 +2391,7 @@ namespace bgfx { namespace d3d9
 		{
 			usage |= D3DUSAGE_DYNAMIC;
 			pool = D3DPOOL_DEFAULT;
-			m_dynamic = (uint8_t*)BX_ALLOC(g_allocator, _size);
+			m_dynamic = (uint8_t*)BX_ALLOC(getAllocator(MemoryTag::Renderer), _size);
 		}
 
 		DX_CHECK(s_renderD3D9->m_device->CreateVertexBuffer(m_size
@@ -3772,6 +3810,8 @@ namespace bgfx { namespace d3d9
 		uint32_t blendFactor = 0;
 
 		BlitState bs(_render);
+		ProgramProfiler programProfiler(_render);
+		StateCounter stateCounter(_render);
 
 		uint8_t primIndex;
 		{
@@ -3847,6 +3887,8 @@ namespace bgfx { namespace d3d9
 
 				if (key.m_view != view)
 				{
+					programProfiler.end();
+
 					currentState.clear();
 					currentState.m_scissor = !draw.m_scissor;
 					changedFlags = BGFX_STATE_MASK;
@@ -3904,6 +3946,15 @@ namespace bgfx { namespace d3d9
 					submitBlit(bs, view);
 				}
 
+				programProfiler.begin(key.m_program, _render->m_renderItem[itemIdx], false);
+
+				if (0 != changedFlags
+				||  0 != changedStencil)
+				{
+					programProfiler.stateChange();
+					stateCounter.stateChange(changedFlags, changedStencil);
+				}
+
 				uint16_t scissor = draw.m_scissor;
 				if (currentState.m_scissor != scissor)
 				{
@@ -4151,6 +4202,7 @@ namespace bgfx { namespace d3d9
 							);
 					}
 
+					stateCounter.programChange();
 					programChanged =
 						constantsChanged = true;
 				}
@@ -4175,6 +4227,8 @@ namespace bgfx { namespace d3d9
 								commit(*fcb);
 							}
 						}
+
+						stateCounter.uniformUpload();
 					}
 
 					viewState.setPredefined<4>(this, view, program, _render, draw);
@@ -4198,6 +4252,9 @@ namespace bgfx { namespace d3d9
 							{
 								DX_CHECK(device->SetTexture(stage, NULL) );
 							}
+
+							programProfiler.textureBind();
+							stateCounter.textureBind();
 						}
 
 						current = bind;
@@ -4259,6 +4316,7 @@ namespace bgfx { namespace d3d9
 
 						DX_CHECK(device->SetStreamSourceFreq(0, freq) );
 						DX_CHECK(device->SetStreamSource(numStreams, vb.m_ptr, 0, stride) );
+						stateCounter.vertexBufferBind();
 					}
 
 					currentState.m_numVertices = numVertices;
@@ -4270,6 +4328,7 @@ namespace bgfx { namespace d3d9
 							const VertexBufferD3D9& inst = m_vertexBuffers[draw.m_instanceDataBuffer.idx];
 							DX_CHECK(device->SetStreamSourceFreq(numStreams, UINT(D3DSTREAMSOURCE_INSTANCEDATA|1) ) );
 							DX_CHECK(device->SetStreamSource(numStreams, inst.m_ptr, draw.m_instanceDataOffset, draw.m_instanceDataStride) );
+							stateCounter.vertexBufferBind();
 							setInputLayout(numStreams, decls, draw.m_instanceDataStride/16);
 						}
 						else
@@ -4299,6 +4358,8 @@ namespace bgfx { namespace d3d9
 					{
 						DX_CHECK(device->SetIndices(NULL) );
 					}
+
+					stateCounter.indexBufferBind();
 				}
 
 				if (0 != currentState.m_streamMask)
@@ -4373,6 +4434,8 @@ namespace bgfx { namespace d3d9
 				}
 			}
 
+			programProfiler.end();
+
 			submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
 
 			if (0 < _render->m_numRenderItems)
@@ -4507,6 +4570,9 @@ namespace bgfx { namespace d3d9
 				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
 				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
 
+				pos++;
+				pos = dbgTextFrameTiming(tvm, 10, pos, _render);
+
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " Occlusion queries: %3d ", m_occlusionQuery.m_control.available() );
 
@@ -4526,6 +4592,7 @@ namespace bgfx { namespace d3d9
 
 				tvm.printf(10, pos++, attr[attrIndex&1], " Submit wait: %7.4f [ms]", _render->m_waitSubmit*toMs);
 				tvm.printf(10, pos++, attr[(attrIndex+1)&1], " Render wait: %7.4f [ms]", _render->m_waitRender*toMs);
+				tvm.printf(10, pos++, 0x8b, " Pacing wait: %7.4f [ms] ", _render->m_framePacing*toMs);
 
 				min = frameTime;
 				max = frameTime;
@@ -167,7 +167,7 @@ namespace bgfx { namespace d3d9
 
 				if (NULL != m_dynamic)
 				{
-					BX_FREE(g_allocator, m_dynamic);
+					BX_FREE(getAllocator(MemoryTag::Renderer), m_dynamic);
 					m_dynamic = NULL;
 				}
 			}
@@ -220,7 +220,7 @@ namespace bgfx { namespace d3d9
 
 				if (NULL != m_dynamic)
 				{
-					BX_FREE(g_allocator, m_dynamic);
+					BX_FREE(getAllocator(MemoryTag::Renderer), m_dynamic);
 					m_dynamic = NULL;
 				}
 			}
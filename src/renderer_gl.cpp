@@ -74,6 +74,12 @@ namespace bgfx { namespace gl
 	};
 	BX_STATIC_ASSERT(BGFX_CONFIG_MAX_INSTANCE_DATA_COUNT == BX_COUNTOF(s_instanceDataName) );
 
+	static const char* s_uniformBlockName[] =
+	{
+		"bgfx_VertexUniforms",
+		"bgfx_FragmentUniforms",
+	};
+
 	static const GLenum s_access[] =
 	{
 		GL_READ_ONLY,
@@ -481,9 +487,11 @@ namespace bgfx { namespace gl
 			APPLE_texture_format_BGRA8888,
 			APPLE_texture_max_level,
 
+			ARB_buffer_storage,
 			ARB_clip_control,
 			ARB_compute_shader,
 			ARB_conservative_depth,
+			ARB_copy_buffer,
 			ARB_copy_image,
 			ARB_debug_label,
 			ARB_debug_output,
@@ -514,6 +522,7 @@ namespace bgfx { namespace gl
 			ARB_shader_image_load_store,
 			ARB_shader_storage_buffer_object,
 			ARB_shader_texture_lod,
+			ARB_sync,
 			ARB_texture_compression_bptc,
 			ARB_texture_compression_rgtc,
 			ARB_texture_cube_map_array,
@@ -542,6 +551,7 @@ namespace bgfx { namespace gl
 			EXT_blend_color,
 			EXT_blend_minmax,
 			EXT_blend_subtract,
+			EXT_buffer_storage,
 			EXT_color_buffer_half_float,
 			EXT_color_buffer_float,
 			EXT_copy_image,
@@ -691,9 +701,11 @@ namespace bgfx { namespace gl
 		{ "APPLE_texture_format_BGRA8888",            false,                             true  },
 		{ "APPLE_texture_max_level",                  false,                             true  },
 
+		{ "ARB_buffer_storage",                       BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_clip_control",                         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_compute_shader",                       BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_conservative_depth",                   BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
+		{ "ARB_copy_buffer",                          BGFX_CONFIG_RENDERER_OPENGL >= 31, true  },
 		{ "ARB_copy_image",                           BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
 		{ "ARB_debug_label",                          false,                             true  },
 		{ "ARB_debug_output",                         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
@@ -724,6 +736,7 @@ namespace bgfx { namespace gl
 		{ "ARB_shader_image_load_store",              BGFX_CONFIG_RENDERER_OPENGL >= 42, true  },
 		{ "ARB_shader_storage_buffer_object",         BGFX_CONFIG_RENDERER_OPENGL >= 43, true  },
 		{ "ARB_shader_texture_lod",                   BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
+		{ "ARB_sync",                                 BGFX_CONFIG_RENDERER_OPENGL >= 32, true  },
 		{ "ARB_texture_compression_bptc",             BGFX_CONFIG_RENDERER_OPENGL >= 44, true  },
 		{ "ARB_texture_compression_rgtc",             BGFX_CONFIG_RENDERER_OPENGL >= 30, true  },
 		{ "ARB_texture_cube_map_array",               BGFX_CONFIG_RENDERER_OPENGL >= 40, true  },
@@ -752,6 +765,7 @@ namespace bgfx { namespace gl
 		{ "EXT_blend_color",                          BGFX_CONFIG_RENDERER_OPENGL >= 31, true  },
 		{ "EXT_blend_minmax",                         BGFX_CONFIG_RENDERER_OPENGL >= 14, true  },
 		{ "EXT_blend_subtract",                       BGFX_CONFIG_RENDERER_OPENGL >= 14, true  },
+		{ "EXT_buffer_storage",                       false,                             true  }, // GLES3.1 extension.
 		{ "EXT_color_buffer_half_float",              false,                             true  }, // GLES2 extension.
 		{ "EXT_color_buffer_float",                   false,                             true  }, // GLES2 extension.
 		{ "EXT_copy_image",                           false,                             true  }, // GLES2 extension.
@@ -1728,6 +1742,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 	{
 		RendererContextGL()
 			: m_numWindows(1)
+			, m_uniformBufferOffsetAlign(256)
 			, m_rtMsaa(false)
 			, m_fbDiscard(BGFX_CLEAR_NONE)
 			, m_capture(NULL)
@@ -1735,7 +1750,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			, m_maxAnisotropy(0.0f)
 			, m_maxAnisotropyDefault(0.0f)
 			, m_maxMsaa(0)
-			, m_vao(0)
+			, m_currentVaoCache(&m_vaoCache)
+			, m_vaoEpoch(0)
 			, m_blitSupported(false)
 			, m_readBackSupported(BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL) )
 			, m_vaoSupport(false)
@@ -1750,6 +1766,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			, m_occlusionQuerySupport(false)
 			, m_atocSupport(false)
 			, m_conservativeRasterSupport(false)
+			, m_stagingBufferSupport(false)
+			, m_syncSupport(false)
+			, m_streamBufferSupport(false)
+			, m_uniformBlockSupport(false)
+			, m_pixelPackSupport(false)
+			, m_updateTextureUnpack(0)
 			, m_flip(false)
 			, m_hash( (BX_PLATFORM_WINDOWS<<1) | BX_ARCH_64BIT)
 			, m_backBufferFbo(0)
@@ -1758,6 +1780,9 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			, m_clearQuadDepth(BGFX_INVALID_HANDLE)
 		{
 			bx::memSet(m_msaaBackBufferRbos, 0, sizeof(m_msaaBackBufferRbos) );
+			bx::memSet(m_fence, 0, sizeof(m_fence) );
+			bx::memSet(m_uniformBlockBuffer, 0, sizeof(m_uniformBlockBuffer) );
+			bx::memSet(m_uniformChanges, 0, sizeof(m_uniformChanges) );
 		}
 
 		~RendererContextGL()
@@ -2370,7 +2395,70 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 				if (m_vaoSupport)
 				{
-					GL_CHECK(glGenVertexArrays(1, &m_vao) );
+					m_vaoCache.create();
+				}
+
+				m_stagingBufferSupport = !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
+					&& (!!(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+						|| (s_extension[Extension::ARB_map_buffer_range].m_supported
+						&&  s_extension[Extension::ARB_copy_buffer     ].m_supported)
+						);
+
+				m_syncSupport = !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
+					&& (!!(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+						|| s_extension[Extension::ARB_sync].m_supported
+						);
+
+				m_streamBufferSupport = true
+					&& m_stagingBufferSupport
+					&& m_syncSupport
+					&& NULL != glBufferStorage
+					&& (s_extension[Extension::ARB_buffer_storage].m_supported
+					||  s_extension[Extension::EXT_buffer_storage].m_supported)
+					;
+
+				if (m_streamBufferSupport)
+				{
+					m_streamBufferSupport = m_streamBuffer.create(0
+						+ BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
+						+ BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
+						+ BGFX_CONFIG_FRAME_STAGING_SIZE
+						);
+				}
+
+				m_uniformBlockSupport = true
+					&& (!!(BGFX_CONFIG_RENDERER_OPENGLES >= 30)
+						|| s_extension[Extension::ARB_uniform_buffer_object].m_supported
+						)
+					&& NULL != glGetUniformBlockIndex
+					&& NULL != glGetActiveUniformBlockiv
+					&& NULL != glGetActiveUniformsiv
+					&& NULL != glUniformBlockBinding
+					&& NULL != glBindBufferRange
+					;
+
+				m_pixelPackSupport = true
+					&& m_stagingBufferSupport
+					&& m_syncSupport
+					;
+
+				if (m_pixelPackSupport)
+				{
+					m_pixelPack.create();
+				}
+
+				if (m_uniformBlockSupport)
+				{
+					GLint align = 0;
+					GL_CHECK(glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &align) );
+					m_uniformBufferOffsetAlign = bx::uint32_max(align, 16);
+
+					GL_CHECK(glGenBuffers(BX_COUNTOF(m_uniformBlockBuffer), m_uniformBlockBuffer) );
+
+					if (m_streamBufferSupport)
+					{
+						m_uniformStream.create(BGFX_CONFIG_RENDERER_OPENGL_UNIFORM_STREAM_SIZE);
+					}
 				}
 
 				m_samplerObjectSupport = !BX_ENABLED(BX_PLATFORM_EMSCRIPTEN)
@@ -2562,6 +2650,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				if (m_timerQuerySupport)
 				{
 					m_gpuTimer.create();
+					m_gpuScope.m_timer.create();
 				}
 
 				if (m_occlusionQuerySupport)
@@ -2597,9 +2686,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		{
 			if (m_vaoSupport)
 			{
-				GL_CHECK(glBindVertexArray(0) );
-				GL_CHECK(glDeleteVertexArrays(1, &m_vao) );
-				m_vao = 0;
+				m_vaoCache.destroy();
 			}
 
 			captureFinish();
@@ -2609,6 +2696,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			if (m_timerQuerySupport)
 			{
 				m_gpuTimer.destroy();
+				m_gpuScope.m_timer.destroy();
 			}
 
 			if (m_occlusionQuerySupport)
@@ -2616,6 +2704,21 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				m_occlusionQuery.destroy();
 			}
 
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_stagingBuffer); ++ii)
+			{
+				m_stagingBuffer[ii].destroy();
+			}
+
+			m_streamBuffer.destroy();
+			m_uniformStream.destroy();
+			m_pixelPack.destroy();
+
+			if (m_uniformBlockSupport)
+			{
+				GL_CHECK(glDeleteBuffers(BX_COUNTOF(m_uniformBlockBuffer), m_uniformBlockBuffer) );
+				bx::memSet(m_uniformBlockBuffer, 0, sizeof(m_uniformBlockBuffer) );
+			}
+
 			destroyMsaaFbo();
 			m_glctx.destroy();
 
@@ -2677,6 +2780,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		void destroyIndexBuffer(IndexBufferHandle _handle) override
 		{
 			m_indexBuffers[_handle.idx].destroy();
+			++m_vaoEpoch;
 		}
 
 		void createVertexDecl(VertexDeclHandle _handle, const VertexDecl& _decl) override
@@ -2698,6 +2802,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		void destroyVertexBuffer(VertexBufferHandle _handle) override
 		{
 			m_vertexBuffers[_handle.idx].destroy();
+			++m_vaoEpoch;
 		}
 
 		void createDynamicIndexBuffer(IndexBufferHandle _handle, uint32_t _size, uint16_t _flags) override
@@ -2707,12 +2812,24 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void updateDynamicIndexBuffer(IndexBufferHandle _handle, uint32_t _offset, uint32_t _size, const Memory* _mem) override
 		{
-			m_indexBuffers[_handle.idx].update(_offset, bx::uint32_min(_size, _mem->size), _mem->data);
+			IndexBufferGL& ib = m_indexBuffers[_handle.idx];
+			const uint32_t size = bx::uint32_min(_size, _mem->size);
+
+			const StagingBufferGL* staging = findStagingBuffer(_mem->data);
+			if (NULL != staging)
+			{
+				staging->copy(ib.m_id, _offset, _mem->data, size);
+			}
+			else if (!m_streamBuffer.copy(ib.m_id, _offset, _mem->data, size) )
+			{
+				ib.update(_offset, size, _mem->data);
+			}
 		}
 
 		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
 		{
 			m_indexBuffers[_handle.idx].destroy();
+			++m_vaoEpoch;
 		}
 
 		void createDynamicVertexBuffer(VertexBufferHandle _handle, uint32_t _size, uint16_t _flags) override
@@ -2723,12 +2840,24 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void updateDynamicVertexBuffer(VertexBufferHandle _handle, uint32_t _offset, uint32_t _size, const Memory* _mem) override
 		{
-			m_vertexBuffers[_handle.idx].update(_offset, bx::uint32_min(_size, _mem->size), _mem->data);
+			VertexBufferGL& vb = m_vertexBuffers[_handle.idx];
+			const uint32_t size = bx::uint32_min(_size, _mem->size);
+
+			const StagingBufferGL* staging = findStagingBuffer(_mem->data);
+			if (NULL != staging)
+			{
+				staging->copy(vb.m_id, _offset, _mem->data, size);
+			}
+			else if (!m_streamBuffer.copy(vb.m_id, _offset, _mem->data, size) )
+			{
+				vb.update(_offset, size, _mem->data);
+			}
 		}
 
 		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
 		{
 			m_vertexBuffers[_handle.idx].destroy();
+			++m_vaoEpoch;
 		}
 
 		void createShader(ShaderHandle _handle, const Memory* _mem) override
@@ -2750,6 +2879,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		void destroyProgram(ProgramHandle _handle) override
 		{
 			m_program[_handle.idx].destroy();
+			++m_vaoEpoch;
+		}
+
+		void prewarmPipeline(ProgramHandle /*_program*/, VertexDeclHandle /*_declHandle*/, FrameBufferHandle /*_fbh*/, uint64_t /*_state*/) override
+		{
 		}
 
 		void* createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip) override
@@ -2758,8 +2892,14 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			return NULL;
 		}
 
-		void updateTextureBegin(TextureHandle /*_handle*/, uint8_t /*_side*/, uint8_t /*_mip*/) override
+		void updateTextureBegin(TextureHandle _handle, uint8_t /*_side*/, uint8_t /*_mip*/) override
 		{
+			// Updates are batched per texture/side/mip, bind texture and set
+			// unpack state only once for the whole batch.
+			const TextureGL& texture = m_textures[_handle.idx];
+			GL_CHECK(glBindTexture(texture.m_target, texture.m_id) );
+			GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
+			m_updateTextureUnpack = 0;
 		}
 
 		void updateTexture(TextureHandle _handle, uint8_t _side, uint8_t _mip, const Rect& _rect, uint16_t _z, uint16_t _depth, uint16_t _pitch, const Memory* _mem) override
@@ -2769,6 +2909,49 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void updateTextureEnd() override
 		{
+			if (0 != m_updateTextureUnpack)
+			{
+				GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0) );
+				m_updateTextureUnpack = 0;
+			}
+
+			if (BX_ENABLED(BGFX_CONFIG_RENDERER_OPENGL)
+			||  s_extension[Extension::EXT_unpack_subimage].m_supported)
+			{
+				GL_CHECK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0) );
+			}
+		}
+
+		void* mapStagingBuffer(uint8_t _idx, uint32_t _size) override
+		{
+			if (m_stagingBufferSupport)
+			{
+				return m_stagingBuffer[_idx].map(_size, m_streamBufferSupport);
+			}
+
+			return NULL;
+		}
+
+		void unmapStagingBuffer(uint8_t _idx, uint32_t /*_size*/) override
+		{
+			m_stagingBuffer[_idx].unmap();
+		}
+
+		StagingBufferGL* findStagingBuffer(const void* _data)
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_stagingBuffer); ++ii)
+			{
+				StagingBufferGL& staging = m_stagingBuffer[ii];
+
+				// Buffer that is still mapped belongs to frame being submitted.
+				if (!staging.m_mapped
+				&&  staging.contains(_data) )
+				{
+					return &staging;
+				}
+			}
+
+			return NULL;
 		}
 
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
@@ -2922,11 +3105,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		{
 			if (NULL != m_uniforms[_handle.idx])
 			{
-				BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+				BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			}
 
 			uint32_t size = g_uniformTypeSize[_type]*_num;
-			void* data = BX_ALLOC(g_allocator, size);
+			void* data = BX_ALLOC(getAllocator(MemoryTag::Renderer), size);
 			bx::memSet(data, 0, size);
 			m_uniforms[_handle.idx] = data;
 			m_uniformReg.add(_handle, _name);
@@ -2934,7 +3117,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void destroyUniform(UniformHandle _handle) override
 		{
-			BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+			BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			m_uniforms[_handle.idx] = NULL;
 			m_uniformReg.remove(_handle);
 		}
@@ -2955,6 +3138,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 			m_glctx.makeCurrent(swapChain);
 
+			if (m_pixelPackSupport)
+			{
+				m_pixelPack.read(width, height, m_readPixelsFmt, _filePath);
+				return;
+			}
+
 			uint32_t length = width*height*4;
 			uint8_t* data = (uint8_t*)BX_ALLOC(g_allocator, length);
 
@@ -3001,11 +3190,51 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			m_occlusionQuery.invalidate(_handle);
 		}
 
+		bool createFence(FenceHandle _handle) override
+		{
+			if (!m_syncSupport)
+			{
+				return false;
+			}
+
+			m_fence[_handle.idx] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			GL_CHECK(glFlush() );
+			return NULL != m_fence[_handle.idx];
+		}
+
+		bool isFenceSignaled(FenceHandle _handle) override
+		{
+			const GLenum result = glClientWaitSync(m_fence[_handle.idx], 0, 0);
+			return GL_ALREADY_SIGNALED    == result
+				|| GL_CONDITION_SATISFIED == result
+				;
+		}
+
+		void destroyFence(FenceHandle _handle) override
+		{
+			GLsync& fence = m_fence[_handle.idx];
+			if (NULL != fence)
+			{
+				GL_CHECK(glDeleteSync(fence) );
+				fence = NULL;
+			}
+		}
+
 		void setMarker(const char* _marker, uint16_t _len) override
 		{
 			GL_CHECK(glInsertEventMarker(_len, _marker) );
 		}
 
+		void beginGpuScope(const char* _name, uint16_t _len) override
+		{
+			m_gpuScope.begin(_name, _len);
+		}
+
+		void endGpuScope() override
+		{
+			m_gpuScope.end();
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			uint16_t len = bx::min(_len, m_maxLabelLen);
@@ -3050,9 +3279,9 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void blitSetup(TextVideoMemBlitter& _blitter) override
 		{
-			if (0 != m_vao)
+			if (m_vaoSupport)
 			{
-				GL_CHECK(glBindVertexArray(m_vao) );
+				m_currentVaoCache->bindDefault();
 			}
 
 			uint32_t width  = m_resolution.width;
@@ -3076,11 +3305,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			float proj[16];
 			bx::mtxOrtho(proj, 0.0f, (float)width, (float)height, 0.0f, 0.0f, 1000.0f, 0.0f, g_caps.homogeneousDepth);
 
-			GL_CHECK(glUniformMatrix4fv(program.m_predefined[0].m_loc
-				, 1
-				, GL_FALSE
-				, proj
-				) );
+			setShaderUniform4x4f(0, program.m_predefined[0].m_loc, proj, 1);
+			commitUniformBlocks(program);
 
 			GL_CHECK(glActiveTexture(GL_TEXTURE0) );
 			GL_CHECK(glBindTexture(GL_TEXTURE_2D, m_textures[_blitter.m_texture.idx].m_id) );
@@ -3179,8 +3405,24 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			}
 		}
 
+		void setUniformBlock(uint32_t _loc, const void* _val, uint32_t _size)
+		{
+			const uint32_t stage  = 0 != (_loc&BGFX_GL_UNIFORM_BLOCK_FRAGMENTBIT);
+			const uint32_t offset = _loc&BGFX_GL_UNIFORM_BLOCK_OFFSET_MASK;
+			BX_CHECK(offset + _size <= sizeof(m_uniformScratch[0]), "Uniform block write out of bounds.");
+
+			bx::memCopy(&m_uniformScratch[stage][offset], _val, _size);
+			m_uniformChanges[stage]++;
+		}
+
 		void setShaderUniform4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
+			if (0 != (_regIndex&BGFX_GL_UNIFORM_BLOCK_BIT) )
+			{
+				setUniformBlock(_regIndex, _val, _numRegs*16);
+				return;
+			}
+
 			GL_CHECK(glUniform4fv(_regIndex
 				, _numRegs
 				, (const GLfloat*)_val
@@ -3189,6 +3431,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void setShaderUniform4x4f(uint8_t /*_flags*/, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
 		{
+			if (0 != (_regIndex&BGFX_GL_UNIFORM_BLOCK_BIT) )
+			{
+				setUniformBlock(_regIndex, _val, _numRegs*64);
+				return;
+			}
+
 			GL_CHECK(glUniformMatrix4fv(_regIndex
 				, _numRegs
 				, GL_FALSE
@@ -3196,6 +3444,38 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				) );
 		}
 
+		void commitUniformBlocks(const ProgramGL& _program)
+		{
+			for (uint32_t stage = 0; stage < BX_COUNTOF(m_uniformChanges); ++stage)
+			{
+				const uint32_t size = _program.m_uniformBlockSize[stage];
+
+				if (0 == size
+				||  0 == m_uniformChanges[stage])
+				{
+					continue;
+				}
+
+				m_uniformChanges[stage] = 0;
+
+				const uint8_t* data = m_uniformScratch[stage];
+				const uint32_t offset = m_uniformStream.alloc(data, size, m_uniformBufferOffsetAlign);
+
+				if (UINT32_MAX != offset)
+				{
+					GL_CHECK(glBindBufferRange(GL_UNIFORM_BUFFER, stage, m_uniformStream.m_id, offset, size) );
+				}
+				else
+				{
+					// Ring is not available or it's full, orphan and update
+					// block buffer instead.
+					GL_CHECK(glBindBuffer(GL_UNIFORM_BUFFER, m_uniformBlockBuffer[stage]) );
+					GL_CHECK(glBufferData(GL_UNIFORM_BUFFER, size, data, GL_STREAM_DRAW) );
+					GL_CHECK(glBindBufferBase(GL_UNIFORM_BUFFER, stage, m_uniformBlockBuffer[stage]) );
+				}
+			}
+		}
+
 		uint32_t setFrameBuffer(FrameBufferHandle _fbh, uint32_t _height, uint16_t _discard = BGFX_CLEAR_NONE, bool _msaa = true)
 		{
 			if (isValid(m_fbh)
@@ -3212,6 +3492,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			}
 
 			m_glctx.makeCurrent(NULL);
+			m_currentVaoCache = &m_vaoCache;
 
 			if (!isValid(_fbh) )
 			{
@@ -3240,6 +3521,18 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					m_glctx.makeCurrent(frameBuffer.m_swapChain);
 					GL_CHECK(glFrontFace(GL_CW) );
 
+					if (m_vaoSupport)
+					{
+						if (NULL == frameBuffer.m_vaoCache)
+						{
+							frameBuffer.m_vaoCache = BX_NEW(getAllocator(MemoryTag::Renderer), VaoCacheGL);
+							frameBuffer.m_vaoCache->create();
+						}
+
+						m_currentVaoCache = frameBuffer.m_vaoCache;
+						m_currentVaoCache->bindDefault();
+					}
+
 					frameBuffer.m_needPresent = true;
 					m_currentFbo = 0;
 				}
@@ -3357,10 +3650,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				{
 					m_glctx.create(_width, _height);
 
-#if BX_PLATFORM_IOS
+#if BX_PLATFORM_IOS || BGFX_USE_EGL
 					// iOS: need to figure out how to deal with FBO created by context.
+					// EGL: headless context renders into FBO created by context.
 					m_backBufferFbo = m_msaaBackBufferFbo = m_glctx.getFbo();
-#endif // BX_PLATFORM_IOS
+#endif // BX_PLATFORM_IOS || BGFX_USE_EGL
 				}
 				else
 				{
@@ -3504,6 +3798,9 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		void updateCapture()
 		{
+			// Deliver frames captured with previous resolution first.
+			m_pixelPack.update(true);
+
 			if (m_resolution.reset&BGFX_RESET_CAPTURE)
 			{
 				m_captureSize = m_resolution.width*m_resolution.height*4;
@@ -3520,6 +3817,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		{
 			if (NULL != m_capture)
 			{
+				if (m_pixelPackSupport)
+				{
+					m_pixelPack.read(m_resolution.width, m_resolution.height, m_readPixelsFmt, NULL);
+					return;
+				}
+
 				GL_CHECK(glReadPixels(0
 					, 0
 					, m_resolution.width
@@ -3549,6 +3852,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		{
 			if (NULL != m_capture)
 			{
+				m_pixelPack.update(true);
 				g_callback->captureEnd();
 				BX_FREE(g_allocator, m_capture);
 				m_capture = NULL;
@@ -3648,6 +3952,29 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 				uint32_t loc = _uniformBuffer.read();
 
+				if (0 != (loc&BGFX_GL_UNIFORM_BLOCK_BIT) )
+				{
+					if (UniformType::Mat3 == type)
+					{
+						// std140 layout pads each mat3 column to vec4.
+						const float* value = (const float*)data;
+						for (uint32_t ii = 0; ii < num; ++ii, loc += 3*16, value += 9)
+						{
+							float mtx[12] = { 0.0f };
+							bx::memCopy(&mtx[0], &value[0], 12);
+							bx::memCopy(&mtx[4], &value[3], 12);
+							bx::memCopy(&mtx[8], &value[6], 12);
+							setUniformBlock(loc, mtx, sizeof(mtx) );
+						}
+					}
+					else if (UniformType::End != type)
+					{
+						setUniformBlock(loc, data, g_uniformTypeSize[type]*num);
+					}
+
+					continue;
+				}
+
 #define CASE_IMPLEMENT_UNIFORM(_uniform, _glsuffix, _dxsuffix, _type) \
 		case UniformType::_uniform: \
 				{ \
@@ -3746,10 +4073,9 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			}
 			else
 			{
-				const GLuint defaultVao = m_vao;
-				if (0 != defaultVao)
+				if (m_vaoSupport)
 				{
-					GL_CHECK(glBindVertexArray(defaultVao) );
+					m_currentVaoCache->bindDefault();
 				}
 
 				GL_CHECK(glDisable(GL_SCISSOR_TEST) );
@@ -3838,6 +4164,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				updateUniform(m_clearQuadColor.idx, mrtClearColor[0], numMrt * sizeof(float) * 4);
 
 				commit(*program.m_constantBuffer);
+				commitUniformBlocks(program);
 
 				GL_CHECK(glDrawArrays(GL_TRIANGLE_STRIP
 					, 0
@@ -3861,7 +4188,17 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		UniformRegistry m_uniformReg;
 		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
 
+		StagingBufferGL m_stagingBuffer[BGFX_CONFIG_MULTITHREADED ? 2 : 1];
+		StreamBufferGL  m_streamBuffer;
+		StreamBufferGL  m_uniformStream;
+		GLuint m_uniformBlockBuffer[2];
+		uint8_t  m_uniformScratch[2][BGFX_GL_UNIFORM_BLOCK_OFFSET_MASK+1];
+		uint32_t m_uniformChanges[2];
+		uint32_t m_uniformBufferOffsetAlign;
+		PixelPackRingGL m_pixelPack;
+
 		TimerQueryGL m_gpuTimer;
+		GpuScopeProfiler<GpuScopeTimerGL> m_gpuScope;
 		OcclusionQueryGL m_occlusionQuery;
 
 		SamplerStateCache m_samplerStateCache;
@@ -3878,7 +4215,9 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		float m_maxAnisotropy;
 		float m_maxAnisotropyDefault;
 		int32_t m_maxMsaa;
-		GLuint m_vao;
+		VaoCacheGL  m_vaoCache;
+		VaoCacheGL* m_currentVaoCache;
+		uint32_t m_vaoEpoch;
 		uint16_t m_maxLabelLen;
 		bool m_blitSupported;
 		bool m_readBackSupported;
@@ -3894,6 +4233,13 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		bool m_occlusionQuerySupport;
 		bool m_atocSupport;
 		bool m_conservativeRasterSupport;
+		bool m_stagingBufferSupport;
+		bool m_syncSupport;
+		bool m_streamBufferSupport;
+		bool m_uniformBlockSupport;
+		bool m_pixelPackSupport;
+		GLuint m_updateTextureUnpack;
+		GLsync m_fence[BGFX_CONFIG_MAX_FENCES];
 		bool m_imageLoadStoreSupport;
 		bool m_flip;
 
@@ -3923,10 +4269,10 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 	RendererContextI* rendererCreate(const Init& _init)
 	{
-		s_renderGL = BX_NEW(g_allocator, RendererContextGL);
+		s_renderGL = BX_NEW(getAllocator(MemoryTag::Renderer), RendererContextGL);
 		if (!s_renderGL->init(_init) )
 		{
-			BX_DELETE(g_allocator, s_renderGL);
+			BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderGL);
 			s_renderGL = NULL;
 		}
 		return s_renderGL;
@@ -3935,7 +4281,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 	void rendererDestroy()
 	{
 		s_renderGL->shutdown();
-		BX_DELETE(g_allocator, s_renderGL);
+		BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderGL);
 		s_renderGL = NULL;
 	}
 
@@ -4184,6 +4530,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			m_constantBuffer = NULL;
 		}
 		m_numPredefined = 0;
+		bx::memSet(m_uniformBlockSize, 0, sizeof(m_uniformBlockSize) );
 
 		if (0 != m_id)
 		{
@@ -4263,6 +4610,39 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				);
 		}
 
+		GLuint uniformBlock[BX_COUNTOF(m_uniformBlockSize)];
+		bx::memSet(uniformBlock, 0xff, sizeof(uniformBlock) );
+		bx::memSet(m_uniformBlockSize, 0, sizeof(m_uniformBlockSize) );
+
+		if (s_renderGL->m_uniformBlockSupport)
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_uniformBlockSize); ++ii)
+			{
+				const GLuint index = glGetUniformBlockIndex(m_id, s_uniformBlockName[ii]);
+				if (GL_INVALID_INDEX != index)
+				{
+					GLint size = 0;
+					GL_CHECK(glGetActiveUniformBlockiv(m_id, index, GL_UNIFORM_BLOCK_DATA_SIZE, &size) );
+
+					if (uint32_t(size) > BGFX_GL_UNIFORM_BLOCK_OFFSET_MASK+1)
+					{
+						BX_WARN(false, "Uniform block %s is too large (%d bytes), it won't be set."
+							, s_uniformBlockName[ii]
+							, size
+							);
+						continue;
+					}
+
+					GL_CHECK(glUniformBlockBinding(m_id, index, ii) );
+					uniformBlock[ii]       = index;
+					m_uniformBlockSize[ii] = uint32_t(size);
+					BX_TRACE("Uniform block %s, binding %d, size %d.", s_uniformBlockName[ii], ii, size);
+				}
+			}
+		}
+
+		const bool uniformBlocks = 0 != (m_uniformBlockSize[0] | m_uniformBlockSize[1]);
+
 		m_numPredefined = 0;
 		m_numSamplers = 0;
 
@@ -4312,6 +4692,43 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				loc = glGetUniformLocation(m_id, name);
 			}
 
+			if (uniformBlocks
+			&&  -1 == loc)
+			{
+				// Block members are declared with instance name, and they
+				// are reported as "<block name>.<member name>". Member used
+				// by both stages is stored once per block.
+				for (uint32_t jj = 0; jj < BX_COUNTOF(s_uniformBlockName); ++jj)
+				{
+					const uint32_t len = bx::strLen(s_uniformBlockName[jj]);
+					if (0 == bx::strCmp(name, s_uniformBlockName[jj], len)
+					&&  '.' == name[len])
+					{
+						bx::memMove(name, &name[len+1], bx::strLen(&name[len+1]) + 1);
+						break;
+					}
+				}
+
+				// Uniform block member doesn't have location, it's addressed by
+				// its offset in block instead.
+				const GLuint index = GLuint(ii);
+				GLint block = -1;
+				GL_CHECK(glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_BLOCK_INDEX, &block) );
+
+				if (-1 != block
+				&& (GLuint(block) == uniformBlock[0] || GLuint(block) == uniformBlock[1]) )
+				{
+					GLint blockOffset = 0;
+					GL_CHECK(glGetActiveUniformsiv(m_id, 1, &index, GL_UNIFORM_OFFSET, &blockOffset) );
+
+					loc = GLint(0
+						| BGFX_GL_UNIFORM_BLOCK_BIT
+						| (GLuint(block) == uniformBlock[1] ? BGFX_GL_UNIFORM_BLOCK_FRAGMENTBIT : 0)
+						| uint32_t(blockOffset)
+						);
+				}
+			}
+
 			num = bx::uint32_max(num, 1);
 
 			int32_t offset = 0;
@@ -4580,6 +4997,73 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		}
 	}
 
+	void VaoCacheGL::create()
+	{
+		GL_CHECK(glGenVertexArrays(1, &m_default) );
+		GL_CHECK(glBindVertexArray(m_default) );
+		m_current = m_default;
+		m_epoch   = s_renderGL->m_vaoEpoch;
+	}
+
+	void VaoCacheGL::destroy()
+	{
+		GL_CHECK(glBindVertexArray(0) );
+		m_current = 0;
+
+		m_cache.invalidate();
+
+		if (0 != m_default)
+		{
+			GL_CHECK(glDeleteVertexArrays(1, &m_default) );
+			m_default = 0;
+		}
+	}
+
+	void VaoCacheGL::bindDefault()
+	{
+		if (m_current != m_default)
+		{
+			m_current = m_default;
+			GL_CHECK(glBindVertexArray(m_default) );
+		}
+	}
+
+	bool VaoCacheGL::bind(uint64_t _key, uint32_t _epoch)
+	{
+		if (m_epoch != _epoch)
+		{
+			// Buffer or program was destroyed, and its handle might be reused
+			// by cached key.
+			bindDefault();
+			m_cache.invalidate();
+			m_epoch = _epoch;
+		}
+
+		VaoGL* vao = m_cache.find(_key);
+		if (NULL != vao)
+		{
+			if (m_current != vao->m_id)
+			{
+				m_current = vao->m_id;
+				GL_CHECK(glBindVertexArray(vao->m_id) );
+			}
+
+			return false;
+		}
+
+		// Evicted VAO might be bound, bind default before adding.
+		bindDefault();
+
+		VaoGL newVao;
+		GL_CHECK(glGenVertexArrays(1, &newVao.m_id) );
+		m_cache.add(_key, newVao, 0);
+
+		m_current = newVao.m_id;
+		GL_CHECK(glBindVertexArray(newVao.m_id) );
+
+		return true;
+	}
+
 	void IndexBufferGL::destroy()
 	{
 		GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
@@ -4592,46 +5076,539 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		GL_CHECK(glDeleteBuffers(1, &m_id) );
 	}
 
-	bool TextureGL::init(GLenum _target, uint32_t _width, uint32_t _height, uint32_t _depth, uint8_t _numMips, uint64_t _flags)
+	void* StagingBufferGL::map(uint32_t _size, bool _persistent)
 	{
-		m_target  = _target;
-		m_numMips = _numMips;
-		m_flags   = _flags;
-		m_width   = _width;
-		m_height  = _height;
-		m_depth   = _depth;
-		m_currentSamplerHash = UINT32_MAX;
-
-		const bool writeOnly    = 0 != (m_flags&BGFX_TEXTURE_RT_WRITE_ONLY);
-		const bool computeWrite = 0 != (m_flags&BGFX_TEXTURE_COMPUTE_WRITE );
-		const bool srgb         = 0 != (m_flags&BGFX_TEXTURE_SRGB);
-		const bool textureArray = false
-			|| _target == GL_TEXTURE_2D_ARRAY
-			|| _target == GL_TEXTURE_CUBE_MAP_ARRAY
-			;
-
-		if (!writeOnly)
+		if (m_size < _size
+		||  m_persistent != _persistent)
 		{
-			GL_CHECK(glGenTextures(1, &m_id) );
-			BX_CHECK(0 != m_id, "Failed to generate texture id.");
-			GL_CHECK(glBindTexture(_target, m_id) );
-			GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
-
-			const TextureFormatInfo& tfi = s_textureFormat[m_textureFormat];
-			m_fmt  = tfi.m_fmt;
-			m_type = tfi.m_type;
+			destroy();
 
-			const bool swizzle = true
-				&& TextureFormat::BGRA8 == m_requestedFormat
-				&& !s_textureFormat[m_requestedFormat].m_supported
-				&& !s_renderGL->m_textureSwizzleSupport
-				;
-			const bool convert = false
-				|| m_textureFormat != m_requestedFormat
-				|| swizzle
-				;
+			GL_CHECK(glGenBuffers(1, &m_id) );
+			BX_CHECK(0 != m_id, "Failed to generate buffer id.");
+			GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
 
-			if (convert)
+			if (_persistent)
+			{
+				const uint32_t size = _size*BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES;
+				const GLbitfield flags = 0
+					| GL_MAP_READ_BIT
+					| GL_MAP_WRITE_BIT
+					| GL_MAP_PERSISTENT_BIT
+					| GL_MAP_COHERENT_BIT
+					;
+
+				GL_CHECK(glBufferStorage(GL_COPY_READ_BUFFER, size, NULL, flags) );
+				GL_CHECK(m_base = (uint8_t*)glMapBufferRange(GL_COPY_READ_BUFFER, 0, size, flags) );
+			}
+			else
+			{
+				GL_CHECK(glBufferData(GL_COPY_READ_BUFFER, _size, NULL, GL_STREAM_DRAW) );
+			}
+
+			GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+
+			if (_persistent
+			&&  NULL == m_base)
+			{
+				BX_TRACE("Failed to map staging buffer.");
+				destroy();
+				return NULL;
+			}
+
+			m_size       = _size;
+			m_idx        = BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES-1;
+			m_persistent = _persistent;
+		}
+
+		if (m_persistent)
+		{
+			// Copies from region used by previous frame are already issued.
+			GLsync& prev = m_fence[m_idx];
+			BX_CHECK(NULL == prev, "Staging buffer region is still fenced.");
+			prev = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+			m_idx = (m_idx + 1) % BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES;
+
+			// Region is reused after BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES
+			// frames, GPU is normally done with it already.
+			GLsync& fence = m_fence[m_idx];
+			if (NULL != fence)
+			{
+				BGFX_PROFILER_SCOPE("bgfx/Wait for staging buffer", kColorResource);
+
+				GLenum result;
+				do
+				{
+					result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000) );
+				}
+				while (GL_TIMEOUT_EXPIRED == result);
+
+				GL_CHECK(glDeleteSync(fence) );
+				fence = NULL;
+			}
+
+			m_offset = m_idx*m_size;
+			m_data   = &m_base[m_offset];
+		}
+		else
+		{
+			// Invalidating whole buffer lets driver orphan storage still in use
+			// by previous copies instead of stalling.
+			GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+			GL_CHECK(m_data = (uint8_t*)glMapBufferRange(GL_COPY_READ_BUFFER
+				, 0
+				, m_size
+				, GL_MAP_WRITE_BIT|GL_MAP_INVALIDATE_BUFFER_BIT
+				) );
+			GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+			m_offset = 0;
+		}
+
+		m_mapped = NULL != m_data;
+		return m_data;
+	}
+
+	void StagingBufferGL::unmap()
+	{
+		if (m_mapped)
+		{
+			if (!m_persistent)
+			{
+				GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+				GL_CHECK(glUnmapBuffer(GL_COPY_READ_BUFFER) );
+				GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+			}
+
+			m_mapped = false;
+		}
+	}
+
+	void StagingBufferGL::copy(GLuint _dst, uint32_t _dstOffset, const void* _data, uint32_t _size) const
+	{
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+		GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, _dst) );
+		GL_CHECK(glCopyBufferSubData(GL_COPY_READ_BUFFER
+			, GL_COPY_WRITE_BUFFER
+			, getOffset(_data)
+			, _dstOffset
+			, _size
+			) );
+		GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, 0) );
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+	}
+
+	void StagingBufferGL::read(void* _dst, const void* _data, uint32_t _size) const
+	{
+		BX_CHECK(!m_mapped, "Staging buffer is still mapped.");
+
+		if (m_persistent)
+		{
+			// Persistent mapping is readable and coherent.
+			bx::memCopy(_dst, _data, _size);
+			return;
+		}
+
+		const void* data;
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+		GL_CHECK(data = glMapBufferRange(GL_COPY_READ_BUFFER
+			, getOffset(_data)
+			, _size
+			, GL_MAP_READ_BIT
+			) );
+
+		if (NULL != data)
+		{
+			bx::memCopy(_dst, data, _size);
+			GL_CHECK(glUnmapBuffer(GL_COPY_READ_BUFFER) );
+		}
+
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+	}
+
+	void StagingBufferGL::destroy()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_fence); ++ii)
+		{
+			if (NULL != m_fence[ii])
+			{
+				GL_CHECK(glDeleteSync(m_fence[ii]) );
+				m_fence[ii] = NULL;
+			}
+		}
+
+		if (0 != m_id)
+		{
+			if (m_mapped
+			||  NULL != m_base)
+			{
+				GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+				GL_CHECK(glUnmapBuffer(GL_COPY_READ_BUFFER) );
+				GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+			}
+
+			GL_CHECK(glDeleteBuffers(1, &m_id) );
+			m_id = 0;
+		}
+
+		m_base   = NULL;
+		m_data   = NULL;
+		m_size   = 0;
+		m_offset = 0;
+		m_mapped = false;
+	}
+
+	bool StreamBufferGL::create(uint32_t _size)
+	{
+		const uint32_t size = _size*BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES;
+		const GLbitfield flags = 0
+			| GL_MAP_WRITE_BIT
+			| GL_MAP_PERSISTENT_BIT
+			| GL_MAP_COHERENT_BIT
+			;
+
+		GL_CHECK(glGenBuffers(1, &m_id) );
+		BX_CHECK(0 != m_id, "Failed to generate buffer id.");
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+		GL_CHECK(glBufferStorage(GL_COPY_READ_BUFFER, size, NULL, flags) );
+		GL_CHECK(m_data = (uint8_t*)glMapBufferRange(GL_COPY_READ_BUFFER, 0, size, flags) );
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+
+		if (NULL == m_data)
+		{
+			BX_TRACE("Failed to map stream buffer, buffers are updated with glBufferSubData.");
+			destroy();
+			return false;
+		}
+
+		m_size = _size;
+		m_pos  = 0;
+		m_idx  = 0;
+		m_wait = false;
+
+		return true;
+	}
+
+	void StreamBufferGL::destroy()
+	{
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_fence); ++ii)
+		{
+			if (NULL != m_fence[ii])
+			{
+				GL_CHECK(glDeleteSync(m_fence[ii]) );
+				m_fence[ii] = NULL;
+			}
+		}
+
+		if (0 != m_id)
+		{
+			if (NULL != m_data)
+			{
+				GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+				GL_CHECK(glUnmapBuffer(GL_COPY_READ_BUFFER) );
+				GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+			}
+
+			GL_CHECK(glDeleteBuffers(1, &m_id) );
+			m_id = 0;
+		}
+
+		m_data = NULL;
+		m_size = 0;
+	}
+
+	uint32_t StreamBufferGL::alloc(const void* _data, uint32_t _size, uint32_t _align)
+	{
+		if (0 == m_id)
+		{
+			return UINT32_MAX;
+		}
+
+		const uint32_t base = m_idx*m_size;
+		const uint32_t pos  = bx::strideAlign(base + m_pos, _align) - base;
+
+		if (pos + _size > m_size)
+		{
+			return UINT32_MAX;
+		}
+
+		if (m_wait)
+		{
+			m_wait = false;
+
+			// Region is reused after BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES
+			// frames, GPU is normally done with it already.
+			GLsync& fence = m_fence[m_idx];
+			if (NULL != fence)
+			{
+				BGFX_PROFILER_SCOPE("bgfx/Wait for stream buffer", kColorResource);
+
+				GLenum result;
+				do
+				{
+					result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000) );
+				}
+				while (GL_TIMEOUT_EXPIRED == result);
+
+				GL_CHECK(glDeleteSync(fence) );
+				fence = NULL;
+			}
+		}
+
+		const uint32_t offset = base + pos;
+		bx::memCopy(&m_data[offset], _data, _size);
+		m_pos = pos + _size;
+
+		return offset;
+	}
+
+	bool StreamBufferGL::copy(GLuint _dst, uint32_t _dstOffset, const void* _data, uint32_t _size)
+	{
+		const uint32_t offset = alloc(_data, _size, 16);
+
+		if (UINT32_MAX == offset)
+		{
+			return false;
+		}
+
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, m_id) );
+		GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, _dst) );
+		GL_CHECK(glCopyBufferSubData(GL_COPY_READ_BUFFER
+			, GL_COPY_WRITE_BUFFER
+			, offset
+			, _dstOffset
+			, _size
+			) );
+		GL_CHECK(glBindBuffer(GL_COPY_WRITE_BUFFER, 0) );
+		GL_CHECK(glBindBuffer(GL_COPY_READ_BUFFER, 0) );
+
+		return true;
+	}
+
+	void StreamBufferGL::end()
+	{
+		if (0 == m_id
+		||  0 == m_pos)
+		{
+			return;
+		}
+
+		BX_CHECK(NULL == m_fence[m_idx], "Stream buffer region is still fenced.");
+		m_fence[m_idx] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+		m_idx  = (m_idx + 1) % BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES;
+		m_pos  = 0;
+		m_wait = true;
+	}
+
+	void PixelPackRingGL::create()
+	{
+		bx::memSet(m_entry, 0, sizeof(m_entry) );
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_entry); ++ii)
+		{
+			GL_CHECK(glGenBuffers(1, &m_entry[ii].m_pbo) );
+		}
+
+		m_read = 0;
+		m_num  = 0;
+	}
+
+	void PixelPackRingGL::destroy()
+	{
+		update(true);
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_entry); ++ii)
+		{
+			if (0 != m_entry[ii].m_pbo)
+			{
+				GL_CHECK(glDeleteBuffers(1, &m_entry[ii].m_pbo) );
+				m_entry[ii].m_pbo = 0;
+			}
+		}
+
+		if (NULL != m_data)
+		{
+			BX_FREE(g_allocator, m_data);
+			m_data = NULL;
+			m_dataSize = 0;
+		}
+	}
+
+	void PixelPackRingGL::read(uint32_t _width, uint32_t _height, GLenum _format, const char* _filePath)
+	{
+		if (BX_COUNTOF(m_entry) == m_num)
+		{
+			complete(true);
+		}
+
+		Entry& entry = m_entry[(m_read + m_num) % BX_COUNTOF(m_entry)];
+
+		const uint32_t size = _width*_height*4;
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, entry.m_pbo) );
+
+		if (entry.m_size != size)
+		{
+			GL_CHECK(glBufferData(GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ) );
+			entry.m_size = size;
+		}
+
+		GL_CHECK(glReadPixels(0
+			, 0
+			, _width
+			, _height
+			, _format
+			, GL_UNSIGNED_BYTE
+			, NULL
+			) );
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+		entry.m_fence  = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		// Fence might be created on swap chain context and waited on from
+		// main context, it must be flushed to become visible there.
+		GL_CHECK(glFlush() );
+		entry.m_width  = _width;
+		entry.m_height = _height;
+		entry.m_format = _format;
+
+		entry.m_filePath = NULL;
+		if (NULL != _filePath)
+		{
+			const int32_t len = bx::strLen(_filePath)+1;
+			entry.m_filePath = (char*)BX_ALLOC(g_allocator, len);
+			bx::strCopy(entry.m_filePath, len, _filePath);
+		}
+
+		++m_num;
+	}
+
+	void PixelPackRingGL::update(bool _wait)
+	{
+		while (0 != m_num
+		&&     complete(_wait) )
+		{
+		}
+	}
+
+	bool PixelPackRingGL::complete(bool _wait)
+	{
+		Entry& entry = m_entry[m_read];
+
+		GLenum result = glClientWaitSync(entry.m_fence, 0, 0);
+		if (GL_TIMEOUT_EXPIRED == result)
+		{
+			if (!_wait)
+			{
+				return false;
+			}
+
+			BGFX_PROFILER_SCOPE("bgfx/Wait for read back", kColorResource);
+
+			do
+			{
+				result = glClientWaitSync(entry.m_fence, GL_SYNC_FLUSH_COMMANDS_BIT, UINT64_C(1000000) );
+			}
+			while (GL_TIMEOUT_EXPIRED == result);
+		}
+
+		GL_CHECK(glDeleteSync(entry.m_fence) );
+		entry.m_fence = NULL;
+
+		const uint32_t pitch = entry.m_width*4;
+		const uint32_t size  = pitch*entry.m_height;
+
+		if (m_dataSize < size)
+		{
+			m_data = (uint8_t*)BX_REALLOC(g_allocator, m_data, size);
+			m_dataSize = size;
+		}
+
+		const void* data;
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, entry.m_pbo) );
+		GL_CHECK(data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT) );
+
+		if (NULL != data)
+		{
+			bx::memCopy(m_data, data, size);
+			GL_CHECK(glUnmapBuffer(GL_PIXEL_PACK_BUFFER) );
+		}
+		else
+		{
+			BX_TRACE("Failed to map pixel pack buffer.");
+			bx::memSet(m_data, 0, size);
+		}
+
+		GL_CHECK(glBindBuffer(GL_PIXEL_PACK_BUFFER, 0) );
+
+		if (GL_RGBA == entry.m_format)
+		{
+			bimg::imageSwizzleBgra8(m_data, pitch, entry.m_width, entry.m_height, m_data, pitch);
+		}
+
+		if (NULL == entry.m_filePath)
+		{
+			g_callback->captureFrame(m_data, size);
+		}
+		else
+		{
+			g_callback->screenShot(entry.m_filePath
+				, entry.m_width
+				, entry.m_height
+				, pitch
+				, m_data
+				, size
+				, true
+				);
+			BX_FREE(g_allocator, entry.m_filePath);
+			entry.m_filePath = NULL;
+		}
+
+		m_read = (m_read + 1) % BX_COUNTOF(m_entry);
+		--m_num;
+
+		return true;
+	}
+
+	bool TextureGL::init(GLenum _target, uint32_t _width, uint32_t _height, uint32_t _depth, uint8_t _numMips, uint64_t _flags)
+	{
+		m_target  = _target;
+		m_numMips = _numMips;
+		m_flags   = _flags;
+		m_width   = _width;
+		m_height  = _height;
+		m_depth   = _depth;
+		m_currentSamplerHash = UINT32_MAX;
+
+		const bool writeOnly    = 0 != (m_flags&BGFX_TEXTURE_RT_WRITE_ONLY);
+		const bool computeWrite = 0 != (m_flags&BGFX_TEXTURE_COMPUTE_WRITE );
+		const bool srgb         = 0 != (m_flags&BGFX_TEXTURE_SRGB);
+		const bool textureArray = false
+			|| _target == GL_TEXTURE_2D_ARRAY
+			|| _target == GL_TEXTURE_CUBE_MAP_ARRAY
+			;
+
+		if (!writeOnly)
+		{
+			GL_CHECK(glGenTextures(1, &m_id) );
+			BX_CHECK(0 != m_id, "Failed to generate texture id.");
+			GL_CHECK(glBindTexture(_target, m_id) );
+			GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
+
+			const TextureFormatInfo& tfi = s_textureFormat[m_textureFormat];
+			m_fmt  = tfi.m_fmt;
+			m_type = tfi.m_type;
+
+			const bool swizzle = true
+				&& TextureFormat::BGRA8 == m_requestedFormat
+				&& !s_textureFormat[m_requestedFormat].m_supported
+				&& !s_renderGL->m_textureSwizzleSupport
+				;
+			const bool convert = false
+				|| m_textureFormat != m_requestedFormat
+				|| swizzle
+				;
+
+			if (convert)
 			{
 				m_textureFormat = (uint8_t)TextureFormat::RGBA8;
 				const TextureFormatInfo& tfiRgba8 = s_textureFormat[TextureFormat::RGBA8];
@@ -5002,9 +5979,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		const uint32_t rectpitch = _rect.m_width*bpp/8;
 		uint32_t srcpitch  = UINT16_MAX == _pitch ? rectpitch : _pitch;
 
-		GL_CHECK(glBindTexture(m_target, m_id) );
-		GL_CHECK(glPixelStorei(GL_UNPACK_ALIGNMENT, 1) );
-
+		// Texture is bound and unpack state is set by updateTextureBegin.
 		GLenum target = isCubeMap()
 			? GL_TEXTURE_CUBE_MAP_POSITIVE_X
 			: m_target
@@ -5025,6 +6000,49 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		const uint32_t width  = _rect.m_width;
 		const uint32_t height = _rect.m_height;
 
+		const uint8_t* memData = _mem->data;
+
+		const StagingBufferGL* staging = s_renderGL->findStagingBuffer(_mem->data);
+
+		uint8_t* cpuCopy = NULL;
+		if (NULL != staging
+		&&  (convert || !unpackRowLength) )
+		{
+			// Data must be processed on CPU, only this path copies it back
+			// from staging buffer.
+			cpuCopy = (uint8_t*)BX_ALLOC(g_allocator, _mem->size);
+			staging->read(cpuCopy, _mem->data, _mem->size);
+			memData = cpuCopy;
+			staging = NULL;
+		}
+
+		GLuint unpack = 0;
+		if (NULL != staging)
+		{
+			// Source texels are read directly from staging buffer.
+			unpack  = staging->m_id;
+			memData = (const uint8_t*)staging->getOffset(_mem->data);
+		}
+		else if (!convert
+			 &&  unpackRowLength)
+		{
+			// Texture updates of the frame are packed into stream ring, and
+			// uploaded from it as pixel unpack buffer.
+			const uint32_t offset = s_renderGL->m_streamBuffer.alloc(_mem->data, _mem->size, 16);
+			if (UINT32_MAX != offset)
+			{
+				unpack  = s_renderGL->m_streamBuffer.m_id;
+				memData = (const uint8_t*)uintptr_t(offset);
+			}
+		}
+
+		// Update group binds each unpack buffer only once.
+		if (unpack != s_renderGL->m_updateTextureUnpack)
+		{
+			GL_CHECK(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, unpack) );
+			s_renderGL->m_updateTextureUnpack = unpack;
+		}
+
 		uint8_t* temp = NULL;
 		if (convert
 		||  !unpackRowLength)
@@ -5038,7 +6056,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		if (compressed)
 		{
-			const uint8_t* data = _mem->data;
+			const uint8_t* data = memData;
 
 			if (!unpackRowLength)
 			{
@@ -5061,7 +6079,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		}
 		else
 		{
-			const uint8_t* data = _mem->data;
+			const uint8_t* data = memData;
 
 			if (convert)
 			{
@@ -5092,15 +6110,14 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				) );
 		}
 
-		if (!convert
-		&&  unpackRowLength)
+		if (NULL != temp)
 		{
-			GL_CHECK(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0) );
+			BX_FREE(g_allocator, temp);
 		}
 
-		if (NULL != temp)
+		if (NULL != cpuCopy)
 		{
-			BX_FREE(g_allocator, temp);
+			BX_FREE(g_allocator, cpuCopy);
 		}
 	}
 
@@ -5537,6 +6554,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					const bool usesTextureMS    = !bx::findIdentifierMatch(code, s_ARB_texture_multisample).isEmpty();
 					const bool usesPacking      = !bx::findIdentifierMatch(code, s_ARB_shading_language_packing).isEmpty();
 					const bool usesInterpQ      = !bx::findIdentifierMatch(code, s_intepolationQualifier).isEmpty();
+					const bool usesUniformBlock = !bx::strFind(code, "layout(std140) uniform bgfx_").isEmpty();
 
 					uint32_t version = BX_ENABLED(BX_PLATFORM_OSX) ? 120
 						:  usesTextureArray
@@ -5555,6 +6573,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 						bx::write(&writer, &err, "#version %d\n", version);
 					}
 
+					if (usesUniformBlock)
+					{
+						bx::write(&writer, "#extension GL_ARB_uniform_buffer_object : enable\n");
+					}
+
 					if (usesTextureLod)
 					{
 						if (m_type == GL_FRAGMENT_SHADER)
@@ -6094,6 +7117,17 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			m_num = 0;
 		}
 
+		if (NULL != m_vaoCache)
+		{
+			s_renderGL->m_glctx.makeCurrent(m_swapChain);
+			m_vaoCache->destroy();
+			BX_DELETE(getAllocator(MemoryTag::Renderer), m_vaoCache);
+			m_vaoCache = NULL;
+
+			s_renderGL->m_glctx.makeCurrent(NULL);
+			s_renderGL->m_currentVaoCache = &s_renderGL->m_vaoCache;
+		}
+
 		if (NULL != m_swapChain)
 		{
 			s_renderGL->m_glctx.destroySwapChain(m_swapChain);
@@ -6357,21 +7391,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		BGFX_GL_PROFILER_BEGIN_LITERAL("rendererSubmit", kColorView);
 
-		if (1 < m_numWindows
-		&&  m_vaoSupport)
-		{
-			m_vaoSupport = false;
-			GL_CHECK(glBindVertexArray(0) );
-			GL_CHECK(glDeleteVertexArrays(1, &m_vao) );
-			m_vao = 0;
-		}
-
 		m_glctx.makeCurrent(NULL);
+		m_currentVaoCache = &m_vaoCache;
 
-		const GLuint defaultVao = m_vao;
-		if (0 != defaultVao)
+		if (m_vaoSupport)
 		{
-			GL_CHECK(glBindVertexArray(defaultVao) );
+			m_vaoCache.bindDefault();
 		}
 
 		GL_CHECK(glBindFramebuffer(GL_FRAMEBUFFER, m_backBufferFbo) );
@@ -6390,18 +7415,30 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			frameQueryIdx = m_gpuTimer.begin(BGFX_CONFIG_MAX_VIEWS);
 		}
 
+		m_gpuScope.start(_render
+			, m_timerQuerySupport && !BX_ENABLED(BX_PLATFORM_OSX)
+			);
+
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
 			TransientIndexBuffer* ib = _render->m_transientIb;
-			m_indexBuffers[ib->handle.idx].update(0, _render->m_iboffset, ib->data, true);
+			IndexBufferGL& buffer = m_indexBuffers[ib->handle.idx];
+			if (!m_streamBuffer.copy(buffer.m_id, 0, ib->data, _render->m_iboffset) )
+			{
+				buffer.update(0, _render->m_iboffset, ib->data, true);
+			}
 		}
 
 		if (0 < _render->m_vboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
 			TransientVertexBuffer* vb = _render->m_transientVb;
-			m_vertexBuffers[vb->handle.idx].update(0, _render->m_vboffset, vb->data, true);
+			VertexBufferGL& buffer = m_vertexBuffers[vb->handle.idx];
+			if (!m_streamBuffer.copy(buffer.m_id, 0, vb->data, _render->m_vboffset) )
+			{
+				buffer.update(0, _render->m_vboffset, vb->data, true);
+			}
 		}
 
 		_render->sort();
@@ -6419,11 +7456,14 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 		ProgramHandle currentProgram = BGFX_INVALID_HANDLE;
 		ProgramHandle boundProgram   = BGFX_INVALID_HANDLE;
+		const VertexBufferHandle transientVb = _render->m_transientVb->handle;
 		SortKey key;
 		uint16_t view = UINT16_MAX;
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
 
 		BlitState bs(_render);
+		ProgramProfiler programProfiler(_render);
+		StateCounter stateCounter(_render);
 
 		int32_t resolutionHeight = _render->m_resolution.height;
 		uint32_t blendFactor = 0;
@@ -6497,6 +7537,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 				if (viewChanged)
 				{
+					programProfiler.end();
+
 					view = key.m_view;
 					currentProgram = BGFX_INVALID_HANDLE;
 
@@ -6547,6 +7589,8 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					submitBlit(bs, view);
 				}
 
+				programProfiler.begin(key.m_program, renderItem, isCompute);
+
 				if (isCompute)
 				{
 					if (!wasCompute)
@@ -6564,6 +7608,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 						ProgramGL& program = m_program[key.m_program.idx];
 						GL_CHECK(glUseProgram(program.m_id) );
+						stateCounter.programChange();
 
 						GLbitfield barrier = 0;
 						for (uint32_t ii = 0; ii < maxComputeBindings; ++ii)
@@ -6623,9 +7668,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							&&  NULL != program.m_constantBuffer)
 							{
 								commit(*program.m_constantBuffer);
+								stateCounter.uniformUpload();
 							}
 
 							viewState.setPredefined<1>(this, view, program, _render, compute);
+							commitUniformBlocks(program);
 
 							if (isValid(compute.m_indirectBuffer) )
 							{
@@ -6709,6 +7756,13 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				uint64_t changedStencil = currentState.m_stencil ^ draw.m_stencil;
 				currentState.m_stencil = newStencil;
 
+				if (0 != changedFlags
+				||  0 != changedStencil)
+				{
+					programProfiler.stateChange();
+					stateCounter.stateChange(changedFlags, changedStencil);
+				}
+
 				if (resetState)
 				{
 					currentState.clear();
@@ -7052,6 +8106,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					currentProgram = 0 == id ? ProgramHandle{kInvalidHandle} : currentProgram;
 
 					GL_CHECK(glUseProgram(id) );
+					stateCounter.programChange();
 					programChanged =
 						constantsChanged =
 						bindAttribs = true;
@@ -7065,9 +8120,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 					&&  NULL != program.m_constantBuffer)
 					{
 						commit(*program.m_constantBuffer);
+						stateCounter.uniformUpload();
 					}
 
 					viewState.setPredefined<1>(this, view, program, _render, draw);
+					commitUniformBlocks(program);
 
 					{
 						for (uint32_t stage = 0; stage < BGFX_CONFIG_MAX_TEXTURE_SAMPLERS; ++stage)
@@ -7105,6 +8162,9 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 										break;
 									}
 								}
+
+								programProfiler.textureBind();
+								stateCounter.textureBind();
 							}
 
 							current = bind;
@@ -7156,25 +8216,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							bindAttribs = true;
 						}
 
-						if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
-						{
-							currentState.m_indexBuffer = draw.m_indexBuffer;
-
-							uint16_t handle = draw.m_indexBuffer.idx;
-							if (kInvalidHandle != handle)
-							{
-								IndexBufferGL& ib = m_indexBuffers[handle];
-								GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib.m_id) );
-							}
-							else
-							{
-								GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
-							}
-						}
+						bool bindIndexBuffer = currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx;
+						currentState.m_indexBuffer = draw.m_indexBuffer;
 
 						if (0 != currentState.m_streamMask)
 						{
-							bool diffStartVertex = false;
 							for (uint32_t idx = 0, streamMask = draw.m_streamMask
 								; 0 != streamMask
 								; streamMask >>= 1, idx += 1
@@ -7186,53 +8232,149 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 								if (currentState.m_stream[idx].m_startVertex != draw.m_stream[idx].m_startVertex)
 								{
-									diffStartVertex = true;
+									bindAttribs = true;
 									break;
 								}
 							}
+						}
+
+						// Transient buffers and start vertex offsets change from draw
+						// to draw, caching VAOs for them would only thrash cache.
+						bool cacheVao = m_vaoSupport
+							&& (bindAttribs || bindIndexBuffer)
+							&& (!isValid(draw.m_instanceDataBuffer) || draw.m_instanceDataBuffer.idx != transientVb.idx)
+							;
+
+						for (uint32_t idx = 0, streamMask = cacheVao ? draw.m_streamMask : 0
+							; 0 != streamMask
+							; streamMask >>= 1, idx += 1
+							)
+						{
+							const uint32_t ntz = bx::uint32_cnttz(streamMask);
+							streamMask >>= ntz;
+							idx         += ntz;
+
+							cacheVao &= 0 == draw.m_stream[idx].m_startVertex
+								&& draw.m_stream[idx].m_handle.idx != transientVb.idx
+								;
+						}
+
+						if (cacheVao)
+						{
+							// Index buffer binding is part of VAO state.
+							bx::HashMurmur2A murmur;
+							murmur.begin();
+							murmur.add(currentProgram.idx);
+							murmur.add(draw.m_streamMask);
 
-							if (bindAttribs || diffStartVertex)
+							if (UINT8_MAX != draw.m_streamMask)
 							{
-								if (isValid(boundProgram) )
+								for (uint32_t idx = 0, streamMask = draw.m_streamMask
+									; 0 != streamMask
+									; streamMask >>= 1, idx += 1
+									)
 								{
-									m_program[boundProgram.idx].unbindAttributes();
-									boundProgram = BGFX_INVALID_HANDLE;
+									const uint32_t ntz = bx::uint32_cnttz(streamMask);
+									streamMask >>= ntz;
+									idx         += ntz;
+
+									currentState.m_stream[idx].m_startVertex = draw.m_stream[idx].m_startVertex;
+
+									murmur.add(draw.m_stream[idx].m_handle.idx);
+									murmur.add(draw.m_stream[idx].m_decl.idx);
 								}
+							}
 
-								boundProgram = currentProgram;
+							murmur.add(draw.m_instanceDataBuffer.idx);
+							if (isValid(draw.m_instanceDataBuffer) )
+							{
+								murmur.add(draw.m_instanceDataOffset);
+								murmur.add(draw.m_instanceDataStride);
+							}
 
-								program.bindAttributesBegin();
+							murmur.add(draw.m_indexBuffer.idx);
 
-								if (UINT8_MAX != draw.m_streamMask)
-								{
-									for (uint32_t idx = 0, streamMask = draw.m_streamMask
-										; 0 != streamMask
-										; streamMask >>= 1, idx += 1
-										)
-									{
-										const uint32_t ntz = bx::uint32_cnttz(streamMask);
-										streamMask >>= ntz;
-										idx         += ntz;
-
-										currentState.m_stream[idx].m_startVertex = draw.m_stream[idx].m_startVertex;
-
-										const VertexBufferGL& vb = m_vertexBuffers[draw.m_stream[idx].m_handle.idx];
-										const uint16_t decl = isValid(draw.m_stream[idx].m_decl)
-											? draw.m_stream[idx].m_decl.idx
-											: vb.m_decl.idx;
-										GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, vb.m_id) );
-										program.bindAttributes(m_vertexDecls[decl], draw.m_stream[idx].m_startVertex);
-									}
-								}
+							const bool created = m_currentVaoCache->bind(murmur.end(), m_vaoEpoch);
+							stateCounter.bindCache(!created);
+
+							bindAttribs     = created;
+							bindIndexBuffer = created;
+						}
+						else if (m_vaoSupport
+						&&  (bindAttribs || bindIndexBuffer)
+						&&  !m_currentVaoCache->isDefault() )
+						{
+							// Default VAO holds state of last uncached draw.
+							m_currentVaoCache->bindDefault();
+							bindAttribs     = true;
+							bindIndexBuffer = true;
+						}
+
+						const bool cachedVao = m_vaoSupport && !m_currentVaoCache->isDefault();
+
+						if (bindIndexBuffer)
+						{
+							uint16_t handle = draw.m_indexBuffer.idx;
+							if (kInvalidHandle != handle)
+							{
+								IndexBufferGL& ib = m_indexBuffers[handle];
+								GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ib.m_id) );
+							}
+							else
+							{
+								GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0) );
+							}
+
+							stateCounter.indexBufferBind();
+						}
+
+						if (0 != currentState.m_streamMask
+						&&  bindAttribs)
+						{
+							// Newly created VAO has all attributes disabled, default one
+							// still has attributes of previous uncached draw enabled.
+							if (isValid(boundProgram)
+							&&  !cachedVao)
+							{
+								m_program[boundProgram.idx].unbindAttributes();
+								boundProgram = BGFX_INVALID_HANDLE;
+							}
 
-								program.bindAttributesEnd();
+							boundProgram = cachedVao ? boundProgram : currentProgram;
 
-								if (isValid(draw.m_instanceDataBuffer) )
+							program.bindAttributesBegin();
+
+							if (UINT8_MAX != draw.m_streamMask)
+							{
+								for (uint32_t idx = 0, streamMask = draw.m_streamMask
+									; 0 != streamMask
+									; streamMask >>= 1, idx += 1
+									)
 								{
-									GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffers[draw.m_instanceDataBuffer.idx].m_id) );
-									program.bindInstanceData(draw.m_instanceDataStride, draw.m_instanceDataOffset);
+									const uint32_t ntz = bx::uint32_cnttz(streamMask);
+									streamMask >>= ntz;
+									idx         += ntz;
+
+									currentState.m_stream[idx].m_startVertex = draw.m_stream[idx].m_startVertex;
+
+									const VertexBufferGL& vb = m_vertexBuffers[draw.m_stream[idx].m_handle.idx];
+									const uint16_t decl = isValid(draw.m_stream[idx].m_decl)
+										? draw.m_stream[idx].m_decl.idx
+										: vb.m_decl.idx;
+									GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, vb.m_id) );
+									program.bindAttributes(m_vertexDecls[decl], draw.m_stream[idx].m_startVertex);
+									stateCounter.vertexBufferBind();
 								}
 							}
+
+							program.bindAttributesEnd();
+
+							if (isValid(draw.m_instanceDataBuffer) )
+							{
+								GL_CHECK(glBindBuffer(GL_ARRAY_BUFFER, m_vertexBuffers[draw.m_instanceDataBuffer.idx].m_id) );
+								program.bindInstanceData(draw.m_instanceDataStride, draw.m_instanceDataOffset);
+								stateCounter.vertexBufferBind();
+							}
 						}
 					}
 
@@ -7380,7 +8522,10 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 							m_occlusionQuery.end();
 						}
 
-						if(isValid(draw.m_instanceDataBuffer))
+						// Instance data attributes are part of cached VAO state, only
+						// on default VAO they would leak into following draws.
+						if (isValid(draw.m_instanceDataBuffer)
+						&&  (!m_vaoSupport || m_currentVaoCache->isDefault() ) )
 						{
 							program.unbindInstanceData();
 						}
@@ -7395,6 +8540,12 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 
 			if (isValid(boundProgram) )
 			{
+				if (m_vaoSupport)
+				{
+					// Attributes left enabled belong to default VAO.
+					m_currentVaoCache->bindDefault();
+				}
+
 				m_program[boundProgram.idx].unbindAttributes();
 				boundProgram = BGFX_INVALID_HANDLE;
 			}
@@ -7406,13 +8557,15 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				BGFX_GL_PROFILER_BEGIN(view, kColorCompute);
 			}
 
+			programProfiler.end();
+
 			submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
 
 			blitMsaaFbo();
 
 			if (m_vaoSupport)
 			{
-				GL_CHECK(glBindVertexArray(m_vao) );
+				m_currentVaoCache->bindDefault();
 			}
 
 			if (0 < _render->m_numRenderItems)
@@ -7433,6 +8586,19 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 		BGFX_GL_PROFILER_END();
 
 		m_glctx.makeCurrent(NULL);
+		m_currentVaoCache = &m_vaoCache;
+
+		// Buffer updates between frames change index buffer binding of bound
+		// VAO, keep it away from cached ones.
+		if (m_vaoSupport)
+		{
+			m_vaoCache.bindDefault();
+		}
+
+		m_streamBuffer.end();
+		m_uniformStream.end();
+		m_pixelPack.update(false);
+
 		int64_t timeEnd = bx::getHPCounter();
 		int64_t frameTime = timeEnd - timeBegin;
 
@@ -7457,6 +8623,11 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 			maxGpuLatency = bx::uint32_imax(maxGpuLatency, result.m_pending-1);
 		}
 
+		if (m_timerQuerySupport)
+		{
+			m_gpuScope.finish(_render);
+		}
+
 		const int64_t timerFreq = bx::getHPFrequency();
 
 		Stats& perfStats = _render->m_perfStats;
@@ -7554,6 +8725,9 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
 				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
 
+				pos++;
+				pos = dbgTextFrameTiming(tvm, 10, pos, _render);
+
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " State cache:     ");
 				tvm.printf(10, pos++, 0x8b, " Sampler ");
@@ -7641,6 +8815,7 @@ BX_TRACE("%d, %d, %d, %s", _array, _srgb, _mipAutogen, getName(_format) );
 				uint8_t attrIndex = _render->m_waitSubmit < _render->m_waitRender;
 				tvm.printf(10, pos++, attr[attrIndex&1], " Submit wait: %7.4f [ms] ", double(_render->m_waitSubmit)*toMs);
 				tvm.printf(10, pos++, attr[(attrIndex+1)&1], " Render wait: %7.4f [ms] ", double(_render->m_waitRender)*toMs);
+				tvm.printf(10, pos++, 0x8b, " Pacing wait: %7.4f [ms] ", _render->m_framePacing*toMs);
 
 				min = frameTime;
 				max = frameTime;
@@ -48,6 +48,13 @@
 		GL_CHECK(glPopDebugGroup() ); \
 	BX_MACRO_BLOCK_END
 
+// Uniform location of uniform block member. Location is byte offset into
+// vertex or fragment uniform block, marked so it can't be mistaken for GL
+// uniform location.
+#define BGFX_GL_UNIFORM_BLOCK_BIT         UINT32_C(0x40000000)
+#define BGFX_GL_UNIFORM_BLOCK_FRAGMENTBIT UINT32_C(0x20000000)
+#define BGFX_GL_UNIFORM_BLOCK_OFFSET_MASK UINT32_C(0x0000ffff)
+
 #if BGFX_CONFIG_RENDERER_OPENGL
 #	if BGFX_CONFIG_RENDERER_OPENGL >= 31
 #		include <gl/glcorearb.h>
@@ -1013,6 +1020,94 @@ typedef uint64_t GLuint64;
 #	define GL_DISPATCH_INDIRECT_BUFFER 0x90EE
 #endif // GL_DISPATCH_INDIRECT_BUFFER
 
+#ifndef GL_PIXEL_UNPACK_BUFFER
+#	define GL_PIXEL_UNPACK_BUFFER 0x88EC
+#endif // GL_PIXEL_UNPACK_BUFFER
+
+#ifndef GL_COPY_READ_BUFFER
+#	define GL_COPY_READ_BUFFER 0x8F36
+#endif // GL_COPY_READ_BUFFER
+
+#ifndef GL_COPY_WRITE_BUFFER
+#	define GL_COPY_WRITE_BUFFER 0x8F37
+#endif // GL_COPY_WRITE_BUFFER
+
+#ifndef GL_PIXEL_PACK_BUFFER
+#	define GL_PIXEL_PACK_BUFFER 0x88EB
+#endif // GL_PIXEL_PACK_BUFFER
+
+#ifndef GL_STREAM_READ
+#	define GL_STREAM_READ 0x88E1
+#endif // GL_STREAM_READ
+
+#ifndef GL_MAP_READ_BIT
+#	define GL_MAP_READ_BIT 0x0001
+#endif // GL_MAP_READ_BIT
+
+#ifndef GL_MAP_WRITE_BIT
+#	define GL_MAP_WRITE_BIT 0x0002
+#endif // GL_MAP_WRITE_BIT
+
+#ifndef GL_MAP_INVALIDATE_BUFFER_BIT
+#	define GL_MAP_INVALIDATE_BUFFER_BIT 0x0008
+#endif // GL_MAP_INVALIDATE_BUFFER_BIT
+
+#ifndef GL_SYNC_GPU_COMMANDS_COMPLETE
+#	define GL_SYNC_GPU_COMMANDS_COMPLETE 0x9117
+#endif // GL_SYNC_GPU_COMMANDS_COMPLETE
+
+#ifndef GL_ALREADY_SIGNALED
+#	define GL_ALREADY_SIGNALED 0x911A
+#endif // GL_ALREADY_SIGNALED
+
+#ifndef GL_CONDITION_SATISFIED
+#	define GL_CONDITION_SATISFIED 0x911C
+#endif // GL_CONDITION_SATISFIED
+
+#ifndef GL_TIMEOUT_EXPIRED
+#	define GL_TIMEOUT_EXPIRED 0x911B
+#endif // GL_TIMEOUT_EXPIRED
+
+#ifndef GL_SYNC_FLUSH_COMMANDS_BIT
+#	define GL_SYNC_FLUSH_COMMANDS_BIT 0x00000001
+#endif // GL_SYNC_FLUSH_COMMANDS_BIT
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#	define GL_MAP_PERSISTENT_BIT 0x0040
+#endif // GL_MAP_PERSISTENT_BIT
+
+#ifndef GL_MAP_COHERENT_BIT
+#	define GL_MAP_COHERENT_BIT 0x0080
+#endif // GL_MAP_COHERENT_BIT
+
+#ifndef GL_UNIFORM_BUFFER
+#	define GL_UNIFORM_BUFFER 0x8A11
+#endif // GL_UNIFORM_BUFFER
+
+#ifndef GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+#	define GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT 0x8A34
+#endif // GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT
+
+#ifndef GL_MAX_UNIFORM_BLOCK_SIZE
+#	define GL_MAX_UNIFORM_BLOCK_SIZE 0x8A30
+#endif // GL_MAX_UNIFORM_BLOCK_SIZE
+
+#ifndef GL_UNIFORM_BLOCK_INDEX
+#	define GL_UNIFORM_BLOCK_INDEX 0x8A3A
+#endif // GL_UNIFORM_BLOCK_INDEX
+
+#ifndef GL_UNIFORM_OFFSET
+#	define GL_UNIFORM_OFFSET 0x8A3B
+#endif // GL_UNIFORM_OFFSET
+
+#ifndef GL_UNIFORM_BLOCK_DATA_SIZE
+#	define GL_UNIFORM_BLOCK_DATA_SIZE 0x8A40
+#endif // GL_UNIFORM_BLOCK_DATA_SIZE
+
+#ifndef GL_INVALID_INDEX
+#	define GL_INVALID_INDEX 0xFFFFFFFFu
+#endif // GL_INVALID_INDEX
+
 #ifndef GL_MAX_NAME_LENGTH
 #	define GL_MAX_NAME_LENGTH 0x92F6
 #endif // GL_MAX_NAME_LENGTH
@@ -1178,14 +1273,15 @@ namespace bgfx { namespace gl
 		{
 			BX_CHECK(0 != m_id, "Updating invalid index buffer.");
 
+			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
+
 			if (_discard)
 			{
-				// orphan buffer...
-				destroy();
-				create(m_size, NULL, m_flags);
+				// Orphan buffer storage, but keep buffer object, since it
+				// might be referenced by cached vertex array objects.
+				GL_CHECK(glBufferData(GL_ELEMENT_ARRAY_BUFFER, m_size, NULL, GL_DYNAMIC_DRAW) );
 			}
 
-			GL_CHECK(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_id) );
 			GL_CHECK(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER
 				, _offset
 				, _size
@@ -1226,14 +1322,15 @@ namespace bgfx { namespace gl
 		{
 			BX_CHECK(0 != m_id, "Updating invalid vertex buffer.");
 
+			GL_CHECK(glBindBuffer(m_target, m_id) );
+
 			if (_discard)
 			{
-				// orphan buffer...
-				destroy();
-				create(m_size, NULL, m_decl, 0);
+				// Orphan buffer storage, but keep buffer object, since it
+				// might be referenced by cached vertex array objects.
+				GL_CHECK(glBufferData(m_target, m_size, NULL, GL_DYNAMIC_DRAW) );
 			}
 
-			GL_CHECK(glBindBuffer(m_target, m_id) );
 			GL_CHECK(glBufferSubData(m_target
 				, _offset
 				, _size
@@ -1250,6 +1347,145 @@ namespace bgfx { namespace gl
 		VertexDeclHandle m_decl;
 	};
 
+	/// Staging area application writes into directly. When buffer storage
+	/// is available it's persistently mapped and split into one region per
+	/// frame in flight, otherwise whole buffer is invalidated on each map.
+	struct StagingBufferGL
+	{
+		StagingBufferGL()
+			: m_id(0)
+			, m_base(NULL)
+			, m_data(NULL)
+			, m_size(0)
+			, m_offset(0)
+			, m_idx(0)
+			, m_persistent(false)
+			, m_mapped(false)
+		{
+			bx::memSet(m_fence, 0, sizeof(m_fence) );
+		}
+
+		void* map(uint32_t _size, bool _persistent);
+		void unmap();
+		void copy(GLuint _dst, uint32_t _dstOffset, const void* _data, uint32_t _size) const;
+
+		/// Copies data back into CPU memory, used only by paths that must
+		/// process data on CPU.
+		void read(void* _dst, const void* _data, uint32_t _size) const;
+		void destroy();
+
+		bool contains(const void* _ptr) const
+		{
+			const uint8_t* ptr = (const uint8_t*)_ptr;
+			return ptr >= m_data
+				&& ptr <  m_data + m_size
+				;
+		}
+
+		GLintptr getOffset(const void* _ptr) const
+		{
+			return GLintptr(m_offset + ( (const uint8_t*)_ptr - m_data) );
+		}
+
+		GLuint   m_id;
+		uint8_t* m_base;
+		uint8_t* m_data;
+		GLsync   m_fence[BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES];
+		uint32_t m_size;
+		uint32_t m_offset;
+		uint32_t m_idx;
+		bool     m_persistent;
+		bool     m_mapped;
+	};
+
+	/// Persistently mapped upload ring, split into one region per frame in
+	/// flight. Data is written directly into mapped memory and copied into
+	/// destination buffer on GPU, so updating buffer still in use by GPU
+	/// doesn't stall in driver.
+	struct StreamBufferGL
+	{
+		StreamBufferGL()
+			: m_id(0)
+			, m_data(NULL)
+			, m_size(0)
+			, m_pos(0)
+			, m_idx(0)
+			, m_wait(false)
+		{
+			bx::memSet(m_fence, 0, sizeof(m_fence) );
+		}
+
+		bool create(uint32_t _size);
+		void destroy();
+
+		/// Writes data into current frame region, and returns its offset in
+		/// stream buffer. Returns UINT32_MAX when ring is not available or
+		/// current frame region is full.
+		uint32_t alloc(const void* _data, uint32_t _size, uint32_t _align);
+
+		/// Copies data into `_dst` buffer. Returns false when ring is not
+		/// available or current frame region is full.
+		bool copy(GLuint _dst, uint32_t _dstOffset, const void* _data, uint32_t _size);
+
+		/// Fences current frame region and moves to next one.
+		void end();
+
+		GLuint   m_id;
+		uint8_t* m_data;
+		GLsync   m_fence[BGFX_CONFIG_RENDERER_OPENGL_STREAM_FRAMES];
+		uint32_t m_size;
+		uint32_t m_pos;
+		uint32_t m_idx;
+		bool     m_wait;
+	};
+
+	/// Ring of pixel pack buffers used to read back screen shots and
+	/// captured frames without stalling. Each read back is fenced, and its
+	/// result is delivered to callback once GPU is done with it.
+	struct PixelPackRingGL
+	{
+		PixelPackRingGL()
+			: m_data(NULL)
+			, m_dataSize(0)
+			, m_read(0)
+			, m_num(0)
+		{
+			bx::memSet(m_entry, 0, sizeof(m_entry) );
+		}
+
+		void create();
+		void destroy();
+
+		/// Reads back pixels of currently bound frame buffer. `_filePath` is
+		/// NULL for captured frames.
+		void read(uint32_t _width, uint32_t _height, GLenum _format, const char* _filePath);
+
+		/// Delivers finished read backs, in order they were issued. When
+		/// `_wait` is true, waits for all pending read backs.
+		void update(bool _wait);
+
+		/// Delivers oldest pending read back. Returns false when it's not
+		/// finished yet and `_wait` is false.
+		bool complete(bool _wait);
+
+		struct Entry
+		{
+			GLuint   m_pbo;
+			GLsync   m_fence;
+			char*    m_filePath;
+			uint32_t m_size;
+			uint32_t m_width;
+			uint32_t m_height;
+			GLenum   m_format;
+		};
+
+		Entry    m_entry[BGFX_CONFIG_RENDERER_OPENGL_PIXEL_PACK_BUFFERS];
+		uint8_t* m_data;
+		uint32_t m_dataSize;
+		uint32_t m_read;
+		uint32_t m_num;
+	};
+
 	struct TextureGL
 	{
 		TextureGL()
@@ -1314,10 +1550,59 @@ namespace bgfx { namespace gl
 		uint32_t m_hash;
 	};
 
+	struct VaoGL
+	{
+		GLuint m_id;
+	};
+
+	inline void release(VaoGL _vao)
+	{
+		GL_CHECK(glDeleteVertexArrays(1, &_vao.m_id) );
+	}
+
+	/// Vertex array objects of single GL context. VAOs are container objects
+	/// and can't be shared between contexts, each context has its own cache.
+	class VaoCacheGL
+	{
+	public:
+		VaoCacheGL()
+			: m_default(0)
+			, m_current(0)
+			, m_epoch(0)
+		{
+		}
+
+		/// Context owning cache must be current.
+		void create();
+		void destroy();
+
+		/// Binds VAO used when vertex attributes are specified every time.
+		void bindDefault();
+
+		/// Returns true when VAO used for uncached draws is bound.
+		bool isDefault() const
+		{
+			return m_current == m_default;
+		}
+
+		/// Binds cached VAO for vertex stream configuration `_key`. Returns
+		/// true when VAO is newly created and vertex attributes must be
+		/// specified. When `_epoch` differs from one cache was used with, all
+		/// cached VAOs are released first.
+		bool bind(uint64_t _key, uint32_t _epoch);
+
+	private:
+		StateCacheLru<VaoGL, BGFX_CONFIG_RENDERER_OPENGL_VAO_CACHE_SIZE> m_cache;
+		GLuint   m_default;
+		GLuint   m_current;
+		uint32_t m_epoch;
+	};
+
 	struct FrameBufferGL
 	{
 		FrameBufferGL()
 			: m_swapChain(NULL)
+			, m_vaoCache(NULL)
 			, m_denseIdx(UINT16_MAX)
 			, m_num(0)
 			, m_needPresent(false)
@@ -1334,6 +1619,7 @@ namespace bgfx { namespace gl
 		void set();
 
 		SwapChainGL* m_swapChain;
+		VaoCacheGL*  m_vaoCache;
 		GLuint m_fbo[2];
 		uint32_t m_width;
 		uint32_t m_height;
@@ -1351,6 +1637,7 @@ namespace bgfx { namespace gl
 			, m_constantBuffer(NULL)
 			, m_numPredefined(0)
 		{
+			bx::memSet(m_uniformBlockSize, 0, sizeof(m_uniformBlockSize) );
 		}
 
 		void create(const ShaderGL& _vsh, const ShaderGL& _fsh);
@@ -1393,8 +1680,10 @@ namespace bgfx { namespace gl
 		uint8_t m_numSamplers;
 
 		UniformBuffer* m_constantBuffer;
-		PredefinedUniform m_predefined[PredefinedUniform::Count];
+		PredefinedUniform m_predefined[PredefinedUniform::Count*2]; // Uniform used by both stages has entry per block.
 		uint8_t m_numPredefined;
+
+		uint32_t m_uniformBlockSize[2]; // Vertex and fragment uniform block size, 0 when not used.
 	};
 
 	struct TimerQueryGL
@@ -1538,6 +1827,53 @@ namespace bgfx { namespace gl
 		bx::RingBufferControl m_control;
 	};
 
+	struct GpuScopeTimerGL
+	{
+		void create()
+		{
+			GL_CHECK(glGenQueries(BX_COUNTOF(m_query), m_query) );
+		}
+
+		void destroy()
+		{
+			GL_CHECK(glDeleteQueries(BX_COUNTOF(m_query), m_query) );
+		}
+
+		void timestamp(uint32_t _idx)
+		{
+			GL_CHECK(glQueryCounter(m_query[_idx]
+				, GL_TIMESTAMP
+				) );
+		}
+
+		bool result(uint32_t _idx, uint64_t& _time)
+		{
+			GLint available;
+			GL_CHECK(glGetQueryObjectiv(m_query[_idx]
+				, GL_QUERY_RESULT_AVAILABLE
+				, &available
+				) );
+
+			if (available)
+			{
+				GL_CHECK(glGetQueryObjectui64v(m_query[_idx]
+					, GL_QUERY_RESULT
+					, &_time
+					) );
+
+				return true;
+			}
+
+			return false;
+		}
+
+		void release(uint32_t /*_idx*/)
+		{
+		}
+
+		GLuint m_query[kGpuScopeQueries];
+	};
+
 	struct OcclusionQueryGL
 	{
 		OcclusionQueryGL()
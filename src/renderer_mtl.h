@@ -800,7 +800,7 @@ namespace bgfx { namespace mtl
 
 			if (NULL != m_dynamic)
 			{
-				BX_DELETE(g_allocator, m_dynamic);
+				BX_DELETE(getAllocator(MemoryTag::Renderer), m_dynamic);
 				m_dynamic = NULL;
 			}
 		}
@@ -937,7 +937,7 @@ namespace bgfx { namespace mtl
 
 	void release(PipelineStateMtl* _ptr)
 	{
-		BX_DELETE(g_allocator, _ptr);
+		BX_DELETE(getAllocator(MemoryTag::Renderer), _ptr);
 	}
 
 	struct TextureMtl
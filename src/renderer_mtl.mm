@@ -817,6 +817,10 @@ namespace bgfx { namespace mtl
 			m_program[_handle.idx].destroy();
 		}
 
+		void prewarmPipeline(ProgramHandle /*_program*/, VertexDeclHandle /*_declHandle*/, FrameBufferHandle /*_fbh*/, uint64_t /*_state*/) override
+		{
+		}
+
 		void* createTexture(TextureHandle _handle, const Memory* _mem, uint64_t _flags, uint8_t _skip) override
 		{
 			m_textures[_handle.idx].create(_mem, _flags, _skip);
@@ -836,6 +840,15 @@ namespace bgfx { namespace mtl
 		{
 		}
 
+		void* mapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
+		{
+			return NULL;
+		}
+
+		void unmapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
+		{
+		}
+
 		void readTexture(TextureHandle _handle, void* _data, uint8_t _mip) override
 		{
 			m_cmd.kick(false, true);
@@ -953,11 +966,11 @@ namespace bgfx { namespace mtl
 		{
 			if (NULL != m_uniforms[_handle.idx])
 			{
-				BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+				BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			}
 
 			uint32_t size = BX_ALIGN_16(g_uniformTypeSize[_type]*_num);
-			void* data = BX_ALLOC(g_allocator, size);
+			void* data = BX_ALLOC(getAllocator(MemoryTag::Renderer), size);
 			bx::memSet(data, 0, size);
 			m_uniforms[_handle.idx] = data;
 			m_uniformReg.add(_handle, _name);
@@ -965,7 +978,7 @@ namespace bgfx { namespace mtl
 
 		void destroyUniform(UniformHandle _handle) override
 		{
-			BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+			BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			m_uniforms[_handle.idx] = NULL;
 			m_uniformReg.remove(_handle);
 		}
@@ -1031,6 +1044,23 @@ namespace bgfx { namespace mtl
 			m_occlusionQuery.invalidate(_handle);
 		}
 
+		bool createFence(FenceHandle _handle) override
+		{
+			BX_UNUSED(_handle);
+			return false;
+		}
+
+		bool isFenceSignaled(FenceHandle _handle) override
+		{
+			BX_UNUSED(_handle);
+			return false;
+		}
+
+		void destroyFence(FenceHandle _handle) override
+		{
+			BX_UNUSED(_handle);
+		}
+
 		void setMarker(const char* _marker, uint16_t _len) override
 		{
 			BX_UNUSED(_len);
@@ -1041,6 +1071,14 @@ namespace bgfx { namespace mtl
 			}
 		}
 
+		void beginGpuScope(const char* /*_name*/, uint16_t /*_len*/) override
+		{
+		}
+
+		void endGpuScope() override
+		{
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			BX_UNUSED(_len);
@@ -1939,7 +1977,7 @@ namespace bgfx { namespace mtl
 
 			if (NULL == pso)
 			{
-				pso = BX_NEW(g_allocator, PipelineStateMtl);
+				pso = BX_NEW(getAllocator(MemoryTag::Renderer), PipelineStateMtl);
 
 				RenderPipelineDescriptor pd = m_renderPipelineDescriptor;
 				reset(pd);
@@ -2172,7 +2210,7 @@ namespace bgfx { namespace mtl
 
 			if (NULL == program.m_computePS)
 			{
-				PipelineStateMtl* pso = BX_NEW(g_allocator, PipelineStateMtl);
+				PipelineStateMtl* pso = BX_NEW(getAllocator(MemoryTag::Renderer), PipelineStateMtl);
 				program.m_computePS = pso;
 
 				ComputePipelineReflection reflection = NULL;
@@ -2347,10 +2385,10 @@ namespace bgfx { namespace mtl
 
 	RendererContextI* rendererCreate(const Init& _init)
 	{
-		s_renderMtl = BX_NEW(g_allocator, RendererContextMtl);
+		s_renderMtl = BX_NEW(getAllocator(MemoryTag::Renderer), RendererContextMtl);
 		if (!s_renderMtl->init(_init) )
 		{
-			BX_DELETE(g_allocator, s_renderMtl);
+			BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderMtl);
 			s_renderMtl = NULL;
 		}
 		return s_renderMtl;
@@ -2359,7 +2397,7 @@ namespace bgfx { namespace mtl
 	void rendererDestroy()
 	{
 		s_renderMtl->shutdown();
-		BX_DELETE(g_allocator, s_renderMtl);
+		BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderMtl);
 		s_renderMtl = NULL;
 	}
 
@@ -2509,7 +2547,7 @@ namespace bgfx { namespace mtl
 		m_fsh = NULL;
 		if ( NULL != m_computePS )
 		{
-			BX_DELETE(g_allocator, m_computePS);
+			BX_DELETE(getAllocator(MemoryTag::Renderer), m_computePS);
 			m_computePS = NULL;
 		}
 	}
@@ -2540,7 +2578,7 @@ namespace bgfx { namespace mtl
 		{
 			if ( m_dynamic == NULL )
 			{
-				m_dynamic = (uint8_t*)BX_ALLOC(g_allocator, m_size);
+				m_dynamic = (uint8_t*)BX_ALLOC(getAllocator(MemoryTag::Renderer), m_size);
 			}
 
 			bx::memCopy(m_dynamic + _offset, _data, _size);
@@ -3247,7 +3285,7 @@ namespace bgfx { namespace mtl
 	void FrameBufferMtl::create(uint16_t _denseIdx, void* _nwh, uint32_t _width, uint32_t _height, TextureFormat::Enum _format, TextureFormat::Enum _depthFormat)
 	{
 		BX_UNUSED(_format, _depthFormat);
-		m_swapChain = BX_NEW(g_allocator, SwapChainMtl);
+		m_swapChain = BX_NEW(getAllocator(MemoryTag::Renderer), SwapChainMtl);
 		m_num = 0;
 		m_width     = _width;
 		m_height    = _height;
@@ -3265,7 +3303,7 @@ namespace bgfx { namespace mtl
 	{
 		if (NULL != m_swapChain)
 		{
-			BX_DELETE(g_allocator, m_swapChain);
+			BX_DELETE(getAllocator(MemoryTag::Renderer), m_swapChain);
 			m_swapChain = NULL;
 		}
 
@@ -3685,6 +3723,8 @@ namespace bgfx { namespace mtl
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
 
 		BlitState bs(_render);
+		ProgramProfiler programProfiler(_render);
+		StateCounter stateCounter(_render);
 
 		const uint64_t primType = 0;
 		uint8_t primIndex = uint8_t(primType>>BGFX_STATE_PT_SHIFT);
@@ -3738,6 +3778,8 @@ namespace bgfx { namespace mtl
 				if (viewChanged
 				|| (!isCompute && wasCompute) )
 				{
+					programProfiler.end();
+
 					view = key.m_view;
 					currentProgram = BGFX_INVALID_HANDLE;
 
@@ -3927,6 +3969,8 @@ namespace bgfx { namespace mtl
 					}
 				}
 
+				programProfiler.begin(key.m_program, renderItem, isCompute);
+
 				if (isCompute)
 				{
 					if (!wasCompute)
@@ -3973,6 +4017,7 @@ namespace bgfx { namespace mtl
 						}
 
 						m_computeCommandEncoder.setComputePipelineState(currentPso->m_cps);
+						stateCounter.programChange();
 						programChanged = true;
 					}
 
@@ -3994,6 +4039,7 @@ namespace bgfx { namespace mtl
 						}
 
 						viewState.setPredefined<4>(this, view, *currentPso, _render, compute);
+						stateCounter.uniformUpload();
 
 						m_uniformBufferVertexOffset += vertexUniformBufferSize;
 					}
@@ -4123,6 +4169,13 @@ namespace bgfx { namespace mtl
 				uint64_t changedStencil = currentState.m_stencil ^ draw.m_stencil;
 				currentState.m_stencil = newStencil;
 
+				if (0 != changedFlags
+				||  0 != changedStencil)
+				{
+					programProfiler.stateChange();
+					stateCounter.stateChange(changedFlags, changedStencil);
+				}
+
 				if (resetState)
 				{
 					currentState.clear();
@@ -4250,6 +4303,11 @@ namespace bgfx { namespace mtl
 				   ) & changedFlags
 				|| ( (blendFactor != draw.m_rgba) && !!(newFlags & BGFX_STATE_BLEND_INDEPENDENT) ) )
 				{
+					if (key.m_program.idx != currentProgram.idx)
+					{
+						stateCounter.programChange();
+					}
+
 					currentProgram = key.m_program;
 
 					currentState.m_streamMask             = draw.m_streamMask;
@@ -4292,6 +4350,7 @@ namespace bgfx { namespace mtl
 						const uint32_t offset = draw.m_stream[idx].m_startVertex * stride;
 
 						rce.setVertexBuffer(vb.m_ptr, offset, idx+1);
+						stateCounter.vertexBufferBind();
 					}
 
 					currentState.m_numVertices = numVertices;
@@ -4330,6 +4389,7 @@ namespace bgfx { namespace mtl
 					{
 						const VertexBufferMtl& inst = m_vertexBuffers[draw.m_instanceDataBuffer.idx];
 						rce.setVertexBuffer(inst.m_ptr, draw.m_instanceDataOffset, numStreams+1);
+						stateCounter.vertexBufferBind();
 					}
 
 					programChanged = true;
@@ -4366,6 +4426,7 @@ namespace bgfx { namespace mtl
 					}
 
 					viewState.setPredefined<4>(this, view, *currentPso, _render, draw);
+					stateCounter.uniformUpload();
 
 					m_uniformBufferFragmentOffset += fragmentUniformBufferSize;
 					m_uniformBufferVertexOffset    = m_uniformBufferFragmentOffset;
@@ -4396,6 +4457,9 @@ namespace bgfx { namespace mtl
 									, bind.m_samplerFlags
 									);
 							}
+
+							programProfiler.textureBind();
+							stateCounter.textureBind();
 						}
 
 						current = bind;
@@ -4430,6 +4494,8 @@ namespace bgfx { namespace mtl
 
 						if (isValid(draw.m_indexBuffer) )
 						{
+							stateCounter.indexBufferBind();
+
 							const IndexBufferMtl& ib = m_indexBuffers[draw.m_indexBuffer.idx];
 							MTLIndexType indexType = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? MTLIndexTypeUInt16 : MTLIndexTypeUInt32;
 
@@ -4459,6 +4525,9 @@ namespace bgfx { namespace mtl
 					{
 						if (isValid(draw.m_indexBuffer) )
 						{
+							// Metal binds index buffer with each indexed draw call.
+							stateCounter.indexBufferBind();
+
 							const IndexBufferMtl& ib = m_indexBuffers[draw.m_indexBuffer.idx];
 							MTLIndexType indexType = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? MTLIndexTypeUInt16 : MTLIndexTypeUInt32;
 
@@ -4515,6 +4584,8 @@ namespace bgfx { namespace mtl
 				BGFX_MTL_PROFILER_BEGIN(view, kColorCompute);
 			}
 
+			programProfiler.end();
+
 			submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
 
 			if (0 < _render->m_numRenderItems)
@@ -4644,6 +4715,9 @@ namespace bgfx { namespace mtl
 				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
 				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
 
+				pos++;
+				pos = dbgTextFrameTiming(tvm, 10, pos, _render);
+
 				pos++;
 				double captureMs = double(captureElapsed)*toMs;
 				tvm.printf(10, pos++, 0x8b, "     Capture: %3.4f [ms]", captureMs);
@@ -4653,6 +4727,7 @@ namespace bgfx { namespace mtl
 
 				tvm.printf(10, pos++, attr[attrIndex    &1], " Submit wait: %3.4f [ms]", _render->m_waitSubmit*toMs);
 				tvm.printf(10, pos++, attr[(attrIndex+1)&1], " Render wait: %3.4f [ms]", _render->m_waitRender*toMs);
+				tvm.printf(10, pos++, 0x8b, " Pacing wait: %7.4f [ms] ", _render->m_framePacing*toMs);
 
 				min = frameTime;
 				max = frameTime;
@@ -4,13 +4,120 @@
  */
 
 #include "bgfx_p.h"
+#include "renderer.h"
 
 namespace bgfx { namespace noop
 {
+	struct PrimInfo
+	{
+		uint32_t m_min;
+		uint32_t m_div;
+		uint32_t m_sub;
+	};
+
+	static const PrimInfo s_primInfo[] =
+	{
+		{ 3, 3, 0 },
+		{ 3, 1, 2 },
+		{ 2, 2, 0 },
+		{ 2, 1, 1 },
+		{ 1, 1, 0 },
+		{ 0, 0, 0 },
+	};
+	BX_STATIC_ASSERT(Topology::Count == BX_COUNTOF(s_primInfo)-1);
+
+	struct BufferNOOP
+	{
+		void create(uint32_t _size, uint16_t _flags, VertexDeclHandle _declHandle)
+		{
+			m_size  = _size;
+			m_flags = _flags;
+			m_decl  = _declHandle;
+		}
+
+		void destroy()
+		{
+			m_size     = 0;
+			m_flags    = BGFX_BUFFER_NONE;
+			m_decl.idx = kInvalidHandle;
+		}
+
+		uint32_t m_size;
+		uint16_t m_flags;
+		VertexDeclHandle m_decl;
+	};
+
+	struct ShaderNOOP
+	{
+		ShaderNOOP()
+			: m_constantBuffer(NULL)
+			, m_numPredefined(0)
+		{
+		}
+
+		void create(const Memory* _mem);
+
+		void destroy()
+		{
+			if (NULL != m_constantBuffer)
+			{
+				UniformBuffer::destroy(m_constantBuffer);
+				m_constantBuffer = NULL;
+			}
+
+			m_numPredefined = 0;
+		}
+
+		UniformBuffer* m_constantBuffer;
+		PredefinedUniform m_predefined[PredefinedUniform::Count];
+		uint8_t m_numPredefined;
+	};
+
+	struct ProgramNOOP
+	{
+		ProgramNOOP()
+			: m_vsh(NULL)
+			, m_fsh(NULL)
+			, m_numPredefined(0)
+		{
+		}
+
+		void create(const ShaderNOOP* _vsh, const ShaderNOOP* _fsh)
+		{
+			m_vsh = _vsh;
+			bx::memCopy(&m_predefined[0], _vsh->m_predefined, _vsh->m_numPredefined*sizeof(PredefinedUniform) );
+			m_numPredefined = _vsh->m_numPredefined;
+
+			if (NULL != _fsh)
+			{
+				m_fsh = _fsh;
+				bx::memCopy(&m_predefined[m_numPredefined], _fsh->m_predefined, _fsh->m_numPredefined*sizeof(PredefinedUniform) );
+				m_numPredefined += _fsh->m_numPredefined;
+			}
+		}
+
+		void destroy()
+		{
+			m_numPredefined = 0;
+			m_vsh = NULL;
+			m_fsh = NULL;
+		}
+
+		const ShaderNOOP* m_vsh;
+		const ShaderNOOP* m_fsh;
+
+		PredefinedUniform m_predefined[PredefinedUniform::Count*2];
+		uint8_t m_numPredefined;
+	};
+
 	struct RendererContextNOOP : public RendererContextI
 	{
 		RendererContextNOOP()
+			: m_vsChanges(0)
+			, m_fsChanges(0)
 		{
+			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+
 			// Pretend all features are available.
 			g_caps.supported = 0
 				| BGFX_CAPS_ALPHA_TO_COVERAGE
@@ -71,6 +178,13 @@ namespace bgfx { namespace noop
 
 		~RendererContextNOOP()
 		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_uniforms); ++ii)
+			{
+				if (NULL != m_uniforms[ii])
+				{
+					BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[ii]);
+				}
+			}
 		}
 
 		RendererType::Enum getRendererType() const override
@@ -92,67 +206,87 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void createIndexBuffer(IndexBufferHandle /*_handle*/, const Memory* /*_mem*/, uint16_t /*_flags*/) override
+		void createIndexBuffer(IndexBufferHandle _handle, const Memory* _mem, uint16_t _flags) override
 		{
+			VertexDeclHandle decl = BGFX_INVALID_HANDLE;
+			m_indexBuffers[_handle.idx].create(_mem->size, _flags, decl);
 		}
 
-		void destroyIndexBuffer(IndexBufferHandle /*_handle*/) override
+		void destroyIndexBuffer(IndexBufferHandle _handle) override
 		{
+			m_indexBuffers[_handle.idx].destroy();
 		}
 
-		void createVertexDecl(VertexDeclHandle /*_handle*/, const VertexDecl& /*_decl*/) override
+		void createVertexDecl(VertexDeclHandle _handle, const VertexDecl& _decl) override
 		{
+			bx::memCopy(&m_vertexDecls[_handle.idx], &_decl, sizeof(VertexDecl) );
 		}
 
 		void destroyVertexDecl(VertexDeclHandle /*_handle*/) override
 		{
 		}
 
-		void createVertexBuffer(VertexBufferHandle /*_handle*/, const Memory* /*_mem*/, VertexDeclHandle /*_declHandle*/, uint16_t /*_flags*/) override
+		void createVertexBuffer(VertexBufferHandle _handle, const Memory* _mem, VertexDeclHandle _declHandle, uint16_t _flags) override
 		{
+			m_vertexBuffers[_handle.idx].create(_mem->size, _flags, _declHandle);
 		}
 
-		void destroyVertexBuffer(VertexBufferHandle /*_handle*/) override
+		void destroyVertexBuffer(VertexBufferHandle _handle) override
 		{
+			m_vertexBuffers[_handle.idx].destroy();
 		}
 
-		void createDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_size*/, uint16_t /*_flags*/) override
+		void createDynamicIndexBuffer(IndexBufferHandle _handle, uint32_t _size, uint16_t _flags) override
 		{
+			VertexDeclHandle decl = BGFX_INVALID_HANDLE;
+			m_indexBuffers[_handle.idx].create(_size, _flags, decl);
 		}
 
 		void updateDynamicIndexBuffer(IndexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
 		{
 		}
 
-		void destroyDynamicIndexBuffer(IndexBufferHandle /*_handle*/) override
+		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
 		{
+			m_indexBuffers[_handle.idx].destroy();
 		}
 
-		void createDynamicVertexBuffer(VertexBufferHandle /*_handle*/, uint32_t /*_size*/, uint16_t /*_flags*/) override
+		void createDynamicVertexBuffer(VertexBufferHandle _handle, uint32_t _size, uint16_t _flags) override
 		{
+			VertexDeclHandle decl = BGFX_INVALID_HANDLE;
+			m_vertexBuffers[_handle.idx].create(_size, _flags, decl);
 		}
 
 		void updateDynamicVertexBuffer(VertexBufferHandle /*_handle*/, uint32_t /*_offset*/, uint32_t /*_size*/, const Memory* /*_mem*/) override
 		{
 		}
 
-		void destroyDynamicVertexBuffer(VertexBufferHandle /*_handle*/) override
+		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
+		{
+			m_vertexBuffers[_handle.idx].destroy();
+		}
+
+		void createShader(ShaderHandle _handle, const Memory* _mem) override
 		{
+			m_shaders[_handle.idx].create(_mem);
 		}
 
-		void createShader(ShaderHandle /*_handle*/, const Memory* /*_mem*/) override
+		void destroyShader(ShaderHandle _handle) override
 		{
+			m_shaders[_handle.idx].destroy();
 		}
 
-		void destroyShader(ShaderHandle /*_handle*/) override
+		void createProgram(ProgramHandle _handle, ShaderHandle _vsh, ShaderHandle _fsh) override
 		{
+			m_program[_handle.idx].create(&m_shaders[_vsh.idx], isValid(_fsh) ? &m_shaders[_fsh.idx] : NULL);
 		}
 
-		void createProgram(ProgramHandle /*_handle*/, ShaderHandle /*_vsh*/, ShaderHandle /*_fsh*/) override
+		void destroyProgram(ProgramHandle _handle) override
 		{
+			m_program[_handle.idx].destroy();
 		}
 
-		void destroyProgram(ProgramHandle /*_handle*/) override
+		void prewarmPipeline(ProgramHandle /*_program*/, VertexDeclHandle /*_declHandle*/, FrameBufferHandle /*_fbh*/, uint64_t /*_state*/) override
 		{
 		}
 
@@ -173,6 +307,15 @@ namespace bgfx { namespace noop
 		{
 		}
 
+		void* mapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
+		{
+			return NULL;
+		}
+
+		void unmapStagingBuffer(uint8_t /*_idx*/, uint32_t /*_size*/) override
+		{
+		}
+
 		void readTexture(TextureHandle /*_handle*/, void* /*_data*/, uint8_t /*_mip*/) override
 		{
 		}
@@ -206,12 +349,25 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void createUniform(UniformHandle /*_handle*/, UniformType::Enum /*_type*/, uint16_t /*_num*/, const char* /*_name*/) override
+		void createUniform(UniformHandle _handle, UniformType::Enum _type, uint16_t _num, const char* _name) override
 		{
+			if (NULL != m_uniforms[_handle.idx])
+			{
+				BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
+			}
+
+			uint32_t size = BX_ALIGN_16(g_uniformTypeSize[_type]*_num);
+			void* data = BX_ALLOC(getAllocator(MemoryTag::Renderer), size);
+			bx::memSet(data, 0, size);
+			m_uniforms[_handle.idx] = data;
+			m_uniformReg.add(_handle, _name);
 		}
 
-		void destroyUniform(UniformHandle /*_handle*/) override
+		void destroyUniform(UniformHandle _handle) override
 		{
+			BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
+			m_uniforms[_handle.idx] = NULL;
+			m_uniformReg.remove(_handle);
 		}
 
 		void requestScreenShot(FrameBufferHandle /*_handle*/, const char* /*_filePath*/) override
@@ -222,42 +378,476 @@ namespace bgfx { namespace noop
 		{
 		}
 
-		void updateUniform(uint16_t /*_loc*/, const void* /*_data*/, uint32_t /*_size*/) override
+		void updateUniform(uint16_t _loc, const void* _data, uint32_t _size) override
 		{
+			bx::memCopy(m_uniforms[_loc], _data, _size);
 		}
 
 		void invalidateOcclusionQuery(OcclusionQueryHandle /*_handle*/) override
 		{
 		}
 
+		bool createFence(FenceHandle /*_handle*/) override
+		{
+			return true;
+		}
+
+		bool isFenceSignaled(FenceHandle /*_handle*/) override
+		{
+			return true;
+		}
+
+		void destroyFence(FenceHandle /*_handle*/) override
+		{
+		}
+
 		void setMarker(const char* /*_marker*/, uint16_t /*_len*/) override
 		{
 		}
 
+		void beginGpuScope(const char* /*_name*/, uint16_t /*_len*/) override
+		{
+		}
+
+		void endGpuScope() override
+		{
+		}
+
 		virtual void setName(Handle /*_handle*/, const char* /*_name*/, uint16_t /*_len*/) override
 		{
 		}
 
+		void setShaderUniform(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+		{
+			const uint32_t size = _numRegs*16;
+			if (_regIndex + size > sizeof(m_vsScratch) )
+			{
+				return;
+			}
+
+			if (_flags&BGFX_UNIFORM_FRAGMENTBIT)
+			{
+				bx::memCopy(&m_fsScratch[_regIndex], _val, size);
+				m_fsChanges += _numRegs;
+			}
+			else
+			{
+				bx::memCopy(&m_vsScratch[_regIndex], _val, size);
+				m_vsChanges += _numRegs;
+			}
+		}
+
+		void setShaderUniform4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+		{
+			setShaderUniform(_flags, _regIndex, _val, _numRegs);
+		}
+
+		void setShaderUniform4x4f(uint8_t _flags, uint32_t _regIndex, const void* _val, uint32_t _numRegs)
+		{
+			setShaderUniform(_flags, _regIndex, _val, _numRegs);
+		}
+
+		void commit(UniformBuffer& _uniformBuffer)
+		{
+			_uniformBuffer.reset();
+
+			for (;;)
+			{
+				uint32_t opcode = _uniformBuffer.read();
+
+				if (UniformType::End == opcode)
+				{
+					break;
+				}
+
+				UniformType::Enum type;
+				uint16_t loc;
+				uint16_t num;
+				uint16_t copy;
+				UniformBuffer::decodeOpcode(opcode, type, loc, num, copy);
+
+				const uint32_t size = g_uniformTypeSize[type&~BGFX_UNIFORM_MASK]*num;
+
+				const char* data;
+				if (copy)
+				{
+					data = _uniformBuffer.read(size);
+				}
+				else
+				{
+					UniformHandle handle;
+					bx::memCopy(&handle, _uniformBuffer.read(sizeof(UniformHandle) ), sizeof(UniformHandle) );
+					data = (const char*)m_uniforms[handle.idx];
+				}
+
+				const uint32_t numRegs = (size + 15)/16;
+				setShaderUniform(uint8_t(type), loc, data, numRegs);
+			}
+		}
+
+		void commitShaderConstants()
+		{
+			// Nothing to upload, just reset dirty register counts.
+			m_vsChanges = 0;
+			m_fsChanges = 0;
+		}
+
 		void submit(Frame* _render, ClearQuad& /*_clearQuad*/, TextVideoMemBlitter& /*_textVideoMemBlitter*/) override
 		{
 			const int64_t timerFreq = bx::getHPFrequency();
 			const int64_t timeBegin = bx::getHPCounter();
 
+			_render->sort();
+
+			uint32_t statsNumPrimsRendered[Topology::Count] = {};
+			uint32_t statsKeyType[2] = {};
+
+			if (BX_ENABLED(BGFX_CONFIG_RENDERER_NOOP_NULL_DRIVER)
+			&&  0 == (_render->m_debug&BGFX_DEBUG_IFH) )
+			{
+				BGFX_PROFILER_SCOPE("bgfx/Noop walk frame", kColorFrame);
+				walk(_render, statsNumPrimsRendered, statsKeyType);
+			}
+
 			Stats& perfStats = _render->m_perfStats;
 			perfStats.cpuTimeBegin  = timeBegin;
-			perfStats.cpuTimeEnd    = timeBegin;
+			perfStats.cpuTimeEnd    = bx::getHPCounter();
 			perfStats.cpuTimerFreq  = timerFreq;
 
 			perfStats.gpuTimeBegin  = 0;
 			perfStats.gpuTimeEnd    = 0;
 			perfStats.gpuTimerFreq  = 1000000000;
 
-			bx::memSet(perfStats.numPrims, 0, sizeof(perfStats.numPrims) );
+			perfStats.numDraw       = statsKeyType[0];
+			perfStats.numCompute    = statsKeyType[1];
+			perfStats.numBlit       = _render->m_numBlitItems;
+			perfStats.maxGpuLatency = 0;
+			bx::memCopy(perfStats.numPrims, statsNumPrimsRendered, sizeof(perfStats.numPrims) );
 
 			perfStats.gpuMemoryMax  = -INT64_MAX;
 			perfStats.gpuMemoryUsed = -INT64_MAX;
 		}
 
+		// Walks frame the same way real renderers do in submit: sort key
+		// decode, view changes, blits, predefined uniforms, uniform commit,
+		// state, bind and vertex stream diffing. Only graphics API calls are
+		// omitted, so render thread cost is representative.
+		void walk(Frame* _render, uint32_t* _numPrimsRendered, uint32_t* _keyType)
+		{
+			RenderDraw currentState;
+			currentState.clear();
+			currentState.m_stateFlags = BGFX_STATE_NONE;
+			currentState.m_stencil    = packStencil(BGFX_STENCIL_NONE, BGFX_STENCIL_NONE);
+
+			RenderBind currentBind;
+			currentBind.clear();
+
+			static ViewState viewState;
+			viewState.reset(_render);
+
+			ProgramHandle currentProgram = BGFX_INVALID_HANDLE;
+			SortKey key;
+			uint16_t view = UINT16_MAX;
+			BlitState bs(_render);
+			ProgramProfiler programProfiler(_render);
+			StateCounter stateCounter(_render);
+
+			uint8_t primIndex = 0;
+			PrimInfo prim = s_primInfo[primIndex];
+
+			bool wasCompute = false;
+			Rect viewScissorRect;
+			viewScissorRect.clear();
+
+			const uint32_t maxTextureSamplers = g_caps.limits.maxTextureSamplers;
+
+			viewState.m_rect = _render->m_view[0].m_rect;
+			int32_t numItems = _render->m_numRenderItems;
+
+			for (int32_t item = 0; item < numItems;)
+			{
+				const uint64_t encodedKey = _render->m_sortKeys[item];
+				const bool isCompute = key.decode(encodedKey, _render->m_viewRemap);
+				_keyType[isCompute]++;
+
+				const bool viewChanged = 0
+					|| key.m_view != view
+					|| item == numItems
+					;
+
+				const uint32_t itemIdx       = _render->m_sortValues[item];
+				const RenderItem& renderItem = _render->m_renderItem[itemIdx];
+				const RenderBind& renderBind = _render->m_renderItemBind[itemIdx];
+				++item;
+
+				if (viewChanged)
+				{
+					programProfiler.end();
+
+					view = key.m_view;
+					currentProgram = BGFX_INVALID_HANDLE;
+
+					viewState.m_rect = _render->m_view[view].m_rect;
+
+					const Rect& scissorRect = _render->m_view[view].m_scissor;
+					viewScissorRect = scissorRect.isZero() ? viewState.m_rect : scissorRect;
+
+					while (bs.hasItem(view) )
+					{
+						bs.advance();
+					}
+				}
+
+				programProfiler.begin(key.m_program, renderItem, isCompute);
+
+				if (isCompute)
+				{
+					wasCompute = true;
+
+					const RenderCompute& compute = renderItem.compute;
+
+					bool constantsChanged = compute.m_uniformBegin < compute.m_uniformEnd;
+					rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
+
+					if (key.m_program.idx != currentProgram.idx)
+					{
+						currentProgram = key.m_program;
+						stateCounter.programChange();
+						constantsChanged = true;
+					}
+
+					if (isValid(currentProgram) )
+					{
+						ProgramNOOP& program = m_program[currentProgram.idx];
+
+						if (constantsChanged
+						&&  NULL != program.m_vsh
+						&&  NULL != program.m_vsh->m_constantBuffer)
+						{
+							commit(*program.m_vsh->m_constantBuffer);
+						}
+
+						viewState.setPredefined<4>(this, view, program, _render, compute);
+						commitShaderConstants();
+						stateCounter.uniformUpload();
+					}
+
+					continue;
+				}
+
+				bool resetState = viewChanged || wasCompute;
+
+				if (wasCompute)
+				{
+					currentProgram = BGFX_INVALID_HANDLE;
+				}
+
+				const RenderDraw& draw = renderItem.draw;
+
+				if (_render->m_frameCache.isZeroArea(viewScissorRect, draw.m_scissor) )
+				{
+					if (resetState)
+					{
+						currentState.clear();
+						currentState.m_scissor = !draw.m_scissor;
+						currentBind.clear();
+					}
+
+					continue;
+				}
+
+				const uint64_t newFlags = draw.m_stateFlags;
+				uint64_t changedFlags = currentState.m_stateFlags ^ draw.m_stateFlags;
+				changedFlags |= currentState.m_rgba != draw.m_rgba ? BGFX_STATE_BLEND_MASK : 0;
+				currentState.m_stateFlags = newFlags;
+
+				const uint64_t newStencil = draw.m_stencil;
+				const uint64_t changedStencil = currentState.m_stencil ^ draw.m_stencil;
+				currentState.m_stencil = newStencil;
+
+				if (0 != changedFlags
+				||  0 != changedStencil)
+				{
+					programProfiler.stateChange();
+					stateCounter.stateChange(changedFlags, changedStencil);
+				}
+
+				if (resetState)
+				{
+					wasCompute = false;
+
+					currentState.clear();
+					currentState.m_scissor = !draw.m_scissor;
+					changedFlags = BGFX_STATE_MASK;
+					currentState.m_stateFlags = newFlags;
+					currentState.m_stencil    = newStencil;
+
+					currentBind.clear();
+				}
+
+				currentState.m_scissor = draw.m_scissor;
+
+				if (BGFX_STATE_BLEND_MASK & changedFlags)
+				{
+					currentState.m_rgba = draw.m_rgba;
+				}
+
+				if (BGFX_STATE_ALPHA_REF_MASK & changedFlags)
+				{
+					uint32_t ref = (newFlags&BGFX_STATE_ALPHA_REF_MASK)>>BGFX_STATE_ALPHA_REF_SHIFT;
+					viewState.m_alphaRef = ref/255.0f;
+				}
+
+				if (BGFX_STATE_PT_MASK & changedFlags)
+				{
+					const uint64_t pt = newFlags&BGFX_STATE_PT_MASK;
+					primIndex = uint8_t(pt>>BGFX_STATE_PT_SHIFT);
+					prim = s_primInfo[primIndex];
+				}
+
+				bool programChanged = false;
+				bool constantsChanged = draw.m_uniformBegin < draw.m_uniformEnd;
+				rendererUpdateUniforms(this, _render->m_uniformBuffer[draw.m_uniformIdx], draw.m_uniformBegin, draw.m_uniformEnd);
+
+				if (key.m_program.idx != currentProgram.idx)
+				{
+					currentProgram = key.m_program;
+					stateCounter.programChange();
+					programChanged =
+						constantsChanged = true;
+				}
+
+				if (isValid(currentProgram) )
+				{
+					ProgramNOOP& program = m_program[currentProgram.idx];
+
+					if (constantsChanged)
+					{
+						if (NULL != program.m_vsh
+						&&  NULL != program.m_vsh->m_constantBuffer)
+						{
+							commit(*program.m_vsh->m_constantBuffer);
+						}
+
+						if (NULL != program.m_fsh
+						&&  NULL != program.m_fsh->m_constantBuffer)
+						{
+							commit(*program.m_fsh->m_constantBuffer);
+						}
+					}
+
+					viewState.setPredefined<4>(this, view, program, _render, draw);
+					commitShaderConstants();
+					stateCounter.uniformUpload();
+				}
+
+				for (uint8_t stage = 0; stage < maxTextureSamplers; ++stage)
+				{
+					const Binding& bind = renderBind.m_bind[stage];
+					Binding& current = currentBind.m_bind[stage];
+					if (current.m_idx          != bind.m_idx
+					||  current.m_type         != bind.m_type
+					||  current.m_samplerFlags != bind.m_samplerFlags
+					||  programChanged)
+					{
+						current = bind;
+						programProfiler.textureBind();
+						stateCounter.textureBind();
+					}
+				}
+
+				if (programChanged
+				||  hasVertexStreamChanged(currentState, draw) )
+				{
+					currentState.m_streamMask             = draw.m_streamMask;
+					currentState.m_instanceDataBuffer.idx = draw.m_instanceDataBuffer.idx;
+					currentState.m_instanceDataOffset     = draw.m_instanceDataOffset;
+					currentState.m_instanceDataStride     = draw.m_instanceDataStride;
+
+					uint32_t numVertices = draw.m_numVertices;
+
+					for (uint32_t idx = 0, streamMask = draw.m_streamMask
+						; 0 != streamMask
+						; streamMask >>= 1, idx += 1
+						)
+					{
+						const uint32_t ntz = bx::uint32_cnttz(streamMask);
+						streamMask >>= ntz;
+						idx         += ntz;
+
+						currentState.m_stream[idx].m_decl        = draw.m_stream[idx].m_decl;
+						currentState.m_stream[idx].m_handle      = draw.m_stream[idx].m_handle;
+						currentState.m_stream[idx].m_startVertex = draw.m_stream[idx].m_startVertex;
+
+						const BufferNOOP& vb = m_vertexBuffers[draw.m_stream[idx].m_handle.idx];
+						const uint16_t decl = isValid(draw.m_stream[idx].m_decl)
+							? draw.m_stream[idx].m_decl.idx
+							: vb.m_decl.idx
+							;
+						const uint32_t stride = kInvalidHandle != decl
+							? bx::max<uint32_t>(m_vertexDecls[decl].m_stride, 1)
+							: 1
+							;
+
+						numVertices = bx::uint32_min(UINT32_MAX == draw.m_numVertices
+							? vb.m_size/stride
+							: draw.m_numVertices
+							, numVertices
+							);
+
+						stateCounter.vertexBufferBind();
+					}
+
+					if (isValid(draw.m_instanceDataBuffer) )
+					{
+						stateCounter.vertexBufferBind();
+					}
+
+					currentState.m_numVertices = numVertices;
+				}
+
+				if (currentState.m_indexBuffer.idx != draw.m_indexBuffer.idx)
+				{
+					currentState.m_indexBuffer = draw.m_indexBuffer;
+					stateCounter.indexBufferBind();
+				}
+
+				if (0 != currentState.m_streamMask
+				&&  !isValid(draw.m_indirectBuffer) )
+				{
+					uint32_t numPrimsSubmitted = 0;
+
+					if (isValid(draw.m_indexBuffer) )
+					{
+						const BufferNOOP& ib = m_indexBuffers[draw.m_indexBuffer.idx];
+						const uint32_t indexSize = 0 == (ib.m_flags & BGFX_BUFFER_INDEX32) ? 2 : 4;
+						const uint32_t numIndices = UINT32_MAX == draw.m_numIndices
+							? ib.m_size/indexSize
+							: draw.m_numIndices
+							;
+
+						if (prim.m_min <= numIndices)
+						{
+							numPrimsSubmitted = numIndices/prim.m_div - prim.m_sub;
+						}
+					}
+					else if (prim.m_min <= currentState.m_numVertices)
+					{
+						numPrimsSubmitted = currentState.m_numVertices/prim.m_div - prim.m_sub;
+					}
+
+					_numPrimsRendered[primIndex] += numPrimsSubmitted*draw.m_numInstances;
+				}
+			}
+
+			programProfiler.end();
+
+			while (bs.hasItem(BGFX_CONFIG_MAX_VIEWS) )
+			{
+				bs.advance();
+			}
+		}
+
 		void blitSetup(TextVideoMemBlitter& /*_blitter*/) override
 		{
 		}
@@ -265,20 +855,108 @@ namespace bgfx { namespace noop
 		void blitRender(TextVideoMemBlitter& /*_blitter*/, uint32_t /*_numIndices*/) override
 		{
 		}
+
+		BufferNOOP  m_indexBuffers[BGFX_CONFIG_MAX_INDEX_BUFFERS];
+		BufferNOOP  m_vertexBuffers[BGFX_CONFIG_MAX_VERTEX_BUFFERS];
+		VertexDecl  m_vertexDecls[BGFX_CONFIG_MAX_VERTEX_DECLS];
+		ShaderNOOP  m_shaders[BGFX_CONFIG_MAX_SHADERS];
+		ProgramNOOP m_program[BGFX_CONFIG_MAX_PROGRAMS];
+
+		void* m_uniforms[BGFX_CONFIG_MAX_UNIFORMS];
+		UniformRegistry m_uniformReg;
+
+		uint8_t  m_vsScratch[64<<10];
+		uint8_t  m_fsScratch[64<<10];
+		uint32_t m_vsChanges;
+		uint32_t m_fsChanges;
 	};
 
 	static RendererContextNOOP* s_renderNOOP;
 
+	void ShaderNOOP::create(const Memory* _mem)
+	{
+		bx::MemoryReader reader(_mem->data, _mem->size);
+
+		uint32_t magic;
+		bx::read(&reader, magic);
+
+		const uint8_t fragmentBit = isShaderType(magic, 'F') ? BGFX_UNIFORM_FRAGMENTBIT : 0;
+
+		uint32_t hashIn;
+		bx::read(&reader, hashIn);
+
+		if (!isShaderVerLess(magic, 6) )
+		{
+			uint32_t hashOut;
+			bx::read(&reader, hashOut);
+		}
+
+		uint16_t count = 0;
+		bx::read(&reader, count);
+
+		m_numPredefined = 0;
+
+		for (uint32_t ii = 0; ii < count; ++ii)
+		{
+			uint8_t nameSize = 0;
+			bx::read(&reader, nameSize);
+
+			char name[256] = { '\0' };
+			bx::read(&reader, &name, nameSize);
+			name[nameSize] = '\0';
+
+			uint8_t type = 0;
+			bx::read(&reader, type);
+
+			uint8_t num = 0;
+			bx::read(&reader, num);
+
+			uint16_t regIndex = 0;
+			bx::read(&reader, regIndex);
+
+			uint16_t regCount = 0;
+			bx::read(&reader, regCount);
+
+			PredefinedUniform::Enum predefined = nameToPredefinedUniformEnum(name);
+			if (PredefinedUniform::Count != predefined)
+			{
+				m_predefined[m_numPredefined].m_loc   = regIndex;
+				m_predefined[m_numPredefined].m_count = regCount;
+				m_predefined[m_numPredefined].m_type  = uint8_t(predefined|fragmentBit);
+				m_numPredefined++;
+			}
+			else if (0 == (BGFX_UNIFORM_SAMPLERBIT & type) )
+			{
+				const UniformRegInfo* info = s_renderNOOP->m_uniformReg.find(name);
+
+				if (NULL != info)
+				{
+					if (NULL == m_constantBuffer)
+					{
+						m_constantBuffer = UniformBuffer::create(1024);
+					}
+
+					m_constantBuffer->writeUniformHandle( (UniformType::Enum)(type|fragmentBit), regIndex, info->m_handle, regCount);
+				}
+			}
+		}
+
+		if (NULL != m_constantBuffer)
+		{
+			m_constantBuffer->finish();
+		}
+	}
+
 	RendererContextI* rendererCreate(const Init& _init)
 	{
 		BX_UNUSED(_init);
-		s_renderNOOP = BX_NEW(g_allocator, RendererContextNOOP);
+		s_renderNOOP = BX_NEW(getAllocator(MemoryTag::Renderer), RendererContextNOOP);
 		return s_renderNOOP;
 	}
 
 	void rendererDestroy()
 	{
-		BX_DELETE(g_allocator, s_renderNOOP);
+		BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderNOOP);
 		s_renderNOOP = NULL;
 	}
 } /* namespace noop */ } // namespace bgfx
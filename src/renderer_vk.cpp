@@ -371,13 +371,13 @@ VK_IMPORT_DEVICE
 	static void* VKAPI_PTR allocationFunction(void* _userData, size_t _size, size_t _alignment, VkSystemAllocationScope _allocationScope)
 	{
 		BX_UNUSED(_userData, _allocationScope);
-		return bx::alignedAlloc(g_allocator, _size, _alignment, s_allocScopeName[_allocationScope]);
+		return bx::alignedAlloc(getAllocator(MemoryTag::Renderer), _size, _alignment, s_allocScopeName[_allocationScope]);
 	}
 
 	static void* VKAPI_PTR reallocationFunction(void* _userData, void* _original, size_t _size, size_t _alignment, VkSystemAllocationScope _allocationScope)
 	{
 		BX_UNUSED(_userData, _allocationScope);
-		return bx::alignedRealloc(g_allocator, _original, _size, _alignment, s_allocScopeName[_allocationScope]);
+		return bx::alignedRealloc(getAllocator(MemoryTag::Renderer), _original, _size, _alignment, s_allocScopeName[_allocationScope]);
 	}
 
 	static void VKAPI_PTR freeFunction(void* _userData, void* _memory)
@@ -389,7 +389,7 @@ VK_IMPORT_DEVICE
 			return;
 		}
 
-		bx::alignedFree(g_allocator, _memory, 8);
+		bx::alignedFree(getAllocator(MemoryTag::Renderer), _memory, 8);
 	}
 
 	static void VKAPI_PTR internalAllocationNotification(void* _userData, size_t _size, VkInternalAllocationType _allocationType, VkSystemAllocationScope _allocationScope)
@@ -498,7 +498,10 @@ VK_IMPORT_DEVICE
 			, _messageCode
 			, _message
 			);
-		return VK_TRUE;
+
+		// Returning true would abort call that triggered report, and
+		// validation would change behavior of what it validates.
+		return VK_FALSE;
 	}
 
 	VkResult enumerateLayerProperties(VkPhysicalDevice _physicalDevice, uint32_t* _propertyCount, VkLayerProperties* _properties)
@@ -509,6 +512,30 @@ VK_IMPORT_DEVICE
 			;
 	}
 
+	bool isLayerSupported(const char* _layerName)
+	{
+		uint32_t numLayerProperties;
+		VkResult result = vkEnumerateInstanceLayerProperties(&numLayerProperties, NULL);
+
+		if (VK_SUCCESS == result
+		&&  0 < numLayerProperties)
+		{
+			VkLayerProperties layerProperties[64];
+			numLayerProperties = bx::min<uint32_t>(numLayerProperties, BX_COUNTOF(layerProperties) );
+			result = vkEnumerateInstanceLayerProperties(&numLayerProperties, layerProperties);
+
+			for (uint32_t layer = 0; VK_SUCCESS == result && layer < numLayerProperties; ++layer)
+			{
+				if (0 == bx::strCmp(layerProperties[layer].layerName, _layerName) )
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+
 	VkResult enumerateExtensionProperties(VkPhysicalDevice _physicalDevice, const char* _layerName, uint32_t* _propertyCount, VkExtensionProperties* _properties)
 	{
 		return (VK_NULL_HANDLE == _physicalDevice)
@@ -675,6 +702,35 @@ VK_IMPORT_DEVICE
 		}
 	}
 
+	static bool isPipelineCacheCompatible(const VkPhysicalDeviceProperties& _properties, const void* _data, uint32_t _size)
+	{
+		// VK_PIPELINE_CACHE_HEADER_VERSION_ONE layout.
+		struct Header
+		{
+			uint32_t m_size;
+			uint32_t m_version;
+			uint32_t m_vendorId;
+			uint32_t m_deviceId;
+			uint8_t  m_uuid[VK_UUID_SIZE];
+		};
+
+		if (_size < sizeof(Header) )
+		{
+			return false;
+		}
+
+		Header header;
+		bx::memCopy(&header, _data, sizeof(Header) );
+
+		return true
+			&& header.m_size     >= sizeof(Header)
+			&& header.m_version  == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+			&& header.m_vendorId == _properties.vendorID
+			&& header.m_deviceId == _properties.deviceID
+			&& 0 == bx::memCmp(header.m_uuid, _properties.pipelineCacheUUID, VK_UUID_SIZE)
+			;
+	}
+
 	void setImageMemoryBarrier(VkCommandBuffer _commandBuffer, VkImage _image, VkImageLayout _oldLayout, VkImageLayout _newLayout)
 	{
 		BX_CHECK(true
@@ -810,6 +866,7 @@ VK_IMPORT_DEVICE
 			, m_maxAnisotropy(1)
 			, m_depthClamp(false)
 			, m_wireframe(false)
+			, m_timerQuerySupport(false)
 		{
 		}
 
@@ -841,6 +898,8 @@ VK_IMPORT_DEVICE
 
 			m_fbh.idx = kInvalidHandle;
 			bx::memSet(m_uniforms, 0, sizeof(m_uniforms) );
+			bx::memSet(m_renderDone, 0, sizeof(m_renderDone) );
+			bx::memSet(m_fence, 0, sizeof(m_fence) );
 			bx::memSet(&m_resolution, 0, sizeof(m_resolution) );
 
 			bool imported = true;
@@ -916,6 +975,18 @@ VK_IMPORT
 					/*not used*/ ""
 				};
 
+				uint32_t numEnabledLayers = BX_COUNTOF(enabledLayerNames) - 1;
+				enabledLayerNames[numEnabledLayers] = "VK_LAYER_KHRONOS_validation";
+
+				// Validation layer is enabled for debug runs when it's installed,
+				// errors are reported through debug report callback.
+				if (_init.debug
+				&&  isLayerSupported(enabledLayerNames[numEnabledLayers]) )
+				{
+					BX_TRACE("Enabling %s.", enabledLayerNames[numEnabledLayers]);
+					++numEnabledLayers;
+				}
+
 				uint32_t numEnabledExtensions = 2;
 
 				const char* enabledExtension[Extension::Count + 2] =
@@ -942,7 +1013,7 @@ VK_IMPORT
 				ici.pNext = NULL;
 				ici.flags = 0;
 				ici.pApplicationInfo = &appInfo;
-				ici.enabledLayerCount   = BX_COUNTOF(enabledLayerNames) - 1;
+				ici.enabledLayerCount   = numEnabledLayers;
 				ici.ppEnabledLayerNames = enabledLayerNames;
 				ici.enabledExtensionCount   = numEnabledExtensions;
 				ici.ppEnabledExtensionNames = enabledExtension;
@@ -1707,6 +1778,14 @@ VK_IMPORT_DEVICE
 						goto error;
 					}
 
+					result = vkCreateSemaphore(m_device, &sci, m_allocatorCb, &m_renderDone[ii]);
+
+					if (VK_SUCCESS != result)
+					{
+						BX_TRACE("Init error: vkCreateSemaphore failed %d: %s.", result, getName(result) );
+						goto error;
+					}
+
 					sci.flags = 0;
 				}
 			}
@@ -1714,16 +1793,23 @@ VK_IMPORT_DEVICE
 			errorState = ErrorState::SwapchainCreated;
 
 			{
+				// Fences start signaled, so the first wait on each frame slot
+				// doesn't block.
 				VkFenceCreateInfo fci;
 				fci.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
 				fci.pNext = NULL;
-				fci.flags = 0;
-				result = vkCreateFence(m_device, &fci, m_allocatorCb, &m_fence);
+				fci.flags = VK_FENCE_CREATE_SIGNALED_BIT;
 
-				if (VK_SUCCESS != result)
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_fence); ++ii)
 				{
-					BX_TRACE("Init error: vkCreateFence failed %d: %s.", result, getName(result) );
-					goto error;
+					result = vkCreateFence(m_device, &fci, m_allocatorCb, &m_fence[ii]);
+
+					if (VK_SUCCESS != result)
+					{
+						destroyFences();
+						BX_TRACE("Init error: vkCreateFence failed %d: %s.", result, getName(result) );
+						goto error;
+					}
 				}
 
 				VkCommandPoolCreateInfo cpci;
@@ -1735,7 +1821,7 @@ VK_IMPORT_DEVICE
 
 				if (VK_SUCCESS != result)
 				{
-					vkDestroy(m_fence);
+					destroyFences();
 					BX_TRACE("Init error: vkCreateCommandPool failed %d: %s.", result, getName(result) );
 					goto error;
 				}
@@ -1752,7 +1838,7 @@ VK_IMPORT_DEVICE
 				if (VK_SUCCESS != result)
 				{
 					vkDestroy(m_commandPool);
-					vkDestroy(m_fence);
+					destroyFences();
 					BX_TRACE("Init error: vkAllocateCommandBuffers failed %d: %s.", result, getName(result) );
 					goto error;
 				}
@@ -1764,6 +1850,7 @@ VK_IMPORT_DEVICE
 				cbbi.pInheritanceInfo = NULL;
 
 				VkCommandBuffer commandBuffer = m_commandBuffers[0];
+				m_commandBuffer = commandBuffer;
 				VK_CHECK(vkBeginCommandBuffer(commandBuffer, &cbbi) );
 
 				VkRenderPassBeginInfo rpbi;
@@ -1808,42 +1895,32 @@ VK_IMPORT_DEVICE
 				finishAll();
 
 				VK_CHECK(vkResetCommandPool(m_device, m_commandPool, 0) );
+
+				m_numFramesInFlight = 0 == _init.resolution.maxFrameLatency
+					? BX_COUNTOF(m_fence)
+					: bx::min<uint32_t>(_init.resolution.maxFrameLatency, BX_COUNTOF(m_fence) )
+					;
+				m_frameIdx       = 0;
+				m_presentIdx     = 0;
+				m_frameBegun     = false;
+				m_frameCount     = 0;
+				m_frameCompleted = 0;
+				bx::memSet(m_fenceFrame, 0, sizeof(m_fenceFrame) );
+				bx::memSet(m_frameStagingUsed, 0, sizeof(m_frameStagingUsed) );
+				bx::memSet(m_frameStagingMapped, 0xff, sizeof(m_frameStagingMapped) );
 			}
 
 			errorState = ErrorState::CommandBuffersCreated;
 
 			{
-				VkDescriptorPoolSize dps[] =
-				{
-//					{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-					{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         10<<10                           },
-//					{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
-				};
-
 				VkDescriptorSetLayoutBinding dslb[] =
 				{
 //					{ DslBinding::CombinedImageSampler,  VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, VK_SHADER_STAGE_ALL,          NULL },
-					{ DslBinding::VertexUniformBuffer,   VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         1,                                VK_SHADER_STAGE_ALL,          NULL },
-					{ DslBinding::FragmentUniformBuffer, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,         1,                                VK_SHADER_STAGE_FRAGMENT_BIT, NULL },
+					{ DslBinding::VertexUniformBuffer,   VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,                                VK_SHADER_STAGE_ALL,          NULL },
+					{ DslBinding::FragmentUniformBuffer, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1,                                VK_SHADER_STAGE_FRAGMENT_BIT, NULL },
 //					{ DslBinding::StorageBuffer,         VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         BGFX_CONFIG_MAX_TEXTURE_SAMPLERS, VK_SHADER_STAGE_ALL,          NULL },
 				};
 
-				VkDescriptorPoolCreateInfo dpci;
-				dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-				dpci.pNext = NULL;
-				dpci.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
-				dpci.maxSets       = 10<<10;
-				dpci.poolSizeCount = BX_COUNTOF(dps);
-				dpci.pPoolSizes    = dps;
-
-				result = vkCreateDescriptorPool(m_device, &dpci, m_allocatorCb, &m_descriptorPool);
-
-				if (VK_SUCCESS != result)
-				{
-					BX_TRACE("Init error: vkCreateDescriptorPool failed %d: %s.", result, getName(result) );
-					goto error;
-				}
-
 				VkDescriptorSetLayoutCreateInfo dsl;
 				dsl.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 				dsl.pNext = NULL;
@@ -1874,14 +1951,46 @@ VK_IMPORT_DEVICE
 					goto error;
 				}
 
+				bx::HashMurmur2A murmur;
+				murmur.begin();
+				murmur.add("VkPipelineCache", 15);
+				murmur.add(m_deviceProperties.vendorID);
+				murmur.add(m_deviceProperties.deviceID);
+				murmur.add(m_deviceProperties.driverVersion);
+				murmur.add(m_deviceProperties.pipelineCacheUUID, VK_UUID_SIZE);
+				m_pipelineCacheId    = murmur.end();
+				m_pipelineCacheDirty = false;
+				m_pipelinePrewarmed  = false;
+
 				VkPipelineCacheCreateInfo pcci;
 				pcci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 				pcci.pNext = NULL;
 				pcci.flags = 0;
 				pcci.initialDataSize = 0;
 				pcci.pInitialData    = NULL;
+
+				void* cachedData = NULL;
+				uint32_t length = g_callback->cacheReadSize(m_pipelineCacheId);
+
+				if (0 < length)
+				{
+					cachedData = BX_ALLOC(g_allocator, length);
+					if (g_callback->cacheRead(m_pipelineCacheId, cachedData, length)
+					&&  isPipelineCacheCompatible(m_deviceProperties, cachedData, length) )
+					{
+						BX_TRACE("Loading cached pipeline cache (size %d).", length);
+						pcci.initialDataSize = length;
+						pcci.pInitialData    = cachedData;
+					}
+				}
+
 				result = vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &m_pipelineCache);
 
+				if (NULL != cachedData)
+				{
+					BX_FREE(g_allocator, cachedData);
+				}
+
 				if (VK_SUCCESS != result)
 				{
 					BX_TRACE("Init error: vkCreatePipelineCache failed %d: %s.", result, getName(result) );
@@ -1896,6 +2005,30 @@ VK_IMPORT_DEVICE
 					);
 			}
 
+			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
+			{
+				m_stagingBuffer[ii].create(0
+					+ BGFX_CONFIG_TRANSIENT_VERTEX_BUFFER_SIZE
+					+ BGFX_CONFIG_TRANSIENT_INDEX_BUFFER_SIZE
+					+ BGFX_CONFIG_FRAME_STAGING_SIZE
+					);
+			}
+
+			m_timerQuerySupport = true
+				&& m_deviceProperties.limits.timestampComputeAndGraphics
+				&& VK_SUCCESS == m_gpuScope.m_timer.create()
+				;
+
+			result = m_commandRecorder.init(BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS);
+
+			if (VK_SUCCESS != result)
+			{
+				BX_TRACE("Init warning: Failed to create command recorder %d: %s, views are recorded on render thread."
+					, result
+					, getName(result)
+					);
+			}
+
 			errorState = ErrorState::DescriptorCreated;
 
 			if (NULL == vkSetDebugUtilsObjectNameEXT)
@@ -1928,16 +2061,23 @@ VK_IMPORT_DEVICE
 			switch (errorState)
 			{
 			case ErrorState::DescriptorCreated:
+				for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
+				{
+					m_scratchBuffer[ii].destroy();
+					m_stagingBuffer[ii].destroy();
+				}
+
+				m_memoryAllocator.shutdown();
+				m_gpuScope.m_timer.destroy();
 				vkDestroy(m_pipelineCache);
 				vkDestroy(m_pipelineLayout);
 				vkDestroy(m_descriptorSetLayout);
-				vkDestroy(m_descriptorPool);
 				BX_FALLTHROUGH;
 
 			case ErrorState::CommandBuffersCreated:
 				vkFreeCommandBuffers(m_device, m_commandPool, BX_COUNTOF(m_commandBuffers), m_commandBuffers);
 				vkDestroy(m_commandPool);
-				vkDestroy(m_fence);
+				destroyFences();
 				BX_FALLTHROUGH;
 
 			case ErrorState::SwapchainCreated:
@@ -1957,6 +2097,11 @@ VK_IMPORT_DEVICE
 					{
 						vkDestroy(m_presentDone[ii]);
 					}
+
+					if (VK_NULL_HANDLE != m_renderDone[ii])
+					{
+						vkDestroy(m_renderDone[ii]);
+					}
 				}
 				vkDestroy(m_swapchain);
 				BX_FALLTHROUGH;
@@ -2002,13 +2147,24 @@ VK_IMPORT_DEVICE
 			VK_CHECK(vkQueueWaitIdle(m_queueGraphics) );
 			VK_CHECK(vkDeviceWaitIdle(m_device) );
 
+			m_commandRecorder.shutdown();
 			m_pipelineStateCache.invalidate();
 
+			m_bufferCopy.clear();
+
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_scratchBuffer); ++ii)
 			{
 				m_scratchBuffer[ii].destroy();
+				m_stagingBuffer[ii].destroy();
+			}
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameStaging); ++ii)
+			{
+				m_frameStaging[ii].destroy();
 			}
 
+			m_gpuScope.m_timer.destroy();
+
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameBuffers); ++ii)
 			{
 				m_frameBuffers[ii].destroy();
@@ -2034,14 +2190,21 @@ VK_IMPORT_DEVICE
 				m_textures[ii].destroy();
 			}
 
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_release); ++ii)
+			{
+				consume(ii);
+			}
+
+			m_memoryAllocator.shutdown();
+
+			savePipelineCache();
 			vkDestroy(m_pipelineCache);
 			vkDestroy(m_pipelineLayout);
 			vkDestroy(m_descriptorSetLayout);
-			vkDestroy(m_descriptorPool);
 
 			vkFreeCommandBuffers(m_device, m_commandPool, BX_COUNTOF(m_commandBuffers), m_commandBuffers);
 			vkDestroy(m_commandPool);
-			vkDestroy(m_fence);
+			destroyFences();
 
 			for (uint32_t ii = 0; ii < BX_COUNTOF(m_backBufferColorImageView); ++ii)
 			{
@@ -2059,6 +2222,11 @@ VK_IMPORT_DEVICE
 				{
 					vkDestroy(m_presentDone[ii]);
 				}
+
+				if (VK_NULL_HANDLE != m_renderDone[ii])
+				{
+					vkDestroy(m_renderDone[ii]);
+				}
 			}
 			vkDestroy(m_swapchain);
 
@@ -2107,8 +2275,8 @@ VK_IMPORT_DEVICE
 				VkPresentInfoKHR pi;
 				pi.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
 				pi.pNext = NULL;
-				pi.waitSemaphoreCount = 0;
-				pi.pWaitSemaphores    = NULL; //&m_presentDone[0];
+				pi.waitSemaphoreCount = 1;
+				pi.pWaitSemaphores    = &m_renderDone[m_presentIdx];
 				pi.swapchainCount = 1;
 				pi.pSwapchains    = &m_swapchain;
 				pi.pImageIndices  = &m_backBufferColorIdx;
@@ -2155,8 +2323,7 @@ VK_IMPORT_DEVICE
 
 		void updateDynamicIndexBuffer(IndexBufferHandle _handle, uint32_t _offset, uint32_t _size, const Memory* _mem) override
 		{
-			BX_UNUSED(_handle, _offset, _size, _mem);
-//			m_indexBuffers[_handle.idx].update(m_commandBuffer, _offset, bx::min<uint32_t>(_size, _mem->size), _mem->data);
+			m_indexBuffers[_handle.idx].update(m_commandBuffer, _offset, bx::min<uint32_t>(_size, _mem->size), _mem->data);
 		}
 
 		void destroyDynamicIndexBuffer(IndexBufferHandle _handle) override
@@ -2172,8 +2339,7 @@ VK_IMPORT_DEVICE
 
 		void updateDynamicVertexBuffer(VertexBufferHandle _handle, uint32_t _offset, uint32_t _size, const Memory* _mem) override
 		{
-			BX_UNUSED(_handle, _offset, _size, _mem);
-//			m_vertexBuffers[_handle.idx].update(m_commandBuffer, _offset, bx::min<uint32_t>(_size, _mem->size), _mem->data);
+			m_vertexBuffers[_handle.idx].update(m_commandBuffer, _offset, bx::min<uint32_t>(_size, _mem->size), _mem->data);
 		}
 
 		void destroyDynamicVertexBuffer(VertexBufferHandle _handle) override
@@ -2201,6 +2367,23 @@ VK_IMPORT_DEVICE
 			m_program[_handle.idx].destroy();
 		}
 
+		void prewarmPipeline(ProgramHandle _program, VertexDeclHandle _declHandle, FrameBufferHandle _fbh, uint64_t _state) override
+		{
+			// Pipeline hash includes frame buffer pipeline is created for.
+			const FrameBufferHandle fbh = m_fbh;
+			m_fbh = _fbh;
+
+			getPipeline(_state
+				, packStencil(BGFX_STENCIL_DEFAULT, BGFX_STENCIL_DEFAULT)
+				, _declHandle.idx
+				, _program
+				, 0
+				);
+
+			m_fbh = fbh;
+			m_pipelinePrewarmed = true;
+		}
+
 		void* createTexture(TextureHandle /*_handle*/, const Memory* /*_mem*/, uint64_t /*_flags*/, uint8_t /*_skip*/) override
 		{
 			return NULL;
@@ -2218,6 +2401,86 @@ VK_IMPORT_DEVICE
 		{
 		}
 
+		void* mapStagingBuffer(uint8_t _idx, uint32_t _size) override
+		{
+			// Area mapped for this frame before was consumed by its update
+			// commands, it's free once GPU is done copying from it.
+			m_frameStagingMapped[_idx] = UINT8_MAX;
+
+			updateFrameCompleted();
+
+			uint32_t idx = findFreeFrameStaging();
+			if (UINT32_MAX == idx)
+			{
+				finishAll();
+				m_frameCompleted = m_frameCount;
+				idx = findFreeFrameStaging();
+			}
+
+			StagingBufferVK& sb = m_frameStaging[idx];
+			if (sb.m_size < _size)
+			{
+				sb.destroy();
+				sb.create(_size);
+			}
+
+			m_frameStagingMapped[_idx] = uint8_t(idx);
+
+			return sb.m_memory.m_data;
+		}
+
+		void unmapStagingBuffer(uint8_t _idx, uint32_t /*_size*/) override
+		{
+			// Memory is host coherent, nothing to flush. Copies sourced from it
+			// are recorded into the next kicked frame.
+			const uint8_t idx = m_frameStagingMapped[_idx];
+			if (UINT8_MAX != idx)
+			{
+				m_frameStagingUsed[idx] = m_frameCount + 1;
+			}
+		}
+
+		uint32_t findFreeFrameStaging() const
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameStaging); ++ii)
+			{
+				bool mapped = false;
+				for (uint32_t jj = 0; jj < BX_COUNTOF(m_frameStagingMapped); ++jj)
+				{
+					mapped |= ii == m_frameStagingMapped[jj];
+				}
+
+				if (!mapped
+				&&  m_frameStagingUsed[ii] <= m_frameCompleted)
+				{
+					return ii;
+				}
+			}
+
+			return UINT32_MAX;
+		}
+
+		const StagingBufferVK* findFrameStaging(const void* _data) const
+		{
+			const uint8_t* data = (const uint8_t*)_data;
+
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_frameStagingMapped); ++ii)
+			{
+				const uint8_t idx = m_frameStagingMapped[ii];
+				if (UINT8_MAX != idx)
+				{
+					const StagingBufferVK& sb = m_frameStaging[idx];
+					if (data >= sb.m_memory.m_data
+					&&  data <  sb.m_memory.m_data + sb.m_size)
+					{
+						return &sb;
+					}
+				}
+			}
+
+			return NULL;
+		}
+
 		void readTexture(TextureHandle /*_handle*/, void* /*_data*/, uint8_t /*_mip*/) override
 		{
 		}
@@ -2255,11 +2518,11 @@ VK_IMPORT_DEVICE
 		{
 			if (NULL != m_uniforms[_handle.idx])
 			{
-				BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+				BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			}
 
 			uint32_t size = BX_ALIGN_16(g_uniformTypeSize[_type] * _num);
-			void* data = BX_ALLOC(g_allocator, size);
+			void* data = BX_ALLOC(getAllocator(MemoryTag::Renderer), size);
 			bx::memSet(data, 0, size);
 			m_uniforms[_handle.idx] = data;
 			m_uniformReg.add(_handle, _name);
@@ -2267,7 +2530,7 @@ VK_IMPORT_DEVICE
 
 		void destroyUniform(UniformHandle _handle) override
 		{
-			BX_FREE(g_allocator, m_uniforms[_handle.idx]);
+			BX_FREE(getAllocator(MemoryTag::Renderer), m_uniforms[_handle.idx]);
 			m_uniforms[_handle.idx] = NULL;
 		}
 
@@ -2293,12 +2556,42 @@ VK_IMPORT_DEVICE
 			BX_UNUSED(_handle);
 		}
 
+		bool createFence(FenceHandle _handle) override
+		{
+			// Fence is created with post commands, after frame is kicked. GPU
+			// work recorded by them goes to the next frame, it's signaled
+			// once that frame completes.
+			m_fenceValue[_handle.idx] = m_frameCount + 1;
+			return true;
+		}
+
+		bool isFenceSignaled(FenceHandle _handle) override
+		{
+			updateFrameCompleted();
+			return m_fenceValue[_handle.idx] <= m_frameCompleted;
+		}
+
+		void destroyFence(FenceHandle _handle) override
+		{
+			BX_UNUSED(_handle);
+		}
+
 		void setMarker(const char* _marker, uint16_t _len) override
 		{
 			if (BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
 			{
 				BX_UNUSED(_len);
 
+				if (m_renderCommandList.isRecording() )
+				{
+					RenderCommandVK cmd;
+					cmd.clear();
+					cmd.m_type   = RenderCommandVK::Type::Marker;
+					cmd.m_marker = _marker;
+					m_renderCommandList.push(cmd);
+					return;
+				}
+
 				VkDebugUtilsLabelEXT dul;
 				dul.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
 				dul.pNext = NULL;
@@ -2311,6 +2604,16 @@ VK_IMPORT_DEVICE
 			}
 		}
 
+		void beginGpuScope(const char* _name, uint16_t _len) override
+		{
+			m_gpuScope.begin(_name, _len);
+		}
+
+		void endGpuScope() override
+		{
+			m_gpuScope.end();
+		}
+
 		virtual void setName(Handle _handle, const char* _name, uint16_t _len) override
 		{
 			switch (_handle.type)
@@ -2339,6 +2642,8 @@ VK_IMPORT_DEVICE
 
 		void submitBlit(BlitState& _bs, uint16_t _view);
 
+		void submitViews(VkRenderPassBeginInfo& _rpbi);
+
 		void submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter) override;
 
 		void blitSetup(TextVideoMemBlitter& /*_blitter*/) override
@@ -2365,6 +2670,8 @@ VK_IMPORT_DEVICE
 			if (m_depthClamp != depthClamp)
 			{
 				m_depthClamp = depthClamp;
+
+				finishAll();
 				m_pipelineStateCache.invalidate();
 			}
 
@@ -2453,7 +2760,7 @@ VK_IMPORT_DEVICE
 			setShaderUniform(_flags, _regIndex, _val, _numRegs);
 		}
 
-		void commitShaderUniforms(VkCommandBuffer _commandBuffer, ProgramHandle _program)
+		bool commitShaderUniforms(ProgramHandle _program, StateCounter& _stateCounter, VkDescriptorSet& _descriptorSet, uint32_t* _dynamicOffsets)
 		{
 			const ProgramVK& program = m_program[_program.idx];
 
@@ -2462,11 +2769,14 @@ VK_IMPORT_DEVICE
 			const uint32_t fsize = bx::strideAlign( (NULL != program.m_fsh ? program.m_fsh->m_size : 0), align);
 			const uint32_t total = vsize + fsize;
 
+			m_vsChanges = 0;
+			m_fsChanges = 0;
+
 			if (0 < total)
 			{
-				ScratchBufferVK& sb = m_scratchBuffer[m_backBufferColorIdx];
+				ScratchBufferVK& sb = m_scratchBuffer[m_frameIdx];
 
-				uint8_t* data = (uint8_t*)sb.allocUbv(vsize, fsize);
+				uint8_t* data = (uint8_t*)sb.allocUbv(vsize, fsize, _dynamicOffsets);
 
 				bx::memCopy(data, m_vsScratch, program.m_vsh->m_size);
 				data += vsize;
@@ -2476,19 +2786,19 @@ VK_IMPORT_DEVICE
 					bx::memCopy(data, m_fsScratch, program.m_fsh->m_size);
 				}
 
-				vkCmdBindDescriptorSets(_commandBuffer
-					, VK_PIPELINE_BIND_POINT_GRAPHICS
-					, m_pipelineLayout
-					, 0
-					, 1
-					, &sb.m_descriptorSet[sb.m_currentDs - 1]
-					, 0
-					, NULL
+				// Both bindings must reference valid range, even when stage has
+				// no uniforms.
+				bool cached;
+				_descriptorSet = sb.getDescriptorSet(0 != vsize ? vsize : fsize
+					, 0 != fsize ? fsize : vsize
+					, cached
 					);
+				_stateCounter.bindCache(cached);
+
+				return true;
 			}
 
-			m_vsChanges = 0;
-			m_fsChanges = 0;
+			return false;
 		}
 
 		void setFrameBuffer(FrameBufferHandle _fbh, bool _msaa = true)
@@ -2766,6 +3076,27 @@ VK_IMPORT_DEVICE
 			return num;
 		}
 
+		void savePipelineCache()
+		{
+			if (!m_pipelineCacheDirty)
+			{
+				return;
+			}
+
+			m_pipelineCacheDirty = false;
+
+			size_t dataSize;
+			VK_CHECK(vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, NULL) );
+
+			if (0 < dataSize)
+			{
+				void* data = BX_ALLOC(g_allocator, dataSize);
+				VK_CHECK(vkGetPipelineCacheData(m_device, m_pipelineCache, &dataSize, data) );
+				g_callback->cacheWrite(m_pipelineCacheId, data, (uint32_t)dataSize);
+				BX_FREE(g_allocator, data);
+			}
+		}
+
 		VkPipeline getPipeline(ProgramHandle _program)
 		{
 			BX_UNUSED(_program);
@@ -2923,63 +3254,15 @@ VK_IMPORT_DEVICE
 			graphicsPipeline.basePipelineHandle = VK_NULL_HANDLE;
 			graphicsPipeline.basePipelineIndex  = 0;
 
-			uint32_t length = g_callback->cacheReadSize(hash);
-			bool cached = length > 0;
-
-			void* cachedData = NULL;
-
-			VkPipelineCacheCreateInfo pcci;
-			pcci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-			pcci.pNext = NULL;
-			pcci.flags = 0;
-			pcci.initialDataSize = 0;
-			pcci.pInitialData    = NULL;
-
-			if (cached)
-			{
-				cachedData = BX_ALLOC(g_allocator, length);
-				if (g_callback->cacheRead(hash, cachedData, length) )
-				{
-					BX_TRACE("Loading cached pipeline state (size %d).", length);
-					bx::MemoryReader reader(cachedData, length);
-
-					pcci.initialDataSize = (size_t)reader.remaining();
-					pcci.pInitialData    = reader.getDataPtr();
-				}
-			}
-
-			VkPipelineCache cache;
-			VK_CHECK(vkCreatePipelineCache(m_device, &pcci, m_allocatorCb, &cache) );
-
 			VK_CHECK(vkCreateGraphicsPipelines(m_device
-				, cache
+				, m_pipelineCache
 				, 1
 				, &graphicsPipeline
 				, m_allocatorCb
 				, &pipeline
 				) );
 			m_pipelineStateCache.add(hash, pipeline);
-
-			size_t dataSize;
-			VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, NULL) );
-
-			if (0 < dataSize)
-			{
-				if (length < dataSize)
-				{
-					cachedData = BX_REALLOC(g_allocator, cachedData, dataSize);
-				}
-				VK_CHECK(vkGetPipelineCacheData(m_device, cache, &dataSize, cachedData) );
-				g_callback->cacheWrite(hash, cachedData, (uint32_t)dataSize);
-			}
-
-			VK_CHECK(vkMergePipelineCaches(m_device, m_pipelineCache, 1, &cache) );
-			vkDestroy(cache);
-
-			if (NULL != cachedData)
-			{
-				BX_FREE(g_allocator, cachedData);
-			}
+			m_pipelineCacheDirty = true;
 
 			return pipeline;
 		}
@@ -3064,15 +3347,15 @@ VK_IMPORT_DEVICE
 			}
 		}
 
-		void clearQuad(const Rect& _rect, const Clear& _clear, const float _palette[][4])
+		void clearQuad(ViewCommandsVK& _view, const Rect& _rect, const Clear& _clear, const float _palette[][4])
 		{
-			VkClearRect rect[1];
-			rect[0].rect.offset.x      = _rect.m_x;
-			rect[0].rect.offset.y      = _rect.m_y;
-			rect[0].rect.extent.width  = _rect.m_width;
-			rect[0].rect.extent.height = _rect.m_height;
-			rect[0].baseArrayLayer = 0;
-			rect[0].layerCount     = 1;
+			VkClearRect& rect = _view.m_clearRect;
+			rect.rect.offset.x      = _rect.m_x;
+			rect.rect.offset.y      = _rect.m_y;
+			rect.rect.extent.width  = _rect.m_width;
+			rect.rect.extent.height = _rect.m_height;
+			rect.baseArrayLayer = 0;
+			rect.layerCount     = 1;
 
 			uint32_t numMrt = 1;
 //			FrameBufferHandle fbh = m_fbh;
@@ -3082,7 +3365,7 @@ VK_IMPORT_DEVICE
 //				numMrt = bx::max(1, fb.m_num);
 //			}
 
-			VkClearAttachment attachments[BGFX_CONFIG_MAX_FRAME_BUFFERS];
+			VkClearAttachment* attachments = _view.m_clear;
 			uint32_t mrt = 0;
 
 			if (true //NULL != m_currentColor
@@ -3132,18 +3415,13 @@ VK_IMPORT_DEVICE
 				++mrt;
 			}
 
- 			vkCmdClearAttachments(m_commandBuffer
-				, mrt
-				, attachments
-				, BX_COUNTOF(rect)
-				, rect
-				);
+			_view.m_numClear = mrt;
 		}
 
-		uint64_t kick(VkSemaphore _wait = VK_NULL_HANDLE, VkSemaphore _signal = VK_NULL_HANDLE)
+		void kick(VkSemaphore _wait = VK_NULL_HANDLE, VkSemaphore _signal = VK_NULL_HANDLE, VkFence _fence = VK_NULL_HANDLE)
 		{
 			VkPipelineStageFlags stageFlags = 0
-				| VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+				| VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT
 				;
 
 			VkSubmitInfo si;
@@ -3153,13 +3431,11 @@ VK_IMPORT_DEVICE
 			si.pWaitSemaphores    = &_wait;
 			si.pWaitDstStageMask  = &stageFlags;
 			si.commandBufferCount = 1;
-			si.pCommandBuffers    = &m_commandBuffers[m_backBufferColorIdx];
+			si.pCommandBuffers    = &m_commandBuffer;
 			si.signalSemaphoreCount = VK_NULL_HANDLE != _signal;
 			si.pSignalSemaphores    = &_signal;
 
-//			VK_CHECK(vkResetFences(m_device, 1, &m_fence) );
-			VK_CHECK(vkQueueSubmit(m_queueGraphics, 1, &si, VK_NULL_HANDLE) );
-			return 0;
+			VK_CHECK(vkQueueSubmit(m_queueGraphics, 1, &si, _fence) );
 		}
 
 		void finish()
@@ -3170,49 +3446,321 @@ VK_IMPORT_DEVICE
 		void finishAll()
 		{
 			VK_CHECK(vkQueueWaitIdle(m_queueGraphics) );
-//			VK_CHECK(vkWaitForFences(m_device, 1, &m_fence, true, INT64_MAX) );
 		}
 
-		uint32_t selectMemoryType(uint32_t _memoryTypeBits, uint32_t _propertyFlags) const
+		void updateFrameCompleted()
 		{
-			for (uint32_t ii = 0, num = m_memoryProperties.memoryTypeCount; ii < num; ++ii)
+			// Slot's fence is reset only right before the slot is reused, and
+			// its frame number is already completed by then.
+			for (uint32_t ii = 0; ii < m_numFramesInFlight; ++ii)
 			{
-				const VkMemoryType& memType = m_memoryProperties.memoryTypes[ii];
-				if ( (0 != ( (1<<ii) & _memoryTypeBits) )
-				&& ( (memType.propertyFlags & _propertyFlags) == _propertyFlags) )
+				if (m_fenceFrame[ii] > m_frameCompleted
+				&&  VK_SUCCESS == vkGetFenceStatus(m_device, m_fence[ii]) )
 				{
-					return ii;
+					m_frameCompleted = m_fenceFrame[ii];
 				}
 			}
-
-			BX_TRACE("Failed to find memory that supports flags 0x%08x.", _propertyFlags);
-			return 0;
 		}
 
-		VkAllocationCallbacks*   m_allocatorCb;
-		VkDebugReportCallbackEXT m_debugReportCallback;
-		VkInstance       m_instance;
-		VkPhysicalDevice m_physicalDevice;
+		void waitFrame(uint32_t _frameIdx)
+		{
+			VK_CHECK(vkWaitForFences(m_device, 1, &m_fence[_frameIdx], VK_TRUE, UINT64_MAX) );
+			VK_CHECK(vkResetFences(m_device, 1, &m_fence[_frameIdx]) );
 
-		VkPhysicalDeviceProperties       m_deviceProperties;
-		VkPhysicalDeviceMemoryProperties m_memoryProperties;
+			m_frameCompleted = bx::max(m_frameCompleted, m_fenceFrame[_frameIdx]);
 
-		VkSwapchainCreateInfoKHR m_sci;
-		VkSurfaceKHR     m_surface;
-		VkSwapchainKHR   m_swapchain;
-		VkImage          m_backBufferColorImage[4];
-		VkImageView      m_backBufferColorImageView[4];
-		VkFramebuffer    m_backBufferColor[4];
-		VkCommandBuffer  m_commandBuffers[4];
-		VkCommandBuffer  m_commandBuffer;
+			consume(_frameIdx);
+		}
 
-		VkFormat         m_backBufferDepthStencilFormat;
-		VkDeviceMemory   m_backBufferDepthStencilMemory;
-		VkImage          m_backBufferDepthStencilImage;
-		VkImageView      m_backBufferDepthStencilImageView;
+		void release(VkBuffer& _buffer, DeviceMemoryAllocationVK& _memory)
+		{
+			ReleaseVK item;
+			item.m_buffer = _buffer;
+			item.m_memory = _memory;
+			m_release[m_frameIdx].push_back(item);
 
-		ScratchBufferVK  m_scratchBuffer[4];
-		VkSemaphore      m_presentDone[4];
+			_buffer = VK_NULL_HANDLE;
+			_memory = DeviceMemoryAllocationVK();
+		}
+
+		void consume(uint32_t _frameIdx)
+		{
+			ReleaseArray& ra = m_release[_frameIdx];
+			for (ReleaseArray::iterator it = ra.begin(), itEnd = ra.end(); it != itEnd; ++it)
+			{
+				vkDestroy(it->m_buffer);
+				m_memoryAllocator.free(it->m_memory);
+			}
+			ra.clear();
+		}
+
+		void beginFrame()
+		{
+			if (m_frameBegun)
+			{
+				return;
+			}
+
+			// Wait only for the frame that last used this slot, instead of
+			// draining the queue, so CPU can record while GPU is still busy
+			// with up to m_numFramesInFlight previous frames.
+			m_frameIdx = (m_frameIdx + 1) % m_numFramesInFlight;
+			waitFrame(m_frameIdx);
+
+			VkDescriptorBufferInfo descriptorBufferInfo;
+			m_scratchBuffer[m_frameIdx].reset(descriptorBufferInfo);
+			m_stagingBuffer[m_frameIdx].reset();
+			m_commandRecorder.reset(m_frameIdx);
+
+			VkCommandBufferBeginInfo cbbi;
+			cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			cbbi.pNext = NULL;
+			cbbi.flags = 0
+				| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+//				| VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
+				;
+			cbbi.pInheritanceInfo = NULL;
+
+			m_commandBuffer = m_commandBuffers[m_frameIdx];
+			VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
+
+			if (m_timerQuerySupport)
+			{
+				m_gpuScope.m_timer.resetQueries(m_commandBuffer);
+			}
+
+			m_frameBegun = true;
+		}
+
+		void copyBuffer(VkBuffer _dst, uint32_t _offset, uint32_t _size, const void* _data)
+		{
+			// Updates come before submit starts recording the frame, so copies
+			// are recorded into the frame command buffer ahead of first render
+			// pass by flushCopies.
+			beginFrame();
+
+			// Regions of single vkCmdCopyBuffer must not overlap, flush pending
+			// copies when same part of buffer is updated twice in a frame.
+			for (BufferCopyArray::const_iterator it = m_bufferCopy.begin(), itEnd = m_bufferCopy.end(); it != itEnd; ++it)
+			{
+				if (it->m_dst == _dst
+				&&  it->m_region.dstOffset < _offset + _size
+				&&  _offset < it->m_region.dstOffset + it->m_region.size)
+				{
+					flushCopies();
+					break;
+				}
+			}
+
+			BufferCopyVK copy;
+			copy.m_dst = _dst;
+			copy.m_region.dstOffset = _offset;
+			copy.m_region.size      = _size;
+
+			const StagingBufferVK* frameStaging = findFrameStaging(_data);
+			StagingBufferVK& sb = m_stagingBuffer[m_frameIdx];
+			const uint32_t offset = NULL == frameStaging ? sb.alloc(_size) : UINT32_MAX;
+
+			if (NULL != frameStaging)
+			{
+				// Data was written by application directly into staging area.
+				copy.m_src = frameStaging->m_buffer;
+				copy.m_region.srcOffset = (const uint8_t*)_data - frameStaging->m_memory.m_data;
+			}
+			else if (UINT32_MAX != offset)
+			{
+				bx::memCopy(sb.m_memory.m_data + offset, _data, _size);
+				copy.m_src = sb.m_buffer;
+				copy.m_region.srcOffset = offset;
+			}
+			else
+			{
+				// Staging ring is full, use temporary staging buffer released
+				// once frame is done.
+				VkBufferCreateInfo bci;
+				bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+				bci.pNext = NULL;
+				bci.flags = 0;
+				bci.size  = _size;
+				bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+				bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+				bci.queueFamilyIndexCount = 0;
+				bci.pQueueFamilyIndices   = NULL;
+
+				VkBuffer staging;
+				VK_CHECK(vkCreateBuffer(m_device, &bci, m_allocatorCb, &staging) );
+
+				VkMemoryRequirements mr;
+				vkGetBufferMemoryRequirements(m_device, staging, &mr);
+
+				DeviceMemoryAllocationVK stagingMemory;
+				VK_CHECK(m_memoryAllocator.alloc(mr
+					, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT|VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+					, true
+					, stagingMemory
+					) );
+				VK_CHECK(vkBindBufferMemory(m_device, staging, stagingMemory.m_memory, stagingMemory.m_offset) );
+
+				bx::memCopy(stagingMemory.m_data, _data, _size);
+
+				copy.m_src = staging;
+				copy.m_region.srcOffset = 0;
+
+				release(staging, stagingMemory);
+			}
+
+			m_bufferCopy.push_back(copy);
+		}
+
+		static int32_t compareBufferCopy(const void* _lhs, const void* _rhs)
+		{
+			const BufferCopyVK& lhs = *(const BufferCopyVK*)_lhs;
+			const BufferCopyVK& rhs = *(const BufferCopyVK*)_rhs;
+
+			if (lhs.m_dst != rhs.m_dst)
+			{
+				return lhs.m_dst < rhs.m_dst ? -1 : 1;
+			}
+
+			if (lhs.m_src != rhs.m_src)
+			{
+				return lhs.m_src < rhs.m_src ? -1 : 1;
+			}
+
+			return lhs.m_region.dstOffset < rhs.m_region.dstOffset ? -1 : 1;
+		}
+
+		void flushCopies()
+		{
+			if (m_bufferCopy.empty() )
+			{
+				return;
+			}
+
+			BGFX_PROFILER_SCOPE("bgfx/Flush buffer copies", kColorResource);
+
+			bx::quickSort(&m_bufferCopy[0], uint32_t(m_bufferCopy.size() ), sizeof(BufferCopyVK), compareBufferCopy);
+
+			// Merge copies that are contiguous in both staging and destination
+			// buffer, and batch all regions between same buffers into single
+			// vkCmdCopyBuffer.
+			m_bufferCopyRegion.clear();
+
+			VkMemoryBarrier mb;
+			mb.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+			mb.pNext = NULL;
+			mb.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			mb.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+
+			// Previous frames might still read from destination buffers.
+			vkCmdPipelineBarrier(m_commandBuffer
+				, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT|VK_PIPELINE_STAGE_TRANSFER_BIT
+				, VK_PIPELINE_STAGE_TRANSFER_BIT
+				, 0
+				, 1
+				, &mb
+				, 0
+				, NULL
+				, 0
+				, NULL
+				);
+
+			for (uint32_t ii = 0, num = uint32_t(m_bufferCopy.size() ); ii < num;)
+			{
+				const BufferCopyVK& first = m_bufferCopy[ii];
+				m_bufferCopyRegion.push_back(first.m_region);
+
+				for (++ii; ii < num && m_bufferCopy[ii].m_src == first.m_src && m_bufferCopy[ii].m_dst == first.m_dst; ++ii)
+				{
+					const VkBufferCopy& region = m_bufferCopy[ii].m_region;
+					VkBufferCopy& last = m_bufferCopyRegion.back();
+
+					if (last.srcOffset + last.size == region.srcOffset
+					&&  last.dstOffset + last.size == region.dstOffset)
+					{
+						last.size += region.size;
+					}
+					else
+					{
+						m_bufferCopyRegion.push_back(region);
+					}
+				}
+
+				vkCmdCopyBuffer(m_commandBuffer
+					, first.m_src
+					, first.m_dst
+					, uint32_t(m_bufferCopyRegion.size() )
+					, &m_bufferCopyRegion[0]
+					);
+				m_bufferCopyRegion.clear();
+			}
+
+			mb.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			mb.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT|VK_ACCESS_INDEX_READ_BIT;
+			vkCmdPipelineBarrier(m_commandBuffer
+				, VK_PIPELINE_STAGE_TRANSFER_BIT
+				, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+				, 0
+				, 1
+				, &mb
+				, 0
+				, NULL
+				, 0
+				, NULL
+				);
+
+			m_bufferCopy.clear();
+		}
+
+		void destroyFences()
+		{
+			for (uint32_t ii = 0; ii < BX_COUNTOF(m_fence); ++ii)
+			{
+				vkDestroy(m_fence[ii]);
+			}
+		}
+
+		uint32_t selectMemoryType(uint32_t _memoryTypeBits, uint32_t _propertyFlags) const
+		{
+			for (uint32_t ii = 0, num = m_memoryProperties.memoryTypeCount; ii < num; ++ii)
+			{
+				const VkMemoryType& memType = m_memoryProperties.memoryTypes[ii];
+				if ( (0 != ( (1<<ii) & _memoryTypeBits) )
+				&& ( (memType.propertyFlags & _propertyFlags) == _propertyFlags) )
+				{
+					return ii;
+				}
+			}
+
+			BX_TRACE("Failed to find memory that supports flags 0x%08x.", _propertyFlags);
+			return 0;
+		}
+
+		VkAllocationCallbacks*   m_allocatorCb;
+		VkDebugReportCallbackEXT m_debugReportCallback;
+		VkInstance       m_instance;
+		VkPhysicalDevice m_physicalDevice;
+
+		VkPhysicalDeviceProperties       m_deviceProperties;
+		VkPhysicalDeviceMemoryProperties m_memoryProperties;
+
+		VkSwapchainCreateInfoKHR m_sci;
+		VkSurfaceKHR     m_surface;
+		VkSwapchainKHR   m_swapchain;
+		VkImage          m_backBufferColorImage[4];
+		VkImageView      m_backBufferColorImageView[4];
+		VkFramebuffer    m_backBufferColor[4];
+		VkCommandBuffer  m_commandBuffers[4];
+		VkCommandBuffer  m_commandBuffer;
+
+		VkFormat         m_backBufferDepthStencilFormat;
+		VkDeviceMemory   m_backBufferDepthStencilMemory;
+		VkImage          m_backBufferDepthStencilImage;
+		VkImageView      m_backBufferDepthStencilImageView;
+
+		ScratchBufferVK  m_scratchBuffer[4];
+		VkSemaphore      m_presentDone[4];
+		VkSemaphore      m_renderDone[4];
 
 		uint32_t m_qfiGraphics;
 		uint32_t m_qfiCompute;
@@ -3220,12 +3768,14 @@ VK_IMPORT_DEVICE
 		VkDevice m_device;
 		VkQueue  m_queueGraphics;
 		VkQueue  m_queueCompute;
-		VkFence  m_fence;
+		VkFence  m_fence[4];
 		VkRenderPass m_renderPass;
-		VkDescriptorPool m_descriptorPool;
 		VkDescriptorSetLayout m_descriptorSetLayout;
 		VkPipelineLayout m_pipelineLayout;
 		VkPipelineCache m_pipelineCache;
+		uint32_t m_pipelineCacheId;
+		bool m_pipelineCacheDirty;
+		bool m_pipelinePrewarmed;
 		VkCommandPool m_commandPool;
 
 		void* m_renderDocDll;
@@ -3244,10 +3794,13 @@ VK_IMPORT_DEVICE
 
 		StateCacheT<VkPipeline> m_pipelineStateCache;
 
+		GpuScopeProfiler<GpuScopeTimerVK> m_gpuScope;
+
 		Resolution m_resolution;
 		uint32_t m_maxAnisotropy;
 		bool m_depthClamp;
 		bool m_wireframe;
+		bool m_timerQuerySupport;
 
 		TextVideoMem m_textVideoMem;
 
@@ -3258,16 +3811,63 @@ VK_IMPORT_DEVICE
 
 		uint32_t m_backBufferColorIdx;
 		FrameBufferHandle m_fbh;
+
+		struct BufferCopyVK
+		{
+			VkBuffer m_src;
+			VkBuffer m_dst;
+			VkBufferCopy m_region;
+		};
+
+		typedef stl::vector<BufferCopyVK> BufferCopyArray;
+		BufferCopyArray m_bufferCopy;
+
+		typedef stl::vector<VkBufferCopy> BufferCopyRegionArray;
+		BufferCopyRegionArray m_bufferCopyRegion;
+
+		StagingBufferVK m_stagingBuffer[4];
+
+		// Staging areas returned by mapStagingBuffer, one is mapped per
+		// frame, and others wait for GPU to finish copying from them.
+		StagingBufferVK m_frameStaging[BX_COUNTOF(m_stagingBuffer)+3];
+		uint64_t m_frameStagingUsed[BX_COUNTOF(m_frameStaging)];
+		uint8_t  m_frameStagingMapped[BGFX_CONFIG_MULTITHREADED ? 2 : 1];
+
+		struct ReleaseVK
+		{
+			VkBuffer m_buffer;
+			DeviceMemoryAllocationVK m_memory;
+		};
+
+		typedef stl::vector<ReleaseVK> ReleaseArray;
+		ReleaseArray m_release[4];
+
+		uint64_t m_fenceFrame[4];
+		uint64_t m_fenceValue[BGFX_CONFIG_MAX_FENCES];
+		uint64_t m_frameCount;
+		uint64_t m_frameCompleted;
+		uint32_t m_frameIdx;
+		uint32_t m_presentIdx;
+		uint32_t m_numFramesInFlight;
+		bool m_frameBegun;
+
+		DeviceMemoryAllocatorVK m_memoryAllocator;
+
+		RenderCommandListVK m_renderCommandList;
+		CommandRecorderVK   m_commandRecorder;
+
+		typedef stl::vector<VkCommandBuffer> CommandBufferArray;
+		CommandBufferArray m_secondaryCommandBuffers;
 	};
 
 	static RendererContextVK* s_renderVK;
 
 	RendererContextI* rendererCreate(const Init& _init)
 	{
-		s_renderVK = BX_NEW(g_allocator, RendererContextVK);
+		s_renderVK = BX_NEW(getAllocator(MemoryTag::Renderer), RendererContextVK);
 		if (!s_renderVK->init(_init) )
 		{
-			BX_DELETE(g_allocator, s_renderVK);
+			BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderVK);
 			s_renderVK = NULL;
 		}
 		return s_renderVK;
@@ -3276,7 +3876,7 @@ VK_IMPORT_DEVICE
 	void rendererDestroy()
 	{
 		s_renderVK->shutdown();
-		BX_DELETE(g_allocator, s_renderVK);
+		BX_DELETE(getAllocator(MemoryTag::Renderer), s_renderVK);
 		s_renderVK = NULL;
 	}
 
@@ -3292,146 +3892,1097 @@ VK_IMPORT_DEVICE
 VK_DESTROY
 #undef VK_DESTROY_FUNC
 
-	void ScratchBufferVK::create(uint32_t _size, uint32_t _maxDescriptors)
+	DeviceMemoryAllocatorVK::DeviceMemoryAllocatorVK()
+		: m_used(0)
+		, m_allocated(0)
+		, m_numBlocks(0)
+		, m_numDedicated(0)
+	{
+	}
+
+	void DeviceMemoryAllocatorVK::shutdown()
+	{
+		BX_WARN(0 == m_used, "Leaked %d bytes of device memory.", int32_t(m_used) );
+
+		for (BlockArray::iterator it = m_block.begin(), itEnd = m_block.end(); it != itEnd; ++it)
+		{
+			if (VK_NULL_HANDLE != it->m_memory)
+			{
+				freeMemory(it->m_memory, it->m_data, it->m_size);
+			}
+		}
+
+		m_block.clear();
+		m_numBlocks = 0;
+	}
+
+	VkResult DeviceMemoryAllocatorVK::alloc(const VkMemoryRequirements& _requirements, uint32_t _propertyFlags, bool _linear, DeviceMemoryAllocationVK& _allocation)
+	{
+		const uint32_t memoryTypeIndex = s_renderVK->selectMemoryType(_requirements.memoryTypeBits, _propertyFlags);
+		const VkDeviceSize blockSize = BGFX_CONFIG_RENDERER_VULKAN_MEMORY_BLOCK_SIZE;
+
+		if (_requirements.size > blockSize/2)
+		{
+			VkResult result = allocMemory(_requirements.size, memoryTypeIndex, _allocation.m_memory, _allocation.m_data);
+
+			if (VK_SUCCESS == result)
+			{
+				_allocation.m_offset = 0;
+				_allocation.m_size   = _requirements.size;
+				_allocation.m_block  = UINT32_MAX;
+
+				m_used += int64_t(_requirements.size);
+				++m_numDedicated;
+			}
+
+			return result;
+		}
+
+		uint32_t block  = UINT32_MAX;
+		uint32_t unused = UINT32_MAX;
+		VkDeviceSize offset = 0;
+
+		for (uint32_t ii = 0, num = uint32_t(m_block.size() ); ii < num; ++ii)
+		{
+			const Block& candidate = m_block[ii];
+
+			if (VK_NULL_HANDLE == candidate.m_memory)
+			{
+				unused = UINT32_MAX == unused ? ii : unused;
+			}
+			else if (candidate.m_memoryTypeIndex == memoryTypeIndex
+			&&       candidate.m_linear == _linear
+			&&       allocRange(ii, _requirements.size, _requirements.alignment, offset) )
+			{
+				block = ii;
+				break;
+			}
+		}
+
+		if (UINT32_MAX == block)
+		{
+			if (UINT32_MAX == unused)
+			{
+				unused = uint32_t(m_block.size() );
+				m_block.push_back(Block() );
+			}
+
+			Block& newBlock = m_block[unused];
+			VkResult result = allocMemory(blockSize, memoryTypeIndex, newBlock.m_memory, newBlock.m_data);
+
+			if (VK_SUCCESS != result)
+			{
+				newBlock.m_memory = VK_NULL_HANDLE;
+				return result;
+			}
+
+			Range range = { 0, blockSize };
+			newBlock.m_size = blockSize;
+			newBlock.m_memoryTypeIndex = memoryTypeIndex;
+			newBlock.m_linear = _linear;
+			newBlock.m_free.clear();
+			newBlock.m_free.push_back(range);
+			++m_numBlocks;
+
+			block = unused;
+			allocRange(block, _requirements.size, _requirements.alignment, offset);
+		}
+
+		const Block& owner = m_block[block];
+		_allocation.m_memory = owner.m_memory;
+		_allocation.m_offset = offset;
+		_allocation.m_size   = _requirements.size;
+		_allocation.m_data   = NULL != owner.m_data ? owner.m_data + offset : NULL;
+		_allocation.m_block  = block;
+
+		m_used += int64_t(_requirements.size);
+
+		return VK_SUCCESS;
+	}
+
+	void DeviceMemoryAllocatorVK::free(DeviceMemoryAllocationVK& _allocation)
+	{
+		if (VK_NULL_HANDLE == _allocation.m_memory)
+		{
+			return;
+		}
+
+		m_used -= int64_t(_allocation.m_size);
+
+		if (UINT32_MAX == _allocation.m_block)
+		{
+			freeMemory(_allocation.m_memory, _allocation.m_data, _allocation.m_size);
+			--m_numDedicated;
+		}
+		else
+		{
+			Block& block = m_block[_allocation.m_block];
+			RangeArray& ranges = block.m_free;
+
+			// Free ranges are kept sorted by offset, merge with neighbours.
+			uint32_t idx = 0;
+			for (uint32_t num = uint32_t(ranges.size() ); idx < num && ranges[idx].m_offset < _allocation.m_offset; ++idx)
+			{
+			}
+
+			Range range = { _allocation.m_offset, _allocation.m_size };
+
+			if (idx < ranges.size()
+			&&  range.m_offset + range.m_size == ranges[idx].m_offset)
+			{
+				range.m_size += ranges[idx].m_size;
+				ranges.erase(ranges.begin() + idx);
+			}
+
+			if (0 < idx
+			&&  ranges[idx-1].m_offset + ranges[idx-1].m_size == range.m_offset)
+			{
+				ranges[idx-1].m_size += range.m_size;
+			}
+			else
+			{
+				ranges.insert(ranges.begin() + idx, range);
+			}
+
+			if (1 == ranges.size()
+			&&  block.m_size == ranges[0].m_size)
+			{
+				freeMemory(block.m_memory, block.m_data, block.m_size);
+				block.m_memory = VK_NULL_HANDLE;
+				block.m_data   = NULL;
+				block.m_free.clear();
+				--m_numBlocks;
+			}
+		}
+
+		_allocation = DeviceMemoryAllocationVK();
+	}
+
+	VkResult DeviceMemoryAllocatorVK::allocMemory(VkDeviceSize _size, uint32_t _memoryTypeIndex, VkDeviceMemory& _memory, uint8_t*& _data)
+	{
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkDevice device = s_renderVK->m_device;
+
+		VkMemoryAllocateInfo ma;
+		ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		ma.pNext = NULL;
+		ma.allocationSize  = _size;
+		ma.memoryTypeIndex = _memoryTypeIndex;
+		VkResult result = vkAllocateMemory(device
+			, &ma
+			, allocatorCb
+			, &_memory
+			);
+
+		if (VK_SUCCESS != result)
+		{
+			BX_TRACE("vkAllocateMemory failed %d: %s.", result, getName(result) );
+			return result;
+		}
+
+		_data = NULL;
+
+		// Host visible memory stays mapped for its lifetime, since the same
+		// device memory can't be mapped twice by different sub-allocations.
+		const VkMemoryType& memType = s_renderVK->m_memoryProperties.memoryTypes[_memoryTypeIndex];
+		if (0 != (memType.propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) )
+		{
+			VK_CHECK(vkMapMemory(device, _memory, 0, _size, 0, (void**)&_data) );
+		}
+
+		m_allocated += int64_t(_size);
+
+		return VK_SUCCESS;
+	}
+
+	void DeviceMemoryAllocatorVK::freeMemory(VkDeviceMemory _memory, uint8_t* _data, VkDeviceSize _size)
+	{
+		VkDevice device = s_renderVK->m_device;
+
+		if (NULL != _data)
+		{
+			vkUnmapMemory(device, _memory);
+		}
+
+		vkFreeMemory(device, _memory, s_renderVK->m_allocatorCb);
+
+		m_allocated -= int64_t(_size);
+	}
+
+	bool DeviceMemoryAllocatorVK::allocRange(uint32_t _block, VkDeviceSize _size, VkDeviceSize _align, VkDeviceSize& _offset)
+	{
+		RangeArray& ranges = m_block[_block].m_free;
+
+		for (uint32_t ii = 0, num = uint32_t(ranges.size() ); ii < num; ++ii)
+		{
+			Range& range = ranges[ii];
+
+			const VkDeviceSize offset = (range.m_offset + _align - 1) & ~(_align - 1);
+			const VkDeviceSize end    = range.m_offset + range.m_size;
+
+			if (offset + _size <= end)
+			{
+				const Range head = { range.m_offset, offset - range.m_offset };
+				const Range tail = { offset + _size, end - offset - _size };
+
+				ranges.erase(ranges.begin() + ii);
+
+				if (0 != tail.m_size)
+				{
+					ranges.insert(ranges.begin() + ii, tail);
+				}
+
+				if (0 != head.m_size)
+				{
+					ranges.insert(ranges.begin() + ii, head);
+				}
+
+				_offset = offset;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+	void ScratchBufferVK::create(uint32_t _size, uint32_t _maxDescriptors)
+	{
+		m_maxDescriptors = _maxDescriptors;
+
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkDevice device = s_renderVK->m_device;
+
+		VkDescriptorPoolSize dps[] =
+		{
+//			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2*_maxDescriptors                },
+//			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,         BGFX_CONFIG_MAX_TEXTURE_SAMPLERS },
+		};
+
+		VkDescriptorPoolCreateInfo dpci;
+		dpci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		dpci.pNext = NULL;
+		dpci.flags = 0;
+		dpci.maxSets       = _maxDescriptors;
+		dpci.poolSizeCount = BX_COUNTOF(dps);
+		dpci.pPoolSizes    = dps;
+
+		VK_CHECK(vkCreateDescriptorPool(device
+			, &dpci
+			, allocatorCb
+			, &m_descriptorPool
+			) );
+
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size  = _size;
+		bci.usage = 0
+			| VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
+//			| VK_BUFFER_USAGE_TRANSFER_DST_BIT
+			;
+		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bci.queueFamilyIndexCount = 0;
+		bci.pQueueFamilyIndices   = NULL;
+
+		VK_CHECK(vkCreateBuffer(device
+			, &bci
+			, allocatorCb
+			, &m_buffer
+			) );
+
+		VkMemoryRequirements mr;
+		vkGetBufferMemoryRequirements(device
+			, m_buffer
+			, &mr
+			);
+
+		VK_CHECK(s_renderVK->m_memoryAllocator.alloc(mr
+			, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT|VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+			, true
+			, m_memory
+			) );
+
+		m_size = (uint32_t)mr.size;
+		m_pos  = 0;
+		m_data = m_memory.m_data;
+
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_memory.m_memory, m_memory.m_offset) );
+	}
+
+	void ScratchBufferVK::destroy()
+	{
+		m_descriptorSetCache.clear();
+		vkDestroy(m_descriptorPool);
+
+		vkDestroy(m_buffer);
+
+		s_renderVK->m_memoryAllocator.free(m_memory);
+		m_data = NULL;
+	}
+
+	void ScratchBufferVK::reset(VkDescriptorBufferInfo& /*_descriptorBufferInfo*/)
+	{
+		m_pos = 0;
+
+		// Descriptor sets reference only this buffer, with offsets passed as
+		// dynamic offsets, so they stay valid between frames. Pool is recycled
+		// only when it gets close to full, and it's safe to do so here since
+		// frame that used this buffer last has completed.
+		if (m_descriptorSetCache.size() > m_maxDescriptors/2)
+		{
+			VK_CHECK(vkResetDescriptorPool(s_renderVK->m_device, m_descriptorPool, 0) );
+			m_descriptorSetCache.clear();
+		}
+	}
+
+	void StagingBufferVK::create(uint32_t _size)
+	{
+		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
+		VkDevice device = s_renderVK->m_device;
+
+		VkBufferCreateInfo bci;
+		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bci.pNext = NULL;
+		bci.flags = 0;
+		bci.size  = _size;
+		bci.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+		bci.queueFamilyIndexCount = 0;
+		bci.pQueueFamilyIndices   = NULL;
+
+		VK_CHECK(vkCreateBuffer(device
+			, &bci
+			, allocatorCb
+			, &m_buffer
+			) );
+
+		VkMemoryRequirements mr;
+		vkGetBufferMemoryRequirements(device
+			, m_buffer
+			, &mr
+			);
+
+		VK_CHECK(s_renderVK->m_memoryAllocator.alloc(mr
+			, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT|VK_MEMORY_PROPERTY_HOST_COHERENT_BIT
+			, true
+			, m_memory
+			) );
+
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_memory.m_memory, m_memory.m_offset) );
+
+		m_size = _size;
+		m_pos  = 0;
+	}
+
+	void StagingBufferVK::destroy()
+	{
+		vkDestroy(m_buffer);
+		s_renderVK->m_memoryAllocator.free(m_memory);
+		m_size = 0;
+		m_pos  = 0;
+	}
+
+	void StagingBufferVK::reset()
+	{
+		m_pos = 0;
+	}
+
+	uint32_t StagingBufferVK::alloc(uint32_t _size)
+	{
+		const uint32_t offset = bx::strideAlign(m_pos, 16);
+
+		if (offset + _size > m_size)
+		{
+			return UINT32_MAX;
+		}
+
+		m_pos = offset + _size;
+		return offset;
+	}
+
+	VkResult GpuScopeTimerVK::create()
+	{
+		VkQueryPoolCreateInfo qpci;
+		qpci.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+		qpci.pNext = NULL;
+		qpci.flags = 0;
+		qpci.queryType  = VK_QUERY_TYPE_TIMESTAMP;
+		qpci.queryCount = kGpuScopeQueries;
+		qpci.pipelineStatistics = 0;
+
+		VkResult result = vkCreateQueryPool(s_renderVK->m_device
+			, &qpci
+			, s_renderVK->m_allocatorCb
+			, &m_queryPool
+			);
+
+		m_period = double(s_renderVK->m_deviceProperties.limits.timestampPeriod);
+
+		// Queries must be reset before first use.
+		for (uint32_t ii = 0; ii < kGpuScopeQueries; ++ii)
+		{
+			m_reset[ii] = ii;
+			m_frame[ii] = 0;
+		}
+
+		m_numReset = kGpuScopeQueries;
+
+		return result;
+	}
+
+	void GpuScopeTimerVK::destroy()
+	{
+		vkDestroy(m_queryPool);
+	}
+
+	void GpuScopeTimerVK::resetQueries(VkCommandBuffer _commandBuffer)
+	{
+		for (uint32_t ii = 0; ii < m_numReset;)
+		{
+			const uint32_t first = m_reset[ii];
+			uint32_t num = 1;
+
+			for (++ii; ii < m_numReset && m_reset[ii] == first + num; ++ii)
+			{
+				++num;
+			}
+
+			vkCmdResetQueryPool(_commandBuffer, m_queryPool, first, num);
+		}
+
+		m_numReset = 0;
+	}
+
+	void GpuScopeTimerVK::timestamp(uint32_t _idx)
+	{
+		m_frame[_idx] = s_renderVK->m_frameCount + 1;
+
+		// Scopes inside of view are written in order with view draw calls,
+		// which might be recorded on worker thread.
+		RenderCommandListVK& list = s_renderVK->m_renderCommandList;
+		if (list.isRecording() )
+		{
+			RenderCommandVK cmd;
+			cmd.clear();
+			cmd.m_type = RenderCommandVK::Type::Timestamp;
+			cmd.m_num  = _idx;
+			list.push(cmd);
+			return;
+		}
+
+		vkCmdWriteTimestamp(s_renderVK->m_commandBuffer
+			, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+			, m_queryPool
+			, _idx
+			);
+	}
+
+	bool GpuScopeTimerVK::result(uint32_t _idx, uint64_t& _time)
+	{
+		// Query still holds previous result until frame that reset and
+		// wrote it has completed.
+		if (m_frame[_idx] > s_renderVK->m_frameCompleted)
+		{
+			return false;
+		}
+
+		uint64_t ticks;
+		VkResult result = vkGetQueryPoolResults(s_renderVK->m_device
+			, m_queryPool
+			, _idx
+			, 1
+			, sizeof(ticks)
+			, &ticks
+			, sizeof(ticks)
+			, VK_QUERY_RESULT_64_BIT
+			);
+
+		if (VK_SUCCESS == result)
+		{
+			_time = uint64_t(double(ticks) * m_period);
+			return true;
+		}
+
+		return false;
+	}
+
+	void GpuScopeTimerVK::release(uint32_t _idx)
+	{
+		m_reset[m_numReset++] = _idx;
+	}
+
+	void RenderCommandVK::clear()
+	{
+		bx::memSet(this, 0, sizeof(RenderCommandVK) );
+	}
+
+	void RenderCommandListVK::reset()
+	{
+		m_commands.clear();
+		m_views.clear();
+		m_chunks.clear();
+		m_recording = false;
+	}
+
+	ViewCommandsVK& RenderCommandListVK::beginView(ViewId _view)
+	{
+		m_recording = true;
+
+		ViewCommandsVK vc;
+		bx::memSet(&vc, 0, sizeof(vc) );
+		vc.m_view       = _view;
+		vc.m_firstChunk = uint32_t(m_chunks.size() );
+		m_views.push_back(vc);
+
+		beginChunk();
+
+		return m_views.back();
+	}
+
+	void RenderCommandListVK::end()
+	{
+		m_recording = false;
+	}
+
+	void RenderCommandListVK::beginChunk()
+	{
+		RenderChunkVK chunk;
+		chunk.m_commandBuffer = VK_NULL_HANDLE;
+		chunk.m_view  = uint32_t(m_views.size()-1);
+		chunk.m_begin = uint32_t(m_commands.size() );
+		chunk.m_end   = chunk.m_begin;
+		m_chunks.push_back(chunk);
+
+		m_views.back().m_numChunks++;
+
+		m_bound.clear();
+	}
+
+	uint8_t RenderCommandListVK::push(const RenderCommandVK& _cmd)
+	{
+		BX_CHECK(!m_chunks.empty(), "Command must be inside of view.");
+
+		if (m_chunks.back().m_end - m_chunks.back().m_begin >= BGFX_CONFIG_RENDERER_VULKAN_RECORD_CHUNK_SIZE)
+		{
+			beginChunk();
+		}
+
+		m_commands.push_back(_cmd);
+		m_chunks.back().m_end++;
+
+		RenderCommandVK& cmd = m_commands.back();
+
+		if (RenderCommandVK::Type::Draw        != cmd.m_type
+		&&  RenderCommandVK::Type::DrawIndexed != cmd.m_type)
+		{
+			cmd.m_dirty = 0;
+			return 0;
+		}
+
+		const bool hasFactor = 0 != (cmd.m_dirty & RenderCommandVK::Dirty::BlendFactor);
+		uint8_t dirty = 0;
+
+		if (VK_NULL_HANDLE == m_bound.m_pipeline)
+		{
+			// First draw in chunk sets all state.
+			dirty = UINT8_MAX;
+		}
+		else
+		{
+			if (cmd.m_pipeline != m_bound.m_pipeline)
+			{
+				dirty |= 0
+					| RenderCommandVK::Dirty::Pipeline
+					| RenderCommandVK::Dirty::StencilRef
+					| RenderCommandVK::Dirty::BlendFactor
+					;
+			}
+
+			if (cmd.m_stencilRef != m_bound.m_stencilRef)
+			{
+				dirty |= RenderCommandVK::Dirty::StencilRef;
+			}
+
+			if (hasFactor
+			&&  cmd.m_rgba != m_bound.m_rgba)
+			{
+				dirty |= RenderCommandVK::Dirty::BlendFactor;
+			}
+
+			if (0 != bx::memCmp(&cmd.m_scissor, &m_bound.m_scissor, sizeof(VkRect2D) ) )
+			{
+				dirty |= RenderCommandVK::Dirty::Scissor;
+			}
+
+			if (cmd.m_descriptorSet     != m_bound.m_descriptorSet
+			||  cmd.m_dynamicOffsets[0] != m_bound.m_dynamicOffsets[0]
+			||  cmd.m_dynamicOffsets[1] != m_bound.m_dynamicOffsets[1])
+			{
+				dirty |= RenderCommandVK::Dirty::DescriptorSet;
+			}
+
+			if (cmd.m_vertexBuffer != m_bound.m_vertexBuffer)
+			{
+				dirty |= RenderCommandVK::Dirty::VertexBuffer;
+			}
+
+			if (cmd.m_indexBuffer != m_bound.m_indexBuffer
+			||  cmd.m_indexType   != m_bound.m_indexType)
+			{
+				dirty |= RenderCommandVK::Dirty::IndexBuffer;
+			}
+		}
+
+		if (VK_NULL_HANDLE == cmd.m_descriptorSet)
+		{
+			dirty &= ~RenderCommandVK::Dirty::DescriptorSet;
+		}
+
+		if (RenderCommandVK::Type::DrawIndexed != cmd.m_type)
+		{
+			dirty &= ~RenderCommandVK::Dirty::IndexBuffer;
+		}
+
+		cmd.m_dirty = dirty;
+
+		m_bound.m_pipeline          = cmd.m_pipeline;
+		m_bound.m_stencilRef        = cmd.m_stencilRef;
+		m_bound.m_scissor           = cmd.m_scissor;
+		m_bound.m_vertexBuffer      = cmd.m_vertexBuffer;
+
+		if (0 != (dirty & RenderCommandVK::Dirty::BlendFactor) )
+		{
+			m_bound.m_rgba = cmd.m_rgba;
+		}
+
+		if (0 != (dirty & RenderCommandVK::Dirty::DescriptorSet) )
+		{
+			m_bound.m_descriptorSet     = cmd.m_descriptorSet;
+			m_bound.m_dynamicOffsets[0] = cmd.m_dynamicOffsets[0];
+			m_bound.m_dynamicOffsets[1] = cmd.m_dynamicOffsets[1];
+		}
+
+		if (0 != (dirty & RenderCommandVK::Dirty::IndexBuffer) )
+		{
+			m_bound.m_indexBuffer = cmd.m_indexBuffer;
+			m_bound.m_indexType   = cmd.m_indexType;
+		}
+
+		return dirty;
+	}
+
+	void RenderCommandListVK::record(VkCommandBuffer _commandBuffer, const RenderChunkVK& _chunk) const
+	{
+		const ViewCommandsVK& vc = m_views[_chunk.m_view];
+
+		vkCmdSetViewport(_commandBuffer, 0, 1, &vc.m_viewport);
+
+		const uint32_t chunkIdx = uint32_t(&_chunk - &m_chunks[0]);
+		if (chunkIdx == vc.m_firstChunk
+		&&  0 != vc.m_numClear)
+		{
+			vkCmdClearAttachments(_commandBuffer
+				, vc.m_numClear
+				, vc.m_clear
+				, 1
+				, &vc.m_clearRect
+				);
+		}
+
+		for (uint32_t ii = _chunk.m_begin; ii < _chunk.m_end; ++ii)
+		{
+			const RenderCommandVK& cmd = m_commands[ii];
+
+			switch (cmd.m_type)
+			{
+			case RenderCommandVK::Type::Timestamp:
+				vkCmdWriteTimestamp(_commandBuffer
+					, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT
+					, s_renderVK->m_gpuScope.m_timer.m_queryPool
+					, cmd.m_num
+					);
+				continue;
+
+			case RenderCommandVK::Type::Marker:
+				if (BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
+				{
+					VkDebugUtilsLabelEXT dul;
+					dul.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+					dul.pNext = NULL;
+					dul.pLabelName = cmd.m_marker;
+					dul.color[0] = 1.0f;
+					dul.color[1] = 0.0f;
+					dul.color[2] = 0.0f;
+					dul.color[3] = 1.0f;
+					vkCmdInsertDebugUtilsLabelEXT(_commandBuffer, &dul);
+				}
+				continue;
+
+			default:
+				break;
+			}
+
+			if (0 != (cmd.m_dirty & RenderCommandVK::Dirty::Pipeline) )
+			{
+				vkCmdBindPipeline(_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, cmd.m_pipeline);
+			}
+
+			if (0 != (cmd.m_dirty & RenderCommandVK::Dirty::StencilRef) )
+			{
+				vkCmdSetStencilReference(_commandBuffer, VK_STENCIL_FRONT_AND_BACK, cmd.m_stencilRef);
+			}
+
+			if (0 != (cmd.m_dirty & RenderCommandVK::Dirty::BlendFactor) )
+			{
+				float bf[4];
+				bf[0] = ( (cmd.m_rgba>>24)     )/255.0f;
+				bf[1] = ( (cmd.m_rgba>>16)&0xff)/255.0f;
+				bf[2] = ( (cmd.m_rgba>> 8)&0xff)/255.0f;
+				bf[3] = ( (cmd.m_rgba    )&0xff)/255.0f;
+				vkCmdSetBlendConstants(_commandBuffer, bf);
+			}
+
+			if (0 != (cmd.m_dirty & RenderCommandVK::Dirty::Scissor) )
+			{
+				vkCmdSetScissor(_commandBuffer, 0, 1, &cmd.m_scissor);
+			}
+
+			if (0 != (cmd.m_dirty & RenderCommandVK::Dirty::DescriptorSet) )
+			{
+				vkCmdBindDescriptorSets(_commandBuffer
+					, VK_PIPELINE_BIND_POINT_GRAPHICS
+					, s_renderVK->m_pipelineLayout
+					, 0
+					, 1
+					, &cmd.m_descriptorSet
+					, BX_COUNTOF(cmd.m_dynamicOffsets)
+					, cmd.m_dynamicOffsets
+					);
+			}
+
+			if (0 != (cmd.m_dirty & RenderCommandVK::Dirty::VertexBuffer) )
+			{
+				VkDeviceSize offset = 0;
+				vkCmdBindVertexBuffers(_commandBuffer
+					, 0
+					, 1
+					, &cmd.m_vertexBuffer
+					, &offset
+					);
+			}
+
+			if (RenderCommandVK::Type::Draw == cmd.m_type)
+			{
+				vkCmdDraw(_commandBuffer
+					, cmd.m_num
+					, cmd.m_numInstances
+					, cmd.m_startVertex
+					, 0
+					);
+			}
+			else
+			{
+				if (0 != (cmd.m_dirty & RenderCommandVK::Dirty::IndexBuffer) )
+				{
+					vkCmdBindIndexBuffer(_commandBuffer
+						, cmd.m_indexBuffer
+						, 0
+						, cmd.m_indexType
+						);
+				}
+
+				vkCmdDrawIndexed(_commandBuffer
+					, cmd.m_num
+					, cmd.m_numInstances
+					, cmd.m_startIndex
+					, cmd.m_startVertex
+					, 0
+					);
+			}
+		}
+	}
+
+	CommandRecorderVK::CommandRecorderVK()
+		: m_list(NULL)
+		, m_frameIdx(0)
+		, m_next(0)
+		, m_numThreads(0)
+		, m_exit(false)
+	{
+		bx::memSet(&m_inheritance, 0, sizeof(m_inheritance) );
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_worker); ++ii)
+		{
+			Worker& worker = m_worker[ii];
+			worker.m_recorder = this;
+			worker.m_idx      = ii;
+
+			for (uint32_t jj = 0; jj < BX_COUNTOF(worker.m_commandPool); ++jj)
+			{
+				worker.m_commandPool[jj] = VK_NULL_HANDLE;
+				worker.m_numUsed[jj]     = 0;
+			}
+		}
+	}
+
+	VkResult CommandRecorderVK::init(uint32_t _numThreads)
+	{
+		m_exit = false;
+		m_numThreads = bx::min<uint32_t>(_numThreads, BX_COUNTOF(m_worker)-1);
+
+		VkCommandPoolCreateInfo cpci;
+		cpci.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+		cpci.pNext = NULL;
+		cpci.flags = VK_COMMAND_POOL_CREATE_TRANSIENT_BIT;
+		cpci.queueFamilyIndex = s_renderVK->m_qfiGraphics;
+
+		// Render thread is last worker.
+		for (uint32_t ii = 0; ii <= m_numThreads; ++ii)
+		{
+			Worker& worker = m_worker[ii];
+
+			for (uint32_t jj = 0; jj < BX_COUNTOF(worker.m_commandPool); ++jj)
+			{
+				VkResult result = vkCreateCommandPool(s_renderVK->m_device
+					, &cpci
+					, s_renderVK->m_allocatorCb
+					, &worker.m_commandPool[jj]
+					);
+
+				if (VK_SUCCESS != result)
+				{
+					shutdown();
+					m_numThreads = 0;
+					return result;
+				}
+			}
+		}
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_worker[ii].m_thread.init(threadFunc, &m_worker[ii], 0, "bgfx - vk record thread");
+		}
+
+		return VK_SUCCESS;
+	}
+
+	void CommandRecorderVK::shutdown()
+	{
+		m_exit = true;
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_kick.post();
+		}
+
+		for (uint32_t ii = 0; ii < BX_COUNTOF(m_worker); ++ii)
+		{
+			Worker& worker = m_worker[ii];
+
+			if (worker.m_thread.isRunning() )
+			{
+				worker.m_thread.shutdown();
+			}
+
+			for (uint32_t jj = 0; jj < BX_COUNTOF(worker.m_commandPool); ++jj)
+			{
+				if (VK_NULL_HANDLE != worker.m_commandPool[jj])
+				{
+					vkDestroy(worker.m_commandPool[jj]);
+				}
+
+				worker.m_commandBuffer[jj].clear();
+				worker.m_numUsed[jj] = 0;
+			}
+		}
+
+		m_numThreads = 0;
+	}
+
+	void CommandRecorderVK::reset(uint32_t _frameIdx)
+	{
+		for (uint32_t ii = 0; ii <= m_numThreads; ++ii)
+		{
+			Worker& worker = m_worker[ii];
+
+			if (0 != worker.m_numUsed[_frameIdx])
+			{
+				VK_CHECK(vkResetCommandPool(s_renderVK->m_device, worker.m_commandPool[_frameIdx], 0) );
+				worker.m_numUsed[_frameIdx] = 0;
+			}
+		}
+	}
+
+	void CommandRecorderVK::record(uint32_t _frameIdx, RenderCommandListVK& _list, const VkCommandBufferInheritanceInfo& _inheritance)
+	{
+		BGFX_PROFILER_SCOPE("bgfx/Record command buffers", kColorDraw);
+
+		m_list        = &_list;
+		m_inheritance = _inheritance;
+		m_frameIdx    = _frameIdx;
+		m_next        = 0;
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_kick.post();
+		}
+
+		work(m_numThreads);
+
+		for (uint32_t ii = 0; ii < m_numThreads; ++ii)
+		{
+			m_done.wait();
+		}
+
+		m_list = NULL;
+	}
+
+	int32_t CommandRecorderVK::threadFunc(bx::Thread* /*_thread*/, void* _userData)
 	{
-		m_maxDescriptors = _maxDescriptors;
-		m_descriptorSet  = (VkDescriptorSet*)BX_ALLOC(g_allocator, _maxDescriptors * sizeof(VkDescriptorSet) );
-
-		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		VkDevice device = s_renderVK->m_device;
+		Worker& worker = *(Worker*)_userData;
+		CommandRecorderVK& recorder = *worker.m_recorder;
 
-		VkDescriptorSetAllocateInfo dsai;
-		dsai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-		dsai.pNext = NULL;
-		dsai.descriptorPool = s_renderVK->m_descriptorPool;
-		dsai.descriptorSetCount = 1;
-		dsai.pSetLayouts        = &s_renderVK->m_descriptorSetLayout;
-		for (uint32_t ii = 0, num = m_maxDescriptors; ii < num; ++ii)
+		for (;;)
 		{
-			VK_CHECK(vkAllocateDescriptorSets(device, &dsai, &m_descriptorSet[ii]) );
+			recorder.m_kick.wait();
+
+			if (recorder.m_exit)
+			{
+				break;
+			}
+
+			recorder.work(worker.m_idx);
+			recorder.m_done.post();
 		}
 
-		VkBufferCreateInfo bci;
-		bci.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-		bci.pNext = NULL;
-		bci.flags = 0;
-		bci.size  = _size;
-		bci.usage = 0
-			| VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT
-//			| VK_BUFFER_USAGE_TRANSFER_DST_BIT
+		return bx::kExitSuccess;
+	}
+
+	void CommandRecorderVK::work(uint32_t _worker)
+	{
+		Worker& worker = m_worker[_worker];
+		VkCommandPool       commandPool   = worker.m_commandPool[m_frameIdx];
+		CommandBufferArray& commandBuffer = worker.m_commandBuffer[m_frameIdx];
+		uint32_t&           numUsed       = worker.m_numUsed[m_frameIdx];
+
+		VkCommandBufferBeginInfo cbbi;
+		cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+		cbbi.pNext = NULL;
+		cbbi.flags = 0
+			| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
+			| VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
 			;
-		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-		bci.queueFamilyIndexCount = 0;
-		bci.pQueueFamilyIndices   = NULL;
+		cbbi.pInheritanceInfo = &m_inheritance;
 
-		VK_CHECK(vkCreateBuffer(device
-			, &bci
-			, allocatorCb
-			, &m_buffer
-			) );
+		const uint32_t numChunks = uint32_t(m_list->m_chunks.size() );
 
-		VkMemoryRequirements mr;
-		vkGetBufferMemoryRequirements(device
-			, m_buffer
-			, &mr
-			);
+		for (uint32_t idx = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+			; idx < numChunks
+			; idx = bx::atomicFetchAndAdd<uint32_t>(&m_next, 1)
+			)
+		{
+			if (numUsed == commandBuffer.size() )
+			{
+				VkCommandBufferAllocateInfo cbai;
+				cbai.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+				cbai.pNext = NULL;
+				cbai.commandPool = commandPool;
+				cbai.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY;
+				cbai.commandBufferCount = 1;
 
-		VkMemoryAllocateInfo ma;
-		ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		ma.pNext = NULL;
-		ma.allocationSize  = mr.size;
-		ma.memoryTypeIndex = s_renderVK->selectMemoryType(mr.memoryTypeBits
-			, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-			);
-		VK_CHECK(vkAllocateMemory(device
-			, &ma
-			, allocatorCb
-			, &m_deviceMem
-			) );
+				VkCommandBuffer cb;
+				VK_CHECK(vkAllocateCommandBuffers(s_renderVK->m_device, &cbai, &cb) );
+				commandBuffer.push_back(cb);
+			}
 
-		m_size = (uint32_t)mr.size;
-		m_pos  = 0;
+			VkCommandBuffer cb = commandBuffer[numUsed++];
 
-		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
+			RenderChunkVK& chunk = m_list->m_chunks[idx];
+			VK_CHECK(vkBeginCommandBuffer(cb, &cbbi) );
+			m_list->record(cb, chunk);
+			VK_CHECK(vkEndCommandBuffer(cb) );
 
-		VK_CHECK(vkMapMemory(device, m_deviceMem, 0, ma.allocationSize, 0, (void**)&m_data) );
+			chunk.m_commandBuffer = cb;
+		}
 	}
 
-	void ScratchBufferVK::destroy()
+	void* ScratchBufferVK::allocUbv(uint32_t _vsize, uint32_t _fsize, uint32_t* _dynamicOffsets)
 	{
-		VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-		VkDevice device = s_renderVK->m_device;
+		_dynamicOffsets[0] = m_pos;
+		_dynamicOffsets[1] = 0 != _fsize ? m_pos + _vsize : m_pos;
 
-		vkFreeDescriptorSets(device, s_renderVK->m_descriptorPool, m_maxDescriptors, m_descriptorSet);
-		BX_FREE(g_allocator, m_descriptorSet);
-
-		vkUnmapMemory(device, m_deviceMem);
+		void* data = &m_data[m_pos];
 
-		vkDestroy(m_buffer);
+		m_pos += _vsize + _fsize;
 
-		vkFreeMemory(device
-			, m_deviceMem
-			, allocatorCb
-			);
+		return data;
 	}
 
-	void ScratchBufferVK::reset(VkDescriptorBufferInfo& /*_descriptorBufferInfo*/)
+	VkDescriptorSet ScratchBufferVK::getDescriptorSet(uint32_t _vrange, uint32_t _frange, bool& _cached)
 	{
-		m_pos = 0;
-		m_currentDs = 0;
-	}
+		bx::HashMurmur2A murmur;
+		murmur.begin();
+		murmur.add(s_renderVK->m_descriptorSetLayout);
+		murmur.add(m_buffer);
+		murmur.add(_vrange);
+		murmur.add(_frange);
+		const uint32_t hash = murmur.end();
+
+		DescriptorSetCache::const_iterator it = m_descriptorSetCache.find(hash);
+		if (it != m_descriptorSetCache.end() )
+		{
+			_cached = true;
+			return it->second;
+		}
+
+		_cached = false;
+
+		BX_CHECK(m_descriptorSetCache.size() < m_maxDescriptors, "Descriptor pool is full.");
+
+		VkDescriptorSet descriptorSet;
+
+		VkDescriptorSetAllocateInfo dsai;
+		dsai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		dsai.pNext = NULL;
+		dsai.descriptorPool = m_descriptorPool;
+		dsai.descriptorSetCount = 1;
+		dsai.pSetLayouts        = &s_renderVK->m_descriptorSetLayout;
+		VK_CHECK(vkAllocateDescriptorSets(s_renderVK->m_device, &dsai, &descriptorSet) );
 
-	void* ScratchBufferVK::allocUbv(uint32_t _vsize, uint32_t _fsize)
-	{
 		VkDescriptorBufferInfo dbi[2];
 
 		dbi[0].buffer = m_buffer;
-		dbi[0].offset = m_pos;
-		dbi[0].range  = _vsize;
+		dbi[0].offset = 0;
+		dbi[0].range  = _vrange;
+
+		dbi[1].buffer = m_buffer;
+		dbi[1].offset = 0;
+		dbi[1].range  = _frange;
 
 		VkWriteDescriptorSet wds[2];
 
 		wds[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 		wds[0].pNext = NULL;
-		wds[0].dstSet     = m_descriptorSet[m_currentDs];
+		wds[0].dstSet     = descriptorSet;
 		wds[0].dstBinding = DslBinding::VertexUniformBuffer;
 		wds[0].dstArrayElement  = 0;
 		wds[0].descriptorCount  = 1;
-		wds[0].descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+		wds[0].descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
 		wds[0].pImageInfo       = NULL;
 		wds[0].pBufferInfo      = &dbi[0];
 		wds[0].pTexelBufferView = NULL;
 
-		uint32_t numWds = 1;
-
-		if (0 != _fsize)
-		{
-			dbi[1].buffer = m_buffer;
-			dbi[1].offset = m_pos + _vsize;
-			dbi[1].range  = _fsize;
-
-			wds[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			wds[1].pNext = NULL;
-			wds[1].dstSet     = m_descriptorSet[m_currentDs];
-			wds[1].dstBinding = DslBinding::FragmentUniformBuffer;
-			wds[1].dstArrayElement  = 0;
-			wds[1].descriptorCount  = 1;
-			wds[1].descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			wds[1].pImageInfo       = NULL;
-			wds[1].pBufferInfo      = &dbi[1];
-			wds[1].pTexelBufferView = NULL;
+		wds[1] = wds[0];
+		wds[1].dstBinding  = DslBinding::FragmentUniformBuffer;
+		wds[1].pBufferInfo = &dbi[1];
 
-			++numWds;
-		}
-
-		vkUpdateDescriptorSets(s_renderVK->m_device, numWds, wds, 0, NULL);
-
-		void* data = &m_data[m_pos];
+		vkUpdateDescriptorSets(s_renderVK->m_device, BX_COUNTOF(wds), wds, 0, NULL);
 
-		m_pos += _vsize + _fsize;
-		++m_currentDs;
+		m_descriptorSetCache.insert(stl::make_pair(hash, descriptorSet) );
 
-		return data;
+		return descriptorSet;
 	}
 
 	VkResult ImageVK::create(VkFormat _format, const VkExtent3D& _extent)
@@ -3471,27 +5022,19 @@ VK_DESTROY
 		VkMemoryRequirements mr;
 		vkGetImageMemoryRequirements(device, m_image, &mr);
 
-		VkMemoryAllocateInfo ma;
-		ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		ma.pNext = NULL;
-		ma.allocationSize  = mr.size;
-		ma.memoryTypeIndex = s_renderVK->selectMemoryType(mr.memoryTypeBits
+		result = s_renderVK->m_memoryAllocator.alloc(mr
 			, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
-			);
-		result = vkAllocateMemory(device
-			, &ma
-			, allocatorCb
-			, &m_memory
+			, false
+			, m_memory
 			);
 
 		if (VK_SUCCESS != result)
 		{
-			BX_TRACE("vkAllocateMemory failed %d: %s.", result, getName(result) );
 			destroy();
 			return result;
 		}
 
-		result = vkBindImageMemory(device, m_image, m_memory, 0);
+		result = vkBindImageMemory(device, m_image, m_memory.m_memory, m_memory.m_offset);
 
 		if (VK_SUCCESS != result)
 		{
@@ -3535,11 +5078,7 @@ VK_DESTROY
 	{
 		vkDestroy(m_imageView);
 		vkDestroy(m_image);
-		if (VK_NULL_HANDLE != m_memory)
-		{
-			vkFreeMemory(s_renderVK->m_device, m_memory, s_renderVK->m_allocatorCb);
-			m_memory = VK_NULL_HANDLE;
-		}
+		s_renderVK->m_memoryAllocator.free(m_memory);
 	}
 
 	void BufferVK::create(uint32_t _size, void* _data, uint16_t _flags, bool _vertex, uint32_t _stride)
@@ -3556,7 +5095,7 @@ VK_DESTROY
 		bci.flags = 0;
 		bci.size  = _size;
 		bci.usage = 0
-			| (m_dynamic ? VK_BUFFER_USAGE_TRANSFER_DST_BIT  : 0)
+			| VK_BUFFER_USAGE_TRANSFER_DST_BIT
 			| (_vertex   ? VK_BUFFER_USAGE_VERTEX_BUFFER_BIT : VK_BUFFER_USAGE_INDEX_BUFFER_BIT)
 			;
 		bci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
@@ -3577,47 +5116,32 @@ VK_DESTROY
 			, &mr
 			);
 
-		VkMemoryAllocateInfo ma;
-		ma.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-		ma.pNext = NULL;
-		ma.allocationSize  = mr.size;
-		ma.memoryTypeIndex = s_renderVK->selectMemoryType(mr.memoryTypeBits
-			, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT
-			);
-		VK_CHECK(vkAllocateMemory(device
-			, &ma
-			, allocatorCb
-			, &m_deviceMem
+		VK_CHECK(s_renderVK->m_memoryAllocator.alloc(mr
+			, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT
+			, true
+			, m_memory
 			) );
 
+		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_memory.m_memory, m_memory.m_offset) );
+
 		if (!m_dynamic)
 		{
-			void* dst;
-			VK_CHECK(vkMapMemory(device, m_deviceMem, 0, ma.allocationSize, 0, &dst) );
-			bx::memCopy(dst, _data, _size);
-			vkUnmapMemory(device, m_deviceMem);
+			s_renderVK->copyBuffer(m_buffer, 0, _size, _data);
 		}
-
-		VK_CHECK(vkBindBufferMemory(device, m_buffer, m_deviceMem, 0) );
 	}
 
 	void BufferVK::update(VkCommandBuffer _commandBuffer, uint32_t _offset, uint32_t _size, void* _data, bool _discard)
 	{
-		BX_UNUSED(_commandBuffer, _offset, _size, _data, _discard);
+		BX_UNUSED(_commandBuffer, _discard);
+		s_renderVK->copyBuffer(m_buffer, _offset, _size, _data);
 	}
 
 	void BufferVK::destroy()
 	{
 		if (VK_NULL_HANDLE != m_buffer)
 		{
-			VkAllocationCallbacks* allocatorCb = s_renderVK->m_allocatorCb;
-			VkDevice device = s_renderVK->m_device;
-
-			vkDestroy(m_buffer);
-			vkFreeMemory(device
-				, m_deviceMem
-				, allocatorCb
-				);
+			// Buffer might still be referenced by frames in flight.
+			s_renderVK->release(m_buffer, m_memory);
 			m_dynamic = false;
 		}
 	}
@@ -3852,10 +5376,91 @@ VK_DESTROY
 		}
 	}
 
+	void RendererContextVK::submitViews(VkRenderPassBeginInfo& _rpbi)
+	{
+		RenderCommandListVK& list = m_renderCommandList;
+
+		// Small frames are recorded inline, waking up workers would cost
+		// more than recording itself.
+		const bool parallel = true
+			&& 0 < m_commandRecorder.getNumThreads()
+			&& BGFX_CONFIG_RENDERER_VULKAN_RECORD_CHUNK_SIZE < list.getNumCommands()
+			;
+
+		if (parallel)
+		{
+			VkCommandBufferInheritanceInfo cbii;
+			cbii.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+			cbii.pNext = NULL;
+			cbii.renderPass  = _rpbi.renderPass;
+			cbii.subpass     = 0;
+			cbii.framebuffer = _rpbi.framebuffer;
+			cbii.occlusionQueryEnable = VK_FALSE;
+			cbii.queryFlags           = 0;
+			cbii.pipelineStatistics   = 0;
+
+			m_commandRecorder.record(m_frameIdx, list, cbii);
+		}
+
+		for (uint32_t ii = 0, num = uint32_t(list.m_views.size() ); ii < num; ++ii)
+		{
+			const ViewCommandsVK& vc = list.m_views[ii];
+
+			if (BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
+			{
+				VkDebugUtilsLabelEXT dul;
+				dul.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+				dul.pNext = NULL;
+				dul.pLabelName = s_viewName[vc.m_view];
+				dul.color[0] = 1.0f;
+				dul.color[1] = 1.0f;
+				dul.color[2] = 1.0f;
+				dul.color[3] = 1.0f;
+				vkCmdBeginDebugUtilsLabelEXT(m_commandBuffer, &dul);
+			}
+
+			_rpbi.renderArea = vc.m_renderArea;
+
+			if (parallel)
+			{
+				vkCmdBeginRenderPass(m_commandBuffer, &_rpbi, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+				m_secondaryCommandBuffers.clear();
+				for (uint32_t jj = vc.m_firstChunk, end = vc.m_firstChunk + vc.m_numChunks; jj < end; ++jj)
+				{
+					m_secondaryCommandBuffers.push_back(list.m_chunks[jj].m_commandBuffer);
+				}
+
+				vkCmdExecuteCommands(m_commandBuffer
+					, uint32_t(m_secondaryCommandBuffers.size() )
+					, &m_secondaryCommandBuffers[0]
+					);
+			}
+			else
+			{
+				vkCmdBeginRenderPass(m_commandBuffer, &_rpbi, VK_SUBPASS_CONTENTS_INLINE);
+
+				for (uint32_t jj = vc.m_firstChunk, end = vc.m_firstChunk + vc.m_numChunks; jj < end; ++jj)
+				{
+					list.record(m_commandBuffer, list.m_chunks[jj]);
+				}
+			}
+
+			vkCmdEndRenderPass(m_commandBuffer);
+
+			if (BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
+			{
+				vkCmdEndDebugUtilsLabelEXT(m_commandBuffer);
+			}
+		}
+	}
+
 	void RendererContextVK::submit(Frame* _render, ClearQuad& _clearQuad, TextVideoMemBlitter& _textVideoMemBlitter)
 	{
 		BX_UNUSED(_render, _clearQuad, _textVideoMemBlitter);
 
+		beginFrame();
+
 		updateResolution(_render->m_resolution);
 
 		int64_t timeBegin = bx::getHPCounter();
@@ -3866,17 +5471,19 @@ VK_DESTROY
 		if (0 < _render->m_iboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient index buffer", kColorResource);
-//			TransientIndexBuffer* ib = _render->m_transientIb;
-//			m_indexBuffers[ib->handle.idx].update(m_commandList, 0, _render->m_iboffset, ib->data);
+			TransientIndexBuffer* ib = _render->m_transientIb;
+			m_indexBuffers[ib->handle.idx].update(m_commandBuffer, 0, _render->m_iboffset, ib->data);
 		}
 
 		if (0 < _render->m_vboffset)
 		{
 			BGFX_PROFILER_SCOPE("bgfx/Update transient vertex buffer", kColorResource);
-//			TransientVertexBuffer* vb = _render->m_transientVb;
-//			m_vertexBuffers[vb->handle.idx].update(m_commandList, 0, _render->m_vboffset, vb->data);
+			TransientVertexBuffer* vb = _render->m_transientVb;
+			m_vertexBuffers[vb->handle.idx].update(m_commandBuffer, 0, _render->m_vboffset, vb->data);
 		}
 
+		flushCopies();
+
 		_render->sort();
 
 		RenderDraw currentState;
@@ -3901,6 +5508,8 @@ VK_DESTROY
 		FrameBufferHandle fbh = { BGFX_CONFIG_MAX_FRAME_BUFFERS };
 
 		BlitState bs(_render);
+		ProgramProfiler programProfiler(_render);
+		StateCounter stateCounter(_render);
 
 		uint32_t blendFactor = 0;
 
@@ -3910,7 +5519,6 @@ VK_DESTROY
 
 		bool wasCompute = false;
 		bool viewHasScissor = false;
-		bool restoreScissor = false;
 		Rect viewScissorRect;
 		viewScissorRect.clear();
 
@@ -3923,7 +5531,7 @@ VK_DESTROY
 		uint32_t statsNumIndices = 0;
 		uint32_t statsKeyType[2] = {};
 
-		VkSemaphore renderWait = m_presentDone[m_backBufferColorIdx];
+		VkSemaphore renderWait = m_presentDone[m_frameIdx];
 		VK_CHECK(vkAcquireNextImageKHR(m_device
 				, m_swapchain
 				, UINT64_MAX
@@ -3936,21 +5544,7 @@ VK_DESTROY
 		const uint64_t f1 = BGFX_STATE_BLEND_FUNC(BGFX_STATE_BLEND_INV_FACTOR, BGFX_STATE_BLEND_INV_FACTOR);
 
 
-		ScratchBufferVK& scratchBuffer = m_scratchBuffer[m_backBufferColorIdx];
-		VkDescriptorBufferInfo descriptorBufferInfo;
-		scratchBuffer.reset(descriptorBufferInfo);
-
-		VkCommandBufferBeginInfo cbbi;
-		cbbi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-		cbbi.pNext = NULL;
-		cbbi.flags = 0
-			| VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT
-//			| VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT
-			;
-		cbbi.pInheritanceInfo = NULL;
-
-		m_commandBuffer = m_commandBuffers[m_backBufferColorIdx];
-		VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
+		m_gpuScope.start(_render, m_timerQuerySupport);
 
 		setImageMemoryBarrier(m_commandBuffer
 			, m_backBufferColorImage[m_backBufferColorIdx]
@@ -3969,7 +5563,11 @@ VK_DESTROY
 		rpbi.clearValueCount = 0;
 		rpbi.pClearValues    = NULL;
 
-		bool beginRenderPass = false;
+		VkRect2D        currentScissor = {};
+		VkDescriptorSet currentDescriptorSet = VK_NULL_HANDLE;
+		uint32_t        currentDynamicOffsets[2] = {};
+
+		m_renderCommandList.reset();
 
 		if (0 == (_render->m_debug&BGFX_DEBUG_IFH) )
 		{
@@ -3996,23 +5594,7 @@ VK_DESTROY
 
 				if (viewChanged)
 				{
-					if (beginRenderPass)
-					{
-						vkCmdEndRenderPass(m_commandBuffer);
-						beginRenderPass = false;
-
-						if (BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
-						{
-							vkCmdEndDebugUtilsLabelEXT(m_commandBuffer);
-						}
-					}
-
-					VK_CHECK(vkEndCommandBuffer(m_commandBuffer) );
-
-//					m_batch.flush(m_commandList, true);
-					kick(renderWait);
-					renderWait = VK_NULL_HANDLE;
-finishAll();
+					programProfiler.end();
 
 					view = key.m_view;
 					currentPipeline = VK_NULL_HANDLE;
@@ -4030,52 +5612,36 @@ BX_UNUSED(currentSamplerStateIdx);
 					viewHasScissor  = !scissorRect.isZero();
 					viewScissorRect = viewHasScissor ? scissorRect : rect;
 
-					rpbi.renderArea.offset.x = rect.m_x;
-					rpbi.renderArea.offset.y = rect.m_y;
-					rpbi.renderArea.extent.width  = rect.m_width;
-					rpbi.renderArea.extent.height = rect.m_height;
-					VK_CHECK(vkBeginCommandBuffer(m_commandBuffer, &cbbi) );
-
-					if (BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
-					{
-						VkDebugUtilsLabelEXT dul;
-						dul.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
-						dul.pNext = NULL;
-						dul.pLabelName = s_viewName[view];
-						dul.color[0] = 1.0f;
-						dul.color[1] = 1.0f;
-						dul.color[2] = 1.0f;
-						dul.color[3] = 1.0f;
-						vkCmdBeginDebugUtilsLabelEXT(m_commandBuffer, &dul);
-					}
+					// View is only collected here, render pass is started
+					// once all views are prepared.
+					ViewCommandsVK& vc = m_renderCommandList.beginView(view);
 
-					vkCmdBeginRenderPass(m_commandBuffer, &rpbi, VK_SUBPASS_CONTENTS_INLINE);
-					beginRenderPass = true;
+					vc.m_renderArea.offset.x      = rect.m_x;
+					vc.m_renderArea.offset.y      = rect.m_y;
+					vc.m_renderArea.extent.width  = rect.m_width;
+					vc.m_renderArea.extent.height = rect.m_height;
 
-					VkViewport vp;
+					VkViewport& vp = vc.m_viewport;
 					vp.x        = rect.m_x;
 					vp.y        = rect.m_y;
 					vp.width    = rect.m_width;
 					vp.height   = rect.m_height;
 					vp.minDepth = 0.0f;
 					vp.maxDepth = 1.0f;
-					vkCmdSetViewport(m_commandBuffer, 0, 1, &vp);
 
-					VkRect2D rc;
-					rc.offset.x      = viewScissorRect.m_x;
-					rc.offset.y      = viewScissorRect.m_y;
-					rc.extent.width  = viewScissorRect.m_x + viewScissorRect.m_width;
-					rc.extent.height = viewScissorRect.m_y + viewScissorRect.m_height;
-					vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
+					currentScissor.offset.x      = viewScissorRect.m_x;
+					currentScissor.offset.y      = viewScissorRect.m_y;
+					currentScissor.extent.width  = viewScissorRect.m_x + viewScissorRect.m_width;
+					currentScissor.extent.height = viewScissorRect.m_y + viewScissorRect.m_height;
 
-					restoreScissor = false;
+					currentDescriptorSet = VK_NULL_HANDLE;
 
 					Clear& clr = _render->m_view[view].m_clear;
 					if (BGFX_CLEAR_NONE != clr.m_flags)
 					{
 						Rect clearRect = rect;
 						clearRect.setIntersect(rect, viewScissorRect);
-						clearQuad(clearRect, clr, _render->m_colorPalette);
+						clearQuad(vc, clearRect, clr, _render->m_colorPalette);
 					}
 
 					prim = s_primInfo[Topology::Count]; // Force primitive type update.
@@ -4083,6 +5649,8 @@ BX_UNUSED(currentSamplerStateIdx);
 					submitBlit(bs, view);
 				}
 
+				programProfiler.begin(key.m_program, renderItem, isCompute);
+
 				if (isCompute)
 				{
 					if (!wasCompute)
@@ -4103,7 +5671,7 @@ BX_UNUSED(currentSamplerStateIdx);
 					if (pipeline != currentPipeline)
 					{
 						currentPipeline = pipeline;
-						vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+//						vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
 						currentBindHash = 0;
 					}
 
@@ -4201,6 +5769,11 @@ BX_UNUSED(currentSamplerStateIdx);
 					{
 						rendererUpdateUniforms(this, _render->m_uniformBuffer[compute.m_uniformIdx], compute.m_uniformBegin, compute.m_uniformEnd);
 
+						if (currentProgram.idx != key.m_program.idx)
+						{
+							stateCounter.programChange();
+						}
+
 						currentProgram = key.m_program;
 						ProgramVK& program = m_program[currentProgram.idx];
 
@@ -4279,6 +5852,13 @@ BX_UNUSED(currentSamplerStateIdx);
 				uint64_t changedStencil = (currentState.m_stencil ^ draw.m_stencil) & BGFX_STENCIL_FUNC_REF_MASK;
 				currentState.m_stencil = newStencil;
 
+				if (0 != changedFlags
+				||  0 != changedStencil)
+				{
+					programProfiler.stateChange();
+					stateCounter.stateChange(changedFlags, changedStencil);
+				}
+
 				if (viewChanged
 				||  wasCompute)
 				{
@@ -4422,27 +6002,22 @@ BX_UNUSED(currentSamplerStateIdx);
 //						}
 //					}
 
-					if (pipeline != currentPipeline
-					||  0 != changedStencil)
-					{
-						const uint32_t fstencil = unpackStencil(0, draw.m_stencil);
-						const uint32_t ref = (fstencil&BGFX_STENCIL_FUNC_REF_MASK)>>BGFX_STENCIL_FUNC_REF_SHIFT;
-						vkCmdSetStencilReference(m_commandBuffer, VK_STENCIL_FRONT_AND_BACK, ref);
-					}
+					RenderCommandVK cmd;
+					cmd.clear();
+					cmd.m_pipeline = pipeline;
+
+					const uint32_t fstencil = unpackStencil(0, draw.m_stencil);
+					cmd.m_stencilRef = (fstencil&BGFX_STENCIL_FUNC_REF_MASK)>>BGFX_STENCIL_FUNC_REF_SHIFT;
 
 					if (pipeline != currentPipeline
 					|| (hasFactor && blendFactor != draw.m_rgba) )
 					{
 						blendFactor = draw.m_rgba;
-
-						float bf[4];
-						bf[0] = ( (draw.m_rgba>>24)     )/255.0f;
-						bf[1] = ( (draw.m_rgba>>16)&0xff)/255.0f;
-						bf[2] = ( (draw.m_rgba>> 8)&0xff)/255.0f;
-						bf[3] = ( (draw.m_rgba    )&0xff)/255.0f;
-						vkCmdSetBlendConstants(m_commandBuffer, bf);
 					}
 
+					cmd.m_rgba  = blendFactor;
+					cmd.m_dirty = hasFactor ? RenderCommandVK::Dirty::BlendFactor : 0;
+
 					if (0 != (BGFX_STATE_PT_MASK & changedFlags)
 					||  prim.m_topology != s_primInfo[primIndex].m_topology)
 					{
@@ -4456,46 +6031,32 @@ BX_UNUSED(currentSamplerStateIdx);
 					{
 						currentState.m_scissor = scissor;
 
-						if (UINT16_MAX == scissor)
-						{
-							if (restoreScissor
-							||  viewHasScissor)
-							{
-								restoreScissor = false;
-								VkRect2D rc;
-								rc.offset.x      = viewScissorRect.m_x;
-								rc.offset.y      = viewScissorRect.m_y;
-								rc.extent.width  = viewScissorRect.m_x + viewScissorRect.m_width;
-								rc.extent.height = viewScissorRect.m_y + viewScissorRect.m_height;
-								vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
-							}
-						}
-						else
+						Rect scissorRect = viewScissorRect;
+						if (UINT16_MAX != scissor)
 						{
-							restoreScissor = true;
-							Rect scissorRect;
 							scissorRect.setIntersect(viewScissorRect, _render->m_frameCache.m_rectCache.m_cache[scissor]);
-
-							VkRect2D rc;
-							rc.offset.x      = scissorRect.m_x;
-							rc.offset.y      = scissorRect.m_y;
-							rc.extent.width  = scissorRect.m_x + scissorRect.m_width;
-							rc.extent.height = scissorRect.m_y + scissorRect.m_height;
-							vkCmdSetScissor(m_commandBuffer, 0, 1, &rc);
 						}
-					}
 
-					if (pipeline != currentPipeline)
-					{
-						currentPipeline = pipeline;
-						vkCmdBindPipeline(m_commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+						currentScissor.offset.x      = scissorRect.m_x;
+						currentScissor.offset.y      = scissorRect.m_y;
+						currentScissor.extent.width  = scissorRect.m_x + scissorRect.m_width;
+						currentScissor.extent.height = scissorRect.m_y + scissorRect.m_height;
 					}
 
+					cmd.m_scissor = currentScissor;
+
+					currentPipeline = pipeline;
+
 					bool constantsChanged = false;
 					if (draw.m_uniformBegin < draw.m_uniformEnd
 					||  currentProgram.idx != key.m_program.idx
 					||  BGFX_STATE_ALPHA_REF_MASK & changedFlags)
 					{
+						if (currentProgram.idx != key.m_program.idx)
+						{
+							stateCounter.programChange();
+						}
+
 						currentProgram = key.m_program;
 						ProgramVK& program = m_program[currentProgram.idx];
 
@@ -4522,22 +6083,24 @@ BX_UNUSED(currentSamplerStateIdx);
 						uint32_t ref = (newFlags&BGFX_STATE_ALPHA_REF_MASK)>>BGFX_STATE_ALPHA_REF_SHIFT;
 						viewState.m_alphaRef = ref/255.0f;
 						viewState.setPredefined<4>(this, view, program, _render, draw);
-						commitShaderUniforms(m_commandBuffer, key.m_program); //, gpuAddress);
+						if (commitShaderUniforms(key.m_program, stateCounter, currentDescriptorSet, currentDynamicOffsets) )
+						{
+							stateCounter.uniformUpload();
+						}
 					}
 
+					cmd.m_descriptorSet     = currentDescriptorSet;
+					cmd.m_dynamicOffsets[0] = currentDynamicOffsets[0];
+					cmd.m_dynamicOffsets[1] = currentDynamicOffsets[1];
 
 //					vb.setState(_commandList, D3D12_RESOURCE_STATE_GENERIC_READ);
 
 					const VertexDecl& vertexDecl = m_vertexDecls[declIdx];
 					uint32_t numIndices = 0;
 
-					VkDeviceSize offset = 0;
-					vkCmdBindVertexBuffers(m_commandBuffer
-						, 0
-						, 1
-						, &vb.m_buffer
-						, &offset
-						);
+					cmd.m_vertexBuffer = vb.m_buffer;
+					cmd.m_numInstances = draw.m_numInstances;
+					cmd.m_startVertex  = draw.m_stream[0].m_startVertex;
 
 					if (!isValid(draw.m_indexBuffer) )
 					{
@@ -4545,12 +6108,9 @@ BX_UNUSED(currentSamplerStateIdx);
 							? vb.m_size / vertexDecl.m_stride
 							: draw.m_numVertices
 							;
-						vkCmdDraw(m_commandBuffer
-							, numVertices
-							, draw.m_numInstances
-							, draw.m_stream[0].m_startVertex
-							, 0
-							);
+
+						cmd.m_type = RenderCommandVK::Type::Draw;
+						cmd.m_num  = numVertices;
 					}
 					else
 					{
@@ -4565,20 +6125,26 @@ BX_UNUSED(currentSamplerStateIdx);
 							: draw.m_numIndices
 							;
 
-						vkCmdBindIndexBuffer(m_commandBuffer
-							, ib.m_buffer
-							, 0
-							, hasIndex16
-								? VK_INDEX_TYPE_UINT16
-								: VK_INDEX_TYPE_UINT32
-							);
-						vkCmdDrawIndexed(m_commandBuffer
-							, numIndices
-							, draw.m_numInstances
-							, draw.m_startIndex
-							, draw.m_stream[0].m_startVertex
-							, 0
-							);
+						cmd.m_type        = RenderCommandVK::Type::DrawIndexed;
+						cmd.m_num         = numIndices;
+						cmd.m_startIndex  = draw.m_startIndex;
+						cmd.m_indexBuffer = ib.m_buffer;
+						cmd.m_indexType   = hasIndex16
+							? VK_INDEX_TYPE_UINT16
+							: VK_INDEX_TYPE_UINT32
+							;
+					}
+
+					const uint8_t dirty = m_renderCommandList.push(cmd);
+
+					if (0 != (dirty & RenderCommandVK::Dirty::VertexBuffer) )
+					{
+						stateCounter.vertexBufferBind();
+					}
+
+					if (0 != (dirty & RenderCommandVK::Dirty::IndexBuffer) )
+					{
+						stateCounter.indexBufferBind();
 					}
 
 					uint32_t numPrimsSubmitted = numIndices / prim.m_div - prim.m_sub;
@@ -4598,8 +6164,14 @@ BX_UNUSED(currentSamplerStateIdx);
 				}
 			}
 
+			programProfiler.end();
+
+			m_renderCommandList.end();
+
 			submitBlit(bs, BGFX_CONFIG_MAX_VIEWS);
 
+			submitViews(rpbi);
+
 //			m_batch.end(m_commandList);
 		}
 
@@ -4624,6 +6196,11 @@ BX_UNUSED(presentMin, presentMax);
 
 //		m_gpuTimer.end(m_commandList);
 
+		if (m_timerQuerySupport)
+		{
+			m_gpuScope.finish(_render);
+		}
+
 //		while (m_gpuTimer.get() )
 //		{
 //			double toGpuMs = 1000.0 / double(m_gpuTimer.m_frequency);
@@ -4646,8 +6223,17 @@ BX_UNUSED(presentMin, presentMax);
 		perfStats.numBlit       = _render->m_numBlitItems;
 //		perfStats.maxGpuLatency = maxGpuLatency;
 		bx::memCopy(perfStats.numPrims, statsNumPrimsRendered, sizeof(perfStats.numPrims) );
-		perfStats.gpuMemoryMax  = -INT64_MAX;
-		perfStats.gpuMemoryUsed = -INT64_MAX;
+		perfStats.gpuMemoryMax  = 0;
+		perfStats.gpuMemoryUsed = m_memoryAllocator.getUsed();
+
+		for (uint32_t ii = 0, num = m_memoryProperties.memoryHeapCount; ii < num; ++ii)
+		{
+			const VkMemoryHeap& heap = m_memoryProperties.memoryHeaps[ii];
+			if (0 != (heap.flags & VK_MEMORY_HEAP_DEVICE_LOCAL_BIT) )
+			{
+				perfStats.gpuMemoryMax += int64_t(heap.size);
+			}
+		}
 
 		if (_render->m_debug & (BGFX_DEBUG_IFH|BGFX_DEBUG_STATS) )
 		{
@@ -4718,6 +6304,24 @@ BX_UNUSED(presentMin, presentMax);
 //					, currentReservation
 //					);
 
+				char memoryUsed[16];
+				bx::prettify(memoryUsed, BX_COUNTOF(memoryUsed), perfStats.gpuMemoryUsed);
+
+				char memoryAllocated[16];
+				bx::prettify(memoryAllocated, BX_COUNTOF(memoryAllocated), m_memoryAllocator.getAllocated() );
+
+				tvm.printf(0, pos++, 0x8f, " Memory: %s (used), %s (allocated, %d blocks, %d dedicated) "
+					, memoryUsed
+					, memoryAllocated
+					, m_memoryAllocator.getNumBlocks()
+					, m_memoryAllocator.getNumDedicated()
+					);
+
+				tvm.printf(0, pos++, 0x8f, " Bind cache: %d hits, %d misses "
+					, stateCounter.m_numBindCacheHits
+					, stateCounter.m_numBindCacheMisses
+					);
+
 				pos = 10;
 				tvm.printf(10, pos++, 0x8b, "       Frame: % 7.3f, % 7.3f \x1f, % 7.3f \x1e [ms] / % 6.2f FPS "
 					, double(frameTime)*toMs
@@ -4779,6 +6383,9 @@ BX_UNUSED(presentMin, presentMax);
 				tvm.printf(10, pos++, 0x8b, "     DVB size: %7d ", _render->m_vboffset);
 				tvm.printf(10, pos++, 0x8b, "     DIB size: %7d ", _render->m_iboffset);
 
+				pos++;
+				pos = dbgTextFrameTiming(tvm, 10, pos, _render);
+
 				pos++;
 				tvm.printf(10, pos++, 0x8b, " State cache:                        ");
 				tvm.printf(10, pos++, 0x8b, " PSO    | Sampler | Bind   | Queued  ");
@@ -4798,6 +6405,7 @@ BX_UNUSED(presentMin, presentMax);
 
 				tvm.printf(10, pos++, attr[attrIndex&1], " Submit wait: %7.4f [ms] ", _render->m_waitSubmit*toMs);
 				tvm.printf(10, pos++, attr[(attrIndex+1)&1], " Render wait: %7.4f [ms] ", _render->m_waitRender*toMs);
+				tvm.printf(10, pos++, 0x8b, " Pacing wait: %7.4f [ms] ", _render->m_framePacing*toMs);
 
 				min = frameTime;
 				max = frameTime;
@@ -4818,17 +6426,6 @@ BX_UNUSED(presentMin, presentMax);
 //			PIX_ENDEVENT();
 		}
 
-		if (beginRenderPass)
-		{
-			vkCmdEndRenderPass(m_commandBuffer);
-			beginRenderPass = false;
-
-			if (BX_ENABLED(BGFX_CONFIG_DEBUG_ANNOTATION) )
-			{
-				vkCmdEndDebugUtilsLabelEXT(m_commandBuffer);
-			}
-		}
-
 		setImageMemoryBarrier(m_commandBuffer
 			, m_backBufferColorImage[m_backBufferColorIdx]
 			, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL
@@ -4837,10 +6434,19 @@ BX_UNUSED(presentMin, presentMax);
 
 		VK_CHECK(vkEndCommandBuffer(m_commandBuffer) );
 
-		kick(renderWait); //, m_presentDone[m_backBufferColorIdx]);
-		finishAll();
+		m_fenceFrame[m_frameIdx] = ++m_frameCount;
+		kick(renderWait, m_renderDone[m_frameIdx], m_fence[m_frameIdx]);
+
+		m_presentIdx = m_frameIdx;
 
-		VK_CHECK(vkResetCommandPool(m_device, m_commandPool, 0) );
+		// Pipelines created ahead of use are written out right away, so the
+		// next run benefits from them even if it doesn't shutdown cleanly.
+		if (m_pipelinePrewarmed)
+		{
+			m_pipelinePrewarmed = false;
+			savePipelineCache();
+		}
+		m_frameBegun = false;
 	}
 
 } /* namespace vk */ } // namespace bgfx
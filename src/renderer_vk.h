@@ -92,6 +92,7 @@
 			VK_IMPORT_DEVICE_FUNC(false, vkCreateSemaphore);               \
 			VK_IMPORT_DEVICE_FUNC(false, vkDestroySemaphore);              \
 			VK_IMPORT_DEVICE_FUNC(false, vkResetFences);                   \
+			VK_IMPORT_DEVICE_FUNC(false, vkGetFenceStatus);                \
 			VK_IMPORT_DEVICE_FUNC(false, vkCreateCommandPool);             \
 			VK_IMPORT_DEVICE_FUNC(false, vkDestroyCommandPool);            \
 			VK_IMPORT_DEVICE_FUNC(false, vkResetCommandPool);              \
@@ -141,6 +142,7 @@
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdPipelineBarrier);            \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdBeginRenderPass);            \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdEndRenderPass);              \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdExecuteCommands);            \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdSetViewport);                \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdDraw);                       \
 			VK_IMPORT_DEVICE_FUNC(false, vkCmdDrawIndexed);                \
@@ -167,6 +169,11 @@
 			VK_IMPORT_DEVICE_FUNC(false, vkInvalidateMappedMemoryRanges);  \
 			VK_IMPORT_DEVICE_FUNC(false, vkBindBufferMemory);              \
 			VK_IMPORT_DEVICE_FUNC(false, vkBindImageMemory);               \
+			VK_IMPORT_DEVICE_FUNC(false, vkCreateQueryPool);               \
+			VK_IMPORT_DEVICE_FUNC(false, vkDestroyQueryPool);              \
+			VK_IMPORT_DEVICE_FUNC(false, vkGetQueryPoolResults);           \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdResetQueryPool);             \
+			VK_IMPORT_DEVICE_FUNC(false, vkCmdWriteTimestamp);             \
 			/* VK_EXT_debug_marker */                                      \
 			VK_IMPORT_DEVICE_FUNC(true,  vkDebugMarkerSetObjectTagEXT);    \
 			VK_IMPORT_DEVICE_FUNC(true,  vkDebugMarkerSetObjectNameEXT);   \
@@ -198,6 +205,7 @@
 			VK_DESTROY_FUNC(Pipeline);            \
 			VK_DESTROY_FUNC(PipelineCache);       \
 			VK_DESTROY_FUNC(PipelineLayout);      \
+			VK_DESTROY_FUNC(QueryPool);           \
 			VK_DESTROY_FUNC(RenderPass);          \
 			VK_DESTROY_FUNC(Semaphore);           \
 			VK_DESTROY_FUNC(ShaderModule);        \
@@ -299,10 +307,77 @@ VK_DESTROY
 		HashMap m_hashMap;
 	};
 
+	struct DeviceMemoryAllocationVK
+	{
+		DeviceMemoryAllocationVK()
+			: m_memory(VK_NULL_HANDLE)
+			, m_offset(0)
+			, m_size(0)
+			, m_data(NULL)
+			, m_block(UINT32_MAX)
+		{
+		}
+
+		VkDeviceMemory m_memory;
+		VkDeviceSize   m_offset;
+		VkDeviceSize   m_size;
+		uint8_t*       m_data;
+		uint32_t       m_block;
+	};
+
+	class DeviceMemoryAllocatorVK
+	{
+	public:
+		DeviceMemoryAllocatorVK();
+
+		void shutdown();
+		VkResult alloc(const VkMemoryRequirements& _requirements, uint32_t _propertyFlags, bool _linear, DeviceMemoryAllocationVK& _allocation);
+		void free(DeviceMemoryAllocationVK& _allocation);
+
+		int64_t  getUsed() const { return m_used; }
+		int64_t  getAllocated() const { return m_allocated; }
+		uint32_t getNumBlocks() const { return m_numBlocks; }
+		uint32_t getNumDedicated() const { return m_numDedicated; }
+
+	private:
+		VkResult allocMemory(VkDeviceSize _size, uint32_t _memoryTypeIndex, VkDeviceMemory& _memory, uint8_t*& _data);
+		void freeMemory(VkDeviceMemory _memory, uint8_t* _data, VkDeviceSize _size);
+		bool allocRange(uint32_t _block, VkDeviceSize _size, VkDeviceSize _align, VkDeviceSize& _offset);
+
+		struct Range
+		{
+			VkDeviceSize m_offset;
+			VkDeviceSize m_size;
+		};
+
+		typedef stl::vector<Range> RangeArray;
+
+		struct Block
+		{
+			VkDeviceMemory m_memory;
+			VkDeviceSize   m_size;
+			uint8_t*       m_data;
+			uint32_t       m_memoryTypeIndex;
+			bool           m_linear;
+			RangeArray     m_free;
+		};
+
+		typedef stl::vector<Block> BlockArray;
+		BlockArray m_block;
+
+		int64_t  m_used;
+		int64_t  m_allocated;
+		uint32_t m_numBlocks;
+		uint32_t m_numDedicated;
+	};
+
 	class ScratchBufferVK
 	{
 	public:
 		ScratchBufferVK()
+			: m_descriptorPool(VK_NULL_HANDLE)
+			, m_buffer(VK_NULL_HANDLE)
+			, m_data(NULL)
 		{
 		}
 
@@ -313,23 +388,237 @@ VK_DESTROY
 		void create(uint32_t _size, uint32_t _maxDescriptors);
 		void destroy();
 		void reset(VkDescriptorBufferInfo& _gpuAddress);
-		void* allocUbv(uint32_t _vsize, uint32_t _fsize);
+		void* allocUbv(uint32_t _vsize, uint32_t _fsize, uint32_t* _dynamicOffsets);
+		VkDescriptorSet getDescriptorSet(uint32_t _vrange, uint32_t _frange, bool& _cached);
+
+		typedef stl::unordered_map<uint32_t, VkDescriptorSet> DescriptorSetCache;
+		DescriptorSetCache m_descriptorSetCache;
 
-		VkDescriptorSet* m_descriptorSet;
+		VkDescriptorPool m_descriptorPool;
 		VkBuffer m_buffer;
-		VkDeviceMemory m_deviceMem;
+		DeviceMemoryAllocationVK m_memory;
 		uint8_t* m_data;
 		uint32_t m_size;
 		uint32_t m_pos;
-		uint32_t m_currentDs;
 		uint32_t m_maxDescriptors;
 	};
 
+	class StagingBufferVK
+	{
+	public:
+		StagingBufferVK()
+			: m_buffer(VK_NULL_HANDLE)
+			, m_size(0)
+			, m_pos(0)
+		{
+		}
+
+		void create(uint32_t _size);
+		void destroy();
+		void reset();
+
+		/// Returns offset of allocated range, or UINT32_MAX when buffer is full.
+		uint32_t alloc(uint32_t _size);
+
+		VkBuffer m_buffer;
+		DeviceMemoryAllocationVK m_memory;
+		uint32_t m_size;
+		uint32_t m_pos;
+	};
+
+	struct GpuScopeTimerVK
+	{
+		GpuScopeTimerVK()
+			: m_queryPool(VK_NULL_HANDLE)
+			, m_period(1.0)
+			, m_numReset(0)
+		{
+		}
+
+		VkResult create();
+		void destroy();
+		void resetQueries(VkCommandBuffer _commandBuffer);
+		void timestamp(uint32_t _idx);
+		bool result(uint32_t _idx, uint64_t& _time);
+		void release(uint32_t _idx);
+
+		VkQueryPool m_queryPool;
+		double      m_period;
+		uint32_t    m_numReset;
+		uint32_t    m_reset[kGpuScopeQueries];
+		uint64_t    m_frame[kGpuScopeQueries];
+	};
+
+	/// Draw call, timestamp or marker with all state resolved on render
+	/// thread, so it can be recorded into command buffer from any thread.
+	struct RenderCommandVK
+	{
+		struct Type
+		{
+			enum Enum
+			{
+				Draw,
+				DrawIndexed,
+				Timestamp,
+				Marker,
+			};
+		};
+
+		struct Dirty
+		{
+			enum Enum
+			{
+				Pipeline      = 1<<0,
+				StencilRef    = 1<<1,
+				BlendFactor   = 1<<2,
+				Scissor       = 1<<3,
+				DescriptorSet = 1<<4,
+				VertexBuffer  = 1<<5,
+				IndexBuffer   = 1<<6,
+			};
+		};
+
+		void clear();
+
+		VkPipeline      m_pipeline;
+		VkDescriptorSet m_descriptorSet;
+		VkBuffer        m_vertexBuffer;
+		VkBuffer        m_indexBuffer;
+		VkRect2D        m_scissor;
+		const char*     m_marker;
+		uint32_t        m_dynamicOffsets[2];
+		uint32_t        m_stencilRef;
+		uint32_t        m_rgba;
+		uint32_t        m_num;
+		uint32_t        m_numInstances;
+		uint32_t        m_startVertex;
+		uint32_t        m_startIndex;
+		VkIndexType     m_indexType;
+		uint8_t         m_type;
+		uint8_t         m_dirty;
+	};
+
+	struct ViewCommandsVK
+	{
+		VkRect2D          m_renderArea;
+		VkViewport        m_viewport;
+		VkClearRect       m_clearRect;
+		VkClearAttachment m_clear[BGFX_CONFIG_MAX_FRAME_BUFFER_ATTACHMENTS+1];
+		uint32_t          m_numClear;
+		uint32_t          m_firstChunk;
+		uint32_t          m_numChunks;
+		ViewId            m_view;
+	};
+
+	struct RenderChunkVK
+	{
+		VkCommandBuffer m_commandBuffer;
+		uint32_t        m_view;
+		uint32_t        m_begin;
+		uint32_t        m_end;
+	};
+
+	/// Render commands of frame, grouped by view and split into chunks of
+	/// at most `BGFX_CONFIG_RENDERER_VULKAN_RECORD_CHUNK_SIZE` commands. Each
+	/// chunk starts with no bound state, so chunks can be recorded
+	/// independently.
+	class RenderCommandListVK
+	{
+	public:
+		RenderCommandListVK()
+			: m_recording(false)
+		{
+		}
+
+		void reset();
+		ViewCommandsVK& beginView(ViewId _view);
+		void end();
+
+		/// Adds command, and returns state that needs to be set before it.
+		uint8_t push(const RenderCommandVK& _cmd);
+
+		void record(VkCommandBuffer _commandBuffer, const RenderChunkVK& _chunk) const;
+
+		bool isRecording() const
+		{
+			return m_recording;
+		}
+
+		uint32_t getNumCommands() const
+		{
+			return uint32_t(m_commands.size() );
+		}
+
+		typedef stl::vector<RenderCommandVK> RenderCommandArray;
+		RenderCommandArray m_commands;
+
+		typedef stl::vector<ViewCommandsVK> ViewCommandsArray;
+		ViewCommandsArray m_views;
+
+		typedef stl::vector<RenderChunkVK> RenderChunkArray;
+		RenderChunkArray m_chunks;
+
+		RenderCommandVK m_bound;
+		bool m_recording;
+
+	private:
+		void beginChunk();
+	};
+
+	/// Records chunks of render command list into secondary command buffers
+	/// on worker threads. Render thread records chunks too while waiting for
+	/// workers.
+	class CommandRecorderVK
+	{
+	public:
+		CommandRecorderVK();
+
+		VkResult init(uint32_t _numThreads);
+		void shutdown();
+
+		/// Resets command buffers of frame slot. Frame that used them last must
+		/// be completed.
+		void reset(uint32_t _frameIdx);
+
+		void record(uint32_t _frameIdx, RenderCommandListVK& _list, const VkCommandBufferInheritanceInfo& _inheritance);
+
+		uint32_t getNumThreads() const
+		{
+			return m_numThreads;
+		}
+
+	private:
+		static int32_t threadFunc(bx::Thread* _thread, void* _userData);
+		void work(uint32_t _worker);
+
+		typedef stl::vector<VkCommandBuffer> CommandBufferArray;
+
+		struct Worker
+		{
+			CommandRecorderVK* m_recorder;
+			bx::Thread         m_thread;
+			VkCommandPool      m_commandPool[4];
+			CommandBufferArray m_commandBuffer[4];
+			uint32_t           m_numUsed[4];
+			uint32_t           m_idx;
+		};
+
+		Worker m_worker[BGFX_CONFIG_RENDERER_VULKAN_RECORD_THREADS+1];
+		bx::Semaphore m_kick;
+		bx::Semaphore m_done;
+
+		RenderCommandListVK* m_list;
+		VkCommandBufferInheritanceInfo m_inheritance;
+		uint32_t m_frameIdx;
+		uint32_t m_next;
+		uint32_t m_numThreads;
+		bool     m_exit;
+	};
+
 	struct ImageVK
 	{
 		ImageVK()
-			: m_memory(VK_NULL_HANDLE)
-			, m_image(VK_NULL_HANDLE)
+			: m_image(VK_NULL_HANDLE)
 			, m_imageView(VK_NULL_HANDLE)
 		{
 		}
@@ -337,16 +626,15 @@ VK_DESTROY
 		VkResult create(VkFormat _format, const VkExtent3D& _extent);
 		void destroy();
 
-		VkDeviceMemory m_memory;
-		VkImage        m_image;
-		VkImageView    m_imageView;
+		DeviceMemoryAllocationVK m_memory;
+		VkImage     m_image;
+		VkImageView m_imageView;
 	};
 
 	struct BufferVK
 	{
 		BufferVK()
 			: m_buffer(VK_NULL_HANDLE)
-			, m_deviceMem(VK_NULL_HANDLE)
 			, m_size(0)
 			, m_flags(BGFX_BUFFER_NONE)
 			, m_dynamic(false)
@@ -358,7 +646,7 @@ VK_DESTROY
 		void destroy();
 
 		VkBuffer m_buffer;
-		VkDeviceMemory m_deviceMem;
+		DeviceMemoryAllocationVK m_memory;
 		uint32_t m_size;
 		uint16_t m_flags;
 		bool m_dynamic;
@@ -0,0 +1,309 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include "bgfx_p.h"
+#include "trace.h"
+
+#include <bx/os.h>
+
+namespace bgfx
+{
+#if BGFX_CONFIG_PROFILER
+	BX_STATIC_ASSERT(0 == (BGFX_CONFIG_PROFILER_TRACE_EVENTS & (BGFX_CONFIG_PROFILER_TRACE_EVENTS-1) ));
+
+	static const uint32_t kTraceGpuTid = UINT32_MAX;
+
+	struct TraceEvent
+	{
+		enum Enum
+		{
+			Begin,
+			End,
+			Complete,
+		};
+
+		char     m_name[64]; //!< Copied, source string can change or go away.
+		int64_t  m_time;
+		int64_t  m_duration;
+		uint32_t m_tid;
+		uint32_t m_frame;
+		uint32_t m_abgr;
+		uint32_t m_type;
+		volatile uint32_t m_seq; //!< Event index + 1, 0 while slot is being written.
+	};
+
+	struct TraceThread
+	{
+		uint32_t m_tid;
+		char     m_name[64];
+	};
+
+	struct TraceRecorder
+	{
+		TraceEvent* m_events;
+		uint32_t    m_head;
+		uint32_t    m_frame;
+		uint32_t    m_numThreads;
+		TraceThread m_thread[32];
+	};
+
+	static TraceRecorder s_trace;
+
+	static void tracePush(TraceEvent::Enum _type, const char* _name, uint32_t _abgr, uint32_t _tid, int64_t _time, int64_t _duration)
+	{
+		TraceEvent* events = s_trace.m_events;
+
+		if (NULL == events)
+		{
+			return;
+		}
+
+		const uint32_t idx = bx::atomicFetchAndAdd(&s_trace.m_head, 1u);
+		TraceEvent& event = events[idx & (BGFX_CONFIG_PROFILER_TRACE_EVENTS-1)];
+
+		event.m_seq = 0;
+		bx::writeBarrier();
+
+		bx::strCopy(event.m_name, BX_COUNTOF(event.m_name), NULL != _name ? _name : "");
+		event.m_time     = _time;
+		event.m_duration = _duration;
+		event.m_tid      = _tid;
+		event.m_frame    = s_trace.m_frame;
+		event.m_abgr     = _abgr;
+		event.m_type     = _type;
+
+		bx::writeBarrier();
+		event.m_seq = idx + 1;
+	}
+
+	void traceInit()
+	{
+		bx::memSet(&s_trace, 0, sizeof(s_trace) );
+
+		TraceEvent* events = (TraceEvent*)BX_ALLOC(g_allocator, BGFX_CONFIG_PROFILER_TRACE_EVENTS*sizeof(TraceEvent) );
+		bx::memSet(events, 0, BGFX_CONFIG_PROFILER_TRACE_EVENTS*sizeof(TraceEvent) );
+
+		bx::writeBarrier();
+		s_trace.m_events = events;
+	}
+
+	void traceShutdown()
+	{
+		TraceEvent* events = s_trace.m_events;
+		s_trace.m_events = NULL;
+		bx::writeBarrier();
+
+		BX_FREE(g_allocator, events);
+	}
+
+	void traceFrame(uint32_t _frame)
+	{
+		s_trace.m_frame = _frame;
+	}
+
+	void traceBegin(const char* _name, uint32_t _abgr)
+	{
+		tracePush(TraceEvent::Begin, _name, _abgr, bx::getTid(), bx::getHPCounter(), 0);
+	}
+
+	void traceEnd()
+	{
+		tracePush(TraceEvent::End, NULL, 0, bx::getTid(), bx::getHPCounter(), 0);
+	}
+
+	void traceSetThreadName(const char* _name)
+	{
+		const uint32_t idx = bx::atomicFetchAndAdd(&s_trace.m_numThreads, 1u);
+
+		if (idx < BX_COUNTOF(s_trace.m_thread) )
+		{
+			TraceThread& thread = s_trace.m_thread[idx];
+			thread.m_tid = bx::getTid();
+			bx::strCopy(thread.m_name, BX_COUNTOF(thread.m_name), _name);
+		}
+	}
+
+	void traceGpuViews(const Stats& _stats)
+	{
+		if (0 == _stats.gpuTimerFreq)
+		{
+			return;
+		}
+
+		const double toCpu = double(_stats.cpuTimerFreq) / double(_stats.gpuTimerFreq);
+		int64_t time = _stats.cpuTimeBegin;
+
+		for (uint16_t ii = 0; ii < _stats.numViews; ++ii)
+		{
+			const ViewStats& viewStats = _stats.viewStats[ii];
+			const int64_t duration = int64_t(double(viewStats.gpuTimeElapsed) * toCpu);
+
+			tracePush(TraceEvent::Complete, viewStats.name, 0, kTraceGpuTid, time, duration);
+			time += duration;
+		}
+	}
+
+	static const char* traceEscape(char* _out, uint32_t _size, const char* _str)
+	{
+		uint32_t pos = 0;
+
+		for (const char* ptr = _str; '\0' != *ptr && pos + 2 < _size; ++ptr)
+		{
+			const char ch = *ptr;
+
+			if ('"' == ch
+			||  '\\' == ch)
+			{
+				_out[pos++] = '\\';
+				_out[pos++] = ch;
+			}
+			else if (uint8_t(ch) >= ' ')
+			{
+				_out[pos++] = ch;
+			}
+		}
+
+		_out[pos] = '\0';
+
+		return _out;
+	}
+
+	bool traceWrite(bx::WriterI* _writer, uint32_t _firstFrame, uint32_t _numFrames)
+	{
+		const TraceEvent* events = s_trace.m_events;
+
+		if (NULL == events)
+		{
+			return false;
+		}
+
+		const uint32_t head      = bx::atomicFetchAndAdd(&s_trace.m_head, 0u);
+		const uint32_t num       = bx::min<uint32_t>(head, BGFX_CONFIG_PROFILER_TRACE_EVENTS);
+		const uint64_t lastFrame = uint64_t(_firstFrame) + _numFrames;
+		const double   toUs      = 1000000.0 / double(bx::getHPFrequency() );
+
+		char name[128];
+		bx::Error err;
+
+		bx::write(_writer, &err, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+		bx::write(_writer, &err
+			, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"GPU\"}}"
+			, kTraceGpuTid
+			);
+
+		const uint32_t numThreads = bx::min<uint32_t>(s_trace.m_numThreads, BX_COUNTOF(s_trace.m_thread) );
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			const TraceThread& thread = s_trace.m_thread[ii];
+			bx::write(_writer, &err
+				, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%u,\"args\":{\"name\":\"%s\"}}"
+				, thread.m_tid
+				, traceEscape(name, sizeof(name), thread.m_name)
+				);
+		}
+
+		for (uint32_t idx = head - num; idx != head; ++idx)
+		{
+			const TraceEvent& slot = events[idx & (BGFX_CONFIG_PROFILER_TRACE_EVENTS-1)];
+
+			const uint32_t seq = slot.m_seq;
+			bx::readBarrier();
+
+			TraceEvent event;
+			bx::memCopy(&event, (const void*)&slot, sizeof(TraceEvent) );
+
+			bx::readBarrier();
+
+			// Slot is being written, or was already overwritten by newer event.
+			if (seq != idx + 1
+			||  seq != slot.m_seq)
+			{
+				continue;
+			}
+
+			if (event.m_frame <  _firstFrame
+			||  event.m_frame >= lastFrame)
+			{
+				continue;
+			}
+
+			const double ts = double(event.m_time) * toUs;
+
+			switch (event.m_type)
+			{
+			case TraceEvent::Begin:
+				bx::write(_writer, &err
+					, ",\n{\"name\":\"%s\",\"cat\":\"bgfx\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":0,\"tid\":%u,\"args\":{\"frame\":%u}}"
+					, traceEscape(name, sizeof(name), event.m_name)
+					, ts
+					, event.m_tid
+					, event.m_frame
+					);
+				break;
+
+			case TraceEvent::End:
+				bx::write(_writer, &err
+					, ",\n{\"ph\":\"E\",\"ts\":%.3f,\"pid\":0,\"tid\":%u}"
+					, ts
+					, event.m_tid
+					);
+				break;
+
+			case TraceEvent::Complete:
+				bx::write(_writer, &err
+					, ",\n{\"name\":\"%s\",\"cat\":\"gpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%u,\"args\":{\"frame\":%u}}"
+					, traceEscape(name, sizeof(name), event.m_name)
+					, ts
+					, double(event.m_duration) * toUs
+					, event.m_tid
+					, event.m_frame
+					);
+				break;
+
+			default:
+				break;
+			}
+		}
+
+		bx::write(_writer, &err, "\n]}\n");
+
+		return err.isOk();
+	}
+#else
+	void traceInit()
+	{
+	}
+
+	void traceShutdown()
+	{
+	}
+
+	void traceFrame(uint32_t /*_frame*/)
+	{
+	}
+
+	void traceBegin(const char* /*_name*/, uint32_t /*_abgr*/)
+	{
+	}
+
+	void traceEnd()
+	{
+	}
+
+	void traceSetThreadName(const char* /*_name*/)
+	{
+	}
+
+	void traceGpuViews(const Stats& /*_stats*/)
+	{
+	}
+
+	bool traceWrite(bx::WriterI* /*_writer*/, uint32_t /*_firstFrame*/, uint32_t /*_numFrames*/)
+	{
+		return false;
+	}
+#endif // BGFX_CONFIG_PROFILER
+
+} // namespace bgfx
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#ifndef BGFX_TRACE_H_HEADER_GUARD
+#define BGFX_TRACE_H_HEADER_GUARD
+
+#include <bgfx/bgfx.h>
+#include <bx/readerwriter.h>
+
+namespace bgfx
+{
+	/// Built-in recorder for `BGFX_PROFILER_*` scopes. Events from all threads
+	/// are appended to fixed size ring buffer with single atomic increment,
+	/// oldest events are overwritten once ring is full. Scope names are
+	/// copied into event, and truncated to 63 characters.
+	///
+	void traceInit();
+
+	///
+	void traceShutdown();
+
+	/// Set frame number events recorded from this point are tagged with.
+	void traceFrame(uint32_t _frame);
+
+	///
+	void traceBegin(const char* _name, uint32_t _abgr);
+
+	///
+	void traceEnd();
+
+	///
+	void traceSetThreadName(const char* _name);
+
+	/// Record GPU view timings collected by `Profiler<Ty>`. GPU timestamps
+	/// are not in the same time domain as CPU, views are laid out back to
+	/// back starting at `Stats::cpuTimeBegin` of the frame.
+	void traceGpuViews(const Stats& _stats);
+
+	/// Write recorded events tagged with frames in range [_firstFrame,
+	/// _firstFrame + _numFrames) as Chrome trace event format JSON.
+	bool traceWrite(bx::WriterI* _writer, uint32_t _firstFrame, uint32_t _numFrames);
+
+} // namespace bgfx
+
+#endif // BGFX_TRACE_H_HEADER_GUARD
@@ -0,0 +1,680 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/allocator.h>
+#include <bx/commandline.h>
+#include <bx/cpu.h>
+#include <bx/file.h>
+#include <bx/math.h>
+#include <bx/semaphore.h>
+#include <bx/string.h>
+#include <bx/thread.h>
+#include <bx/timer.h>
+#include <bgfx/bgfx.h>
+#include <bgfx/platform.h>
+
+#include <float.h>
+#include <stdarg.h>
+
+#define BGFX_BENCH_VERSION_MAJOR 1
+#define BGFX_BENCH_VERSION_MINOR 1
+
+#define BGFX_BENCH_MAX_ENCODERS 64
+#define BGFX_BENCH_MAX_UNIFORMS 64
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		bx::printf("Error:\n%s\n\n", _error);
+	}
+
+	bx::printf(
+		  "bench, bgfx headless CPU benchmark, version %d.%d.%d.\n"
+		  "Copyright 2011-2019 Branimir Karadzic. All rights reserved.\n"
+		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
+		, BGFX_BENCH_VERSION_MAJOR
+		, BGFX_BENCH_VERSION_MINOR
+		, BGFX_API_VERSION
+		);
+
+	bx::printf(
+		  "Usage: bench [options]\n"
+
+		  "\n"
+		  "Options:\n"
+		  "  -h, --help                 Help.\n"
+		  "  -v, --version              Version information only.\n"
+		  "  -o <file path>             Write JSON report to file instead of stdout.\n"
+		  "      --frames <num>         Number of measured frames (default: 300).\n"
+		  "      --warmup <num>         Number of frames before measuring (default: 30).\n"
+		  "      --draws <num>          Draw calls per frame (default: 10000).\n"
+		  "      --encoders <num>       Number of encoder threads (default: 1).\n"
+		  "      --uniforms <num>       Uniforms set per draw call (default: 1).\n"
+		  "      --transient <bytes>    Transient vertex buffer bytes per frame (default: 0).\n"
+		  "      --texture-updates <num> 64x64 texture updates per frame (default: 0).\n"
+		  "      --threaded             Run renderer on its own thread. By default\n"
+		  "           renderer runs on API thread, and frame time includes rendering.\n"
+
+		  "\n"
+		  "Report (JSON):\n"
+		  "  encode        Time from start of encoding until all encoders are done.\n"
+		  "  frame         Time spent in bgfx::frame.\n"
+		  "  sort          Render thread time sorting draw and blit items.\n"
+		  "  execCommands  Render thread time executing pre and post commands.\n"
+		  "  submit        Render thread time in renderer submit, excluding sort.\n"
+		  "  allocations   Allocator calls per frame made through bgfx::Init::allocator.\n"
+
+		  "\n"
+		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+		);
+}
+
+struct CountingAllocator : public bx::AllocatorI
+{
+	CountingAllocator()
+		: m_numAllocs(0)
+		, m_numReallocs(0)
+		, m_numFrees(0)
+		, m_bytes(0)
+	{
+	}
+
+	virtual ~CountingAllocator()
+	{
+	}
+
+	virtual void* realloc(void* _ptr, size_t _size, size_t _align, const char* _file, uint32_t _line) override
+	{
+		if (0 == _size)
+		{
+			if (NULL != _ptr)
+			{
+				bx::atomicFetchAndAdd<int32_t>(&m_numFrees, 1);
+			}
+		}
+		else if (NULL == _ptr)
+		{
+			bx::atomicFetchAndAdd<int32_t>(&m_numAllocs, 1);
+			bx::atomicFetchAndAdd<int64_t>(&m_bytes, int64_t(_size) );
+		}
+		else
+		{
+			bx::atomicFetchAndAdd<int32_t>(&m_numReallocs, 1);
+			bx::atomicFetchAndAdd<int64_t>(&m_bytes, int64_t(_size) );
+		}
+
+		return m_allocator.realloc(_ptr, _size, _align, _file, _line);
+	}
+
+	bx::DefaultAllocator m_allocator;
+	int32_t m_numAllocs;
+	int32_t m_numReallocs;
+	int32_t m_numFrees;
+	int64_t m_bytes;
+};
+
+struct Timing
+{
+	Timing()
+		: m_total(0.0)
+		, m_min(DBL_MAX)
+		, m_max(0.0)
+		, m_num(0)
+	{
+	}
+
+	void add(int64_t _time, int64_t _freq)
+	{
+		const double ms = double(_time)*1000.0/double(bx::max<int64_t>(_freq, 1) );
+		m_total += ms;
+		m_min = bx::min(m_min, ms);
+		m_max = bx::max(m_max, ms);
+		++m_num;
+	}
+
+	double   m_total;
+	double   m_min;
+	double   m_max;
+	uint32_t m_num;
+};
+
+struct Settings
+{
+	Settings()
+		: m_numFrames(300)
+		, m_numWarmup(30)
+		, m_numDraws(10000)
+		, m_numEncoders(1)
+		, m_numUniforms(1)
+		, m_transientSize(0)
+		, m_numTextureUpdates(0)
+		, m_threaded(false)
+	{
+	}
+
+	uint32_t m_numFrames;
+	uint32_t m_numWarmup;
+	uint32_t m_numDraws;
+	uint32_t m_numEncoders;
+	uint32_t m_numUniforms;
+	uint32_t m_transientSize;
+	uint32_t m_numTextureUpdates;
+	bool     m_threaded;
+};
+
+struct PosColorVertex
+{
+	float m_x;
+	float m_y;
+	float m_z;
+	uint32_t m_abgr;
+
+	static void init()
+	{
+		ms_decl
+			.begin()
+			.add(bgfx::Attrib::Position, 3, bgfx::AttribType::Float)
+			.add(bgfx::Attrib::Color0,   4, bgfx::AttribType::Uint8, true)
+			.end();
+	}
+
+	static bgfx::VertexDecl ms_decl;
+};
+
+bgfx::VertexDecl PosColorVertex::ms_decl;
+
+static const PosColorVertex s_cubeVertices[8] =
+{
+	{-1.0f,  1.0f,  1.0f, 0xff000000 },
+	{ 1.0f,  1.0f,  1.0f, 0xff0000ff },
+	{-1.0f, -1.0f,  1.0f, 0xff00ff00 },
+	{ 1.0f, -1.0f,  1.0f, 0xff00ffff },
+	{-1.0f,  1.0f, -1.0f, 0xffff0000 },
+	{ 1.0f,  1.0f, -1.0f, 0xffff00ff },
+	{-1.0f, -1.0f, -1.0f, 0xffffff00 },
+	{ 1.0f, -1.0f, -1.0f, 0xffffffff },
+};
+
+static const uint16_t s_cubeIndices[36] =
+{
+	0, 1, 2,
+	1, 3, 2,
+	4, 6, 5,
+	5, 6, 7,
+	0, 2, 4,
+	4, 2, 6,
+	1, 5, 3,
+	5, 7, 3,
+	0, 4, 1,
+	4, 5, 1,
+	2, 3, 6,
+	6, 3, 7,
+};
+
+// Minimal shader binaries accepted by bgfx::createShader: magic, input hash,
+// and zero uniforms. Noop renderer doesn't look past the header.
+static const uint8_t s_vsNoop[] = { 'V', 'S', 'H', 0x5, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 };
+static const uint8_t s_fsNoop[] = { 'F', 'S', 'H', 0x5, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0 };
+
+struct Workload
+{
+	Workload()
+		: m_settings(NULL)
+		, m_numUniforms(0)
+		, m_tvb(NULL)
+	{
+	}
+
+	void encode(uint32_t _encoderIdx, bgfx::Encoder* _encoder)
+	{
+		const uint32_t numEncoders = m_settings->m_numEncoders;
+		const uint32_t numDraws    = m_settings->m_numDraws;
+		const uint32_t begin = numDraws*_encoderIdx/numEncoders;
+		const uint32_t end   = numDraws*(_encoderIdx+1)/numEncoders;
+
+		for (uint32_t ii = begin; ii < end; ++ii)
+		{
+			float mtx[16];
+			bx::mtxTranslate(mtx, float(ii%100)*3.0f, float(ii/100%100)*3.0f, float(ii/10000)*3.0f);
+			_encoder->setTransform(mtx);
+
+			for (uint32_t uu = 0; uu < m_numUniforms; ++uu)
+			{
+				const float value[4] = { float(ii), float(uu), 0.0f, 1.0f };
+				_encoder->setUniform(m_uniforms[uu], value);
+			}
+
+			if (NULL != m_tvb
+			&&  ii == begin)
+			{
+				_encoder->setVertexBuffer(1, m_tvb);
+			}
+
+			_encoder->setVertexBuffer(0, m_vbh);
+			_encoder->setIndexBuffer(m_ibh);
+			_encoder->setState(BGFX_STATE_DEFAULT);
+			// Scatter depth, so that sort has work to do.
+			_encoder->submit(0, m_program, (ii*2654435761u)>>8);
+		}
+	}
+
+	const Settings* m_settings;
+	bgfx::VertexBufferHandle m_vbh;
+	bgfx::IndexBufferHandle  m_ibh;
+	bgfx::ProgramHandle      m_program;
+	bgfx::UniformHandle      m_uniforms[BGFX_BENCH_MAX_UNIFORMS];
+	uint32_t m_numUniforms;
+	const bgfx::TransientVertexBuffer* m_tvb;
+};
+
+struct EncoderThread
+{
+	EncoderThread()
+		: m_workload(NULL)
+		, m_idx(0)
+		, m_exit(false)
+	{
+	}
+
+	static int32_t threadFunc(bx::Thread* _thread, void* _userData)
+	{
+		BX_UNUSED(_thread);
+		EncoderThread* self = (EncoderThread*)_userData;
+
+		for (;;)
+		{
+			self->m_start.wait();
+
+			if (self->m_exit)
+			{
+				break;
+			}
+
+			bgfx::Encoder* encoder = bgfx::begin(true);
+			if (NULL != encoder)
+			{
+				self->m_workload->encode(self->m_idx, encoder);
+				bgfx::end(encoder);
+			}
+
+			self->m_done->post();
+		}
+
+		return bx::kExitSuccess;
+	}
+
+	Workload*      m_workload;
+	bx::Semaphore* m_done;
+	bx::Semaphore  m_start;
+	bx::Thread     m_thread;
+	uint32_t       m_idx;
+	bool           m_exit;
+};
+
+struct JsonWriter
+{
+	JsonWriter()
+		: m_pos(0)
+	{
+		m_data[0] = '\0';
+	}
+
+	void printf(const char* _format, ...)
+	{
+		va_list argList;
+		va_start(argList, _format);
+		const int32_t len = bx::vsnprintf(&m_data[m_pos], sizeof(m_data)-m_pos, _format, argList);
+		va_end(argList);
+
+		m_pos = bx::min<int32_t>(m_pos + bx::max(len, 0), int32_t(sizeof(m_data) )-1);
+	}
+
+	void timing(const char* _name, const Timing& _timing, bool _last = false)
+	{
+		const double num = double(bx::max<uint32_t>(_timing.m_num, 1) );
+		printf("\t\t\"%s\": { \"avg\": %.4f, \"min\": %.4f, \"max\": %.4f }%s\n"
+			, _name
+			, _timing.m_total/num
+			, 0 == _timing.m_num ? 0.0 : _timing.m_min
+			, _timing.m_max
+			, _last ? "" : ","
+			);
+	}
+
+	char    m_data[4<<10];
+	int32_t m_pos;
+};
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('v', "version") )
+	{
+		bx::printf(
+			  "bench, bgfx headless CPU benchmark, version %d.%d.%d.\n"
+			, BGFX_BENCH_VERSION_MAJOR
+			, BGFX_BENCH_VERSION_MINOR
+			, BGFX_API_VERSION
+			);
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitFailure;
+	}
+
+	Settings settings;
+	cmdLine.hasArg(settings.m_numFrames,         '\0', "frames");
+	cmdLine.hasArg(settings.m_numWarmup,         '\0', "warmup");
+	cmdLine.hasArg(settings.m_numDraws,          '\0', "draws");
+	cmdLine.hasArg(settings.m_numEncoders,       '\0', "encoders");
+	cmdLine.hasArg(settings.m_numUniforms,       '\0', "uniforms");
+	cmdLine.hasArg(settings.m_transientSize,     '\0', "transient");
+	cmdLine.hasArg(settings.m_numTextureUpdates, '\0', "texture-updates");
+	settings.m_threaded = cmdLine.hasArg('\0', "threaded");
+
+	settings.m_numFrames   = bx::max<uint32_t>(settings.m_numFrames, 1);
+	settings.m_numEncoders = bx::clamp<uint32_t>(settings.m_numEncoders, 1, BGFX_BENCH_MAX_ENCODERS);
+
+	if (BGFX_BENCH_MAX_UNIFORMS < settings.m_numUniforms)
+	{
+		help("Too many uniforms per draw call.");
+		return bx::kExitFailure;
+	}
+
+	const char* outFilePath = cmdLine.findOption('o');
+
+	if (!settings.m_threaded)
+	{
+		// Calling renderFrame before init keeps renderer on API thread.
+		bgfx::renderFrame();
+	}
+
+	CountingAllocator allocator;
+
+	bgfx::Init init;
+	init.type      = bgfx::RendererType::Noop;
+	init.allocator = &allocator;
+	init.resolution.width  = 1280;
+	init.resolution.height = 720;
+	init.resolution.reset  = BGFX_RESET_NONE;
+	init.limits.maxEncoders     = uint16_t(bx::max<uint32_t>(init.limits.maxEncoders, settings.m_numEncoders) );
+	init.limits.transientVbSize = bx::max<uint32_t>(init.limits.transientVbSize, settings.m_transientSize + (64<<10) );
+
+	if (!bgfx::init(init) )
+	{
+		bx::printf("Failed to initialize Noop renderer.\n");
+		return bx::kExitFailure;
+	}
+
+	const bgfx::Caps* caps = bgfx::getCaps();
+	if (settings.m_numDraws > caps->limits.maxDrawCalls)
+	{
+		settings.m_numDraws = caps->limits.maxDrawCalls;
+	}
+
+	settings.m_numEncoders = bx::min<uint32_t>(settings.m_numEncoders, caps->limits.maxEncoders);
+
+	PosColorVertex::init();
+
+	Workload workload;
+	workload.m_settings = &settings;
+	workload.m_vbh = bgfx::createVertexBuffer(bgfx::makeRef(s_cubeVertices, sizeof(s_cubeVertices) ), PosColorVertex::ms_decl);
+	workload.m_ibh = bgfx::createIndexBuffer(bgfx::makeRef(s_cubeIndices, sizeof(s_cubeIndices) ) );
+	workload.m_program = bgfx::createProgram(
+		  bgfx::createShader(bgfx::makeRef(s_vsNoop, sizeof(s_vsNoop) ) )
+		, bgfx::createShader(bgfx::makeRef(s_fsNoop, sizeof(s_fsNoop) ) )
+		, true
+		);
+
+	workload.m_numUniforms = settings.m_numUniforms;
+	for (uint32_t ii = 0; ii < workload.m_numUniforms; ++ii)
+	{
+		char name[32];
+		bx::snprintf(name, BX_COUNTOF(name), "u_bench%d", ii);
+		workload.m_uniforms[ii] = bgfx::createUniform(name, bgfx::UniformType::Vec4);
+	}
+
+	bgfx::VertexDecl transientDecl;
+	transientDecl
+		.begin()
+		.add(bgfx::Attrib::TexCoord7, 4, bgfx::AttribType::Float)
+		.end();
+
+	const uint16_t textureSize = 256;
+	bgfx::TextureHandle texture = BGFX_INVALID_HANDLE;
+	if (0 != settings.m_numTextureUpdates)
+	{
+		texture = bgfx::createTexture2D(textureSize, textureSize, false, 1, bgfx::TextureFormat::RGBA8);
+	}
+
+	bgfx::setViewRect(0, 0, 0, uint16_t(init.resolution.width), uint16_t(init.resolution.height) );
+
+	bx::Semaphore  done;
+	EncoderThread* threads = NULL;
+	const uint32_t numThreads = settings.m_numEncoders - 1;
+
+	if (0 != numThreads)
+	{
+		threads = new EncoderThread[numThreads];
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			EncoderThread& thread = threads[ii];
+			thread.m_workload = &workload;
+			thread.m_done     = &done;
+			thread.m_idx      = ii + 1;
+			thread.m_thread.init(EncoderThread::threadFunc, &thread, 0, "bench-encoder");
+		}
+	}
+
+	Timing encodeTime;
+	Timing frameTime;
+	Timing sortTime;
+	Timing execCommandsTime;
+	Timing submitTime;
+
+	int32_t numAllocs   = 0;
+	int32_t numReallocs = 0;
+	int32_t numFrees    = 0;
+	int64_t allocBytes  = 0;
+	int64_t frameArenaUsed      = 0;
+	int64_t numFrameArenaAllocs = 0;
+
+	int64_t numProgramChanges     = 0;
+	int64_t numBlendStateChanges  = 0;
+	int64_t numDepthStateChanges  = 0;
+	int64_t numRasterStateChanges = 0;
+	int64_t numVertexBufferBinds  = 0;
+	int64_t numIndexBufferBinds   = 0;
+	int64_t numTextureBinds       = 0;
+	int64_t numUniformUploads     = 0;
+	int64_t numBindCacheHits      = 0;
+	int64_t numBindCacheMisses    = 0;
+
+	const int64_t hpFreq = bx::getHPFrequency();
+	const uint32_t numFrames = settings.m_numWarmup + settings.m_numFrames;
+
+	for (uint32_t frame = 0; frame < numFrames; ++frame)
+	{
+		const bool measure = frame >= settings.m_numWarmup;
+
+		if (frame == settings.m_numWarmup)
+		{
+			numAllocs   = bx::atomicFetchAndAdd<int32_t>(&allocator.m_numAllocs,   0);
+			numReallocs = bx::atomicFetchAndAdd<int32_t>(&allocator.m_numReallocs, 0);
+			numFrees    = bx::atomicFetchAndAdd<int32_t>(&allocator.m_numFrees,    0);
+			allocBytes  = bx::atomicFetchAndAdd<int64_t>(&allocator.m_bytes,       0);
+		}
+
+		const int64_t encodeBegin = bx::getHPCounter();
+
+		bgfx::TransientVertexBuffer tvb;
+		workload.m_tvb = NULL;
+
+		if (0 != settings.m_transientSize)
+		{
+			const uint32_t num = settings.m_transientSize/transientDecl.getStride();
+			if (0 != num
+			&&  num == bgfx::getAvailTransientVertexBuffer(num, transientDecl) )
+			{
+				bgfx::allocTransientVertexBuffer(&tvb, num, transientDecl);
+				bx::memSet(tvb.data, uint8_t(frame), tvb.size);
+				workload.m_tvb = &tvb;
+			}
+		}
+
+		for (uint32_t ii = 0; ii < settings.m_numTextureUpdates; ++ii)
+		{
+			const uint16_t size = 64;
+			const uint16_t tiles = textureSize/size;
+			const uint16_t tile  = uint16_t( (frame + ii) % (tiles*tiles) );
+			const bgfx::Memory* mem = bgfx::alloc(size*size*4);
+			bx::memSet(mem->data, uint8_t(ii), mem->size);
+			bgfx::updateTexture2D(texture, 0, 0, uint16_t(tile%tiles*size), uint16_t(tile/tiles*size), size, size, mem);
+		}
+
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			threads[ii].m_start.post();
+		}
+
+		bgfx::Encoder* encoder = bgfx::begin();
+		workload.encode(0, encoder);
+		bgfx::end(encoder);
+
+		for (uint32_t ii = 0; ii < numThreads; ++ii)
+		{
+			done.wait();
+		}
+
+		const int64_t frameBegin = bx::getHPCounter();
+		bgfx::frame();
+		const int64_t frameEnd = bx::getHPCounter();
+
+		if (measure)
+		{
+			encodeTime.add(frameBegin - encodeBegin, hpFreq);
+			frameTime.add(frameEnd - frameBegin, hpFreq);
+
+			// Renderer stats are for the frame rendered before this one.
+			const bgfx::Stats* stats = bgfx::getStats();
+			sortTime.add(stats->cpuTimeSort, stats->cpuTimerFreq);
+			execCommandsTime.add(stats->cpuTimeExecCommands, stats->cpuTimerFreq);
+			submitTime.add(stats->cpuTimeEnd - stats->cpuTimeBegin - stats->cpuTimeSort, stats->cpuTimerFreq);
+
+			frameArenaUsed      += stats->frameArenaUsed;
+			numFrameArenaAllocs += stats->numFrameArenaAllocs;
+
+			numProgramChanges     += stats->numProgramChanges;
+			numBlendStateChanges  += stats->numBlendStateChanges;
+			numDepthStateChanges  += stats->numDepthStateChanges;
+			numRasterStateChanges += stats->numRasterStateChanges;
+			numVertexBufferBinds  += stats->numVertexBufferBinds;
+			numIndexBufferBinds   += stats->numIndexBufferBinds;
+			numTextureBinds       += stats->numTextureBinds;
+			numUniformUploads     += stats->numUniformUploads;
+			numBindCacheHits      += stats->numBindCacheHits;
+			numBindCacheMisses    += stats->numBindCacheMisses;
+		}
+	}
+
+	numAllocs   = bx::atomicFetchAndAdd<int32_t>(&allocator.m_numAllocs,   0) - numAllocs;
+	numReallocs = bx::atomicFetchAndAdd<int32_t>(&allocator.m_numReallocs, 0) - numReallocs;
+	numFrees    = bx::atomicFetchAndAdd<int32_t>(&allocator.m_numFrees,    0) - numFrees;
+	allocBytes  = bx::atomicFetchAndAdd<int64_t>(&allocator.m_bytes,       0) - allocBytes;
+
+	for (uint32_t ii = 0; ii < numThreads; ++ii)
+	{
+		threads[ii].m_exit = true;
+		threads[ii].m_start.post();
+		threads[ii].m_thread.shutdown();
+	}
+
+	delete [] threads;
+
+	if (bgfx::isValid(texture) )
+	{
+		bgfx::destroy(texture);
+	}
+
+	for (uint32_t ii = 0; ii < workload.m_numUniforms; ++ii)
+	{
+		bgfx::destroy(workload.m_uniforms[ii]);
+	}
+
+	bgfx::destroy(workload.m_program);
+	bgfx::destroy(workload.m_ibh);
+	bgfx::destroy(workload.m_vbh);
+
+	bgfx::shutdown();
+
+	const double perFrame = 1.0/double(settings.m_numFrames);
+
+	JsonWriter json;
+	json.printf("{\n");
+	json.printf("\t\"version\": \"%d.%d.%d\",\n", BGFX_BENCH_VERSION_MAJOR, BGFX_BENCH_VERSION_MINOR, BGFX_API_VERSION);
+	json.printf("\t\"renderer\": \"%s\",\n", bgfx::getRendererName(bgfx::RendererType::Noop) );
+	json.printf("\t\"settings\": {\n");
+	json.printf("\t\t\"frames\": %d,\n",         settings.m_numFrames);
+	json.printf("\t\t\"warmup\": %d,\n",         settings.m_numWarmup);
+	json.printf("\t\t\"draws\": %d,\n",          settings.m_numDraws);
+	json.printf("\t\t\"encoders\": %d,\n",       settings.m_numEncoders);
+	json.printf("\t\t\"uniforms\": %d,\n",       settings.m_numUniforms);
+	json.printf("\t\t\"transient\": %d,\n",      settings.m_transientSize);
+	json.printf("\t\t\"textureUpdates\": %d,\n", settings.m_numTextureUpdates);
+	json.printf("\t\t\"threaded\": %s\n",        settings.m_threaded ? "true" : "false");
+	json.printf("\t},\n");
+	json.printf("\t\"timeMs\": {\n");
+	json.timing("encode",       encodeTime);
+	json.timing("frame",        frameTime);
+	json.timing("sort",         sortTime);
+	json.timing("execCommands", execCommandsTime);
+	json.timing("submit",       submitTime, true);
+	json.printf("\t},\n");
+	json.printf("\t\"allocations\": {\n");
+	json.printf("\t\t\"allocsPerFrame\": %.2f,\n",           double(numAllocs)*perFrame);
+	json.printf("\t\t\"reallocsPerFrame\": %.2f,\n",         double(numReallocs)*perFrame);
+	json.printf("\t\t\"freesPerFrame\": %.2f,\n",            double(numFrees)*perFrame);
+	json.printf("\t\t\"bytesPerFrame\": %.2f,\n",            double(allocBytes)*perFrame);
+	json.printf("\t\t\"frameArenaAllocsPerFrame\": %.2f,\n", double(numFrameArenaAllocs)*perFrame);
+	json.printf("\t\t\"frameArenaBytesPerFrame\": %.2f\n",   double(frameArenaUsed)*perFrame);
+	json.printf("\t},\n");
+	json.printf("\t\"stateChanges\": {\n");
+	json.printf("\t\t\"programPerFrame\": %.2f,\n",           double(numProgramChanges)*perFrame);
+	json.printf("\t\t\"blendPerFrame\": %.2f,\n",             double(numBlendStateChanges)*perFrame);
+	json.printf("\t\t\"depthPerFrame\": %.2f,\n",             double(numDepthStateChanges)*perFrame);
+	json.printf("\t\t\"rasterPerFrame\": %.2f,\n",            double(numRasterStateChanges)*perFrame);
+	json.printf("\t\t\"vertexBufferBindsPerFrame\": %.2f,\n", double(numVertexBufferBinds)*perFrame);
+	json.printf("\t\t\"indexBufferBindsPerFrame\": %.2f,\n",  double(numIndexBufferBinds)*perFrame);
+	json.printf("\t\t\"textureBindsPerFrame\": %.2f,\n",      double(numTextureBinds)*perFrame);
+	json.printf("\t\t\"uniformUploadsPerFrame\": %.2f,\n",    double(numUniformUploads)*perFrame);
+	json.printf("\t\t\"bindCacheHitsPerFrame\": %.2f,\n",     double(numBindCacheHits)*perFrame);
+	json.printf("\t\t\"bindCacheMissesPerFrame\": %.2f\n",    double(numBindCacheMisses)*perFrame);
+	json.printf("\t}\n");
+	json.printf("}\n");
+
+	if (NULL != outFilePath)
+	{
+		bx::FileWriter writer;
+		if (!bx::open(&writer, outFilePath) )
+		{
+			bx::printf("Unable to open output file '%s'.\n", outFilePath);
+			return bx::kExitFailure;
+		}
+
+		bx::write(&writer, json.m_data, json.m_pos);
+		bx::close(&writer);
+	}
+	else
+	{
+		bx::printf("%s", json.m_data);
+	}
+
+	return bx::kExitSuccess;
+}
@@ -0,0 +1,271 @@
+/*
+ * Copyright 2011-2019 Branimir Karadzic. All rights reserved.
+ * License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause
+ */
+
+#include <bx/allocator.h>
+#include <bx/commandline.h>
+#include <bx/file.h>
+#include <bx/string.h>
+#include <bx/timer.h>
+#include <bgfx/bgfx.h>
+#include <bgfx/platform.h>
+#include "../../src/capture.h"
+
+#define BGFX_REPLAY_VERSION_MAJOR 1
+#define BGFX_REPLAY_VERSION_MINOR 0
+
+void help(const char* _error = NULL)
+{
+	if (NULL != _error)
+	{
+		bx::printf("Error:\n%s\n\n", _error);
+	}
+
+	bx::printf(
+		  "replay, bgfx command stream replay tool, version %d.%d.%d.\n"
+		  "Copyright 2011-2019 Branimir Karadzic. All rights reserved.\n"
+		  "License: https://github.com/bkaradzic/bgfx#license-bsd-2-clause\n\n"
+		, BGFX_REPLAY_VERSION_MAJOR
+		, BGFX_REPLAY_VERSION_MINOR
+		, BGFX_API_VERSION
+		);
+
+	bx::printf(
+		  "Usage: replay -f <in>\n"
+
+		  "\n"
+		  "Options:\n"
+		  "  -h, --help               Help.\n"
+		  "  -v, --version            Version information only.\n"
+		  "  -f <file path>           Capture file path (see bgfx::Init::captureFilePath).\n"
+		  "  -t, --type <renderer>    Renderer type (default: noop). Renderer other than noop\n"
+		  "           must be able to initialize without window, and capture must be\n"
+		  "           recorded with the same renderer type.\n"
+		  "      --loop <num>         Replay capture number of times (default: 1).\n"
+
+		  "\n"
+		  "For additional information, see https://github.com/bkaradzic/bgfx\n"
+		);
+}
+
+static bgfx::RendererType::Enum findRendererType(const char* _name)
+{
+	for (uint32_t ii = 0; ii < bgfx::RendererType::Count; ++ii)
+	{
+		const bgfx::RendererType::Enum type = bgfx::RendererType::Enum(ii);
+		if (0 == bx::strCmpI(_name, bgfx::getRendererName(type) ) )
+		{
+			return type;
+		}
+	}
+
+	return bgfx::RendererType::Count;
+}
+
+struct FrameTime
+{
+	FrameTime()
+		: m_total(0)
+		, m_min(INT64_MAX)
+		, m_max(0)
+		, m_num(0)
+	{
+	}
+
+	void add(int64_t _time)
+	{
+		m_total += _time;
+		m_min = bx::min(m_min, _time);
+		m_max = bx::max(m_max, _time);
+		++m_num;
+	}
+
+	int64_t  m_total;
+	int64_t  m_min;
+	int64_t  m_max;
+	uint32_t m_num;
+};
+
+static bool replay(bx::FileReaderI* _reader, uint32_t _dataOffset, FrameTime& _frameTime)
+{
+	bx::seek(_reader, _dataOffset, bx::Whence::Begin);
+
+	bx::DefaultAllocator allocator;
+	void*    data     = NULL;
+	uint32_t capacity = 0;
+	bool     result   = true;
+
+	for (;;)
+	{
+		bx::Error err;
+
+		uint32_t magic;
+		bx::read(_reader, magic, &err);
+
+		if (!err.isOk() )
+		{
+			// End of capture.
+			break;
+		}
+
+		uint32_t size;
+		bx::read(_reader, size, &err);
+
+		if (!err.isOk()
+		||  BGFX_CHUNK_MAGIC_FRM != magic)
+		{
+			bx::printf("Invalid frame chunk at frame %d.\n", _frameTime.m_num);
+			result = false;
+			break;
+		}
+
+		if (size > capacity)
+		{
+			capacity = size;
+			data = BX_REALLOC(&allocator, data, capacity);
+		}
+
+		bx::read(_reader, data, size, &err);
+
+		if (!err.isOk() )
+		{
+			bx::printf("Truncated frame chunk at frame %d.\n", _frameTime.m_num);
+			result = false;
+			break;
+		}
+
+		const int64_t start = bx::getHPCounter();
+
+		if (!bgfx::replayFrame(data, size) )
+		{
+			bx::printf("Failed to replay frame %d.\n", _frameTime.m_num);
+			result = false;
+			break;
+		}
+
+		_frameTime.add(bx::getHPCounter() - start);
+	}
+
+	BX_FREE(&allocator, data);
+
+	return result;
+}
+
+int main(int _argc, const char* _argv[])
+{
+	bx::CommandLine cmdLine(_argc, _argv);
+
+	if (cmdLine.hasArg('v', "version") )
+	{
+		bx::printf(
+			  "replay, bgfx command stream replay tool, version %d.%d.%d.\n"
+			, BGFX_REPLAY_VERSION_MAJOR
+			, BGFX_REPLAY_VERSION_MINOR
+			, BGFX_API_VERSION
+			);
+		return bx::kExitSuccess;
+	}
+
+	if (cmdLine.hasArg('h', "help") )
+	{
+		help();
+		return bx::kExitFailure;
+	}
+
+	const char* filePath = cmdLine.findOption('f');
+	if (NULL == filePath)
+	{
+		help("Input file name must be specified.");
+		return bx::kExitFailure;
+	}
+
+	bgfx::RendererType::Enum type = bgfx::RendererType::Noop;
+	const char* typeName = cmdLine.findOption('t', "type");
+	if (NULL != typeName)
+	{
+		type = findRendererType(typeName);
+		if (bgfx::RendererType::Count == type)
+		{
+			help("Unknown renderer type.");
+			return bx::kExitFailure;
+		}
+	}
+
+	uint32_t numLoops = 1;
+	cmdLine.hasArg(numLoops, '\0', "loop");
+	numLoops = bx::max<uint32_t>(numLoops, 1);
+
+	bx::FileReader reader;
+	if (!bx::open(&reader, filePath) )
+	{
+		bx::printf("Unable to open input file '%s'.\n", filePath);
+		return bx::kExitFailure;
+	}
+
+	uint32_t magic = 0;
+	bx::read(&reader, magic);
+
+	uint32_t size = 0;
+	bx::read(&reader, size);
+
+	bgfx::CaptureHeader header;
+	if (BGFX_CHUNK_MAGIC_CAP != magic
+	||  sizeof(bgfx::CaptureHeader) != size
+	||  int32_t(sizeof(bgfx::CaptureHeader) ) != bx::read(&reader, &header, sizeof(bgfx::CaptureHeader) )
+	||  BGFX_CAPTURE_VERSION != header.m_version
+	||  BGFX_API_VERSION != header.m_apiVersion)
+	{
+		bx::printf("Input file '%s' is not valid capture, or it's recorded with different bgfx version.\n", filePath);
+		bx::close(&reader);
+		return bx::kExitFailure;
+	}
+
+	const uint32_t dataOffset = uint32_t(bx::seek(&reader) );
+
+	bgfx::Init init;
+	init.type       = type;
+	init.resolution = header.m_resolution;
+	init.limits     = header.m_limits;
+
+	if (!bgfx::init(init) )
+	{
+		bx::printf("Failed to initialize renderer '%s'.\n", bgfx::getRendererName(type) );
+		bx::close(&reader);
+		return bx::kExitFailure;
+	}
+
+	bx::printf("Replaying '%s' with %s renderer (captured with %s).\n"
+		, filePath
+		, bgfx::getRendererName(bgfx::getRendererType() )
+		, header.m_rendererType < bgfx::RendererType::Count ? bgfx::getRendererName(header.m_rendererType) : "default"
+		);
+
+	FrameTime frameTime;
+
+	bool ok = true;
+	for (uint32_t ii = 0; ii < numLoops && ok; ++ii)
+	{
+		ok = replay(&reader, dataOffset, frameTime);
+
+		// Next pass creates all resources again.
+		bgfx::replayReset();
+	}
+
+	bgfx::shutdown();
+	bx::close(&reader);
+
+	if (0 < frameTime.m_num)
+	{
+		const double toMs = 1000.0/double(bx::getHPFrequency() );
+
+		bx::printf("Frames: %d, avg: %.3f [ms], min: %.3f [ms], max: %.3f [ms]\n"
+			, frameTime.m_num
+			, double(frameTime.m_total)*toMs/double(frameTime.m_num)
+			, double(frameTime.m_min)*toMs
+			, double(frameTime.m_max)*toMs
+			);
+	}
+
+	return ok ? bx::kExitSuccess : bx::kExitFailure;
+}
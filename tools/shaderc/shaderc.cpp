@@ -197,6 +197,7 @@ namespace bgfx
 		, backwardsCompatibility(false)
 		, warningsAreErrors(false)
 		, keepIntermediate(false)
+		, uniformBlocks(false)
 		, optimize(false)
 		, optimizationLevel(3)
 	{
@@ -222,6 +223,7 @@ namespace bgfx
 			"\t  backwardsCompatibility: %s\n"
 			"\t  warningsAreErrors: %s\n"
 			"\t  keepIntermediate: %s\n"
+			"\t  uniformBlocks: %s\n"
 			"\t  optimize: %s\n"
 			"\t  optimizationLevel: %d\n"
 
@@ -242,6 +244,7 @@ namespace bgfx
 			, backwardsCompatibility ? "true" : "false"
 			, warningsAreErrors ? "true" : "false"
 			, keepIntermediate ? "true" : "false"
+			, uniformBlocks ? "true" : "false"
 			, optimize ? "true" : "false"
 			, optimizationLevel
 			);
@@ -907,6 +910,12 @@ namespace bgfx
 			  "      --varyingdef <file path>  Path to varying.def.sc file.\n"
 			  "      --verbose                 Verbose.\n"
 
+			  "\n"
+			  "Options (GLSL only):\n"
+
+			  "\n"
+			  "      --uniform-blocks          Place uniforms into std140 uniform blocks (requires GLSL 1.40 or ESSL 3.00).\n"
+
 			  "\n"
 			  "Options (DX9 and DX11 only):\n"
 
@@ -2388,6 +2397,7 @@ namespace bgfx
 			options.backwardsCompatibility = cmdLine.hasArg('\0', "backwards-compatibility");
 			options.warningsAreErrors      = cmdLine.hasArg('\0', "Werror");
 			options.keepIntermediate       = cmdLine.hasArg('\0', "keep-intermediate");
+			options.uniformBlocks          = cmdLine.hasArg('\0', "uniform-blocks");
 
 			uint32_t optimization = 3;
 			if (cmdLine.hasArg(optimization, 'O') )
@@ -153,6 +153,7 @@ namespace bgfx
 		bool backwardsCompatibility;
 		bool warningsAreErrors;
 		bool keepIntermediate;
+		bool uniformBlocks;
 
 		bool optimize;
 		uint32_t optimizationLevel;
@@ -101,6 +101,12 @@ namespace bgfx { namespace glsl
 		}
 
 		UniformArray uniforms;
+		std::string uniformBlock;
+		std::string uniformDefines;
+
+		// Each stage has its own block, referenced through instance name,
+		// so that the same uniform can be used by both stages.
+		const char* uniformInstance = 'f' == ch ? "bgfx_fs" : "bgfx_vs";
 
 		if (target != kGlslTargetMetal)
 		{
@@ -189,6 +195,22 @@ namespace bgfx { namespace glsl
 						un.regIndex = 0;
 						un.regCount = num;
 						uniforms.push_back(un);
+
+						if (_options.uniformBlocks
+						&&  UniformType::Sampler != un.type)
+						{
+							// Move declaration into uniform block, and blank it out
+							// of shader code.
+							const char* begin = bx::strLTrimSpace(bx::StringView(qualifier.getTerm(), eol.getPtr() ) ).getPtr();
+							uniformBlock += "\t";
+							uniformBlock.append(begin, eol.getPtr() + 1);
+							uniformBlock += "\n";
+
+							char* decl = const_cast<char*>(qualifier.getPtr() );
+							bx::memSet(decl, ' ', uint32_t(eol.getPtr() + 1 - decl) );
+
+							uniformDefines += "#define " + un.name + " " + uniformInstance + "." + un.name + "\n";
+						}
 					}
 
 					parse = bx::strLTrimSpace(bx::strFindNl(bx::StringView(eol.getPtr(), parse.getTerm() ) ) );
@@ -314,6 +336,22 @@ namespace bgfx { namespace glsl
 			}
 		}
 
+		std::string code;
+
+		if (!uniformBlock.empty() )
+		{
+			code  = "layout(std140) uniform ";
+			code += 'f' == ch ? "bgfx_FragmentUniforms" : "bgfx_VertexUniforms";
+			code += "\n{\n";
+			code += uniformBlock;
+			code += "} ";
+			code += uniformInstance;
+			code += ";\n";
+			code += uniformDefines;
+			code += optimizedShader;
+			optimizedShader = code.c_str();
+		}
+
 		uint16_t count = (uint16_t)uniforms.size();
 		bx::write(_writer, count);
 